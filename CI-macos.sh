@@ -23,12 +23,16 @@ export MACOSX_DEPLOYMENT_TARGET=10.15
 # Build TB
 
 TB_BUILD_TYPE="Release"
+TB_ENABLE_FLAT_OCTREE="false"
 if [[ $TB_ENABLE_ASAN == "true" ]] ; then
     TB_BUILD_TYPE="Debug"
+    # the ASan build also verifies the alternative octree implementation
+    TB_ENABLE_FLAT_OCTREE="true"
 fi
 
 echo "TB_BUILD_TYPE: $TB_BUILD_TYPE"
 echo "TB_ENABLE_ASAN: $TB_ENABLE_ASAN"
+echo "TB_ENABLE_FLAT_OCTREE: $TB_ENABLE_FLAT_OCTREE"
 echo "TB_SIGN_MAC_BUNDLE: $TB_SIGN_MAC_BUNDLE"
 
 # Note: The app bundle and the archive should be signed and notarized, otherwise macOS'
@@ -51,6 +55,7 @@ cmake .. \
   -DTB_ENABLE_CCACHE=0 \
   -DTB_ENABLE_PCH=0 \
   -DTB_ENABLE_ASAN="$TB_ENABLE_ASAN" \
+  -DTB_ENABLE_FLAT_OCTREE="$TB_ENABLE_FLAT_OCTREE" \
   -DTB_RUN_MACDEPLOYQT=1 \
   -DTB_SIGN_MAC_BUNDLE=$TB_SIGN_MAC_BUNDLE \
   -DTB_SIGN_IDENTITY="$TB_SIGN_IDENTITY" \
@@ -0,0 +1,182 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "flat_octree.h"
+#include "octree.h"
+
+#include "vm/bbox.h"
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <fmt/format.h>
+
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tb
+{
+namespace
+{
+
+constexpr size_t NumNodes = 500'000;
+constexpr size_t NumRays = 10'000;
+constexpr size_t NumUpdates = 100'000;
+constexpr double WorldSize = 32768.0;
+
+/**
+ * Creates brush sized boxes scattered over the world bounds.
+ */
+auto makeBounds(std::mt19937& rng, const size_t count)
+{
+  auto position =
+    std::uniform_real_distribution<double>{-WorldSize / 2.0, WorldSize / 2.0};
+  auto size = std::uniform_real_distribution<double>{8.0, 256.0};
+
+  auto result = std::vector<vm::bbox3d>{};
+  result.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const auto min = vm::vec3d{position(rng), position(rng), position(rng)};
+    result.emplace_back(min, min + vm::vec3d{size(rng), size(rng), size(rng)});
+  }
+  return result;
+}
+
+auto makeRays(std::mt19937& rng, const size_t count)
+{
+  auto position =
+    std::uniform_real_distribution<double>{-WorldSize / 2.0, WorldSize / 2.0};
+  auto direction = std::uniform_real_distribution<double>{-1.0, 1.0};
+
+  auto result = std::vector<vm::ray3d>{};
+  result.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    result.emplace_back(
+      vm::vec3d{position(rng), position(rng), position(rng)},
+      vm::normalize(vm::vec3d{direction(rng), direction(rng), direction(rng)}));
+  }
+  return result;
+}
+
+template <typename Tree>
+void benchmarkTree(
+  const std::string& name,
+  const std::vector<vm::bbox3d>& bounds,
+  const std::vector<vm::bbox3d>& updatedBounds,
+  const std::vector<vm::ray3d>& rays)
+{
+  auto tree = Tree{256.0};
+
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < bounds.size(); ++i)
+      {
+        tree.insert(bounds[i], i);
+      }
+    },
+    fmt::format("{}: insert {} nodes", name, bounds.size()));
+
+  if constexpr (requires { tree.compact(); })
+  {
+    timeLambda([&]() { tree.compact(); }, fmt::format("{}: compact", name));
+  }
+
+  auto hits = size_t(0);
+  timeLambda(
+    [&]() {
+      auto result = std::vector<size_t>{};
+      for (const auto& ray : rays)
+      {
+        result.clear();
+        tree.find_intersectors(ray, std::back_inserter(result));
+        hits += result.size();
+      }
+    },
+    fmt::format("{}: pick {} rays", name, rays.size()));
+
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < updatedBounds.size(); ++i)
+      {
+        tree.update(updatedBounds[i], i);
+      }
+    },
+    fmt::format("{}: update {} nodes", name, updatedBounds.size()));
+
+  timeLambda(
+    [&]() {
+      auto result = std::vector<size_t>{};
+      for (const auto& ray : rays)
+      {
+        result.clear();
+        tree.find_intersectors(ray, std::back_inserter(result));
+        hits += result.size();
+      }
+    },
+    fmt::format("{}: pick {} rays after update", name, rays.size()));
+
+  CHECK(hits > 0);
+}
+
+template <typename Tree>
+void benchmarkBuild(const std::string& name, const std::vector<vm::bbox3d>& bounds)
+{
+  auto items = std::vector<std::pair<vm::bbox3d, size_t>>{};
+  items.reserve(bounds.size());
+  for (size_t i = 0; i < bounds.size(); ++i)
+  {
+    items.emplace_back(bounds[i], i);
+  }
+
+  auto tree = Tree{256.0};
+  timeLambda(
+    [&]() { tree.build(items); }, fmt::format("{}: build {} nodes", name, items.size()));
+
+  CHECK(tree.contains(bounds.size() - 1));
+}
+
+} // namespace
+
+TEST_CASE("OctreeBenchmark.pickAndUpdate")
+{
+  auto rng = std::mt19937{12345};
+  const auto bounds = makeBounds(rng, NumNodes);
+  const auto updatedBounds = makeBounds(rng, NumUpdates);
+  const auto rays = makeRays(rng, NumRays);
+
+  benchmarkTree<octree<double, size_t>>("octree", bounds, updatedBounds, rays);
+  benchmarkTree<flat_octree<double, size_t>>("flat_octree", bounds, updatedBounds, rays);
+}
+
+TEST_CASE("OctreeBenchmark.build")
+{
+  auto rng = std::mt19937{12345};
+  const auto bounds = makeBounds(rng, NumNodes);
+
+  benchmarkBuild<octree<double, size_t>>("octree", bounds);
+  benchmarkBuild<flat_octree<double, size_t>>("flat_octree", bounds);
+}
+
+} // namespace tb
@@ -0,0 +1,136 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "el/CompiledExpression.h"
+#include "el/EvaluationContext.h"
+#include "el/Expression.h"
+#include "el/Value.h"
+#include "el/VariableStore.h"
+#include "io/ELParser.h"
+#include "io/ParseModelDefinition.h"
+
+#include "kdl/result.h"
+
+#include <fmt/format.h>
+
+#include <string>
+#include <vector>
+
+namespace tb::el
+{
+namespace
+{
+
+constexpr size_t NumEvaluations = 100'000;
+
+// model expressions as they appear in the bundled entity definition files
+const auto ModelExpressions = std::vector<std::string>{
+  R"({ "path": ":progs/player.mdl" })",
+  R"({ "path": ":progs/armor.mdl", "skin": 2 })",
+  R"({ "path": ":models/monsters/insane/tris.md2", "frame":209, "skin":1})",
+  R"({ "path": "models/player.mdl", "frame": sequence, "skin": skin })",
+  R"({{ spawnflags & 1 -> ":maps/b_batt1.bsp", ":maps/b_batt0.bsp" }})",
+  R"({{
+    spawnflags & 2 -> ":maps/b_bh100.bsp",
+    spawnflags & 1 -> ":maps/b_bh10.bsp",
+                      ":maps/b_bh25.bsp"
+  }})",
+  R"({{
+    spawnflags & 8 -> {"path": "progs/end4.mdl"},
+    spawnflags & 4 -> {"path": "progs/end3.mdl"},
+    spawnflags & 2 -> {"path": "progs/end2.mdl"},
+                      "progs/end1.mdl"
+  }})",
+  R"({{ model == "" -> ":progs/h_player.mdl", { "path": model, "skin": skin } }})",
+};
+
+std::vector<VariableTable> makeVariableStores()
+{
+  auto result = std::vector<VariableTable>{};
+  for (size_t i = 0; i < 16; ++i)
+  {
+    result.emplace_back(MapType{
+      {"spawnflags", Value{fmt::format("{}", i)}},
+      {"skin", Value{fmt::format("{}", i % 3)}},
+      {"sequence", Value{fmt::format("{}", i % 5)}},
+      {"model", Value{i % 2 == 0 ? "" : "progs/soldier.mdl"}},
+    });
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("ExpressionBenchmark.evaluateModelExpressions")
+{
+  const auto expressions = [] {
+    auto result = std::vector<ExpressionNode>{};
+    for (const auto& str : ModelExpressions)
+    {
+      result.push_back(
+        io::ELParser::parseStrict(str) | kdl::and_then(io::optimizeModelExpression)
+        | kdl::value());
+    }
+    return result;
+  }();
+
+  const auto compiledExpressions = [&] {
+    auto result = std::vector<CompiledExpression>{};
+    for (const auto& expression : expressions)
+    {
+      result.emplace_back(expression);
+    }
+    return result;
+  }();
+
+  const auto variableStores = makeVariableStores();
+
+  const auto evaluateAll = [&](const auto& expressionsToEvaluate) {
+    auto result = std::vector<Value>{};
+    result.reserve(NumEvaluations);
+
+    for (size_t i = 0; i < NumEvaluations; ++i)
+    {
+      const auto& expression = expressionsToEvaluate[i % expressionsToEvaluate.size()];
+      const auto& variableStore = variableStores[i % variableStores.size()];
+      result.push_back(
+        withEvaluationContext(
+          [&](auto& context) { return expression.evaluate(context); }, variableStore)
+        | kdl::value());
+    }
+
+    return result;
+  };
+
+  auto values = std::vector<Value>{};
+  timeLambda(
+    [&]() { values = evaluateAll(expressions); },
+    fmt::format("evaluate {} model expressions", NumEvaluations));
+
+  auto compiledValues = std::vector<Value>{};
+  timeLambda(
+    [&]() { compiledValues = evaluateAll(compiledExpressions); },
+    fmt::format("evaluate {} compiled model expressions", NumEvaluations));
+
+  CHECK(compiledValues == values);
+}
+
+} // namespace tb::el
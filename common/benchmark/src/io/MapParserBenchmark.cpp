@@ -0,0 +1,166 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "TestParserStatus.h"
+#include "io/StandardMapParser.h"
+#include "io/WorldReader.h"
+#include "mdl/EntityProperties.h"
+#include "mdl/MapFormat.h"
+#include "mdl/WorldNode.h"
+
+#include "kdl/task_manager.h"
+
+#include "vm/bbox.h"
+
+#include <fmt/format.h>
+
+#include <array>
+#include <chrono>
+#include <random>
+#include <string>
+
+namespace tb::io
+{
+namespace
+{
+
+constexpr size_t NumEntities = 1'000;
+constexpr size_t NumBrushes = 50'000;
+
+/**
+ * Creates a Valve 220 map with randomly placed cuboid brushes in the worldspawn entity
+ * and a number of point entities.
+ */
+std::string makeMap()
+{
+  auto rng = std::mt19937{12345};
+  auto position = std::uniform_int_distribution<int>{-4096, 4096};
+  auto size = std::uniform_int_distribution<int>{8, 256};
+  auto offset = std::uniform_real_distribution<double>{-64.0, 64.0};
+
+  auto result = std::string{};
+  result += "// Game: Quake\n// Format: Valve\n";
+  result += "{\n\"classname\" \"worldspawn\"\n\"wad\" \"/quake/gfx.wad\"\n";
+  for (size_t i = 0; i < NumBrushes; ++i)
+  {
+    const auto x1 = position(rng), y1 = position(rng), z1 = position(rng);
+    const auto x2 = x1 + size(rng), y2 = y1 + size(rng), z2 = z1 + size(rng);
+    const auto faces = std::array{
+      fmt::format("( {} 0 0 ) ( {} 1 0 ) ( {} 0 1 )", x1, x1, x1),
+      fmt::format("( {} 0 0 ) ( {} 0 1 ) ( {} 1 0 )", x2, x2, x2),
+      fmt::format("( 0 {} 0 ) ( 0 {} 1 ) ( 1 {} 0 )", y1, y1, y1),
+      fmt::format("( 0 {} 0 ) ( 1 {} 0 ) ( 0 {} 1 )", y2, y2, y2),
+      fmt::format("( 0 0 {} ) ( 1 0 {} ) ( 0 1 {} )", z1, z1, z1),
+      fmt::format("( 0 0 {} ) ( 0 1 {} ) ( 1 0 {} )", z2, z2, z2),
+    };
+
+    result += "// brush " + std::to_string(i) + "\n{\n";
+    for (const auto& face : faces)
+    {
+      result += fmt::format(
+        "{} material_{} [ 1 0 0 {:.6f} ] [ 0 -1 0 {:.6f} ] 0 1 1\n",
+        face,
+        i % 64,
+        offset(rng),
+        offset(rng));
+    }
+    result += "}\n";
+  }
+  result += "}\n";
+
+  for (size_t i = 0; i < NumEntities; ++i)
+  {
+    result += fmt::format(
+      "{{\n\"classname\" \"light\"\n\"origin\" \"{} {} {}\"\n\"light\" \"300\"\n}}\n",
+      position(rng),
+      position(rng),
+      position(rng));
+  }
+
+  return result;
+}
+
+template <typename L>
+void printThroughput(L&& lambda, const std::string& message, const size_t byteCount)
+{
+  const auto start = std::chrono::high_resolution_clock::now();
+  lambda();
+  const auto end = std::chrono::high_resolution_clock::now();
+
+  const auto seconds = std::chrono::duration<double>(end - start).count();
+  const auto megabytes = double(byteCount) / (1024.0 * 1024.0);
+  printf(
+    "Throughput for '%s': %.1f MB/s (%.1f MB in %fms)\n",
+    message.c_str(),
+    megabytes / seconds,
+    megabytes,
+    seconds * 1000.0);
+}
+
+} // namespace
+
+TEST_CASE("MapParserBenchmark.tokenize")
+{
+  const auto map = makeMap();
+
+  auto tokenCount = size_t(0);
+  auto numberSum = 0.0;
+  printThroughput(
+    [&]() {
+      auto tokenizer = QuakeMapTokenizer{map};
+      for (auto token = tokenizer.nextToken(); !token.hasType(QuakeMapToken::Eof);
+           token = tokenizer.nextToken())
+      {
+        if (token.hasType(QuakeMapToken::Number))
+        {
+          numberSum += token.toFloat<double>();
+        }
+        ++tokenCount;
+      }
+    },
+    "tokenize map",
+    map.size());
+
+  CHECK(tokenCount > NumBrushes * 6 * 20);
+  CHECK(numberSum != 0.0);
+}
+
+TEST_CASE("MapParserBenchmark.read")
+{
+  const auto map = makeMap();
+  const auto worldBounds = vm::bbox3d{8192.0};
+
+  auto taskManager = kdl::task_manager{};
+  auto status = TestParserStatus{};
+
+  auto world = std::unique_ptr<mdl::WorldNode>{};
+  printThroughput(
+    [&]() {
+      auto reader = WorldReader{map, mdl::MapFormat::Valve, {}};
+      world = reader.read(worldBounds, status, taskManager) | kdl::value();
+    },
+    "read map",
+    map.size());
+
+  CHECK(world != nullptr);
+}
+
+} // namespace tb::io
@@ -0,0 +1,94 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "mdl/Brush.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/MapFormat.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+#include "vm/mat.h"
+#include "vm/mat_ext.h"
+#include "vm/vec.h"
+
+#include <fmt/format.h>
+
+#include <vector>
+
+namespace tb::mdl
+{
+namespace
+{
+
+constexpr size_t NumBrushes = 100'000;
+
+} // namespace
+
+TEST_CASE("BrushBenchmark.createCopyTransform")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto brushes = std::vector<Brush>{};
+  brushes.reserve(NumBrushes);
+
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumBrushes; ++i)
+      {
+        brushes.push_back(builder.createCube(64.0, "material") | kdl::value());
+      }
+    },
+    fmt::format("create {} brushes", NumBrushes));
+
+  auto copies = std::vector<Brush>{};
+  copies.reserve(NumBrushes);
+
+  timeLambda(
+    [&]() {
+      for (const auto& brush : brushes)
+      {
+        copies.push_back(brush);
+      }
+    },
+    fmt::format("copy {} brushes", NumBrushes));
+
+  const auto transformation = vm::translation_matrix(vm::vec3d{16, 16, 16});
+  auto transformed = size_t(0);
+  timeLambda(
+    [&]() {
+      for (auto& brush : copies)
+      {
+        if (brush.transform(worldBounds, transformation, false) | kdl::is_success())
+        {
+          ++transformed;
+        }
+      }
+    },
+    fmt::format("transform {} brushes", NumBrushes));
+
+  timeLambda([&]() { copies.clear(); }, fmt::format("destroy {} brushes", NumBrushes));
+
+  CHECK(transformed == NumBrushes);
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,154 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushNode.h"
+#include "mdl/EmptyBrushEntityValidator.h"
+#include "mdl/EmptyGroupValidator.h"
+#include "mdl/Entity.h"
+#include "mdl/EntityNode.h"
+#include "mdl/Group.h"
+#include "mdl/GroupNode.h"
+#include "mdl/InvalidUVScaleValidator.h"
+#include "mdl/LayerNode.h"
+#include "mdl/MapFormat.h"
+#include "mdl/MissingClassnameValidator.h"
+#include "mdl/MixedBrushContentsValidator.h"
+#include "mdl/ModelUtils.h"
+#include "mdl/NonIntegerVerticesValidator.h"
+#include "mdl/PatchNode.h"
+#include "mdl/WorldBoundsValidator.h"
+#include "mdl/WorldNode.h"
+
+#include "kdl/overload.h"
+#include "kdl/result.h"
+#include "kdl/task_manager.h"
+
+#include "vm/bbox.h"
+#include "vm/vec.h"
+
+#include <fmt/format.h>
+
+#include <vector>
+
+namespace tb::mdl
+{
+namespace
+{
+
+constexpr size_t NumGroups = 1'000;
+constexpr size_t NumBrushesPerGroup = 100;
+
+void invalidateAllIssues(WorldNode& worldNode)
+{
+  worldNode.accept(kdl::overload(
+    [](auto&& thisLambda, WorldNode* world) {
+      world->invalidateIssues();
+      world->visitChildren(thisLambda);
+    },
+    [](auto&& thisLambda, LayerNode* layer) {
+      layer->invalidateIssues();
+      layer->visitChildren(thisLambda);
+    },
+    [](auto&& thisLambda, GroupNode* group) {
+      group->invalidateIssues();
+      group->visitChildren(thisLambda);
+    },
+    [](auto&& thisLambda, EntityNode* entity) {
+      entity->invalidateIssues();
+      entity->visitChildren(thisLambda);
+    },
+    [](BrushNode* brush) { brush->invalidateIssues(); },
+    [](PatchNode* patch) { patch->invalidateIssues(); }));
+}
+
+} // namespace
+
+TEST_CASE("IssueBenchmark.collectIssues")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
+  for (size_t i = 0; i < NumGroups; ++i)
+  {
+    auto* groupNode = new GroupNode{Group{fmt::format("group {}", i)}};
+    for (size_t j = 0; j < NumBrushesPerGroup; ++j)
+    {
+      // every tenth brush has non integer vertices
+      const auto offset = j % 10 == 0 ? 0.5 : 0.0;
+      const auto k = i * NumBrushesPerGroup + j;
+      const auto min = vm::vec3d{
+                         static_cast<double>(k % 50),
+                         static_cast<double>(k / 50 % 50),
+                         static_cast<double>(k / 2500)}
+                         * 64.0
+                       + vm::vec3d{offset, offset, offset};
+      const auto bounds = vm::bbox3d{min, min + vm::vec3d{32, 32, 32}};
+      auto brush = builder.createCuboid(bounds, "material") | kdl::value();
+      groupNode->addChild(new BrushNode{std::move(brush)});
+    }
+    worldNode.defaultLayer()->addChild(groupNode);
+  }
+
+  const auto emptyBrushEntityValidator = EmptyBrushEntityValidator{};
+  const auto emptyGroupValidator = EmptyGroupValidator{};
+  const auto invalidUVScaleValidator = InvalidUVScaleValidator{};
+  const auto missingClassnameValidator = MissingClassnameValidator{};
+  const auto mixedBrushContentsValidator = MixedBrushContentsValidator{};
+  const auto nonIntegerVerticesValidator = NonIntegerVerticesValidator{};
+  const auto worldBoundsValidator = WorldBoundsValidator{worldBounds};
+  const auto validators = std::vector<const Validator*>{
+    &emptyBrushEntityValidator,
+    &emptyGroupValidator,
+    &invalidUVScaleValidator,
+    &missingClassnameValidator,
+    &mixedBrushContentsValidator,
+    &nonIntegerVerticesValidator,
+    &worldBoundsValidator,
+  };
+
+  const auto numBrushes = NumGroups * NumBrushesPerGroup;
+  const auto nodes = std::vector<Node*>{&worldNode};
+
+  auto serialTaskManager = kdl::task_manager{0};
+  auto taskManager = kdl::task_manager{};
+
+  auto issueCount = size_t(0);
+  timeLambda(
+    [&]() { issueCount = collectIssues(nodes, validators, serialTaskManager).size(); },
+    fmt::format("validate {} brushes serially", numBrushes));
+  CHECK(issueCount == numBrushes / 10);
+
+  invalidateAllIssues(worldNode);
+  timeLambda(
+    [&]() { issueCount = collectIssues(nodes, validators, taskManager).size(); },
+    fmt::format(
+      "validate {} brushes on {} workers", numBrushes, taskManager.worker_count()));
+  CHECK(issueCount == numBrushes / 10);
+
+  timeLambda(
+    [&]() { issueCount = collectIssues(nodes, validators, taskManager).size(); },
+    fmt::format("collect issues of {} valid brushes", numBrushes));
+  CHECK(issueCount == numBrushes / 10);
+}
+
+} // namespace tb::mdl
@@ -29,6 +29,7 @@
 #include "render/BrushRenderer.h"
 
 #include "kdl/result.h"
+#include "kdl/task_manager.h"
 
 #include <fmt/format.h>
 
@@ -149,4 +150,47 @@ TEST_CASE("BrushRendererBenchmark.benchBrushRenderer")
     "validate remaining brushes");
 }
 
+TEST_CASE("BrushRendererBenchmark.benchValidateInvalidVertexCaches")
+{
+  auto [brushes, materials] = makeBrushes();
+
+  const auto invalidateVertexCaches = [&]() {
+    for (const auto& brush : brushes)
+    {
+      brush->invalidateVertexCache();
+    }
+  };
+
+  const auto benchValidate = [&](BrushRenderer& r, const std::string& message) {
+    invalidateVertexCaches();
+    for (const auto& brush : brushes)
+    {
+      r.addBrush(brush.get());
+    }
+
+    timeLambda(
+      [&]() {
+        if (!r.valid())
+        {
+          r.validate();
+        }
+      },
+      fmt::format(
+        "validate {} brushes with invalid vertex caches {}", brushes.size(), message));
+  };
+
+  SECTION("sequential")
+  {
+    auto r = BrushRenderer{};
+    benchValidate(r, "sequentially");
+  }
+
+  SECTION("parallel")
+  {
+    auto taskManager = kdl::task_manager{};
+    auto r = BrushRenderer{BrushRenderer::NoFilter{}, &taskManager};
+    benchValidate(r, fmt::format("on {} threads", taskManager.worker_count()));
+  }
+}
+
 } // namespace tb::render
@@ -189,6 +189,7 @@ Preference<bool> EnableMSAA("render/Enable multisampling", true);
 
 Preference<bool> AlignmentLock("Editor/Texture lock", true);
 Preference<bool> UVLock("Editor/UV lock", false);
+Preference<int> UndoMemoryBudget("Editor/Undo memory budget", 2048);
 
 Preference<std::filesystem::path>& RendererFontPath()
 {
@@ -383,6 +384,7 @@ const std::vector<PreferenceBase*>& staticPreferences()
     &TextureMagFilter,
     &AlignmentLock,
     &UVLock,
+    &UndoMemoryBudget,
     &RendererFontPath(),
     &RendererFontSize,
     &BrowserFontSize,
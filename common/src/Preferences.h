@@ -134,6 +134,11 @@ extern Preference<bool> EnableMSAA;
 extern Preference<bool> AlignmentLock;
 extern Preference<bool> UVLock;
 
+/**
+ * The amount of memory, in megabytes, that the undo history may use.
+ */
+extern Preference<int> UndoMemoryBudget;
+
 Preference<std::filesystem::path>& RendererFontPath();
 extern Preference<int> RendererFontSize;
 
@@ -505,6 +505,7 @@ bool TrenchBroomApp::initializeGameFactory()
   const auto gamePathConfig = mdl::GamePathConfig{
     io::SystemPaths::findResourceDirectories("games"),
     io::SystemPaths::userDataDirectory() / "games",
+    io::SystemPaths::cacheDirectory() / "ImageFileIndex",
   };
   auto& gameFactory = mdl::GameFactory::instance();
   return gameFactory.initialize(gamePathConfig) | kdl::transform([](auto errors) {
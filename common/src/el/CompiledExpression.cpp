@@ -0,0 +1,775 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CompiledExpression.h"
+
+#include "el/ELExceptions.h"
+#include "el/EvaluationContext.h"
+
+#include "kdl/overload.h"
+#include "kdl/string_format.h"
+#include "kdl/string_utils.h"
+#include "kdl/vector_utils.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <optional>
+#include <ostream>
+#include <variant>
+
+namespace tb::el
+{
+namespace
+{
+
+/**
+ * A slot of the evaluation stack. Booleans and numbers are stored inline.
+ */
+using Slot = std::variant<NumberType, BooleanType, Value>;
+
+// deep enough for the expressions found in game and entity definition files
+constexpr size_t InlineStackSize = 16;
+
+void collectVariableNames(
+  const ExpressionNode& expression, std::vector<std::string>& variableNames)
+{
+  expression.accept(kdl::overload(
+    [](const LiteralExpression&) {},
+    [&](const VariableExpression& variableExpression) {
+      variableNames.push_back(variableExpression.variableName);
+    },
+    [&](const ArrayExpression& arrayExpression) {
+      for (const auto& element : arrayExpression.elements)
+      {
+        collectVariableNames(element, variableNames);
+      }
+    },
+    [&](const MapExpression& mapExpression) {
+      for (const auto& [key, element] : mapExpression.elements)
+      {
+        collectVariableNames(element, variableNames);
+      }
+    },
+    [&](const UnaryExpression& unaryExpression) {
+      collectVariableNames(unaryExpression.operand, variableNames);
+    },
+    [&](const BinaryExpression& binaryExpression) {
+      collectVariableNames(binaryExpression.leftOperand, variableNames);
+      collectVariableNames(binaryExpression.rightOperand, variableNames);
+    },
+    [&](const SubscriptExpression& subscriptExpression) {
+      collectVariableNames(subscriptExpression.leftOperand, variableNames);
+      collectVariableNames(subscriptExpression.rightOperand, variableNames);
+    },
+    [&](const SwitchExpression& switchExpression) {
+      for (const auto& case_ : switchExpression.cases)
+      {
+        collectVariableNames(case_, variableNames);
+      }
+    }));
+}
+
+Value toValue(Slot slot)
+{
+  return std::visit(
+    kdl::overload(
+      [](const NumberType number) { return Value{number}; },
+      [](const BooleanType boolean) { return Value{boolean}; },
+      [](Value value) { return value; }),
+    std::move(slot));
+}
+
+bool isUndefined(const Slot& slot)
+{
+  const auto* value = std::get_if<Value>(&slot);
+  return value && value->type() == ValueType::Undefined;
+}
+
+/**
+ * The type of a slot along with its value if it is a boolean, a number or a string.
+ */
+struct Scalar
+{
+  ValueType type;
+  NumberType number = 0.0;
+  const StringType* string = nullptr;
+};
+
+Scalar scalar(const EvaluationContext& context, const Slot& slot)
+{
+  return std::visit(
+    kdl::overload(
+      [](const NumberType number) { return Scalar{ValueType::Number, number}; },
+      [](const BooleanType boolean) {
+        return Scalar{ValueType::Boolean, boolean ? 1.0 : 0.0};
+      },
+      [&](const Value& value) {
+        switch (value.type())
+        {
+        case ValueType::Boolean:
+          return Scalar{ValueType::Boolean, value.booleanValue(context) ? 1.0 : 0.0};
+        case ValueType::Number:
+          return Scalar{ValueType::Number, value.numberValue(context)};
+        case ValueType::String:
+          return Scalar{ValueType::String, 0.0, &value.stringValue(context)};
+        case ValueType::Array:
+        case ValueType::Map:
+        case ValueType::Range:
+        case ValueType::Null:
+        case ValueType::Undefined:
+          break;
+        }
+        return Scalar{value.type()};
+      }),
+    slot);
+}
+
+bool isBooleanOrNumber(const Scalar& scalar)
+{
+  return scalar.type == ValueType::Boolean || scalar.type == ValueType::Number;
+}
+
+// Converts the given scalar to a number in the same way as Value::convertTo.
+std::optional<NumberType> toNumber(const Scalar& scalar)
+{
+  switch (scalar.type)
+  {
+  case ValueType::Boolean:
+  case ValueType::Number:
+    return scalar.number;
+  case ValueType::String:
+    return kdl::str_is_blank(*scalar.string) ? std::optional{0.0}
+                                             : kdl::str_to_double(*scalar.string);
+  case ValueType::Array:
+  case ValueType::Map:
+  case ValueType::Range:
+  case ValueType::Null:
+  case ValueType::Undefined:
+    break;
+  }
+  return std::nullopt;
+}
+
+/*
+ * The following functions evaluate operations on booleans, numbers and strings without
+ * creating values. They return nothing if the operands require the generic evaluation in
+ * Expression.cpp, whose semantics they must match.
+ */
+
+template <typename Eval>
+std::optional<Slot> tryEvaluateAlgebraicOperation(
+  const Scalar& lhs, const Scalar& rhs, const Eval& eval)
+{
+  if (
+    (isBooleanOrNumber(lhs) || isBooleanOrNumber(rhs))
+    && (isBooleanOrNumber(lhs) || lhs.type == ValueType::String)
+    && (isBooleanOrNumber(rhs) || rhs.type == ValueType::String))
+  {
+    const auto lhsNumber = toNumber(lhs);
+    const auto rhsNumber = toNumber(rhs);
+    if (lhsNumber && rhsNumber)
+    {
+      return Slot{eval(*lhsNumber, *rhsNumber)};
+    }
+  }
+  return std::nullopt;
+}
+
+template <typename Eval>
+std::optional<Slot> tryEvaluateBitwiseOperation(
+  const Scalar& lhs, const Scalar& rhs, const Eval& eval)
+{
+  const auto lhsNumber = toNumber(lhs);
+  const auto rhsNumber = toNumber(rhs);
+  if (lhsNumber && rhsNumber)
+  {
+    return Slot{static_cast<NumberType>(eval(
+      static_cast<IntegerType>(*lhsNumber), static_cast<IntegerType>(*rhsNumber)))};
+  }
+  return std::nullopt;
+}
+
+std::optional<int> tryCompare(const Scalar& lhs, const Scalar& rhs)
+{
+  if (
+    (lhs.type == ValueType::Boolean && isBooleanOrNumber(rhs))
+    || (lhs.type == ValueType::Number && rhs.type == ValueType::Boolean))
+  {
+    const auto lhsValue = lhs.number != 0.0;
+    const auto rhsValue = rhs.number != 0.0;
+    return lhsValue == rhsValue ? 0 : lhsValue ? 1 : -1;
+  }
+
+  if (lhs.type == ValueType::String && rhs.type == ValueType::String)
+  {
+    return lhs.string->compare(*rhs.string);
+  }
+
+  if (
+    (lhs.type == ValueType::Number || lhs.type == ValueType::String)
+    && (rhs.type == ValueType::Number || rhs.type == ValueType::String))
+  {
+    const auto lhsNumber = toNumber(lhs);
+    const auto rhsNumber = toNumber(rhs);
+    if (lhsNumber && rhsNumber)
+    {
+      const auto diff = *lhsNumber - *rhsNumber;
+      return diff < 0.0 ? -1 : diff > 0.0 ? 1 : 0;
+    }
+  }
+
+  return std::nullopt;
+}
+
+template <typename Eval>
+std::optional<Slot> tryEvaluateComparison(
+  const Scalar& lhs, const Scalar& rhs, const Eval& eval)
+{
+  if (const auto result = tryCompare(lhs, rhs))
+  {
+    return Slot{eval(*result)};
+  }
+  return std::nullopt;
+}
+
+std::optional<Slot> tryEvaluateBinaryOperation(
+  const BinaryOperation operation, const Scalar& lhs, const Scalar& rhs)
+{
+  switch (operation)
+  {
+  case BinaryOperation::Addition:
+    return tryEvaluateAlgebraicOperation(
+      lhs, rhs, [](const auto l, const auto r) { return l + r; });
+  case BinaryOperation::Subtraction:
+    return tryEvaluateAlgebraicOperation(
+      lhs, rhs, [](const auto l, const auto r) { return l - r; });
+  case BinaryOperation::Multiplication:
+    return tryEvaluateAlgebraicOperation(
+      lhs, rhs, [](const auto l, const auto r) { return l * r; });
+  case BinaryOperation::Division:
+    return tryEvaluateAlgebraicOperation(
+      lhs, rhs, [](const auto l, const auto r) { return l / r; });
+  case BinaryOperation::Modulus:
+    return tryEvaluateAlgebraicOperation(
+      lhs, rhs, [](const auto l, const auto r) { return std::fmod(l, r); });
+  case BinaryOperation::LogicalAnd:
+  case BinaryOperation::LogicalOr:
+    // the left operand did not short circuit, so the right operand is the result
+    if (lhs.type == ValueType::Boolean && rhs.type == ValueType::Boolean)
+    {
+      return Slot{rhs.number != 0.0};
+    }
+    return std::nullopt;
+  case BinaryOperation::BitwiseAnd:
+    return tryEvaluateBitwiseOperation(
+      lhs, rhs, [](const auto l, const auto r) { return l & r; });
+  case BinaryOperation::BitwiseXOr:
+    return tryEvaluateBitwiseOperation(
+      lhs, rhs, [](const auto l, const auto r) { return l ^ r; });
+  case BinaryOperation::BitwiseOr:
+    return tryEvaluateBitwiseOperation(
+      lhs, rhs, [](const auto l, const auto r) { return l | r; });
+  case BinaryOperation::BitwiseShiftLeft:
+    return tryEvaluateBitwiseOperation(
+      lhs, rhs, [](const auto l, const auto r) { return l << r; });
+  case BinaryOperation::BitwiseShiftRight:
+    return tryEvaluateBitwiseOperation(
+      lhs, rhs, [](const auto l, const auto r) { return l >> r; });
+  case BinaryOperation::Less:
+    return tryEvaluateComparison(lhs, rhs, [](const auto c) { return c < 0; });
+  case BinaryOperation::LessOrEqual:
+    return tryEvaluateComparison(lhs, rhs, [](const auto c) { return c <= 0; });
+  case BinaryOperation::Greater:
+    return tryEvaluateComparison(lhs, rhs, [](const auto c) { return c > 0; });
+  case BinaryOperation::GreaterOrEqual:
+    return tryEvaluateComparison(lhs, rhs, [](const auto c) { return c >= 0; });
+  case BinaryOperation::Equal:
+    return tryEvaluateComparison(lhs, rhs, [](const auto c) { return c == 0; });
+  case BinaryOperation::NotEqual:
+    return tryEvaluateComparison(lhs, rhs, [](const auto c) { return c != 0; });
+  case BinaryOperation::BoundedRange:
+  case BinaryOperation::Case:
+    break;
+  }
+  return std::nullopt;
+}
+
+std::optional<Slot> tryEvaluateUnaryOperation(
+  const UnaryOperation operation, const Scalar& operand)
+{
+  switch (operation)
+  {
+  case UnaryOperation::Plus:
+    if (const auto number = toNumber(operand))
+    {
+      return Slot{*number};
+    }
+    break;
+  case UnaryOperation::Minus:
+    if (const auto number = toNumber(operand))
+    {
+      return Slot{-*number};
+    }
+    break;
+  case UnaryOperation::LogicalNegation:
+    if (operand.type == ValueType::Boolean)
+    {
+      return Slot{operand.number == 0.0};
+    }
+    break;
+  case UnaryOperation::BitwiseNegation:
+    if (operand.type != ValueType::Boolean)
+    {
+      if (const auto number = toNumber(operand))
+      {
+        return Slot{static_cast<NumberType>(~static_cast<IntegerType>(*number))};
+      }
+    }
+    break;
+  case UnaryOperation::Group:
+  case UnaryOperation::LeftBoundedRange:
+  case UnaryOperation::RightBoundedRange:
+    break;
+  }
+  return std::nullopt;
+}
+
+bool isCaseConditionMet(EvaluationContext& context, const Slot& condition)
+{
+  if (const auto conditionScalar = scalar(context, condition);
+      isBooleanOrNumber(conditionScalar))
+  {
+    return conditionScalar.number != 0.0;
+  }
+
+  const auto& value = std::get<Value>(condition);
+  return value.type() != ValueType::Undefined
+         && value.convertTo(context, ValueType::Boolean).booleanValue(context);
+}
+
+ExpressionNode tryOptimize(EvaluationContext& context, const ExpressionNode& expression)
+{
+  try
+  {
+    return expression.optimize(context);
+  }
+  catch (const Exception&)
+  {
+    // the error is reported when the expression is evaluated
+    return expression;
+  }
+}
+
+} // namespace
+
+CompiledExpression::CompiledExpression(ExpressionNode expression)
+  : m_expression{std::move(expression)}
+{
+  withEvaluationContext([&](auto& context) {
+    auto stackSize = size_t(0);
+    compile(context, tryOptimize(context, m_expression), stackSize);
+    assert(stackSize == 1);
+  }).ignore();
+
+  // collected from the source expression because it is evaluated if the instructions fail
+  collectVariableNames(m_expression, m_referencedVariableNames);
+  m_referencedVariableNames = kdl::vec_sort_and_remove_duplicates(
+    std::move(m_referencedVariableNames));
+}
+
+const ExpressionNode& CompiledExpression::expression() const
+{
+  return m_expression;
+}
+
+const std::vector<std::string>& CompiledExpression::referencedVariableNames() const
+{
+  return m_referencedVariableNames;
+}
+
+Value CompiledExpression::evaluate(EvaluationContext& context) const
+{
+  try
+  {
+    return evaluateInstructions(context);
+  }
+  catch (const Exception&)
+  {
+    return m_expression.evaluate(context);
+  }
+}
+
+Value CompiledExpression::tryEvaluate(EvaluationContext& context) const
+{
+  try
+  {
+    return evaluateInstructions(context);
+  }
+  catch (const Exception&)
+  {
+    return m_expression.tryEvaluate(context);
+  }
+}
+
+bool operator==(const CompiledExpression& lhs, const CompiledExpression& rhs)
+{
+  return lhs.m_expression == rhs.m_expression;
+}
+
+bool operator!=(const CompiledExpression& lhs, const CompiledExpression& rhs)
+{
+  return !(lhs == rhs);
+}
+
+std::ostream& operator<<(std::ostream& lhs, const CompiledExpression& rhs)
+{
+  lhs << rhs.m_expression;
+  return lhs;
+}
+
+void CompiledExpression::compile(
+  EvaluationContext& context, const ExpressionNode& expression, size_t& stackSize)
+{
+  expression.accept(kdl::overload(
+    [&](const LiteralExpression& literalExpression) {
+      const auto& value = literalExpression.value;
+      switch (value.type())
+      {
+      case ValueType::Boolean:
+        emit(Opcode::PushBoolean, value.booleanValue(context) ? 1 : 0, 0, 1, stackSize);
+        break;
+      case ValueType::Number:
+        m_numbers.push_back(value.numberValue(context));
+        emit(Opcode::PushNumber, m_numbers.size() - 1, 0, 1, stackSize);
+        break;
+      case ValueType::String:
+      case ValueType::Array:
+      case ValueType::Map:
+      case ValueType::Range:
+      case ValueType::Null:
+      case ValueType::Undefined:
+        m_constants.push_back(value);
+        emit(Opcode::PushConstant, m_constants.size() - 1, 0, 1, stackSize);
+        break;
+      }
+    },
+    [&](const VariableExpression& variableExpression) {
+      m_variableNames.push_back(variableExpression.variableName);
+      emit(Opcode::PushVariable, m_variableNames.size() - 1, 0, 1, stackSize);
+    },
+    [&](const ArrayExpression& arrayExpression) {
+      for (const auto& element : arrayExpression.elements)
+      {
+        compile(context, element, stackSize);
+      }
+      const auto count = arrayExpression.elements.size();
+      emit(Opcode::MakeArray, count, count, 1, stackSize);
+    },
+    [&](const MapExpression& mapExpression) {
+      auto keys = std::vector<std::string>{};
+      for (const auto& [key, element] : mapExpression.elements)
+      {
+        compile(context, element, stackSize);
+        keys.push_back(key);
+      }
+      const auto count = keys.size();
+      m_mapKeys.push_back(std::move(keys));
+      emit(Opcode::MakeMap, m_mapKeys.size() - 1, count, 1, stackSize);
+    },
+    [&](const UnaryExpression& unaryExpression) {
+      compile(context, unaryExpression.operand, stackSize);
+      if (unaryExpression.operation != UnaryOperation::Group)
+      {
+        emit(
+          Opcode::UnaryOperation,
+          static_cast<size_t>(unaryExpression.operation),
+          1,
+          1,
+          stackSize);
+      }
+    },
+    [&](const BinaryExpression& binaryExpression) {
+      compile(context, binaryExpression.leftOperand, stackSize);
+      switch (binaryExpression.operation)
+      {
+      case BinaryOperation::LogicalAnd:
+      case BinaryOperation::LogicalOr: {
+        const auto shortCircuit = emit(
+          binaryExpression.operation == BinaryOperation::LogicalAnd
+            ? Opcode::LogicalAndShortCircuit
+            : Opcode::LogicalOrShortCircuit,
+          0,
+          0,
+          0,
+          stackSize);
+        compile(context, binaryExpression.rightOperand, stackSize);
+        emit(
+          Opcode::BinaryOperation,
+          static_cast<size_t>(binaryExpression.operation),
+          2,
+          1,
+          stackSize);
+        patchJump(shortCircuit);
+        break;
+      }
+      case BinaryOperation::Case: {
+        const auto caseCondition = emit(Opcode::CaseCondition, 0, 1, 0, stackSize);
+        compile(context, binaryExpression.rightOperand, stackSize);
+        patchJump(caseCondition);
+        break;
+      }
+      case BinaryOperation::Addition:
+      case BinaryOperation::Subtraction:
+      case BinaryOperation::Multiplication:
+      case BinaryOperation::Division:
+      case BinaryOperation::Modulus:
+      case BinaryOperation::BitwiseAnd:
+      case BinaryOperation::BitwiseXOr:
+      case BinaryOperation::BitwiseOr:
+      case BinaryOperation::BitwiseShiftLeft:
+      case BinaryOperation::BitwiseShiftRight:
+      case BinaryOperation::Less:
+      case BinaryOperation::LessOrEqual:
+      case BinaryOperation::Greater:
+      case BinaryOperation::GreaterOrEqual:
+      case BinaryOperation::Equal:
+      case BinaryOperation::NotEqual:
+      case BinaryOperation::BoundedRange:
+        compile(context, binaryExpression.rightOperand, stackSize);
+        emit(
+          Opcode::BinaryOperation,
+          static_cast<size_t>(binaryExpression.operation),
+          2,
+          1,
+          stackSize);
+        break;
+      }
+    },
+    [&](const SubscriptExpression& subscriptExpression) {
+      compile(context, subscriptExpression.leftOperand, stackSize);
+      compile(context, subscriptExpression.rightOperand, stackSize);
+      emit(Opcode::Subscript, 0, 2, 1, stackSize);
+    },
+    [&](const SwitchExpression& switchExpression) {
+      if (switchExpression.cases.empty())
+      {
+        m_constants.push_back(Value::Undefined);
+        emit(Opcode::PushConstant, m_constants.size() - 1, 0, 1, stackSize);
+        return;
+      }
+
+      auto switchCases = std::vector<size_t>{};
+      for (size_t i = 0; i < switchExpression.cases.size(); ++i)
+      {
+        compile(context, switchExpression.cases[i], stackSize);
+        if (i + 1 < switchExpression.cases.size())
+        {
+          switchCases.push_back(emit(Opcode::SwitchCase, 0, 1, 0, stackSize));
+        }
+      }
+
+      for (const auto switchCase : switchCases)
+      {
+        patchJump(switchCase);
+      }
+    }));
+}
+
+size_t CompiledExpression::emit(
+  const Opcode opcode,
+  const size_t operand,
+  const size_t popCount,
+  const size_t pushCount,
+  size_t& stackSize)
+{
+  assert(stackSize >= popCount);
+
+  m_instructions.push_back(Instruction{opcode, static_cast<uint32_t>(operand)});
+  stackSize = stackSize - popCount + pushCount;
+  m_stackSize = std::max(m_stackSize, stackSize);
+
+  return m_instructions.size() - 1;
+}
+
+void CompiledExpression::patchJump(const size_t instructionIndex)
+{
+  m_instructions[instructionIndex].operand = static_cast<uint32_t>(m_instructions.size());
+}
+
+Value CompiledExpression::evaluateInstructions(EvaluationContext& context) const
+{
+  auto inlineStack = std::array<Slot, InlineStackSize>{};
+  auto dynamicStack = std::vector<Slot>{};
+
+  auto* stack = inlineStack.data();
+  if (m_stackSize > InlineStackSize)
+  {
+    dynamicStack.resize(m_stackSize);
+    stack = dynamicStack.data();
+  }
+
+  auto size = size_t(0);
+  auto next = size_t(0);
+  while (next < m_instructions.size())
+  {
+    const auto& instruction = m_instructions[next++];
+    switch (instruction.opcode)
+    {
+    case Opcode::PushConstant:
+      stack[size++] = m_constants[instruction.operand];
+      break;
+    case Opcode::PushNumber:
+      stack[size++] = m_numbers[instruction.operand];
+      break;
+    case Opcode::PushBoolean:
+      stack[size++] = instruction.operand != 0;
+      break;
+    case Opcode::PushVariable:
+      stack[size++] = context.variableValue(m_variableNames[instruction.operand]);
+      break;
+    case Opcode::MakeArray: {
+      auto array = ArrayType{};
+      array.reserve(instruction.operand);
+
+      for (size_t i = size - instruction.operand; i < size; ++i)
+      {
+        auto value = toValue(std::move(stack[i]));
+        if (value.hasType(ValueType::Range))
+        {
+          const auto& range = std::get<BoundedRange>(value.rangeValue(context));
+          array.reserve(array.size() + range.length());
+          range.forEach([&](const auto j) { array.emplace_back(j); });
+        }
+        else
+        {
+          array.push_back(std::move(value));
+        }
+      }
+
+      size -= instruction.operand;
+      stack[size++] = Value{std::move(array)};
+      break;
+    }
+    case Opcode::MakeMap: {
+      const auto& keys = m_mapKeys[instruction.operand];
+      auto map = MapType{};
+
+      const auto first = size - keys.size();
+      for (size_t i = 0; i < keys.size(); ++i)
+      {
+        map.emplace(keys[i], toValue(std::move(stack[first + i])));
+      }
+
+      size = first;
+      stack[size++] = Value{std::move(map)};
+      break;
+    }
+    case Opcode::UnaryOperation: {
+      const auto operation = static_cast<UnaryOperation>(instruction.operand);
+      auto& operand = stack[size - 1];
+      if (auto result = tryEvaluateUnaryOperation(operation, scalar(context, operand)))
+      {
+        operand = std::move(*result);
+      }
+      else
+      {
+        operand = evaluateUnaryOperation(
+          context, operation, toValue(std::move(operand)), m_expression);
+      }
+      break;
+    }
+    case Opcode::BinaryOperation: {
+      const auto operation = static_cast<BinaryOperation>(instruction.operand);
+      const auto rhs = std::move(stack[--size]);
+      auto& lhs = stack[size - 1];
+      if (
+        auto result = tryEvaluateBinaryOperation(
+          operation, scalar(context, lhs), scalar(context, rhs)))
+      {
+        lhs = std::move(*result);
+      }
+      else
+      {
+        lhs = evaluateBinaryOperation(
+          context, operation, toValue(std::move(lhs)), toValue(rhs), m_expression);
+      }
+      break;
+    }
+    case Opcode::Subscript: {
+      const auto rhs = toValue(std::move(stack[--size]));
+      auto& lhs = stack[size - 1];
+      lhs = evaluateSubscriptOperation(
+        context, toValue(std::move(lhs)), rhs, m_expression);
+      break;
+    }
+    case Opcode::LogicalAndShortCircuit: {
+      const auto lhs = scalar(context, stack[size - 1]);
+      if (lhs.type == ValueType::Undefined)
+      {
+        next = instruction.operand;
+      }
+      else if (
+        (lhs.type == ValueType::Boolean || lhs.type == ValueType::Null)
+        && lhs.number == 0.0)
+      {
+        stack[size - 1] = false;
+        next = instruction.operand;
+      }
+      break;
+    }
+    case Opcode::LogicalOrShortCircuit: {
+      const auto lhs = scalar(context, stack[size - 1]);
+      if (lhs.type == ValueType::Undefined)
+      {
+        next = instruction.operand;
+      }
+      else if (lhs.type == ValueType::Boolean && lhs.number != 0.0)
+      {
+        stack[size - 1] = true;
+        next = instruction.operand;
+      }
+      break;
+    }
+    case Opcode::CaseCondition:
+      if (!isCaseConditionMet(context, stack[--size]))
+      {
+        stack[size++] = Value::Undefined;
+        next = instruction.operand;
+      }
+      break;
+    case Opcode::SwitchCase:
+      if (isUndefined(stack[size - 1]))
+      {
+        --size;
+      }
+      else
+      {
+        next = instruction.operand;
+      }
+      break;
+    }
+  }
+
+  assert(size == 1);
+  return toValue(std::move(stack[0]));
+}
+
+} // namespace tb::el
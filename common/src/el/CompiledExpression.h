@@ -0,0 +1,123 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "el/EL_Forward.h"
+#include "el/Expression.h"
+#include "el/Types.h"
+#include "el/Value.h"
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace tb::el
+{
+
+/**
+ * An expression compiled into a flat sequence of instructions for a stack machine.
+ *
+ * Compiling folds constant subexpressions. Evaluating the instructions avoids walking
+ * the expression tree and tracing every intermediate value, and booleans and numbers are
+ * kept on the stack directly instead of being wrapped in values. Evaluating common
+ * expressions such as those found in model definitions therefore allocates only when
+ * looking up variables or building arrays and maps.
+ *
+ * Intermediate values are not traced, so if evaluating the instructions fails, the source
+ * expression is evaluated instead to report the error with the same information as
+ * ExpressionNode::evaluate.
+ */
+class CompiledExpression
+{
+private:
+  enum class Opcode : uint8_t
+  {
+    PushConstant,
+    PushNumber,
+    PushBoolean,
+    PushVariable,
+    MakeArray,
+    MakeMap,
+    UnaryOperation,
+    BinaryOperation,
+    Subscript,
+    // skips the right operand if the left operand determines the result
+    LogicalAndShortCircuit,
+    LogicalOrShortCircuit,
+    // skips the consequent if the condition isn't met, leaving undefined on the stack
+    CaseCondition,
+    // skips the remaining cases if the current case is defined
+    SwitchCase,
+  };
+
+  struct Instruction
+  {
+    Opcode opcode;
+    // an index into one of the tables below, an element count, an operation or a jump
+    // target, depending on the opcode
+    uint32_t operand;
+  };
+
+  ExpressionNode m_expression;
+
+  std::vector<Instruction> m_instructions;
+  std::vector<Value> m_constants;
+  std::vector<NumberType> m_numbers;
+  std::vector<std::string> m_variableNames;
+  std::vector<std::vector<std::string>> m_mapKeys;
+  size_t m_stackSize = 0;
+
+  std::vector<std::string> m_referencedVariableNames;
+
+public:
+  explicit CompiledExpression(ExpressionNode expression);
+
+  const ExpressionNode& expression() const;
+
+  /**
+   * Returns the sorted names of all variables that evaluating this expression can read.
+   * The result of evaluating this expression only depends on the values of these
+   * variables.
+   */
+  const std::vector<std::string>& referencedVariableNames() const;
+
+  Value evaluate(EvaluationContext& context) const;
+  Value tryEvaluate(EvaluationContext& context) const;
+
+  friend bool operator==(const CompiledExpression& lhs, const CompiledExpression& rhs);
+  friend bool operator!=(const CompiledExpression& lhs, const CompiledExpression& rhs);
+  friend std::ostream& operator<<(std::ostream& lhs, const CompiledExpression& rhs);
+
+private:
+  void compile(
+    EvaluationContext& context, const ExpressionNode& expression, size_t& stackSize);
+  size_t emit(
+    Opcode opcode,
+    size_t operand,
+    size_t popCount,
+    size_t pushCount,
+    size_t& stackSize);
+  void patchJump(size_t instructionIndex);
+
+  Value evaluateInstructions(EvaluationContext& context) const;
+};
+
+} // namespace tb::el
@@ -24,6 +24,7 @@ namespace tb::el
 class Value;
 enum class ValueType;
 
+class CompiledExpression;
 class ExpressionNode;
 
 class EvaluationContext;
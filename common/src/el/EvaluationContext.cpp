@@ -27,13 +27,24 @@
 namespace tb::el
 {
 
+namespace
+{
+
+const VariableStore& emptyVariableStore()
+{
+  static const auto variables = VariableTable{};
+  return variables;
+}
+
+} // namespace
+
 EvaluationContext::EvaluationContext()
-  : m_variables{std::make_unique<VariableTable>()}
+  : m_variables{emptyVariableStore()}
 {
 }
 
 EvaluationContext::EvaluationContext(const VariableStore& store)
-  : m_variables{store.clone()}
+  : m_variables{store}
 {
 }
 
@@ -41,7 +52,7 @@ EvaluationContext::~EvaluationContext() = default;
 
 Value EvaluationContext::variableValue(const std::string& name) const
 {
-  return m_variables->value(name);
+  return m_variables.value(name);
 }
 
 std::optional<ExpressionNode> EvaluationContext::expression(const Value& value) const
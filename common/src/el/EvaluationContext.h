@@ -26,7 +26,6 @@
 #include "el/Expression.h"
 #include "el/Value.h"
 
-#include <memory>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -37,7 +36,9 @@ namespace tb::el
 class EvaluationContext
 {
 private:
-  std::unique_ptr<VariableStore> m_variables;
+  // the context only lives during a call to withEvaluationContext, so it can refer to the
+  // variable store passed to that function instead of copying it
+  const VariableStore& m_variables;
   std::unordered_map<Value, ExpressionNode> m_trace;
 
   EvaluationContext();
@@ -1266,22 +1266,34 @@ Expression optimize(
 Expression optimize(
   EvaluationContext& context, const SwitchExpression& expression, const ExpressionNode&)
 {
-  if (expression.cases.empty())
+  auto optimizedExpressions = std::vector<ExpressionNode>{};
+  for (const auto& case_ : expression.cases)
   {
-    return LiteralExpression{Value::Undefined};
-  }
+    auto optimizedExpression = case_.optimize(context);
+    if (optimizedExpression.isLiteral())
+    {
+      // a literal case either never matches or always matches
+      auto value = optimizedExpression.evaluate(context);
+      if (value == Value::Undefined)
+      {
+        continue;
+      }
 
-  auto firstOptimizedExpression = expression.cases.front().optimize(context);
-  if (firstOptimizedExpression.isLiteral())
-  {
-    return LiteralExpression{firstOptimizedExpression.evaluate(context)};
+      if (optimizedExpressions.empty())
+      {
+        return LiteralExpression{std::move(value)};
+      }
+
+      optimizedExpressions.push_back(std::move(optimizedExpression));
+      break;
+    }
+
+    optimizedExpressions.push_back(std::move(optimizedExpression));
   }
 
-  auto optimizedExpressions =
-    std::vector<ExpressionNode>{std::move(firstOptimizedExpression)};
-  for (size_t i = 1u; i < expression.cases.size(); ++i)
+  if (optimizedExpressions.empty())
   {
-    optimizedExpressions.push_back(expression.cases[i].optimize(context));
+    return LiteralExpression{Value::Undefined};
   }
 
   return SwitchExpression{std::move(optimizedExpressions)};
@@ -1350,6 +1362,39 @@ size_t precedence(const Expression& expression)
 
 } // namespace
 
+Value evaluateUnaryOperation(
+  EvaluationContext& context,
+  const UnaryOperation operation,
+  const Value& operand,
+  const ExpressionNode& expressionNode)
+{
+  return evaluateUnaryExpression(context, operation, operand, expressionNode);
+}
+
+Value evaluateBinaryOperation(
+  EvaluationContext& context,
+  const BinaryOperation operation,
+  const Value& leftOperand,
+  const Value& rightOperand,
+  const ExpressionNode& expressionNode)
+{
+  return evaluateBinaryExpression(
+    context,
+    operation,
+    [&] { return leftOperand; },
+    [&] { return rightOperand; },
+    expressionNode);
+}
+
+Value evaluateSubscriptOperation(
+  EvaluationContext& context,
+  const Value& leftOperand,
+  const Value& rightOperand,
+  const ExpressionNode& expressionNode)
+{
+  return evaluateSubscript(context, leftOperand, rightOperand, expressionNode);
+}
+
 std::ostream& operator<<(std::ostream& lhs, const Expression& rhs)
 {
   std::visit([&](const auto& x) { lhs << x; }, rhs);
@@ -260,6 +260,39 @@ bool operator!=(const SwitchExpression& lhs, const SwitchExpression& rhs);
 
 std::ostream& operator<<(std::ostream& lhs, const SwitchExpression& rhs);
 
+/**
+ * Applies the given unary operation to an evaluated operand. The given expression node
+ * is only used to report errors.
+ */
+Value evaluateUnaryOperation(
+  EvaluationContext& context,
+  UnaryOperation operation,
+  const Value& operand,
+  const ExpressionNode& expressionNode);
+
+/**
+ * Applies the given binary operation to evaluated operands. The caller is responsible for
+ * short circuiting logical and case operations, i.e. for not evaluating the right operand
+ * if the left operand already determines the result. The given expression node is only
+ * used to report errors.
+ */
+Value evaluateBinaryOperation(
+  EvaluationContext& context,
+  BinaryOperation operation,
+  const Value& leftOperand,
+  const Value& rightOperand,
+  const ExpressionNode& expressionNode);
+
+/**
+ * Applies the subscript operator to evaluated operands. The given expression node is only
+ * used to report errors.
+ */
+Value evaluateSubscriptOperation(
+  EvaluationContext& context,
+  const Value& leftOperand,
+  const Value& rightOperand,
+  const ExpressionNode& expressionNode);
+
 template <typename Visitor>
 VisitorResultType_t<Visitor> ExpressionNode::accept(const Visitor& visitor) const
 {
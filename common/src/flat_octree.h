@@ -0,0 +1,737 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Exceptions.h"
+#include "octree.h"
+
+#include "vm/bbox.h"
+#include "vm/intersection.h"
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <unordered_map>
+#include <vector>
+
+namespace tb
+{
+
+/**
+ * An octree with the same interface as tb::octree, but which stores its nodes in
+ * contiguous arrays instead of allocating every node separately.
+ *
+ * Nodes refer to their children and parents by index. The node bounds are stored in
+ * separate arrays per component so that a traversal only touches the memory it needs to
+ * decide whether to descend into a node. The children of a node are ordered by quadrant,
+ * which is the Morton order of the child cells, and compact() lays out the nodes in
+ * depth first Morton order.
+ *
+ * Like tb::octree, the tree is path compressed: a node is only created for the cell that
+ * contains a data item or for the smallest cell that contains two diverging subtrees.
+ *
+ * @tparam T the floating point type
+ * @tparam U the node data to store in the nodes
+ */
+template <typename T, typename U>
+class flat_octree
+{
+private:
+  using index_type = std::uint32_t;
+  static constexpr auto invalid_index = std::numeric_limits<index_type>::max();
+
+  // the initial capacity of the traversal stack, enough for trees of moderate depth
+  static constexpr std::size_t initial_stack_capacity = 64;
+
+  T m_min_size;
+
+  // node data, indexed by node index
+  std::vector<detail::node_address> m_addresses;
+  std::vector<T> m_min_x;
+  std::vector<T> m_min_y;
+  std::vector<T> m_min_z;
+  std::vector<T> m_max_x;
+  std::vector<T> m_max_y;
+  std::vector<T> m_max_z;
+  std::vector<std::array<index_type, 8>> m_children;
+  std::vector<index_type> m_parents;
+  std::vector<index_type> m_data_offsets;
+  std::vector<index_type> m_data_sizes;
+  std::vector<index_type> m_data_capacities;
+  std::vector<index_type> m_free_nodes;
+
+  // the data of every node is stored in a contiguous range of this vector, ranges that
+  // were abandoned when a node outgrew its capacity are reclaimed by compact_data
+  std::vector<U> m_data;
+  std::size_t m_unused_data = 0;
+
+  std::unordered_map<U, index_type> m_node_for_data;
+  index_type m_root = invalid_index;
+
+public:
+  explicit flat_octree(const T min_size)
+    : m_min_size{min_size}
+  {
+  }
+
+  /**
+   * Indicates whether a node with the given data exists in this tree.
+   *
+   * @param data the data to find
+   * @return true if a node with the given data exists and false otherwise
+   */
+  bool contains(const U& data) const { return m_node_for_data.count(data) > 0; }
+
+  void insert(const vm::bbox<T, 3>& bounds, U data)
+  {
+    check(bounds);
+
+    if (contains(data))
+    {
+      throw NodeTreeException("Data already in tree");
+    }
+
+    const auto address = detail::get_container(bounds, m_min_size);
+    if (is_root(address))
+    {
+      if (m_root == invalid_index)
+      {
+        m_root = allocate_node(address, invalid_index);
+      }
+      else if (!m_addresses[m_root].contains(address))
+      {
+        set_address(m_root, address);
+      }
+
+      add_data(m_root, std::move(data));
+    }
+    else
+    {
+      const auto root_address = get_root(address);
+      if (m_root == invalid_index)
+      {
+        m_root = allocate_node(root_address, invalid_index);
+      }
+      else if (!m_addresses[m_root].contains(address))
+      {
+        set_address(m_root, root_address);
+      }
+
+      add_data(find_or_create_node(m_root, address), std::move(data));
+    }
+  }
+
+  /**
+   * Replaces the contents of this tree with the given data.
+   *
+   * The data is sorted by the Morton codes of their node addresses and the tree is built
+   * bottom up in a single pass, so that the nodes and their data are laid out in depth
+   * first Morton order like after calling compact().
+   *
+   * @param range a range of pairs of bounds and data
+   *
+   * @throws NodeTreeException if any bounds are invalid or if any data is contained more
+   * than once
+   */
+  template <std::ranges::range R>
+  void build(R&& range)
+  {
+    auto items = detail::make_build_items<T, U>(std::forward<R>(range), m_min_size);
+
+    auto result = flat_octree{m_min_size};
+    if (!items.empty())
+    {
+      const auto root_address = detail::get_build_root(items);
+      const auto first_non_root = detail::sort_build_items(items, root_address);
+
+      result.m_data.reserve(items.size());
+      result.m_node_for_data.reserve(items.size());
+
+      result.m_root = result.allocate_node(root_address, invalid_index);
+      result.add_build_data(result.m_root, items.begin(), first_non_root);
+      result.build_children(result.m_root, first_non_root, items.end());
+    }
+
+    *this = std::move(result);
+  }
+
+  /**
+   * Removes the node with the given data from this tree.
+   *
+   * @param data the data to remove
+   * @return true if a node with the given data was removed, and false otherwise
+   */
+  bool remove(const U& data)
+  {
+    const auto i_node = m_node_for_data.find(data);
+    if (i_node == m_node_for_data.end())
+    {
+      return false;
+    }
+
+    const auto n = i_node->second;
+    m_node_for_data.erase(i_node);
+
+    if (m_node_for_data.empty())
+    {
+      clear();
+      return true;
+    }
+
+    remove_data(n, data);
+    prune(n);
+
+    return true;
+  }
+
+  /**
+   * Updates the node with the given data with the given new bounds.
+   *
+   * @param newBounds the new bounds of the node
+   * @param data the node data of the node to update
+   *
+   * @throws NodeTreeException if no node with the given data can be found in this tree
+   */
+  void update(const vm::bbox<T, 3>& newBounds, const U& data)
+  {
+    check(newBounds);
+
+    if (!remove(data))
+    {
+      throw NodeTreeException("node not found");
+    }
+    insert(newBounds, data);
+  }
+
+  /**
+   * Clears this node tree.
+   */
+  void clear()
+  {
+    m_addresses.clear();
+    m_min_x.clear();
+    m_min_y.clear();
+    m_min_z.clear();
+    m_max_x.clear();
+    m_max_y.clear();
+    m_max_z.clear();
+    m_children.clear();
+    m_parents.clear();
+    m_data_offsets.clear();
+    m_data_sizes.clear();
+    m_data_capacities.clear();
+    m_free_nodes.clear();
+    m_data.clear();
+    m_unused_data = 0;
+    m_node_for_data.clear();
+    m_root = invalid_index;
+  }
+
+  /**
+   * Indicates whether this tree is empty.
+   *
+   * @return true if this tree is empty and false otherwise
+   */
+  bool empty() const { return m_root == invalid_index; }
+
+  /**
+   * Rearranges the nodes and their data so that they are stored in depth first order,
+   * with the children of every node visited in Morton order. This removes the holes left
+   * by removed nodes and improves the memory locality of subsequent queries.
+   */
+  void compact()
+  {
+    if (m_root == invalid_index)
+    {
+      return;
+    }
+
+    auto result = flat_octree{m_min_size};
+    result.m_addresses.reserve(m_addresses.size() - m_free_nodes.size());
+    result.m_data.reserve(m_data.size() - m_unused_data);
+    result.m_node_for_data.reserve(m_node_for_data.size());
+    result.m_root = copy_subtree(result, m_root, invalid_index);
+
+    *this = std::move(result);
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with the given ray
+   * and returns a list of those items.
+   *
+   * @param ray the ray to test
+   * @return a list containing all found data items
+   */
+  std::vector<U> find_intersectors(const vm::ray<T, 3>& ray) const
+  {
+    auto result = std::vector<U>{};
+    find_intersectors(ray, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with the given ray
+   * and appends it to the given output iterator.
+   *
+   * @tparam O the output iterator type
+   * @param ray the ray to test
+   * @param out the output iterator to append to
+   */
+  template <typename O>
+  void find_intersectors(const vm::ray<T, 3>& ray, O out) const
+  {
+    visit_nodes_if(out, [&](const index_type n) {
+      const auto bounds = node_bounds(n);
+      return bounds.contains(ray.origin) || vm::intersect_ray_bbox(ray, bounds);
+    });
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with the given bbox
+   * and returns a list of those items.
+   *
+   * @param bbox the bbox to test
+   * @return a list containing all found data items
+   */
+  std::vector<U> find_intersectors(const vm::bbox<T, 3>& bbox) const
+  {
+    auto result = std::vector<U>{};
+    find_intersectors(bbox, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with the given bbox
+   * and appends it to the given output iterator.
+   *
+   * @tparam O the output iterator type
+   * @param bbox the bbox to test
+   * @param out the output iterator to append to
+   */
+  template <typename O>
+  void find_intersectors(const vm::bbox<T, 3>& bbox, O out) const
+  {
+    visit_nodes_if(out, [&](const index_type n) {
+      return !(
+        m_max_x[n] < bbox.min.x() || m_min_x[n] > bbox.max.x()
+        || m_max_y[n] < bbox.min.y() || m_min_y[n] > bbox.max.y()
+        || m_max_z[n] < bbox.min.z() || m_min_z[n] > bbox.max.z());
+    });
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box contains the given point and
+   * returns a list of those items.
+   *
+   * @param point the point to test
+   * @return a list containing all found data items
+   */
+  std::vector<U> find_containers(const vm::vec<T, 3>& point) const
+  {
+    auto result = std::vector<U>{};
+    find_containers(point, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box contains the given point and
+   * appends it to the given output iterator.
+   *
+   * @tparam O the output iterator type
+   * @param point the point to test
+   * @param out the output iterator to append to
+   */
+  template <typename O>
+  void find_containers(const vm::vec<T, 3>& point, O out) const
+  {
+    visit_nodes_if(out, [&](const index_type n) {
+      return point.x() >= m_min_x[n] && point.x() <= m_max_x[n]
+             && point.y() >= m_min_y[n] && point.y() <= m_max_y[n]
+             && point.z() >= m_min_z[n] && point.z() <= m_max_z[n];
+    });
+  }
+
+  /**
+   * Finds every data item stored in a node whose bounds satisfy the given predicate and
+   * returns a list of those items.
+   *
+   * @tparam P the predicate type, a unary function that accepts a vm::bbox<T, 3>
+   * @param predicate the predicate to apply to the node bounds
+   * @return a list containing all found data items
+   */
+  template <typename P>
+  std::vector<U> find_if(const P& predicate) const
+  {
+    auto result = std::vector<U>{};
+    find_if(predicate, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item stored in a node whose bounds satisfy the given predicate and
+   * appends it to the given output iterator.
+   *
+   * As with tb::octree::find_if, the predicate is not evaluated for the children of a
+   * node that fails it, and the caller is responsible for testing the returned items
+   * precisely.
+   *
+   * @tparam P the predicate type, a unary function that accepts a vm::bbox<T, 3>
+   * @tparam O the output iterator type
+   * @param predicate the predicate to apply to the node bounds
+   * @param out the output iterator to append to
+   */
+  template <typename P, typename O>
+  void find_if(const P& predicate, O out) const
+  {
+    visit_nodes_if(out, [&](const index_type n) { return predicate(node_bounds(n)); });
+  }
+
+private:
+  vm::bbox<T, 3> node_bounds(const index_type n) const
+  {
+    return {{m_min_x[n], m_min_y[n], m_min_z[n]}, {m_max_x[n], m_max_y[n], m_max_z[n]}};
+  }
+
+  template <typename O, typename Predicate>
+  void visit_nodes_if(O out, const Predicate& predicate) const
+  {
+    if (m_root == invalid_index)
+    {
+      return;
+    }
+
+    auto stack = std::vector<index_type>{};
+    stack.reserve(initial_stack_capacity);
+    stack.push_back(m_root);
+
+    while (!stack.empty())
+    {
+      const auto n = stack.back();
+      stack.pop_back();
+      if (predicate(n))
+      {
+        const auto first = m_data.begin() + m_data_offsets[n];
+        out = std::copy(first, first + m_data_sizes[n], out);
+
+        // push in reverse so that the children are visited in Morton order
+        const auto& children = m_children[n];
+        for (auto q = children.size(); q > 0; --q)
+        {
+          if (children[q - 1] != invalid_index)
+          {
+            stack.push_back(children[q - 1]);
+          }
+        }
+      }
+    }
+  }
+
+  index_type allocate_node(const detail::node_address& address, const index_type parent)
+  {
+    auto n = invalid_index;
+    if (!m_free_nodes.empty())
+    {
+      n = m_free_nodes.back();
+      m_free_nodes.pop_back();
+      m_children[n].fill(invalid_index);
+      m_parents[n] = parent;
+      m_data_offsets[n] = 0;
+      m_data_sizes[n] = 0;
+      m_data_capacities[n] = 0;
+    }
+    else
+    {
+      n = index_type(m_addresses.size());
+      m_addresses.push_back(address);
+      m_min_x.push_back(T(0));
+      m_min_y.push_back(T(0));
+      m_min_z.push_back(T(0));
+      m_max_x.push_back(T(0));
+      m_max_y.push_back(T(0));
+      m_max_z.push_back(T(0));
+      m_children.emplace_back().fill(invalid_index);
+      m_parents.push_back(parent);
+      m_data_offsets.push_back(0);
+      m_data_sizes.push_back(0);
+      m_data_capacities.push_back(0);
+    }
+
+    set_address(n, address);
+    return n;
+  }
+
+  void free_node(const index_type n)
+  {
+    assert(m_data_sizes[n] == 0);
+    m_unused_data += m_data_capacities[n];
+    m_free_nodes.push_back(n);
+  }
+
+  void set_address(const index_type n, const detail::node_address& address)
+  {
+    const auto bounds = address.to_bounds(m_min_size);
+    m_addresses[n] = address;
+    m_min_x[n] = bounds.min.x();
+    m_min_y[n] = bounds.min.y();
+    m_min_z[n] = bounds.min.z();
+    m_max_x[n] = bounds.max.x();
+    m_max_y[n] = bounds.max.y();
+    m_max_z[n] = bounds.max.z();
+  }
+
+  void add_data(const index_type n, U data)
+  {
+    if (m_data_sizes[n] == m_data_capacities[n])
+    {
+      // move the node's data to the end of the data vector and double its capacity
+      const auto old_offset = m_data_offsets[n];
+      const auto new_offset = index_type(m_data.size());
+      const auto new_capacity = std::max(index_type(1), 2 * m_data_capacities[n]);
+
+      m_data.resize(m_data.size() + new_capacity);
+      std::move(
+        m_data.begin() + old_offset,
+        m_data.begin() + old_offset + m_data_sizes[n],
+        m_data.begin() + new_offset);
+
+      m_unused_data += m_data_capacities[n];
+      m_data_offsets[n] = new_offset;
+      m_data_capacities[n] = new_capacity;
+    }
+
+    m_data[m_data_offsets[n] + m_data_sizes[n]++] = data;
+    m_node_for_data.emplace(std::move(data), n);
+
+    if (m_unused_data > m_data.size() / 2 && m_data.size() > 1024)
+    {
+      compact_data();
+    }
+  }
+
+  void remove_data(const index_type n, const U& data)
+  {
+    const auto first = m_data.begin() + m_data_offsets[n];
+    const auto last = first + m_data_sizes[n];
+    const auto i_data = std::find(first, last, data);
+    assert(i_data != last);
+
+    // preserve the order of the remaining data
+    std::move(std::next(i_data), last, i_data);
+    --m_data_sizes[n];
+  }
+
+  /**
+   * Packs the data of all nodes into contiguous ranges without any unused capacity
+   * between them.
+   */
+  void compact_data()
+  {
+    auto new_data = std::vector<U>{};
+    new_data.reserve(m_data.size() - m_unused_data);
+
+    for (index_type n = 0; n < m_addresses.size(); ++n)
+    {
+      const auto first = m_data.begin() + m_data_offsets[n];
+      m_data_offsets[n] = index_type(new_data.size());
+      m_data_capacities[n] = m_data_sizes[n];
+      new_data.insert(
+        new_data.end(),
+        std::make_move_iterator(first),
+        std::make_move_iterator(first + m_data_sizes[n]));
+    }
+
+    m_data = std::move(new_data);
+    m_unused_data = 0;
+  }
+
+  /**
+   * Returns the node with the given address, creating it and possibly an intermediate
+   * node that separates it from an existing sibling if necessary.
+   */
+  index_type find_or_create_node(index_type n, const detail::node_address& address)
+  {
+    while (true)
+    {
+      assert(m_addresses[n].contains(address));
+
+      const auto quadrant = detail::get_quadrant(m_addresses[n], address);
+      if (!quadrant)
+      {
+        return n;
+      }
+
+      const auto child = m_children[n][*quadrant];
+      if (child == invalid_index)
+      {
+        const auto new_child = allocate_node(address, n);
+        m_children[n][*quadrant] = new_child;
+        return new_child;
+      }
+
+      if (m_addresses[child].contains(address))
+      {
+        n = child;
+        continue;
+      }
+
+      // the existing child and the given address diverge, so we insert the smallest node
+      // that contains both between the current node and the existing child
+      const auto container_address =
+        detail::get_container(m_addresses[child], address);
+      const auto container = allocate_node(container_address, n);
+      const auto child_quadrant =
+        detail::get_quadrant(container_address, m_addresses[child]);
+      assert(child_quadrant.has_value());
+
+      m_children[container][*child_quadrant] = child;
+      m_parents[child] = container;
+      m_children[n][*quadrant] = container;
+      n = container;
+    }
+  }
+
+  std::size_t child_count(const index_type n) const
+  {
+    return std::size_t(std::count_if(
+      m_children[n].begin(), m_children[n].end(), [](const auto c) {
+        return c != invalid_index;
+      }));
+  }
+
+  void replace_child(
+    const index_type parent, const index_type old_child, const index_type new_child)
+  {
+    auto& children = m_children[parent];
+    const auto i_child = std::find(children.begin(), children.end(), old_child);
+    assert(i_child != children.end());
+    *i_child = new_child;
+  }
+
+  /**
+   * Removes empty nodes and nodes with only one child and no data, starting at the given
+   * node and walking up towards the root.
+   */
+  void prune(index_type n)
+  {
+    while (n != m_root && m_data_sizes[n] == 0)
+    {
+      const auto parent = m_parents[n];
+      const auto num_children = child_count(n);
+      if (num_children == 0)
+      {
+        replace_child(parent, n, invalid_index);
+        free_node(n);
+      }
+      else if (num_children == 1)
+      {
+        const auto& children = m_children[n];
+        const auto child = *std::find_if(children.begin(), children.end(), [](auto c) {
+          return c != invalid_index;
+        });
+        replace_child(parent, n, child);
+        m_parents[child] = parent;
+        free_node(n);
+      }
+      else
+      {
+        break;
+      }
+
+      n = parent;
+    }
+  }
+
+  index_type copy_subtree(
+    flat_octree& result, const index_type n, const index_type parent) const
+  {
+    const auto copy = result.allocate_node(m_addresses[n], parent);
+
+    const auto first = m_data.begin() + m_data_offsets[n];
+    result.m_data_offsets[copy] = index_type(result.m_data.size());
+    result.m_data_sizes[copy] = m_data_sizes[n];
+    result.m_data_capacities[copy] = m_data_sizes[n];
+    result.m_data.insert(result.m_data.end(), first, first + m_data_sizes[n]);
+    for (auto i = first; i != first + m_data_sizes[n]; ++i)
+    {
+      result.m_node_for_data.emplace(*i, copy);
+    }
+
+    for (std::size_t q = 0; q < 8; ++q)
+    {
+      if (const auto child = m_children[n][q]; child != invalid_index)
+      {
+        result.m_children[copy][q] = copy_subtree(result, child, copy);
+      }
+    }
+
+    return copy;
+  }
+
+  template <typename I>
+  void add_build_data(const index_type n, I first, const I last)
+  {
+    m_data_offsets[n] = index_type(m_data.size());
+    for (; first != last; ++first)
+    {
+      if (!m_node_for_data.emplace(first->data, n).second)
+      {
+        throw NodeTreeException("Data already in tree");
+      }
+      m_data.push_back(first->data);
+      ++m_data_sizes[n];
+    }
+    m_data_capacities[n] = m_data_sizes[n];
+  }
+
+  template <typename I>
+  void build_children(const index_type parent, const I first, const I last)
+  {
+    // copy the address because allocating nodes invalidates references into m_addresses
+    const auto parent_address = m_addresses[parent];
+    detail::for_each_build_quadrant(
+      parent_address,
+      first,
+      last,
+      [&](const auto quadrant, const auto i, const auto j) {
+        const auto address = get_container(i->address, std::prev(j)->address);
+        const auto child = allocate_node(address, parent);
+        m_children[parent][quadrant] = child;
+
+        const auto first_quadrant_item = detail::find_first_quadrant_item(address, i, j);
+        add_build_data(child, i, first_quadrant_item);
+        build_children(child, first_quadrant_item, j);
+      });
+  }
+
+  void check(const vm::bbox<T, 3>& bounds) const
+  {
+    if (vm::is_nan(bounds.min) || vm::is_nan(bounds.max))
+    {
+      throw NodeTreeException("Cannot add node to octree with invalid bounds");
+    }
+  }
+};
+
+} // namespace tb
@@ -0,0 +1,54 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "io/ParserStatus.h"
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace tb::io
+{
+
+/**
+ * Records the messages logged by a parser that runs on a worker thread so that they can
+ * be passed on to the actual parser status later, in the order in which the sequential
+ * parser would have logged them. Progress is ignored.
+ */
+class BufferedParserStatus : public ParserStatus
+{
+private:
+  std::vector<std::tuple<LogLevel, std::string>> m_messages;
+
+public:
+  BufferedParserStatus();
+
+  /**
+   * Logs all recorded messages to the given status and clears them.
+   */
+  void flush(ParserStatus& status);
+
+private:
+  void doProgress(double progress) override;
+  void doLog(LogLevel level, const std::string& str) override;
+};
+
+} // namespace tb::io
@@ -0,0 +1,265 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CharScanner.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define TB_CHAR_SCANNER_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TB_CHAR_SCANNER_SSE2
+#endif
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace tb::io
+{
+namespace
+{
+
+constexpr auto MaxSimdChars = std::string_view::size_type(8);
+
+bool isDigit(const char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+template <bool Negate>
+const char* scalarFind(const char* first, const char* last, const std::string_view chars)
+{
+  while (first != last && detail::isAnyOf(*first, chars) == Negate)
+  {
+    ++first;
+  }
+  return first;
+}
+
+#if defined(TB_CHAR_SCANNER_AVX2) || defined(TB_CHAR_SCANNER_SSE2)
+
+unsigned countTrailingZeros(const std::uint32_t mask)
+{
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return unsigned(index);
+#else
+  return unsigned(__builtin_ctz(mask));
+#endif
+}
+
+#endif
+
+#if defined(TB_CHAR_SCANNER_AVX2)
+
+using Vector = __m256i;
+constexpr auto VectorSize = size_t(32);
+
+Vector load(const char* c)
+{
+  return _mm256_loadu_si256(reinterpret_cast<const Vector*>(c));
+}
+
+Vector splat(const char c)
+{
+  return _mm256_set1_epi8(c);
+}
+
+Vector zero()
+{
+  return _mm256_setzero_si256();
+}
+
+Vector equal(const Vector lhs, const Vector rhs)
+{
+  return _mm256_cmpeq_epi8(lhs, rhs);
+}
+
+Vector greater(const Vector lhs, const Vector rhs)
+{
+  return _mm256_cmpgt_epi8(lhs, rhs);
+}
+
+Vector bitOr(const Vector lhs, const Vector rhs)
+{
+  return _mm256_or_si256(lhs, rhs);
+}
+
+Vector bitAnd(const Vector lhs, const Vector rhs)
+{
+  return _mm256_and_si256(lhs, rhs);
+}
+
+std::uint32_t moveMask(const Vector v)
+{
+  return std::uint32_t(_mm256_movemask_epi8(v));
+}
+
+#elif defined(TB_CHAR_SCANNER_SSE2)
+
+using Vector = __m128i;
+constexpr auto VectorSize = size_t(16);
+
+Vector load(const char* c)
+{
+  return _mm_loadu_si128(reinterpret_cast<const Vector*>(c));
+}
+
+Vector splat(const char c)
+{
+  return _mm_set1_epi8(c);
+}
+
+Vector zero()
+{
+  return _mm_setzero_si128();
+}
+
+Vector equal(const Vector lhs, const Vector rhs)
+{
+  return _mm_cmpeq_epi8(lhs, rhs);
+}
+
+Vector greater(const Vector lhs, const Vector rhs)
+{
+  return _mm_cmpgt_epi8(lhs, rhs);
+}
+
+Vector bitOr(const Vector lhs, const Vector rhs)
+{
+  return _mm_or_si128(lhs, rhs);
+}
+
+Vector bitAnd(const Vector lhs, const Vector rhs)
+{
+  return _mm_and_si128(lhs, rhs);
+}
+
+std::uint32_t moveMask(const Vector v)
+{
+  return std::uint32_t(_mm_movemask_epi8(v));
+}
+
+#endif
+
+#if defined(TB_CHAR_SCANNER_AVX2) || defined(TB_CHAR_SCANNER_SSE2)
+
+constexpr auto FullMask = std::uint32_t((std::uint64_t(1) << VectorSize) - 1);
+
+/**
+ * Scans the input in blocks of VectorSize characters. For each block, matchMask must
+ * return a bit mask where bit i is set if and only if the i-th character of the block
+ * matches. Returns a pointer to the first matching character of the first block that
+ * contains a match, or a pointer to the beginning of the remaining characters that do not
+ * fill an entire block.
+ */
+template <typename MatchMask>
+const char* simdFind(const char* first, const char* last, const MatchMask& matchMask)
+{
+  while (size_t(last - first) >= VectorSize)
+  {
+    if (const auto mask = matchMask(load(first)); mask != 0)
+    {
+      return first + countTrailingZeros(mask);
+    }
+    first += VectorSize;
+  }
+  return first;
+}
+
+template <bool Negate>
+const char* simdFindAnyOf(
+  const char* first, const char* last, const std::string_view chars)
+{
+  // std::array would drop the vector type's alignment attributes
+  Vector needles[MaxSimdChars];
+  for (size_t i = 0; i < chars.size(); ++i)
+  {
+    needles[i] = splat(chars[i]);
+  }
+
+  first = simdFind(first, last, [&](const Vector block) {
+    auto matches = zero();
+    for (size_t i = 0; i < chars.size(); ++i)
+    {
+      matches = bitOr(matches, equal(block, needles[i]));
+    }
+    const auto mask = moveMask(matches);
+    return Negate ? ~mask & FullMask : mask;
+  });
+
+  // scans the remainder, or returns immediately if simdFind found a match
+  return scalarFind<Negate>(first, last, chars);
+}
+
+#endif
+
+} // namespace
+
+namespace detail
+{
+
+const char* findFirstOf(const char* first, const char* last, const std::string_view chars)
+{
+#if defined(TB_CHAR_SCANNER_AVX2) || defined(TB_CHAR_SCANNER_SSE2)
+  if (chars.size() <= MaxSimdChars)
+  {
+    return simdFindAnyOf<false>(first, last, chars);
+  }
+#endif
+  return scalarFind<false>(first, last, chars);
+}
+
+const char* findFirstNotOf(
+  const char* first, const char* last, const std::string_view chars)
+{
+#if defined(TB_CHAR_SCANNER_AVX2) || defined(TB_CHAR_SCANNER_SSE2)
+  if (chars.size() <= MaxSimdChars)
+  {
+    return simdFindAnyOf<true>(first, last, chars);
+  }
+#endif
+  return scalarFind<true>(first, last, chars);
+}
+
+const char* findFirstNonDigit(const char* first, const char* last)
+{
+#if defined(TB_CHAR_SCANNER_AVX2) || defined(TB_CHAR_SCANNER_SSE2)
+  // characters >= 0x80 are negative and therefore never greater than '0' - 1
+  const auto lower = splat('0' - 1);
+  const auto upper = splat('9' + 1);
+  first = simdFind(first, last, [&](const Vector block) {
+    const auto digits = bitAnd(greater(block, lower), greater(upper, block));
+    return ~moveMask(digits) & FullMask;
+  });
+#endif
+
+  while (first != last && isDigit(*first))
+  {
+    ++first;
+  }
+  return first;
+}
+
+} // namespace detail
+} // namespace tb::io
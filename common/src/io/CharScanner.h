@@ -0,0 +1,110 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <string_view>
+
+namespace tb::io
+{
+
+namespace detail
+{
+const char* findFirstOf(const char* first, const char* last, std::string_view chars);
+const char* findFirstNotOf(const char* first, const char* last, std::string_view chars);
+const char* findFirstNonDigit(const char* first, const char* last);
+
+/**
+ * Most runs of characters in a map file are short, so the first few characters are
+ * checked inline before the remaining input is handed to the vectorized scan.
+ */
+constexpr auto InlinePrefixLength = 8;
+
+template <typename P>
+bool scanPrefix(const char*& first, const char* last, const P& isMatch)
+{
+  for (auto i = 0; i < InlinePrefixLength && first != last; ++i, ++first)
+  {
+    if (isMatch(*first))
+    {
+      return true;
+    }
+  }
+  return first == last;
+}
+
+inline bool isAnyOf(const char c, const std::string_view chars)
+{
+  for (const auto a : chars)
+  {
+    if (c == a)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace detail
+
+/**
+ * Returns a pointer to the first character in [first, last) that is contained in the
+ * given set of characters, or last if there is no such character.
+ *
+ * Uses SSE2 or AVX2 to examine multiple characters at once if they are available and
+ * the set contains at most 8 characters.
+ */
+inline const char* findFirstOf(
+  const char* first, const char* last, const std::string_view chars)
+{
+  return detail::scanPrefix(
+           first, last, [&](const char c) { return detail::isAnyOf(c, chars); })
+           ? first
+           : detail::findFirstOf(first, last, chars);
+}
+
+/**
+ * Returns a pointer to the first character in [first, last) that is not contained in the
+ * given set of characters, or last if there is no such character.
+ *
+ * Uses SSE2 or AVX2 to examine multiple characters at once if they are available and
+ * the set contains at most 8 characters.
+ */
+inline const char* findFirstNotOf(
+  const char* first, const char* last, const std::string_view chars)
+{
+  return detail::scanPrefix(
+           first, last, [&](const char c) { return !detail::isAnyOf(c, chars); })
+           ? first
+           : detail::findFirstNotOf(first, last, chars);
+}
+
+/**
+ * Returns a pointer to the first character in [first, last) that is not a decimal digit,
+ * or last if there is no such character.
+ */
+inline const char* findFirstNonDigit(const char* first, const char* last)
+{
+  return detail::scanPrefix(
+           first, last, [](const char c) { return c < '0' || c > '9'; })
+           ? first
+           : detail::findFirstNonDigit(first, last);
+}
+
+} // namespace tb::io
@@ -157,7 +157,24 @@ Result<std::vector<std::filesystem::path>> find(
   return result;
 }
 
-Result<std::shared_ptr<CFile>> openFile(const std::filesystem::path& path)
+Result<std::shared_ptr<File>> openFile(const std::filesystem::path& path)
+{
+  const auto fixedPath = fixPath(path);
+  if (pathInfoForFixedPath(fixedPath) != PathInfo::File)
+  {
+    return Error{fmt::format("Failed to open {}: path does not denote a file", path)};
+  }
+
+  return createMmapFile(fixedPath)
+         | kdl::transform([](auto file) { return std::static_pointer_cast<File>(file); })
+         | kdl::or_else([&](const auto&) {
+             return createCFile(fixedPath) | kdl::transform([](auto file) {
+                      return std::static_pointer_cast<File>(file);
+                    });
+           });
+}
+
+Result<std::shared_ptr<CFile>> openUnmappedFile(const std::filesystem::path& path)
 {
   const auto fixedPath = fixPath(path);
   if (pathInfoForFixedPath(fixedPath) != PathInfo::File)
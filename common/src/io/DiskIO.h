@@ -50,7 +50,20 @@ Result<std::vector<std::filesystem::path>> find(
   const TraversalMode& traversalMode,
   const PathMatcher& pathMatcher = matchAnyPath);
 
-Result<std::shared_ptr<CFile>> openFile(const std::filesystem::path& path);
+/**
+ * Opens the file at the given path. The file is mapped into memory if possible, otherwise
+ * it is read using the C file API.
+ */
+Result<std::shared_ptr<File>> openFile(const std::filesystem::path& path);
+
+/**
+ * Opens the file at the given path using the C file API without mapping it into memory.
+ *
+ * Use this for files that are kept open for a long time, such as mounted archives. A
+ * mapped file cannot be replaced on Windows, and accessing it after it was truncated by
+ * another process crashes the application on Linux.
+ */
+Result<std::shared_ptr<CFile>> openUnmappedFile(const std::filesystem::path& path);
 
 template <typename Stream, typename F>
 auto withStream(
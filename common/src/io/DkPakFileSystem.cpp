@@ -36,6 +36,8 @@ namespace DkPakLayout
 static const size_t HeaderMagicLength = 0x4;
 static const size_t EntryLength = 0x48;
 static const size_t EntryNameLength = 0x38;
+static const uint32_t CompressionNone = 0;
+static const uint32_t CompressionLz = 1;
 // static const std::string HeaderMagic = "PACK";
 } // namespace DkPakLayout
 
@@ -107,7 +109,7 @@ Result<std::unique_ptr<char[]>> decompress(
 }
 } // namespace
 
-Result<void> DkPakFileSystem::doReadDirectory()
+Result<std::vector<ImageFileIndexEntry>> DkPakFileSystem::doReadDirectory()
 {
   try
   {
@@ -120,6 +122,9 @@ Result<void> DkPakFileSystem::doReadDirectory()
 
     reader.seekFromBegin(directoryAddress);
 
+    auto entries = std::vector<ImageFileIndexEntry>{};
+    entries.reserve(entryCount);
+
     for (size_t i = 0; i < entryCount; ++i)
     {
       const auto entryName = reader.readString(DkPakLayout::EntryNameLength);
@@ -129,33 +134,43 @@ Result<void> DkPakFileSystem::doReadDirectory()
       const auto compressed = reader.readBool<int32_t>();
       const auto entrySize = compressed ? compressedSize : uncompressedSize;
 
-      const auto entryPath = std::filesystem::path(kdl::str_to_lower(entryName));
-      auto entryFile_ = std::make_shared<FileView>(m_file, entryAddress, entrySize);
-
-      if (compressed)
-      {
-        addFile(
-          entryPath,
-          [entryFile = std::move(entryFile_),
-           uncompressedSize]() -> Result<std::shared_ptr<File>> {
-            return decompress(entryFile, uncompressedSize)
-                   | kdl::transform([&](auto data) {
-                       return std::static_pointer_cast<File>(
-                         std::make_shared<OwningBufferFile>(
-                           std::move(data), uncompressedSize));
-                     });
-          });
-      }
-      else
-      {
-        addFile(entryPath, [entryFile = std::move(entryFile_)]() { return entryFile; });
-      }
+      auto entryPath = std::filesystem::path(kdl::str_to_lower(entryName));
+      entries.push_back(ImageFileIndexEntry{
+        std::move(entryPath),
+        entryAddress,
+        entrySize,
+        uncompressedSize,
+        compressed ? DkPakLayout::CompressionLz : DkPakLayout::CompressionNone});
     }
-    return kdl::void_success;
+    return entries;
   }
   catch (const ReaderException& e)
   {
     return Error{e.what()};
   }
 }
+
+GetImageFile DkPakFileSystem::doMakeGetFile(const ImageFileIndexEntry& entry)
+{
+  auto entryFile_ =
+    std::make_shared<FileView>(m_file, size_t(entry.offset), size_t(entry.size));
+
+  if (entry.compression == DkPakLayout::CompressionLz)
+  {
+    return [entryFile = std::move(entryFile_),
+            uncompressedSize =
+              size_t(entry.uncompressedSize)]() -> Result<std::shared_ptr<File>> {
+      return decompress(entryFile, uncompressedSize)
+             | kdl::transform([&](auto data) {
+                 return std::static_pointer_cast<File>(
+                   std::make_shared<OwningBufferFile>(std::move(data), uncompressedSize));
+               });
+    };
+  }
+
+  return [entryFile = std::move(entryFile_)]() -> Result<std::shared_ptr<File>> {
+    return entryFile;
+  };
+}
+
 } // namespace tb::io
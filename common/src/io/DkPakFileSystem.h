@@ -22,16 +22,19 @@
 #include "Result.h"
 #include "io/ImageFileSystem.h"
 
+#include <vector>
+
 namespace tb::io
 {
-class CFile;
+class File;
 
-class DkPakFileSystem : public ImageFileSystem<CFile>
+class DkPakFileSystem : public ImageFileSystem<File>
 {
 public:
   using ImageFileSystem::ImageFileSystem;
 
 private:
-  Result<void> doReadDirectory() override;
+  Result<std::vector<ImageFileIndexEntry>> doReadDirectory() override;
+  GetImageFile doMakeGetFile(const ImageFileIndexEntry& entry) override;
 };
 } // namespace tb::io
@@ -26,6 +26,16 @@
 
 #include <cstdio>
 #include <cstring>
+#include <tuple>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace tb::io
 {
@@ -195,6 +205,129 @@ Result<std::shared_ptr<CFile>> createCFile(const std::filesystem::path& path)
          });
 }
 
+namespace
+{
+
+Result<std::tuple<CFile::BufferType, size_t>> mapFile(const std::filesystem::path& path)
+{
+#ifdef _WIN32
+  // Allow others to read and write the file just like fopen() does.
+  auto file = kdl::resource{
+    CreateFileW(
+      path.wstring().c_str(),
+      GENERIC_READ,
+      FILE_SHARE_READ | FILE_SHARE_WRITE,
+      nullptr,
+      OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL,
+      nullptr),
+    [](auto handle) {
+      if (handle != INVALID_HANDLE_VALUE)
+      {
+        CloseHandle(handle);
+      }
+    }};
+  if (*file == INVALID_HANDLE_VALUE)
+  {
+    return Error{fmt::format("Failed to open '{}'", path)};
+  }
+
+  auto fileSize = LARGE_INTEGER{};
+  if (!GetFileSizeEx(*file, &fileSize))
+  {
+    return Error{fmt::format("Failed to get size of '{}'", path)};
+  }
+  if (fileSize.QuadPart == 0)
+  {
+    return Error{fmt::format("Failed to map '{}': file is empty", path)};
+  }
+
+  // The view keeps the mapping alive, so the handles can be closed once it is created.
+  auto mapping = kdl::resource{
+    CreateFileMappingW(*file, nullptr, PAGE_READONLY, 0, 0, nullptr), [](auto handle) {
+      if (handle)
+      {
+        CloseHandle(handle);
+      }
+    }};
+  if (!*mapping)
+  {
+    return Error{fmt::format("Failed to map '{}'", path)};
+  }
+
+  auto* data = MapViewOfFile(*mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!data)
+  {
+    return Error{fmt::format("Failed to map '{}'", path)};
+  }
+
+  return std::tuple{
+    CFile::BufferType{static_cast<char*>(data), [](auto* p) { UnmapViewOfFile(p); }},
+    static_cast<size_t>(fileSize.QuadPart)};
+#else
+  auto file = kdl::resource{open(path.c_str(), O_RDONLY | O_CLOEXEC), [](auto fd) {
+                              if (fd >= 0)
+                              {
+                                close(fd);
+                              }
+                            }};
+  if (*file < 0)
+  {
+    return Error{fmt::format("Failed to open '{}': {}", path, std::strerror(errno))};
+  }
+
+  struct stat fileStat;
+  if (fstat(*file, &fileStat) != 0)
+  {
+    return Error{
+      fmt::format("Failed to get size of '{}': {}", path, std::strerror(errno))};
+  }
+  if (fileStat.st_size == 0)
+  {
+    return Error{fmt::format("Failed to map '{}': file is empty", path)};
+  }
+
+  // The mapping stays valid after the file descriptor is closed.
+  const auto size = static_cast<size_t>(fileStat.st_size);
+  auto* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, *file, 0);
+  if (data == MAP_FAILED)
+  {
+    return Error{fmt::format("Failed to map '{}': {}", path, std::strerror(errno))};
+  }
+
+  return std::tuple{
+    CFile::BufferType{static_cast<char*>(data), [size](auto* p) { munmap(p, size); }},
+    size};
+#endif
+}
+
+} // namespace
+
+MmapFile::MmapFile(CFile::BufferType buffer, const size_t size)
+  : m_buffer{std::move(buffer)}
+  , m_size{size}
+{
+}
+
+Reader MmapFile::reader() const
+{
+  return Reader::from(*this);
+}
+
+size_t MmapFile::size() const
+{
+  return m_size;
+}
+
+Result<std::shared_ptr<MmapFile>> createMmapFile(const std::filesystem::path& path)
+{
+  return mapFile(path) | kdl::transform([](auto bufferAndSize) {
+           auto [buffer, size] = std::move(bufferAndSize);
+           // NOLINTNEXTLINE
+           return std::shared_ptr<MmapFile>{new MmapFile{std::move(buffer), size}};
+         });
+}
+
 FileView::FileView(std::shared_ptr<File> file, const size_t offset, const size_t length)
   : m_file{std::move(file)}
   , m_offset{offset}
@@ -124,6 +124,39 @@ private:
 
 Result<std::shared_ptr<CFile>> createCFile(const std::filesystem::path& path);
 
+/**
+ * A file that is backed by a physical file on the disk which is mapped into memory.
+ * Readers access the mapped memory directly without copying it. The mapping is released
+ * when this file and all buffered readers created from it have been destroyed.
+ */
+class MmapFile : public File
+{
+private:
+  CFile::BufferType m_buffer;
+  size_t m_size;
+
+  /**
+   * Creates a new file with the given mapped memory and size in bytes.
+   */
+  MmapFile(CFile::BufferType buffer, size_t size);
+
+public:
+  friend Result<std::shared_ptr<MmapFile>> createMmapFile(
+    const std::filesystem::path& path);
+
+  Reader reader() const override;
+  size_t size() const override;
+
+private:
+  friend class Reader;
+};
+
+/**
+ * Maps the file at the given path into memory. Returns an error if the file cannot be
+ * opened or mapped, e.g. because it is empty.
+ */
+Result<std::shared_ptr<MmapFile>> createMmapFile(const std::filesystem::path& path);
+
 /**
  * A file that is backed by a portion of a physical file.
  */
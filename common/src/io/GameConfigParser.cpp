@@ -19,6 +19,7 @@
 
 #include "GameConfigParser.h"
 
+#include "el/CompiledExpression.h"
 #include "el/EvaluationContext.h"
 #include "el/Value.h"
 #include "io/ParserException.h"
@@ -27,6 +28,7 @@
 #include "mdl/TagAttribute.h"
 #include "mdl/TagMatcher.h"
 
+#include "kdl/optional_utils.h"
 #include "kdl/range_to_vector.h"
 
 #include "vm/vec_io.h"
@@ -453,7 +455,10 @@ mdl::EntityConfig parseEntityConfig(
   return mdl::EntityConfig{
     std::move(paths),
     color,
-    context.expression(value.atOrDefault(context, "scale")),
+    context.expression(value.atOrDefault(context, "scale"))
+      | kdl::optional_transform([](auto expression) {
+          return el::CompiledExpression{std::move(expression)};
+        }),
     value.atOrDefault(context, "setDefaultProperties").booleanValue(context),
   };
 }
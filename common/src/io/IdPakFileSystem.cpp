@@ -37,7 +37,7 @@ static const size_t EntryNameLength = 0x38;
 // static const std::string HeaderMagic = "PACK";
 } // namespace PakLayout
 
-Result<void> IdPakFileSystem::doReadDirectory()
+Result<std::vector<ImageFileIndexEntry>> IdPakFileSystem::doReadDirectory()
 {
   try
   {
@@ -53,23 +53,21 @@ Result<void> IdPakFileSystem::doReadDirectory()
 
     reader.seekFromBegin(directoryAddress);
 
+    auto entries = std::vector<ImageFileIndexEntry>{};
+    entries.reserve(entryCount);
+
     for (size_t i = 0; i < entryCount; ++i)
     {
       const auto entryName = reader.readString(PakLayout::EntryNameLength);
       const auto entryAddress = reader.readSize<int32_t>();
       const auto entrySize = reader.readSize<int32_t>();
 
-      const auto entryPath = std::filesystem::path{kdl::str_to_lower(entryName)};
-      auto entryFile_ = std::static_pointer_cast<File>(
-        std::make_shared<FileView>(m_file, entryAddress, entrySize));
-      addFile(
-        entryPath,
-        [entryFile = std::move(entryFile_)]() -> Result<std::shared_ptr<File>> {
-          return entryFile;
-        });
+      auto entryPath = std::filesystem::path{kdl::str_to_lower(entryName)};
+      entries.push_back(
+        ImageFileIndexEntry{std::move(entryPath), entryAddress, entrySize, entrySize, 0});
     }
 
-    return kdl::void_success;
+    return entries;
   }
   catch (const ReaderException& e)
   {
@@ -77,4 +75,13 @@ Result<void> IdPakFileSystem::doReadDirectory()
   }
 }
 
+GetImageFile IdPakFileSystem::doMakeGetFile(const ImageFileIndexEntry& entry)
+{
+  auto entryFile_ = std::static_pointer_cast<File>(
+    std::make_shared<FileView>(m_file, size_t(entry.offset), size_t(entry.size)));
+  return [entryFile = std::move(entryFile_)]() -> Result<std::shared_ptr<File>> {
+    return entryFile;
+  };
+}
+
 } // namespace tb::io
@@ -22,17 +22,20 @@
 #include "Result.h"
 #include "io/ImageFileSystem.h"
 
+#include <vector>
+
 namespace tb::io
 {
-class CFile;
+class File;
 
-class IdPakFileSystem : public ImageFileSystem<CFile>
+class IdPakFileSystem : public ImageFileSystem<File>
 {
 public:
   using ImageFileSystem::ImageFileSystem;
 
 private:
-  Result<void> doReadDirectory() override;
+  Result<std::vector<ImageFileIndexEntry>> doReadDirectory() override;
+  GetImageFile doMakeGetFile(const ImageFileIndexEntry& entry) override;
 };
 
 } // namespace tb::io
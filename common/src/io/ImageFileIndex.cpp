@@ -0,0 +1,270 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ImageFileIndex.h"
+
+#include "Uuid.h"
+#include "io/DiskIO.h"
+#include "io/File.h"
+#include "io/PathInfo.h"
+#include "io/PathMatcher.h"
+#include "io/Reader.h"
+#include "io/ReaderException.h"
+#include "io/TraversalMode.h"
+
+#include "kdl/reflection_impl.h"
+#include "kdl/result.h"
+#include "kdl/result_fold.h"
+#include "kdl/vector_utils.h"
+
+#include <fmt/format.h>
+#include <fmt/std.h>
+
+#include <ostream>
+#include <string>
+
+namespace tb::io
+{
+namespace ImageFileIndexLayout
+{
+static const std::string Magic = "TBIX";
+static const uint32_t Version = 1;
+} // namespace ImageFileIndexLayout
+
+namespace
+{
+
+/**
+ * Derives the name of the index file from the image file path using 64bit FNV-1a, which
+ * is stable across runs. Collisions are detected when the index is loaded because the
+ * index file contains the full path of its image file.
+ */
+std::filesystem::path indexFileName(const std::filesystem::path& imageFilePath)
+{
+  auto hash = uint64_t(0xcbf29ce484222325);
+  for (const auto c : imageFilePath.generic_string())
+  {
+    hash = (hash ^ uint64_t(static_cast<unsigned char>(c))) * uint64_t(0x100000001b3);
+  }
+  return fmt::format("{:016x}.idx", hash);
+}
+
+std::string readString(Reader& reader)
+{
+  const auto length = reader.readSize<uint32_t>();
+  return reader.readString(length);
+}
+
+std::optional<std::vector<ImageFileIndexEntry>> readIndex(
+  const File& file,
+  const std::filesystem::path& imageFilePath,
+  const ImageFileStamp& imageFileStamp)
+{
+  try
+  {
+    auto reader = file.reader();
+    const auto magic = reader.readString(ImageFileIndexLayout::Magic.size());
+    const auto version = reader.read<uint32_t, uint32_t>();
+    if (magic != ImageFileIndexLayout::Magic || version != ImageFileIndexLayout::Version)
+    {
+      return std::nullopt;
+    }
+
+    const auto size = reader.read<uint64_t, uint64_t>();
+    const auto modificationTime = reader.read<int64_t, int64_t>();
+    if (ImageFileStamp{size, modificationTime} != imageFileStamp
+        || readString(reader) != imageFilePath.generic_string())
+    {
+      return std::nullopt;
+    }
+
+    const auto entryCount = reader.readSize<uint32_t>();
+    auto entries = std::vector<ImageFileIndexEntry>{};
+    entries.reserve(entryCount);
+
+    for (size_t i = 0; i < entryCount; ++i)
+    {
+      auto path = std::filesystem::path{readString(reader)};
+      const auto offset = reader.read<uint64_t, uint64_t>();
+      const auto entrySize = reader.read<uint64_t, uint64_t>();
+      const auto uncompressedSize = reader.read<uint64_t, uint64_t>();
+      const auto compression = reader.read<uint32_t, uint32_t>();
+      entries.push_back(ImageFileIndexEntry{
+        std::move(path), offset, entrySize, uncompressedSize, compression});
+    }
+
+    return entries;
+  }
+  catch (const ReaderException&)
+  {
+    return std::nullopt;
+  }
+}
+
+template <typename T>
+void write(std::ostream& stream, const T value)
+{
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void writeString(std::ostream& stream, const std::string& str)
+{
+  write(stream, uint32_t(str.size()));
+  stream.write(str.data(), std::streamsize(str.size()));
+}
+
+void writeIndex(
+  std::ostream& stream,
+  const std::filesystem::path& imageFilePath,
+  const ImageFileStamp& imageFileStamp,
+  const std::vector<ImageFileIndexEntry>& entries)
+{
+  const auto& magic = ImageFileIndexLayout::Magic;
+  stream.write(magic.data(), std::streamsize(magic.size()));
+  write(stream, ImageFileIndexLayout::Version);
+  write(stream, imageFileStamp.size);
+  write(stream, imageFileStamp.modificationTime);
+  writeString(stream, imageFilePath.generic_string());
+
+  write(stream, uint32_t(entries.size()));
+  for (const auto& entry : entries)
+  {
+    writeString(stream, entry.path.generic_string());
+    write(stream, entry.offset);
+    write(stream, entry.size);
+    write(stream, entry.uncompressedSize);
+    write(stream, entry.compression);
+  }
+}
+
+} // namespace
+
+kdl_reflect_impl(ImageFileIndexEntry);
+
+kdl_reflect_impl(ImageFileStamp);
+
+std::optional<ImageFileStamp> getImageFileStamp(const std::filesystem::path& path)
+{
+  auto error = std::error_code{};
+  const auto size = std::filesystem::file_size(path, error);
+  if (error)
+  {
+    return std::nullopt;
+  }
+
+  const auto modificationTime = std::filesystem::last_write_time(path, error);
+  if (error)
+  {
+    return std::nullopt;
+  }
+
+  return ImageFileStamp{
+    uint64_t(size), int64_t(modificationTime.time_since_epoch().count())};
+}
+
+ImageFileIndexCache::ImageFileIndexCache(std::filesystem::path directory)
+  : m_directory{std::move(directory)}
+{
+}
+
+const std::filesystem::path& ImageFileIndexCache::directory() const
+{
+  return m_directory;
+}
+
+std::optional<std::vector<ImageFileIndexEntry>> ImageFileIndexCache::load(
+  const std::filesystem::path& imageFilePath, const ImageFileStamp& imageFileStamp) const
+{
+  const auto indexFilePath = m_directory / indexFileName(imageFilePath);
+  auto entries = Disk::openFile(indexFilePath) | kdl::transform([&](auto file) {
+                   return readIndex(*file, imageFilePath, imageFileStamp);
+                 })
+                 | kdl::value_or(std::optional<std::vector<ImageFileIndexEntry>>{});
+
+  if (entries)
+  {
+    // mark the index as used so that it isn't removed as stale
+    auto error = std::error_code{};
+    std::filesystem::last_write_time(
+      indexFilePath, std::filesystem::file_time_type::clock::now(), error);
+  }
+
+  return entries;
+}
+
+Result<void> ImageFileIndexCache::store(
+  const std::filesystem::path& imageFilePath,
+  const ImageFileStamp& imageFileStamp,
+  const std::vector<ImageFileIndexEntry>& entries) const
+{
+  // write to a temporary file first so that other instances never read a partial index
+  const auto indexFilePath = m_directory / indexFileName(imageFilePath);
+  const auto tempFilePath = m_directory / (generateUuid() + ".tmp");
+
+  return Disk::createDirectory(m_directory) | kdl::and_then([&](auto) {
+           return Disk::withOutputStream(
+             tempFilePath,
+             std::ios::out | std::ios::binary,
+             [&](auto& stream) -> Result<void> {
+               writeIndex(stream, imageFilePath, imageFileStamp, entries);
+               if (!stream)
+               {
+                 return Error{fmt::format("Failed to write {}", tempFilePath)};
+               }
+               return kdl::void_success;
+             });
+         })
+         | kdl::and_then([&]() { return Disk::moveFile(tempFilePath, indexFilePath); })
+         | kdl::or_else([&](auto e) -> Result<void> {
+             // clean up the temporary file, ignoring any error, and report the original
+             // error
+             auto error = std::error_code{};
+             std::filesystem::remove(tempFilePath, error);
+             return e;
+           });
+}
+
+Result<void> ImageFileIndexCache::removeStaleIndexFiles(
+  const std::chrono::hours maxAge) const
+{
+  if (Disk::pathInfo(m_directory) != PathInfo::Directory)
+  {
+    return kdl::void_success;
+  }
+
+  const auto now = std::filesystem::file_time_type::clock::now();
+  return Disk::find(
+           m_directory, TraversalMode::Flat, makeExtensionPathMatcher({".idx", ".tmp"}))
+         | kdl::and_then([&](const auto& paths) {
+             return kdl::vec_transform(
+                      paths,
+                      [&](const auto& path) {
+                        auto error = std::error_code{};
+                        const auto modificationTime =
+                          std::filesystem::last_write_time(path, error);
+                        return !error && now - modificationTime > maxAge
+                                 ? Disk::deleteFile(path)
+                                 : Result<bool>{false};
+                      })
+                    | kdl::fold;
+           })
+         | kdl::transform([](auto) {});
+}
+
+} // namespace tb::io
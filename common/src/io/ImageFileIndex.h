@@ -0,0 +1,135 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Result.h"
+
+#include "kdl/reflection_decl.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+namespace tb::io
+{
+
+/**
+ * Describes a file contained in an image file such as a pak or a zip archive.
+ */
+struct ImageFileIndexEntry
+{
+  /**
+   * The path of the file within the image file.
+   */
+  std::filesystem::path path;
+
+  /**
+   * The location of the file's data. Depending on the image file format, this is either
+   * the byte offset of the data in the image file or the index of the entry in the image
+   * file's directory.
+   */
+  uint64_t offset = 0;
+
+  /**
+   * The number of bytes stored in the image file.
+   */
+  uint64_t size = 0;
+
+  /**
+   * The number of bytes after decompression. Equal to size for uncompressed files.
+   */
+  uint64_t uncompressedSize = 0;
+
+  /**
+   * The format specific compression method, or 0 if the file is stored uncompressed.
+   */
+  uint32_t compression = 0;
+
+  kdl_reflect_decl(
+    ImageFileIndexEntry, path, offset, size, uncompressedSize, compression);
+};
+
+/**
+ * Identifies a version of an image file by its size and modification time.
+ */
+struct ImageFileStamp
+{
+  uint64_t size = 0;
+  int64_t modificationTime = 0;
+
+  kdl_reflect_decl(ImageFileStamp, size, modificationTime);
+};
+
+/**
+ * Returns the stamp of the file at the given path, or nothing if the file does not exist
+ * or its size or modification time cannot be determined.
+ */
+std::optional<ImageFileStamp> getImageFileStamp(const std::filesystem::path& path);
+
+/**
+ * Stores the directories of image files on the disk so that they don't have to be read
+ * from the image files again.
+ *
+ * Every image file gets a separate index file in the cache directory. An index file
+ * records the stamp of its image file and is ignored once the image file's stamp
+ * changes. Loading an index updates the modification time of its index file, so index
+ * files that have not been used for a while can be removed.
+ */
+class ImageFileIndexCache
+{
+private:
+  std::filesystem::path m_directory;
+
+public:
+  explicit ImageFileIndexCache(std::filesystem::path directory);
+
+  const std::filesystem::path& directory() const;
+
+  /**
+   * Returns the cached directory of the image file at the given path, or nothing if the
+   * cache contains no index for the image file or if the index was stored for a
+   * different stamp.
+   */
+  std::optional<std::vector<ImageFileIndexEntry>> load(
+    const std::filesystem::path& imageFilePath,
+    const ImageFileStamp& imageFileStamp) const;
+
+  /**
+   * Stores the given directory of the image file at the given path, replacing any index
+   * previously stored for it.
+   *
+   * The given stamp must have been taken before the directory was read from the image
+   * file so that the index is never associated with a newer version of the image file.
+   */
+  Result<void> store(
+    const std::filesystem::path& imageFilePath,
+    const ImageFileStamp& imageFileStamp,
+    const std::vector<ImageFileIndexEntry>& entries) const;
+
+  /**
+   * Removes index files that were neither stored nor loaded within the given duration,
+   * and temporary files that were left behind by interrupted stores.
+   */
+  Result<void> removeStaleIndexFiles(std::chrono::hours maxAge) const;
+};
+
+} // namespace tb::io
@@ -25,6 +25,7 @@
 
 #include "kdl/overload.h"
 #include "kdl/path_utils.h"
+#include "kdl/result.h"
 
 #include <fmt/format.h>
 #include <fmt/std.h>
@@ -195,7 +196,12 @@ Result<std::filesystem::path> ImageFileSystemBase::makeAbsolute(
 Result<void> ImageFileSystemBase::reload()
 {
   m_root = ImageDirectoryEntry{{}, {}, {}};
-  return doReadDirectory();
+  return readDirectory() | kdl::transform([&](const auto& entries) {
+           for (const auto& entry : entries)
+           {
+             addFile(entry.path, doMakeGetFile(entry));
+           }
+         });
 }
 
 void ImageFileSystemBase::setMetadata(
@@ -204,6 +210,40 @@ void ImageFileSystemBase::setMetadata(
   m_metadata = std::move(metadata);
 }
 
+void ImageFileSystemBase::setIndexCache(
+  std::shared_ptr<const ImageFileIndexCache> indexCache,
+  std::filesystem::path imageFilePath)
+{
+  m_indexCache = std::move(indexCache);
+  m_imageFilePath = std::move(imageFilePath);
+}
+
+Result<std::vector<ImageFileIndexEntry>> ImageFileSystemBase::readDirectory()
+{
+  // take the stamp before reading the directory so that a concurrent change of the image
+  // file cannot be stored with a directory read from its previous version
+  const auto imageFileStamp =
+    m_indexCache ? getImageFileStamp(m_imageFilePath) : std::nullopt;
+
+  if (imageFileStamp)
+  {
+    if (auto entries = m_indexCache->load(m_imageFilePath, *imageFileStamp))
+    {
+      return std::move(*entries);
+    }
+  }
+
+  return doReadDirectory() | kdl::transform([&](auto entries) {
+           if (imageFileStamp && getImageFileStamp(m_imageFilePath) == imageFileStamp)
+           {
+             // the cache is only an optimization, so failing to update it is not an error
+             m_indexCache->store(m_imageFilePath, *imageFileStamp, entries)
+               | kdl::transform_error([](const auto&) {});
+           }
+           return entries;
+         });
+}
+
 void ImageFileSystemBase::addFile(const std::filesystem::path& path, GetImageFile getFile)
 {
   auto& directoryEntry =
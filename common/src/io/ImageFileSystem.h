@@ -23,6 +23,7 @@
 #include "Result.h"
 #include "io/FileSystem.h"
 #include "io/FileSystemMetadata.h"
+#include "io/ImageFileIndex.h"
 
 #include "kdl/path_hash.h"
 #include "kdl/result.h"
@@ -32,10 +33,10 @@
 #include <memory>
 #include <unordered_map>
 #include <variant>
+#include <vector>
 
 namespace tb::io
 {
-class CFile;
 class File;
 
 using GetImageFile = std::function<Result<std::shared_ptr<File>>()>;
@@ -61,6 +62,8 @@ class ImageFileSystemBase : public FileSystem
 protected:
   ImageEntry m_root;
   std::unordered_map<std::string, FileSystemMetadata> m_metadata;
+  std::shared_ptr<const ImageFileIndexCache> m_indexCache;
+  std::filesystem::path m_imageFilePath;
 
   ImageFileSystemBase();
 
@@ -72,14 +75,28 @@ public:
 
   /**
    * Reload this file system.
+   *
+   * If an index cache is set and contains an up to date index for the image file, the
+   * directory is taken from the cache instead of being read from the image file.
+   * Otherwise, the directory is read from the image file and stored in the cache, unless
+   * the image file changed while its directory was read.
    */
   Result<void> reload();
 
   void setMetadata(std::unordered_map<std::string, FileSystemMetadata> metadata);
 
-protected:
-  void addFile(const std::filesystem::path& path, GetImageFile getFile);
+  /**
+   * Sets the cache to load the directory of the image file from when this file system is
+   * reloaded.
+   *
+   * @param indexCache the index cache
+   * @param imageFilePath the absolute path of the image file on the disk
+   */
+  void setIndexCache(
+    std::shared_ptr<const ImageFileIndexCache> indexCache,
+    std::filesystem::path imageFilePath);
 
+protected:
   PathInfo pathInfo(const std::filesystem::path& path) const override;
 
   const FileSystemMetadata* metadata(
@@ -91,7 +108,18 @@ private:
   Result<std::shared_ptr<File>> doOpenFile(
     const std::filesystem::path& path) const override;
 
-  virtual Result<void> doReadDirectory() = 0;
+  Result<std::vector<ImageFileIndexEntry>> readDirectory();
+  void addFile(const std::filesystem::path& path, GetImageFile getFile);
+
+  /**
+   * Reads the directory of the image file.
+   */
+  virtual Result<std::vector<ImageFileIndexEntry>> doReadDirectory() = 0;
+
+  /**
+   * Returns a function that opens the file described by the given directory entry.
+   */
+  virtual GetImageFile doMakeGetFile(const ImageFileIndexEntry& entry) = 0;
 };
 
 template <typename FileType>
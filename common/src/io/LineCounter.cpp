@@ -0,0 +1,140 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LineCounter.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace tb::io
+{
+namespace
+{
+
+bool isLineEnd(const char* c, const char* end)
+{
+  return *c == '\n' || (*c == '\r' && (c + 1 == end || *(c + 1) != '\n'));
+}
+
+struct LineEnds
+{
+  size_t count = 0;
+  // the first character after the last line end, if count > 0
+  const char* lastLineBegin = nullptr;
+};
+
+/**
+ * Finds the line ends in [first, last). The end pointer is needed to decide whether a
+ * carriage return is followed by a line feed.
+ */
+LineEnds findLineEnds(const char* first, const char* last, const char* end)
+{
+  auto result = LineEnds{};
+  if (first == last)
+  {
+    return result;
+  }
+
+  if (std::memchr(first, '\r', size_t(last - first)) == nullptr)
+  {
+    // the common case, std::count and std::find are vectorized by the compiler
+    result.count = size_t(std::count(first, last, '\n'));
+    if (result.count > 0)
+    {
+      const auto rlast = std::find(
+        std::make_reverse_iterator(last), std::make_reverse_iterator(first), '\n');
+      result.lastLineBegin = rlast.base();
+    }
+    return result;
+  }
+
+  for (const auto* c = first; c != last; ++c)
+  {
+    if (isLineEnd(c, end))
+    {
+      ++result.count;
+      result.lastLineBegin = c + 1;
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+LineCounter::LineCounter(
+  const std::string_view str, const size_t line, const size_t column)
+  : m_str{str}
+  , m_first{0, line, column}
+  , m_last{m_first}
+{
+}
+
+void LineCounter::reset(
+  const std::string_view str, const size_t line, const size_t column)
+{
+  m_str = str;
+  m_first = {0, line, column};
+  m_last = m_first;
+}
+
+void LineCounter::setLocation(const size_t offset, const size_t line, const size_t column)
+{
+  m_last = {std::min(offset, m_str.size()), line, column};
+}
+
+FileLocation LineCounter::location(size_t offset) const
+{
+  offset = std::min(offset, m_str.size());
+
+  const auto* begin = m_str.data();
+  const auto* end = begin + m_str.size();
+  const auto* ptr = begin + offset;
+
+  if (offset >= m_last.offset)
+  {
+    const auto lineEnds = findLineEnds(begin + m_last.offset, ptr, end);
+    m_last = lineEnds.count == 0
+               ? Checkpoint{offset, m_last.line, m_last.column + offset - m_last.offset}
+               : Checkpoint{
+                   offset,
+                   m_last.line + lineEnds.count,
+                   size_t(ptr - lineEnds.lastLineBegin) + 1};
+  }
+  else
+  {
+    const auto lineEnds = findLineEnds(ptr, begin + m_last.offset, end);
+    const auto line = m_last.line - std::min(lineEnds.count, m_last.line - 1);
+
+    // scan backwards for the beginning of the line
+    const auto* lineBegin = ptr;
+    while (lineBegin != begin && !isLineEnd(lineBegin - 1, end))
+    {
+      --lineBegin;
+    }
+
+    const auto column = lineBegin == begin && line == m_first.line
+                          ? m_first.column + offset
+                          : size_t(ptr - lineBegin) + 1;
+    m_last = Checkpoint{offset, line, column};
+  }
+
+  return {m_last.line, m_last.column};
+}
+
+} // namespace tb::io
@@ -0,0 +1,77 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FileLocation.h"
+
+#include <cstddef>
+#include <string_view>
+
+namespace tb::io
+{
+
+/**
+ * Computes the line and column of an offset into a string on demand.
+ *
+ * The location of the most recently queried offset is cached, and a query only scans the
+ * characters between the queried offset and the cached one. Since tokenizers mostly ask
+ * for locations in ascending order, the string is scanned about once in total no matter
+ * how many locations are queried.
+ *
+ * A line ends with a line feed, a carriage return followed by a line feed, or a carriage
+ * return that is not followed by a line feed.
+ */
+class LineCounter
+{
+private:
+  struct Checkpoint
+  {
+    size_t offset;
+    size_t line;
+    size_t column;
+  };
+
+  std::string_view m_str;
+  Checkpoint m_first;
+  mutable Checkpoint m_last;
+
+public:
+  explicit LineCounter(std::string_view str, size_t line = 1, size_t column = 1);
+
+  /**
+   * Resets this line counter to the given string, which begins at the given line and
+   * column.
+   */
+  void reset(std::string_view str, size_t line = 1, size_t column = 1);
+
+  /**
+   * Records that the given offset is at the given line and column. Subsequent queries
+   * are computed relative to this location.
+   */
+  void setLocation(size_t offset, size_t line, size_t column);
+
+  /**
+   * Returns the location of the given offset. Offsets past the end of the string are
+   * clamped to the end of the string.
+   */
+  FileLocation location(size_t offset) const;
+};
+
+} // namespace tb::io
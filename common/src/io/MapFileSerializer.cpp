@@ -341,22 +341,20 @@ void MapFileSerializer::doBeginFile(
 
   // serialize brushes to strings in parallel
   using Entry = std::pair<const mdl::Node*, PrecomputedString>;
-  auto tasks = nodesToSerialize | std::views::transform([&](const auto& node) {
-                 return std::function{[&]() {
-                   return std::visit(
-                     kdl::overload(
-                       [&](const mdl::BrushNode* brushNode) {
-                         return Entry{brushNode, writeBrushFaces(brushNode->brush())};
-                       },
-                       [&](const mdl::PatchNode* patchNode) {
-                         return Entry{patchNode, writePatch(patchNode->patch())};
-                       }),
-                     node);
-                 }};
-               });
+  auto entries = taskManager.parallel_transform(nodesToSerialize, [&](const auto& node) {
+    return std::visit(
+      kdl::overload(
+        [&](const mdl::BrushNode* brushNode) {
+          return Entry{brushNode, writeBrushFaces(brushNode->brush())};
+        },
+        [&](const mdl::PatchNode* patchNode) {
+          return Entry{patchNode, writePatch(patchNode->patch())};
+        }),
+      node);
+  });
 
   // render strings and move them into a map
-  for (auto& entry : taskManager.run_tasks_and_wait(std::move(tasks)))
+  for (auto& entry : entries)
   {
     m_nodeToPrecomputedString.insert(std::move(entry));
   }
@@ -22,6 +22,8 @@
 #include "Error.h" // IWYU pragma: keep
 #include "FileLocation.h"
 #include "Uuid.h"
+#include "io/BufferedParserStatus.h"
+#include "io/LineCounter.h"
 #include "io/ParserStatus.h"
 #include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
@@ -46,6 +48,7 @@
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
+#include <algorithm>
 #include <cassert>
 #include <optional>
 #include <ostream>
@@ -68,14 +71,93 @@ auto getFilePosition(const T& info)
   return std::tuple{startLine, lineCount};
 }
 
+/** A substring of a map file that contains one or more complete entities. */
+struct EntityChunk
+{
+  std::string_view str;
+  FileLocation location;
+};
+
+/**
+ * Splits the given string into chunks of consecutive entities such that there are at
+ * most the given number of chunks of roughly equal size. Every chunk but the first begins
+ * at the opening brace of its first entity.
+ */
+std::vector<EntityChunk> makeEntityChunks(
+  const std::string_view str,
+  const std::vector<size_t>& entityOffsets,
+  const size_t maxChunkCount)
+{
+  assert(maxChunkCount > 0);
+
+  const auto minChunkSize = str.size() / maxChunkCount + 1;
+  const auto lineCounter = LineCounter{str};
+
+  auto result = std::vector<EntityChunk>{};
+  auto chunkBegin = size_t(0);
+  for (const auto entityOffset : entityOffsets)
+  {
+    if (entityOffset - chunkBegin >= minChunkSize)
+    {
+      result.push_back(EntityChunk{
+        str.substr(chunkBegin, entityOffset - chunkBegin),
+        lineCounter.location(chunkBegin)});
+      chunkBegin = entityOffset;
+    }
+  }
+  result.push_back(EntityChunk{str.substr(chunkBegin), lineCounter.location(chunkBegin)});
+
+  return result;
+}
+
 } // namespace
 
+/**
+ * Parses a chunk of entities on a worker thread. The object infos recorded by this
+ * reader are moved into the reader that created the chunk, and no nodes are created.
+ */
+class MapReader::EntityChunkReader : public MapReader
+{
+public:
+  EntityChunkReader(
+    const EntityChunk& chunk,
+    const mdl::MapFormat sourceMapFormat,
+    const mdl::MapFormat targetMapFormat,
+    mdl::EntityPropertyConfig entityPropertyConfig)
+    : MapReader{
+        chunk.str,
+        sourceMapFormat,
+        targetMapFormat,
+        std::move(entityPropertyConfig),
+        chunk.location.line,
+        chunk.location.column.value_or(1)}
+  {
+  }
+
+  Result<void> parse(ParserStatus& status) { return parseEntities(status); }
+
+  std::vector<ObjectInfo> releaseObjectInfos() { return std::move(m_objectInfos); }
+
+private:
+  mdl::Node* onWorldNode(std::unique_ptr<mdl::WorldNode>, ParserStatus&) override
+  {
+    return nullptr;
+  }
+
+  void onLayerNode(std::unique_ptr<mdl::Node>, ParserStatus&) override {}
+
+  void onNode(mdl::Node*, std::unique_ptr<mdl::Node>, ParserStatus&) override {}
+};
+
 MapReader::MapReader(
   const std::string_view str,
   const mdl::MapFormat sourceMapFormat,
   const mdl::MapFormat targetMapFormat,
-  mdl::EntityPropertyConfig entityPropertyConfig)
-  : StandardMapParser{str, sourceMapFormat, targetMapFormat}
+  mdl::EntityPropertyConfig entityPropertyConfig,
+  const size_t line,
+  const size_t column)
+  : StandardMapParser{str, sourceMapFormat, targetMapFormat, line, column}
+  , m_str{str}
   , m_entityPropertyConfig{std::move(entityPropertyConfig)}
 {
 }
@@ -84,7 +166,7 @@ Result<void> MapReader::readEntities(
   const vm::bbox3d& worldBounds, ParserStatus& status, kdl::task_manager& taskManager)
 {
   m_worldBounds = worldBounds;
-  return parseEntities(status)
+  return parseEntitiesInParallel(status, taskManager)
          | kdl::transform([&]() { createNodes(status, taskManager); });
 }
 
@@ -199,6 +281,87 @@ void MapReader::onPatch(
 
 // helper methods
 
+/**
+ * Splits the string into chunks of whole entities and parses each chunk with its own
+ * EntityChunkReader. The object infos of the chunks are then appended to m_objectInfos in
+ * file order, and the messages logged while parsing a chunk are passed on to the given
+ * status in the same order.
+ *
+ * Falls back to parsing sequentially if the string cannot be split, e.g. because it is
+ * malformed, or if any chunk cannot be parsed.
+ */
+Result<void> MapReader::parseEntitiesInParallel(
+  ParserStatus& status, kdl::task_manager& taskManager)
+{
+  const auto entityOffsets = taskManager.worker_count() > 0
+                               ? findEntityOffsets(m_str)
+                               : std::optional<std::vector<size_t>>{};
+  if (!entityOffsets || entityOffsets->size() < 2)
+  {
+    return parseEntities(status);
+  }
+
+  const auto chunks =
+    makeEntityChunks(m_str, *entityOffsets, (taskManager.worker_count() + 1) * 4);
+  if (chunks.size() < 2)
+  {
+    return parseEntities(status);
+  }
+
+  struct ChunkResult
+  {
+    Result<void> result = kdl::void_success;
+    std::vector<ObjectInfo> objectInfos;
+    BufferedParserStatus status;
+  };
+
+  auto chunkResults = std::vector<ChunkResult>(chunks.size());
+  taskManager.parallel_for(
+    0,
+    chunks.size(),
+    [&](const size_t i) {
+      auto& chunkResult = chunkResults[i];
+      auto reader = EntityChunkReader{
+        chunks[i], m_sourceMapFormat, m_targetMapFormat, m_entityPropertyConfig};
+      chunkResult.result = reader.parse(chunkResult.status);
+      chunkResult.objectInfos = reader.releaseObjectInfos();
+    },
+    1);
+
+  // parse errors are reported by parsing the entire map again, so that error messages
+  // and error recovery do not depend on how the map was split into chunks
+  if (std::any_of(chunkResults.begin(), chunkResults.end(), [](const auto& chunkResult) {
+        return chunkResult.result.is_error();
+      }))
+  {
+    return parseEntities(status);
+  }
+
+  for (auto& chunkResult : chunkResults)
+  {
+    chunkResult.status.flush(status);
+
+    // parent indices refer to entities within the same chunk
+    const auto indexOffset = m_objectInfos.size();
+    for (auto& objectInfo : chunkResult.objectInfos)
+    {
+      std::visit(
+        kdl::overload(
+          [](EntityInfo&) {},
+          [&](auto& brushOrPatchInfo) {
+            if (brushOrPatchInfo.parentIndex)
+            {
+              *brushOrPatchInfo.parentIndex += indexOffset;
+            }
+          }),
+        objectInfo);
+      m_objectInfos.push_back(std::move(objectInfo));
+    }
+  }
+
+  return kdl::void_success;
+}
+
 namespace
 {
 /** The type of a node's container. */
@@ -641,27 +804,23 @@ std::vector<std::optional<NodeInfo>> createNodesFromObjectInfos(
   kdl::task_manager& taskManager)
 {
   // create nodes in parallel, moving data out of objectInfos
-  // we store optionals in the result vector to make the elements default constructible,
-  // which is a requirement for parallel transform
-  auto tasks = objectInfos | std::views::transform([&](auto& objectInfo) {
-                 return std::function{[&]() -> CreateNodeResult {
-                   return std::visit(
-                     kdl::overload(
-                       [&](MapReader::EntityInfo& entityInfo) {
-                         return createNodeFromEntityInfo(
-                           entityPropertyConfig, std::move(entityInfo), mapFormat);
-                       },
-                       [&](MapReader::BrushInfo& brushInfo) {
-                         return createBrushNode(std::move(brushInfo), worldBounds);
-                       },
-                       [&](MapReader::PatchInfo& patchInfo) {
-                         return createPatchNode(std::move(patchInfo));
-                       }),
-                     objectInfo);
-                 }};
-               });
-
-  auto results = taskManager.run_tasks_and_wait(std::move(tasks));
+  auto results = taskManager.parallel_transform(
+    objectInfos, [&](auto& objectInfo) -> CreateNodeResult {
+      return std::visit(
+        kdl::overload(
+          [&](MapReader::EntityInfo& entityInfo) {
+            return createNodeFromEntityInfo(
+              entityPropertyConfig, std::move(entityInfo), mapFormat);
+          },
+          [&](MapReader::BrushInfo& brushInfo) {
+            return createBrushNode(std::move(brushInfo), worldBounds);
+          },
+          [&](MapReader::PatchInfo& patchInfo) {
+            return createPatchNode(std::move(patchInfo));
+          }),
+        objectInfo);
+    });
+
   return results | std::views::transform([&](auto& createNodeResult) {
            return std::move(createNodeResult)
                   | kdl::transform([&](NodeInfo&& nodeInfo) -> std::optional<NodeInfo> {
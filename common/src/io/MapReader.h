@@ -106,6 +106,9 @@ public: // only public so that helper methods can see these declarations
   using ObjectInfo = std::variant<EntityInfo, BrushInfo, PatchInfo>;
 
 private:
+  class EntityChunkReader;
+
+  std::string_view m_str;
   mdl::EntityPropertyConfig m_entityPropertyConfig;
   vm::bbox3d m_worldBounds;
 
@@ -123,15 +126,22 @@ protected:
    * @param targetMapFormat the format to convert the created objects to
    * @param entityPropertyConfig the entity property config to use
    * if orphaned
+   * @param line the line at which the given string begins in the file
+   * @param column the column at which the given string begins in the file
    */
   MapReader(
     std::string_view str,
     mdl::MapFormat sourceMapFormat,
     mdl::MapFormat targetMapFormat,
-    mdl::EntityPropertyConfig entityPropertyConfig);
+    mdl::EntityPropertyConfig entityPropertyConfig,
+    size_t line = 1,
+    size_t column = 1);
 
   /**
    * Attempts to parse as one or more entities.
+   *
+   * If the string consists of several entities, it is split into chunks of entities which
+   * are parsed in parallel.
    */
   Result<void> readEntities(
     const vm::bbox3d& worldBounds, ParserStatus& status, kdl::task_manager& taskManager);
@@ -182,6 +192,8 @@ protected: // implement MapParser interface
     ParserStatus& status) override;
 
 private: // helper methods
+  Result<void> parseEntitiesInParallel(
+    ParserStatus& status, kdl::task_manager& taskManager);
   void createNodes(ParserStatus& status, kdl::task_manager& taskManager);
 
 private: // subclassing interface - these will be called in the order that nodes should be
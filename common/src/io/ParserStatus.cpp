@@ -95,6 +95,11 @@ void ParserStatus::errorAndThrow(const std::string& str)
   throw ParserException(buildMessage(str));
 }
 
+void ParserStatus::relay(const LogLevel level, const std::string& str)
+{
+  doLog(level, m_prefix.empty() ? str : m_prefix + ": " + str);
+}
+
 void ParserStatus::log(
   const LogLevel level, const FileLocation& location, const std::string& str)
 {
@@ -57,6 +57,13 @@ public:
   void error(const std::string& str);
   [[noreturn]] void errorAndThrow(const std::string& str);
 
+  /**
+   * Logs a message that was built by another parser status without a prefix, e.g. a
+   * message recorded by a BufferedParserStatus. The message is prefixed with this
+   * status' prefix, but no location is appended.
+   */
+  void relay(LogLevel level, const std::string& str);
+
 private:
   void log(LogLevel level, const FileLocation& location, const std::string& str);
   std::string buildMessage(const FileLocation& location, const std::string& str) const;
@@ -161,6 +161,13 @@ public:
   {
   }
 
+  std::shared_ptr<ReaderSource> subSource(
+    const size_t offset, const size_t length) const override
+  {
+    return std::make_shared<OwningBufferReaderSource>(
+      m_buffer, begin() + offset, begin() + offset + length);
+  }
+
   std::shared_ptr<BufferReaderSource> buffer() const override
   {
     return std::make_shared<OwningBufferReaderSource>(m_buffer, begin(), end());
@@ -238,6 +245,13 @@ Reader Reader::from(const CFile& file, const size_t size)
   return Reader{std::make_shared<FileReaderSource>(file, 0, size)};
 }
 
+Reader Reader::from(const MmapFile& file)
+{
+  const auto* begin = file.m_buffer.get();
+  const auto* end = begin + file.m_size;
+  return Reader{std::make_shared<OwningBufferReaderSource>(file.m_buffer, begin, end)};
+}
+
 Reader Reader::from(const char* begin, const char* end)
 {
   return Reader{std::make_shared<BufferReaderSource>(begin, end)};
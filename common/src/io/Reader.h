@@ -31,6 +31,7 @@ namespace tb::io
 class BufferedReader;
 class BufferReaderSource;
 class CFile;
+class MmapFile;
 class ReaderSource;
 
 /**
@@ -64,6 +65,15 @@ public:
    */
   static Reader from(const CFile& file, size_t size);
 
+  /**
+   * Creates a new reader that reads from the mapped memory of the given file. The reader
+   * shares ownership of the mapped memory.
+   *
+   * @param file the file to read from
+   * @return the reader
+   */
+  static Reader from(const MmapFile& file);
+
   /**
    * Creates a new reader that reads from the given memory region.
    *
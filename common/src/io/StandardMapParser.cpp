@@ -20,12 +20,15 @@
 #include "StandardMapParser.h"
 
 #include "FileLocation.h"
+#include "io/CharScanner.h"
 #include "io/ParserStatus.h"
 #include "mdl/BrushFace.h"
 #include "mdl/EntityProperties.h"
 
 #include "vm/vec.h"
 
+#include <algorithm>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -53,16 +56,166 @@ auto tokenNames()
   };
 }
 
-} // namespace
+constexpr auto Whitespace = std::string_view{" \t\n\r"};
+constexpr auto LineEnd = std::string_view{"\n\r"};
 
-const std::string& QuakeMapTokenizer::NumberDelim()
+/**
+ * Returns a pointer to the character following the closing quotation mark of the quoted
+ * string that begins at the given position (after the opening quotation mark). Mirrors
+ * Tokenizer::readQuotedString, including the hack for trailing backslashes, which the
+ * tokenizer applies to every quoted string regardless of where it occurs.
+ */
+const char* skipQuotedString(const char* c, const char* end)
 {
-  static const std::string numberDelim(Whitespace() + ")");
-  return numberDelim;
+  const auto* begin = c;
+  while ((c = findFirstOf(c, end, "\"")) != end)
+  {
+    auto* e = c;
+    while (e != begin && *(e - 1) == '\\')
+    {
+      --e;
+    }
+
+    const auto escaped = (c - e) % 2 == 1;
+    if (!escaped || (c + 1 != end && (c[1] == '\n' || c[1] == '}')))
+    {
+      return c + 1;
+    }
+    ++c;
+  }
+  return end;
+}
+
+/**
+ * Within brushes and patches, a brace that is directly followed by another character
+ * other than a brace starts a material name such as {fence.
+ */
+bool isMaterialName(const char* c, const char* end, const size_t depth)
+{
+  return depth >= 2 && c + 1 != end && Whitespace.find(c[1]) == std::string_view::npos
+         && c[1] != '{' && c[1] != '}';
+}
+
+using TokenTypes = std::vector<QuakeMapToken::Type>;
+
+/**
+ * Checks whether the given token types match the expected types, which may be unions of
+ * token types.
+ */
+bool matches(const TokenTypes& types, const TokenTypes& expectedTypes)
+{
+  return types.size() == expectedTypes.size()
+         && std::equal(
+           types.begin(),
+           types.end(),
+           expectedTypes.begin(),
+           [](const auto type, const auto expectedType) {
+             return (type & expectedType) != 0;
+           });
+}
+
+TokenTypes concat(TokenTypes lhs, const TokenTypes& rhs)
+{
+  lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+  return lhs;
+}
+
+/**
+ * Checks whether a brush face whose material name is followed by tokens of the given
+ * types can be parsed by the given format.
+ */
+bool isCompatibleFace(const mdl::MapFormat format, const TokenTypes& types)
+{
+  using namespace QuakeMapToken;
+
+  static const auto Any = ~(OParenthesis | CBrace | Eof | Comment);
+  static const auto Quake = TokenTypes{Number, Number, Number, Number, Number};
+  static const auto Valve = TokenTypes{
+    OBracket,
+    Number,
+    Number,
+    Number,
+    Number,
+    CBracket,
+    OBracket,
+    Number,
+    Number,
+    Number,
+    Number,
+    CBracket,
+    Number,
+    Number,
+    Number};
+  static const auto Quake2Extra = TokenTypes{Integer, Integer, Number};
+  static const auto DaikatanaColor = TokenTypes{Integer, Integer, Integer};
+
+  switch (format)
+  {
+  case mdl::MapFormat::Standard:
+    return matches(types, Quake);
+  case mdl::MapFormat::Quake2:
+  case mdl::MapFormat::Quake3_Legacy:
+  case mdl::MapFormat::Quake3:
+    return matches(types, Quake) || matches(types, concat(Quake, Quake2Extra));
+  case mdl::MapFormat::Quake2_Valve:
+  case mdl::MapFormat::Quake3_Valve:
+    return matches(types, Valve) || matches(types, concat(Valve, Quake2Extra));
+  case mdl::MapFormat::Valve:
+    return matches(types, Valve);
+  case mdl::MapFormat::Hexen2:
+    return matches(types, Quake) || matches(types, concat(Quake, {Any}));
+  case mdl::MapFormat::Daikatana:
+    return matches(types, Quake) || matches(types, concat(Quake, Quake2Extra))
+           || matches(types, concat(concat(Quake, Quake2Extra), DaikatanaColor));
+  case mdl::MapFormat::Unknown:
+    return false;
+    switchDefault();
+  }
+}
+
+/**
+ * Reads the remainder of a brush face whose opening parenthesis has already been consumed
+ * and returns the types of the tokens following the material name. Returns an empty
+ * optional if the face is followed by a comment, because that would make the result
+ * depend on the parser's lookahead.
+ */
+std::optional<TokenTypes> readFaceTail(QuakeMapTokenizer& tokenizer)
+{
+  using namespace QuakeMapToken;
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    if (i > 0)
+    {
+      tokenizer.nextToken(OParenthesis);
+    }
+    tokenizer.nextToken(Number);
+    tokenizer.nextToken(Number);
+    tokenizer.nextToken(Number);
+    tokenizer.nextToken(CParenthesis);
+  }
+
+  tokenizer.readAnyString(QuakeMapTokenizer::Whitespace());
+
+  auto types = TokenTypes{};
+  for (auto token = tokenizer.peekToken();
+       !token.hasType(OParenthesis | CBrace | Eof);
+       token = tokenizer.peekToken())
+  {
+    if (token.hasType(Comment))
+    {
+      return std::nullopt;
+    }
+    types.push_back(tokenizer.nextToken().type());
+  }
+  return types;
 }
 
-QuakeMapTokenizer::QuakeMapTokenizer(const std::string_view str)
-  : Tokenizer{tokenNames(), str, "\"", '\\'}
+} // namespace
+
+QuakeMapTokenizer::QuakeMapTokenizer(
+  const std::string_view str, const size_t line, const size_t column)
+  : Tokenizer{tokenNames(), str, "\"", '\\', line, column}
 {
 }
 
@@ -75,9 +228,6 @@ QuakeMapTokenizer::Token QuakeMapTokenizer::emitToken()
 {
   while (!eof())
   {
-    const auto startLine = line();
-    const auto startColumn = column();
-    const auto startLocation = location();
     const auto* c = curPos();
     switch (*c)
     {
@@ -90,7 +240,7 @@ QuakeMapTokenizer::Token QuakeMapTokenizer::emitToken()
         {
           advance();
           return Token{
-            QuakeMapToken::Comment, c, c + 3, offset(c), startLine, startColumn};
+            QuakeMapToken::Comment, c, c + 3, offset(c), lineCounter()};
         }
         discardUntil("\n\r");
       }
@@ -103,29 +253,37 @@ QuakeMapTokenizer::Token QuakeMapTokenizer::emitToken()
       break;
     case '{':
       advance();
-      return Token{QuakeMapToken::OBrace, c, c + 1, offset(c), startLine, startColumn};
+      return Token{QuakeMapToken::OBrace, c, c + 1, offset(c), lineCounter()};
     case '}':
       advance();
-      return Token{QuakeMapToken::CBrace, c, c + 1, offset(c), startLine, startColumn};
+      return Token{QuakeMapToken::CBrace, c, c + 1, offset(c), lineCounter()};
     case '(':
       advance();
       return Token{
-        QuakeMapToken::OParenthesis, c, c + 1, offset(c), startLine, startColumn};
+        QuakeMapToken::OParenthesis, c, c + 1, offset(c), lineCounter()};
     case ')':
       advance();
       return Token{
-        QuakeMapToken::CParenthesis, c, c + 1, offset(c), startLine, startColumn};
+        QuakeMapToken::CParenthesis, c, c + 1, offset(c), lineCounter()};
     case '[':
       advance();
-      return Token{QuakeMapToken::OBracket, c, c + 1, offset(c), startLine, startColumn};
+      return Token{QuakeMapToken::OBracket, c, c + 1, offset(c), lineCounter()};
     case ']':
       advance();
-      return Token{QuakeMapToken::CBracket, c, c + 1, offset(c), startLine, startColumn};
+      return Token{QuakeMapToken::CBracket, c, c + 1, offset(c), lineCounter()};
     case '"': { // quoted string
+      // strings are reported at the location of the opening quote
+      const auto startLocation = lineCounter().location(offset(c));
       advance();
       c = curPos();
       const auto* e = readQuotedString('"', "\n}");
-      return Token{QuakeMapToken::String, c, e, offset(c), startLine, startColumn};
+      return Token{
+        QuakeMapToken::String,
+        c,
+        e,
+        offset(c),
+        startLocation.line,
+        *startLocation.column};
     }
     case '\r':
       if (lookAhead() == '\n')
@@ -139,7 +297,7 @@ QuakeMapTokenizer::Token QuakeMapTokenizer::emitToken()
       if (!m_skipEol)
       {
         advance();
-        return Token{QuakeMapToken::Eol, c, c + 1, offset(c), startLine, startColumn};
+        return Token{QuakeMapToken::Eol, c, c + 1, offset(c), lineCounter()};
       }
       switchFallthrough();
     case ' ':
@@ -149,23 +307,24 @@ QuakeMapTokenizer::Token QuakeMapTokenizer::emitToken()
     default: // whitespace, integer, decimal or word
       if (const auto* e = readInteger(NumberDelim()))
       {
-        return Token{QuakeMapToken::Integer, c, e, offset(c), startLine, startColumn};
+        return Token{QuakeMapToken::Integer, c, e, offset(c), lineCounter()};
       }
 
       if (const auto e = readDecimal(NumberDelim()))
       {
-        return Token{QuakeMapToken::Decimal, c, e, offset(c), startLine, startColumn};
+        return Token{QuakeMapToken::Decimal, c, e, offset(c), lineCounter()};
       }
 
       if (const auto e = readUntil(Whitespace()))
       {
-        return Token{QuakeMapToken::String, c, e, offset(c), startLine, startColumn};
+        return Token{QuakeMapToken::String, c, e, offset(c), lineCounter()};
       }
 
-      throw ParserException{startLocation, fmt::format("Unexpected character: {}", *c)};
+      throw ParserException{
+        lineCounter().location(offset(c)), fmt::format("Unexpected character: {}", *c)};
     }
   }
-  return Token{QuakeMapToken::Eof, nullptr, nullptr, length(), line(), column()};
+  return Token{QuakeMapToken::Eof, nullptr, nullptr, length(), lineCounter()};
 }
 
 const std::string StandardMapParser::BrushPrimitiveId = "brushDef";
@@ -174,8 +333,10 @@ const std::string StandardMapParser::PatchId = "patchDef2";
 StandardMapParser::StandardMapParser(
   const std::string_view str,
   const mdl::MapFormat sourceMapFormat,
-  const mdl::MapFormat targetMapFormat)
-  : m_tokenizer{str}
+  const mdl::MapFormat targetMapFormat,
+  const size_t line,
+  const size_t column)
+  : m_tokenizer{str, line, column}
   , m_sourceMapFormat{sourceMapFormat}
   , m_targetMapFormat{targetMapFormat}
 {
@@ -622,8 +783,6 @@ void StandardMapParser::parseValveFace(ParserStatus& status)
 
 void StandardMapParser::parsePrimitiveFace(ParserStatus& status)
 {
-  /* const auto line = */ m_tokenizer.line();
-
   /* const auto [p1, p2, p3] = */ parseFacePoints(status);
 
   m_tokenizer.nextToken(QuakeMapToken::OParenthesis);
@@ -780,4 +939,195 @@ int StandardMapParser::parseInteger()
   return m_tokenizer.nextToken(QuakeMapToken::Integer).toInteger<int>();
 }
 
+std::optional<std::vector<size_t>> findEntityOffsets(const std::string_view str)
+{
+  const auto* begin = str.data();
+  const auto* end = begin + str.size();
+
+  auto result = std::vector<size_t>{};
+  auto depth = size_t(0);
+
+  const auto* c = findFirstNotOf(begin, end, Whitespace);
+  while (c != end)
+  {
+    switch (*c)
+    {
+    case '/':
+      if (c + 1 != end && c[1] == '/')
+      {
+        if (c + 3 < end && c[2] == '/' && c[3] == ' ')
+        {
+          // a comment token, the remainder of the line is tokenized as usual
+          if (depth == 0)
+          {
+            return std::nullopt;
+          }
+          c += 3;
+        }
+        else
+        {
+          c = findFirstOf(c, end, LineEnd);
+        }
+      }
+      else
+      {
+        ++c;
+      }
+      break;
+    case ';':
+      c = findFirstOf(c, end, LineEnd);
+      break;
+    case '{':
+      if (isMaterialName(c, end, depth))
+      {
+        c = findFirstOf(c, end, Whitespace);
+      }
+      else
+      {
+        if (depth == 0)
+        {
+          result.push_back(size_t(c - begin));
+        }
+        ++depth;
+        ++c;
+      }
+      break;
+    case '}':
+      if (isMaterialName(c, end, depth))
+      {
+        c = findFirstOf(c, end, Whitespace);
+      }
+      else
+      {
+        if (depth == 0)
+        {
+          return std::nullopt;
+        }
+        --depth;
+        ++c;
+      }
+      break;
+    case '"':
+      if (depth == 0)
+      {
+        return std::nullopt;
+      }
+      c = skipQuotedString(c + 1, end);
+      break;
+    case '(':
+    case ')':
+    case '[':
+    case ']':
+      if (depth == 0)
+      {
+        return std::nullopt;
+      }
+      ++c;
+      break;
+    default:
+      if (depth == 0)
+      {
+        return std::nullopt;
+      }
+      c = findFirstOf(c, end, Whitespace);
+      break;
+    }
+
+    c = findFirstNotOf(c, end, Whitespace);
+  }
+
+  if (depth != 0)
+  {
+    return std::nullopt;
+  }
+
+  return result;
+}
+
+const std::string& QuakeMapTokenizer::NumberDelim()
+{
+  static const std::string numberDelim(Whitespace() + ")");
+  return numberDelim;
+}
+
+std::vector<mdl::MapFormat> detectMapFormats(
+  const std::string_view str,
+  const std::vector<mdl::MapFormat>& candidateFormats,
+  const size_t maxFaceCount)
+{
+  using namespace QuakeMapToken;
+
+  auto result = candidateFormats;
+  const auto retainIf = [&](const auto& pred) {
+    std::erase_if(result, [&](const auto format) { return !pred(format); });
+  };
+
+  try
+  {
+    auto tokenizer = QuakeMapTokenizer{str};
+    auto depth = size_t(0);
+    auto faceCount = size_t(0);
+
+    while (faceCount < maxFaceCount && result.size() > 1)
+    {
+      const auto token = tokenizer.nextToken();
+      if (token.hasType(Eof))
+      {
+        break;
+      }
+
+      if (token.hasType(OBrace))
+      {
+        if (++depth == 2)
+        {
+          const auto next = tokenizer.peekToken();
+          if (next.hasType(String) && next.data() == StandardMapParser::BrushPrimitiveId)
+          {
+            // only Quake 3 supports brush primitives, no need to look any further
+            retainIf([](const auto format) { return format == mdl::MapFormat::Quake3; });
+            break;
+          }
+
+          if (next.hasType(String) && next.data() == StandardMapParser::PatchId)
+          {
+            retainIf([](const auto format) {
+              return format == mdl::MapFormat::Quake3
+                     || format == mdl::MapFormat::Quake3_Valve
+                     || format == mdl::MapFormat::Quake3_Legacy;
+            });
+
+            // skip the patch header so that the material name is not tokenized
+            tokenizer.nextToken(String);
+            tokenizer.nextToken(OBrace);
+            tokenizer.readAnyString(QuakeMapTokenizer::Whitespace());
+            ++depth;
+          }
+        }
+      }
+      else if (token.hasType(CBrace))
+      {
+        if (depth == 0)
+        {
+          return candidateFormats;
+        }
+        --depth;
+      }
+      else if (token.hasType(OParenthesis) && depth == 2)
+      {
+        if (const auto types = readFaceTail(tokenizer))
+        {
+          retainIf([&](const auto format) { return isCompatibleFace(format, *types); });
+          ++faceCount;
+        }
+      }
+    }
+  }
+  catch (const ParserException&)
+  {
+    return candidateFormats;
+  }
+
+  return result.empty() ? candidateFormats : result;
+}
+
 } // namespace tb::io
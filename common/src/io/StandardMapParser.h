@@ -29,6 +29,7 @@
 
 #include "vm/vec.h"
 
+#include <optional>
 #include <string_view>
 #include <tuple>
 #include <vector>
@@ -67,7 +68,7 @@ private:
   bool m_skipEol = true;
 
 public:
-  explicit QuakeMapTokenizer(std::string_view str);
+  explicit QuakeMapTokenizer(std::string_view str, size_t line = 1, size_t column = 1);
 
   void setSkipEol(bool skipEol);
 
@@ -77,13 +78,14 @@ private:
 
 class StandardMapParser : public MapParser, public Parser<QuakeMapToken::Type>
 {
+public:
+  static const std::string BrushPrimitiveId;
+  static const std::string PatchId;
+
 private:
   using Token = QuakeMapTokenizer::Token;
   using EntityPropertyKeys = kdl::vector_set<std::string>;
 
-  static const std::string BrushPrimitiveId;
-  static const std::string PatchId;
-
   QuakeMapTokenizer m_tokenizer;
 
 protected:
@@ -98,9 +100,15 @@ public:
    * @param str the string to parse
    * @param sourceMapFormat the expected format of the given string
    * @param targetMapFormat the format to convert the created objects to
+   * @param line the line at which the given string begins in the file
+   * @param column the column at which the given string begins in the file
    */
   StandardMapParser(
-    std::string_view str, mdl::MapFormat sourceMapFormat, mdl::MapFormat targetMapFormat);
+    std::string_view str,
+    mdl::MapFormat sourceMapFormat,
+    mdl::MapFormat targetMapFormat,
+    size_t line = 1,
+    size_t column = 1);
 
   ~StandardMapParser() override;
 
@@ -161,4 +169,30 @@ private:
   int parseInteger();
 };
 
+/**
+ * Finds the offsets of the opening braces of the top level entities in the given string.
+ * Comments and quoted strings are skipped in the same way as QuakeMapTokenizer skips
+ * them, so braces within them are not counted.
+ *
+ * Returns an empty optional if the given string contains anything but comments and
+ * balanced entities at the top level. Such a string must be parsed sequentially in order
+ * to report the error.
+ */
+std::optional<std::vector<size_t>> findEntityOffsets(std::string_view str);
+
+/**
+ * Inspects the first brushes and patches in the given string and returns those of the
+ * given candidate formats which can parse them, in the order in which they were given.
+ * At most the given number of brush faces are inspected.
+ *
+ * The candidate formats are returned unchanged if the inspected objects are compatible
+ * with none of them, or if the string cannot be inspected, e.g. because it is malformed
+ * or contains no brushes. A format is only excluded if parsing the string with that
+ * format would certainly fail.
+ */
+std::vector<mdl::MapFormat> detectMapFormats(
+  std::string_view str,
+  const std::vector<mdl::MapFormat>& candidateFormats,
+  size_t maxFaceCount = 16);
+
 } // namespace tb::io
@@ -68,6 +68,16 @@ std::filesystem::path userDataDirectory()
 #endif
 }
 
+std::filesystem::path cacheDirectory()
+{
+  if (isPortable())
+  {
+    return appDirectory() / "cache";
+  }
+  return io::pathFromQString(
+    QStandardPaths::writableLocation(QStandardPaths::CacheLocation));
+}
+
 std::filesystem::path tempDirectory()
 {
   return io::pathFromQString(
@@ -41,6 +41,12 @@ std::filesystem::path appDirectory();
  */
 std::filesystem::path userDataDirectory();
 
+/**
+ * Returns the directory where cached data should be written
+ * e.g. `C:\\Users\\<user>\\AppData\\Local\\TrenchBroom\\cache`
+ */
+std::filesystem::path cacheDirectory();
+
 std::filesystem::path tempDirectory();
 
 std::filesystem::path logFilePath();
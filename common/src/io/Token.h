@@ -20,11 +20,13 @@
 #pragma once
 
 #include "FileLocation.h"
+#include "io/LineCounter.h"
 
 #include "kdl/string_utils.h"
 
 #include <cassert>
 #include <string>
+#include <string_view>
 
 namespace tb::io
 {
@@ -39,6 +41,7 @@ private:
   size_t m_position = 0;
   size_t m_line = 0;
   size_t m_column = 0;
+  const LineCounter* m_lineCounter = nullptr;
 
 public:
   TokenTemplate() = default;
@@ -60,6 +63,25 @@ public:
     assert(end >= begin);
   }
 
+  /**
+   * Creates a token whose line and column are computed by the given line counter when
+   * they are requested. The line counter must outlive the token.
+   */
+  TokenTemplate(
+    const Type type,
+    const char* begin,
+    const char* end,
+    const size_t position,
+    const LineCounter& lineCounter)
+    : m_type{type}
+    , m_begin{begin}
+    , m_end{end}
+    , m_position{position}
+    , m_lineCounter{&lineCounter}
+  {
+    assert(end >= begin);
+  }
+
   Type type() const { return m_type; }
 
   bool hasType(const Type typeMask) const { return (m_type & typeMask) != 0; }
@@ -74,23 +96,30 @@ public:
 
   size_t length() const { return static_cast<size_t>(m_end - m_begin); }
 
-  size_t line() const { return m_line; }
+  size_t line() const { return location().line; }
 
-  size_t column() const { return m_column; }
+  size_t column() const { return *location().column; }
 
-  FileLocation location() const { return FileLocation{m_line, m_column}; }
+  FileLocation location() const
+  {
+    return m_lineCounter ? m_lineCounter->location(m_position)
+                         : FileLocation{m_line, m_column};
+  }
 
   template <typename T>
   T toFloat() const
   {
-    return static_cast<T>(kdl::str_to_double(std::string(m_begin, m_end)).value_or(0.0));
+    return static_cast<T>(kdl::str_to_double(view()).value_or(0.0));
   }
 
   template <typename T>
   T toInteger() const
   {
-    return static_cast<T>(kdl::str_to_long(std::string(m_begin, m_end)).value_or(0l));
+    return static_cast<T>(kdl::str_to_long(view()).value_or(0l));
   }
+
+private:
+  std::string_view view() const { return std::string_view{m_begin, length()}; }
 };
 
 } // namespace tb::io
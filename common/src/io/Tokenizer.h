@@ -21,6 +21,8 @@
 
 #include "Macros.h"
 #include "Token.h"
+#include "io/CharScanner.h"
+#include "io/LineCounter.h"
 #include "io/ParserException.h"
 
 #include "kdl/range_to_vector.h"
@@ -29,6 +31,7 @@
 #include <fmt/format.h>
 
 #include <cassert>
+#include <cstring>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -52,6 +55,16 @@ struct TokenizerStateAndSource
   const char* end;
 };
 
+/**
+ * The position of a tokenizer. Unlike TokenizerState, this does not contain the line and
+ * column, which are computed on demand by the tokenizer's line counter.
+ */
+struct TokenizerPosition
+{
+  const char* cur;
+  bool escaped;
+};
+
 class TokenizerBase
 {
 protected:
@@ -59,7 +72,8 @@ protected:
   const char* m_end;
   std::string m_escapableChars;
   char m_escapeChar;
-  TokenizerState m_state;
+  TokenizerPosition m_state;
+  LineCounter m_lineCounter;
 
 public:
   TokenizerBase(
@@ -73,7 +87,8 @@ public:
     , m_end{end}
     , m_escapableChars{escapableChars}
     , m_escapeChar{escapeChar}
-    , m_state{begin, line, column, false}
+    , m_state{begin, false}
+    , m_lineCounter{std::string_view{begin, size_t(end - begin)}, line, column}
   {
   }
 
@@ -87,16 +102,19 @@ public:
 
   TokenizerStateAndSource snapshotStateAndSource() const
   {
-    return {m_state, m_begin, m_end};
+    return {snapshot(), m_begin, m_end};
   }
 
   void restoreStateAndSource(const TokenizerStateAndSource& snapshot)
   {
-    m_state = snapshot.state;
     m_begin = snapshot.begin;
     m_end = snapshot.end;
+    m_lineCounter.reset(std::string_view{m_begin, size_t(m_end - m_begin)});
+    restore(snapshot.state);
   }
 
+  const LineCounter& lineCounter() const { return m_lineCounter; }
+
 protected:
   /**
    * Returns current character; caller must ensure eof() is false before calling.
@@ -131,38 +149,45 @@ protected:
 
   void advance(size_t offset)
   {
-    for (size_t i = 0; i < offset; ++i)
+    if (offset > size_t(m_end - m_state.cur))
     {
-      advance();
+      advanceTo(m_end);
+      errorIfEof();
     }
+    advanceTo(m_state.cur + offset);
   }
 
   void advance()
   {
     errorIfEof();
 
-    switch (curChar())
+    m_state.escaped = curChar() == m_escapeChar && !m_state.escaped;
+    ++m_state.cur;
+  }
+
+  /**
+   * Advances to the given position, which must not be before the current position or
+   * after the end of the input. The escaped flag is updated as if advance had been
+   * called for every skipped character, but line and column are not tracked here, so this
+   * is as fast as moving a pointer.
+   */
+  void advanceTo(const char* ptr)
+  {
+    assert(ptr >= m_state.cur);
+    assert(ptr <= m_end);
+
+    // only the trailing run of escape characters determines whether we are escaped
+    const auto* c = ptr;
+    while (c != m_state.cur && *(c - 1) == m_escapeChar)
     {
-    case '\r':
-      if (lookAhead() == '\n')
-      {
-        ++m_state.column;
-        break;
-      }
-      // handle carriage return without consecutive line feed
-      // by falling through into the line feed case
-      switchFallthrough();
-    case '\n':
-      ++m_state.line;
-      m_state.column = 1;
-      m_state.escaped = false;
-      break;
-    default:
-      ++m_state.column;
-      m_state.escaped = curChar() == m_escapeChar ? !m_state.escaped : false;
-      break;
+      --c;
     }
-    ++m_state.cur;
+
+    const auto trailingEscapeChars = size_t(ptr - c);
+    const auto oddEscapeChars = trailingEscapeChars % 2 == 1;
+    m_state.escaped =
+      c == m_state.cur ? m_state.escaped != oddEscapeChars : oddEscapeChars;
+    m_state.cur = ptr;
   }
 
   void errorIfEof() const
@@ -173,26 +198,32 @@ protected:
     }
   }
 
-  TokenizerState snapshot() const { return m_state; }
+  TokenizerState snapshot() const
+  {
+    const auto location = this->location();
+    return {m_state.cur, location.line, *location.column, m_state.escaped};
+  }
 
-  void restore(const TokenizerState& snapshot) { m_state = snapshot; }
+  void restore(const TokenizerState& snapshot)
+  {
+    m_state = {snapshot.cur, snapshot.escaped};
+    m_lineCounter.setLocation(offset(snapshot.cur), snapshot.line, snapshot.column);
+  }
 
 public:
   bool eof() const { return eof(m_state.cur); }
 
-  size_t line() const { return m_state.line; }
+  size_t line() const { return location().line; }
 
-  size_t column() const { return m_state.column; }
+  size_t column() const { return *location().column; }
 
-  FileLocation location() const { return {line(), column()}; }
+  FileLocation location() const { return m_lineCounter.location(offset(m_state.cur)); }
 
 public:
   void reset()
   {
-    m_state.cur = m_begin;
-    m_state.line = 1;
-    m_state.column = 1;
-    m_state.escaped = false;
+    m_state = {m_begin, false};
+    m_lineCounter.reset(std::string_view{m_begin, size_t(m_end - m_begin)});
   }
 
   void adoptState(const TokenizerState& state)
@@ -201,8 +232,7 @@ public:
     assert(state.cur <= m_end);
 
     m_state.cur = state.cur;
-    m_state.line = state.line;
-    m_state.column = state.column;
+    m_lineCounter.setLocation(offset(state.cur), state.line, state.column);
     // m_state.escaped is not updated
   }
 };
@@ -218,11 +248,11 @@ private:
   class SaveAndRestoreState
   {
   private:
-    TokenizerState& m_target;
-    TokenizerState m_snapshot;
+    TokenizerPosition& m_target;
+    TokenizerPosition m_snapshot;
 
   public:
-    explicit SaveAndRestoreState(TokenizerState& target)
+    explicit SaveAndRestoreState(TokenizerPosition& target)
       : m_target{target}
       , m_snapshot{target}
     {
@@ -388,9 +418,9 @@ public:
   std::string_view remainder() const { return std::string_view{curPos(), length()}; }
 
 public:
-  TokenizerState snapshot() const { return m_state; }
+  TokenizerState snapshot() const { return TokenizerBase::snapshot(); }
 
-  void restore(const TokenizerState& snapshot) { m_state = snapshot; }
+  void restore(const TokenizerState& snapshot) { TokenizerBase::restore(snapshot); }
 
 protected:
   const char* curPos() const { return m_state.cur; }
@@ -410,23 +440,21 @@ protected:
 
   const char* readInteger(std::string_view delims)
   {
-    if (curChar() == '+' || curChar() == '-' || isDigit(curChar()))
+    const auto* c = curPos();
+    if (!eof(c) && (*c == '+' || *c == '-'))
     {
-      const auto previousState = m_state;
-      if (curChar() == '+' || curChar() == '-')
-      {
-        advance();
-      }
-      while (!eof() && isDigit(curChar()))
-      {
-        advance();
-      }
-      if (eof() || isAnyOf(curChar(), delims))
-      {
-        return curPos();
-      }
+      ++c;
+    }
+    else if (eof(c) || !isDigit(*c))
+    {
+      return nullptr;
+    }
 
-      m_state = previousState;
+    c = skipDigits(c);
+    if (eof(c) || isAnyOf(*c, delims))
+    {
+      advanceTo(c);
+      return c;
     }
 
     return nullptr;
@@ -434,49 +462,51 @@ protected:
 
   const char* readDecimal(std::string_view delims)
   {
-    if (curChar() == '+' || curChar() == '-' || curChar() == '.' || isDigit(curChar()))
+    const auto* c = curPos();
+    if (eof(c) || !(*c == '+' || *c == '-' || *c == '.' || isDigit(*c)))
     {
-      const auto previousState = m_state;
-      if (curChar() != '.')
-      {
-        advance();
-        readDigits();
-      }
+      return nullptr;
+    }
 
-      if (curChar() == '.')
-      {
-        advance();
-        readDigits();
-      }
+    if (*c != '.')
+    {
+      c = skipDigits(c + 1);
+    }
 
-      if (curChar() == 'e' || curChar() == 'E')
-      {
-        advance();
-        if (curChar() == '+' || curChar() == '-' || isDigit(curChar()))
-        {
-          advance();
-          readDigits();
-        }
-      }
+    if (!eof(c) && *c == '.')
+    {
+      c = skipDigits(c + 1);
+    }
 
-      if (eof() || isAnyOf(curChar(), delims))
+    if (!eof(c) && (*c == 'e' || *c == 'E'))
+    {
+      ++c;
+      if (!eof(c) && (*c == '+' || *c == '-' || isDigit(*c)))
       {
-        return curPos();
+        c = skipDigits(c + 1);
       }
+    }
 
-      m_state = previousState;
+    if (eof(c) || isAnyOf(*c, delims))
+    {
+      advanceTo(c);
+      return c;
     }
 
     return nullptr;
   }
 
 private:
-  void readDigits()
+  const char* skipDigits(const char* c) const { return findFirstNonDigit(c, m_end); }
+
+  const char* skipAnyOf(const char* c, std::string_view allow) const
   {
-    while (!eof() && isDigit(curChar()))
-    {
-      advance();
-    }
+    return findFirstNotOf(c, m_end, allow);
+  }
+
+  const char* skipNoneOf(const char* c, std::string_view delims) const
+  {
+    return findFirstOf(c, m_end, delims);
   }
 
 protected:
@@ -484,32 +514,42 @@ protected:
   {
     if (!eof())
     {
-      do
-      {
-        advance();
-      } while (!eof() && !isAnyOf(curChar(), delims));
+      advanceTo(skipNoneOf(curPos() + 1, delims));
     }
     return curPos();
   }
 
   const char* readWhile(std::string_view allow)
   {
-    while (!eof() && isAnyOf(curChar(), allow))
-    {
-      advance();
-    }
+    advanceTo(skipAnyOf(curPos(), allow));
     return curPos();
   }
 
   const char* readQuotedString(
     const char delim = '"', std::string_view hackDelims = std::string_view{})
   {
-    while (!eof() && (curChar() != delim || isEscaped()))
+    const auto delimIsEscapable = m_escapableChars.find(delim) != std::string::npos;
+
+    while (!eof())
     {
+      const auto* c = static_cast<const char*>(
+        std::memchr(curPos(), delim, size_t(m_end - curPos())));
+      if (c == nullptr)
+      {
+        advanceTo(m_end);
+        break;
+      }
+
+      advanceTo(c);
+      if (!delimIsEscapable || !m_state.escaped)
+      {
+        break;
+      }
+
       // This is a hack to handle paths with trailing backslashes that get misinterpreted
       // as escaped double quotation marks.
       if (
-        !hackDelims.empty() && curChar() == '"' && isEscaped()
+        !hackDelims.empty() && delim == '"'
         && hackDelims.find(lookAhead()) != std::string_view::npos)
       {
         resetEscaped();
@@ -523,21 +563,9 @@ protected:
     return end;
   }
 
-  void discardWhile(std::string_view allow)
-  {
-    while (!eof() && isAnyOf(curChar(), allow))
-    {
-      advance();
-    }
-  }
+  void discardWhile(std::string_view allow) { advanceTo(skipAnyOf(curPos(), allow)); }
 
-  void discardUntil(std::string_view delims)
-  {
-    while (!eof() && !isAnyOf(curChar(), delims))
-    {
-      advance();
-    }
-  }
+  void discardUntil(std::string_view delims) { advanceTo(skipNoneOf(curPos(), delims)); }
 
   bool matchesPattern(std::string_view pattern) const
   {
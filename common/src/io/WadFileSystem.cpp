@@ -54,12 +54,35 @@ namespace WadEntryType
 // static const char WEPalette   = '@';
 }
 
-WadFileSystem::WadFileSystem(std::shared_ptr<CFile> file)
-  : ImageFileSystem{file->buffer()}
+namespace
+{
+
+/**
+ * Reads the given file into memory so that the wad file can be replaced on the disk while
+ * it is mounted.
+ */
+std::shared_ptr<OwningBufferFile> bufferFile(const File& file)
+{
+  try
+  {
+    auto buffer = std::make_unique<char[]>(file.size());
+    file.reader().read(buffer.get(), file.size());
+    return std::make_shared<OwningBufferFile>(std::move(buffer), file.size());
+  }
+  catch (const ReaderException&)
+  {
+    return nullptr;
+  }
+}
+
+} // namespace
+
+WadFileSystem::WadFileSystem(std::shared_ptr<File> file)
+  : ImageFileSystem{bufferFile(*file)}
 {
 }
 
-Result<void> WadFileSystem::doReadDirectory()
+Result<std::vector<ImageFileIndexEntry>> WadFileSystem::doReadDirectory()
 {
   try
   {
@@ -93,6 +116,10 @@ Result<void> WadFileSystem::doReadDirectory()
     }
 
     reader.seekFromBegin(directoryOffset);
+
+    auto entries = std::vector<ImageFileIndexEntry>{};
+    entries.reserve(entryCount);
+
     for (size_t i = 0; i < entryCount; ++i)
     {
       const auto entryAddress = reader.readSize<int32_t>();
@@ -113,19 +140,24 @@ Result<void> WadFileSystem::doReadDirectory()
         continue;
       }
 
-      const auto path = std::filesystem::path{entryName + "." + entryType};
-      auto file_ = std::static_pointer_cast<File>(
-        std::make_shared<FileView>(m_file, entryAddress, entrySize));
-      addFile(path, [file = std::move(file_)]() -> Result<std::shared_ptr<File>> {
-        return file;
-      });
+      auto path = std::filesystem::path{entryName + "." + entryType};
+      entries.push_back(
+        ImageFileIndexEntry{std::move(path), entryAddress, entrySize, entrySize, 0});
     }
 
-    return kdl::void_success;
+    return entries;
   }
   catch (const ReaderException& e)
   {
     return Error{e.what()};
   }
 }
+
+GetImageFile WadFileSystem::doMakeGetFile(const ImageFileIndexEntry& entry)
+{
+  auto file_ = std::static_pointer_cast<File>(
+    std::make_shared<FileView>(m_file, size_t(entry.offset), size_t(entry.size)));
+  return [file = std::move(file_)]() -> Result<std::shared_ptr<File>> { return file; };
+}
+
 } // namespace tb::io
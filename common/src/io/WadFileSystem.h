@@ -22,6 +22,8 @@
 #include "Result.h"
 #include "io/ImageFileSystem.h"
 
+#include <vector>
+
 namespace tb::io
 {
 class FileSystem;
@@ -30,10 +32,11 @@ class OwningBufferFile;
 class WadFileSystem : public ImageFileSystem<OwningBufferFile>
 {
 public:
-  explicit WadFileSystem(std::shared_ptr<CFile> file);
+  explicit WadFileSystem(std::shared_ptr<File> file);
 
 private:
-  Result<void> doReadDirectory() override;
+  Result<std::vector<ImageFileIndexEntry>> doReadDirectory() override;
+  GetImageFile doMakeGetFile(const ImageFileIndexEntry& entry) override;
 };
 
 } // namespace tb::io
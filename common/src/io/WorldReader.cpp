@@ -76,7 +76,9 @@ Result<std::unique_ptr<mdl::WorldNode>> WorldReader::tryRead(
 {
   auto parserErrors = std::vector<std::tuple<mdl::MapFormat, std::string>>{};
 
-  for (const auto mapFormat : mapFormatsToTry)
+  // Only try the formats that can parse the first few brushes. Usually, the first of
+  // these formats parses the entire map, so the map is only parsed once.
+  for (const auto mapFormat : detectMapFormats(str, mapFormatsToTry))
   {
     if (mapFormat == mdl::MapFormat::Unknown)
     {
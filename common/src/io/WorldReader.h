@@ -60,6 +60,9 @@ public:
    * Try to parse the given string as the given map formats, in order.
    * Returns the world if parsing is successful, otherwise returns an error.
    *
+   * Formats that cannot parse the first brushes in the given string are skipped without
+   * parsing the entire string, see detectMapFormats.
+   *
    * @param str the string to parse
    * @param mapFormatsToTry formats to try, in order
    * @param worldBounds world bounds
@@ -20,14 +20,20 @@
 #include "ZipFileSystem.h"
 
 #include "io/File.h"
+#include "io/Reader.h"
+#include "io/ReaderException.h"
 
 #include "kdl/result.h"
 
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <algorithm>
+#include <list>
+#include <map>
 #include <memory>
 #include <string>
+#include <utility>
 
 namespace tb::io
 {
@@ -56,61 +62,248 @@ std::string filename(mz_zip_archive& archive, const mz_uint fileIndex)
 
   return result;
 }
+
+/**
+ * Reads data from the zip file for miniz. Returns the number of bytes read.
+ */
+size_t readZipData(void* opaque, const mz_uint64 offset, void* buffer, const size_t size)
+{
+  const auto& file = *static_cast<const File*>(opaque);
+  if (offset >= file.size())
+  {
+    return 0;
+  }
+
+  try
+  {
+    const auto position = static_cast<size_t>(offset);
+    const auto length = std::min(size, file.size() - position);
+    file.reader().subReaderFromBegin(position, length).read(
+      static_cast<char*>(buffer), length);
+    return length;
+  }
+  catch (const ReaderException&)
+  {
+    return 0;
+  }
+}
+
+/**
+ * A least recently used cache of extracted files that is shared by all zip file systems
+ * so that its size limit applies to all of them together.
+ */
+class ZipFileCache
+{
+private:
+  using Key = std::pair<const ZipFileSystem*, mz_uint>;
+
+  struct Entry
+  {
+    Key key;
+    std::shared_ptr<File> file;
+  };
+
+  std::mutex m_mutex;
+  std::list<Entry> m_entries;
+  std::map<Key, std::list<Entry>::iterator> m_index;
+  size_t m_size = 0;
+
+public:
+  std::shared_ptr<File> find(const ZipFileSystem* owner, const mz_uint fileIndex)
+  {
+    auto lock = std::lock_guard{m_mutex};
+    if (const auto it = m_index.find(Key{owner, fileIndex}); it != m_index.end())
+    {
+      // move the entry to the front of the list to mark it as recently used
+      m_entries.splice(m_entries.begin(), m_entries, it->second);
+      return it->second->file;
+    }
+    return nullptr;
+  }
+
+  void add(
+    const ZipFileSystem* owner, const mz_uint fileIndex, std::shared_ptr<File> file)
+  {
+    const auto fileSize = file->size();
+    if (fileSize > ZipFileSystem::MaxCacheSize / 4)
+    {
+      return;
+    }
+
+    const auto key = Key{owner, fileIndex};
+
+    auto lock = std::lock_guard{m_mutex};
+    if (m_index.contains(key))
+    {
+      // another thread extracted the same file concurrently
+      return;
+    }
+
+    m_entries.push_front(Entry{key, std::move(file)});
+    m_index[key] = m_entries.begin();
+    m_size += fileSize;
+
+    // evict the least recently used files
+    while (m_size > ZipFileSystem::MaxCacheSize)
+    {
+      const auto& leastRecentlyUsed = m_entries.back();
+      m_size -= leastRecentlyUsed.file->size();
+      m_index.erase(leastRecentlyUsed.key);
+      m_entries.pop_back();
+    }
+  }
+
+  void remove(const ZipFileSystem* owner)
+  {
+    auto lock = std::lock_guard{m_mutex};
+    const auto first = m_index.lower_bound(Key{owner, 0});
+    auto last = first;
+    while (last != m_index.end() && last->first.first == owner)
+    {
+      m_size -= last->second->file->size();
+      m_entries.erase(last->second);
+      ++last;
+    }
+    m_index.erase(first, last);
+  }
+};
+
+ZipFileCache& sharedFileCache()
+{
+  static auto cache = ZipFileCache{};
+  return cache;
+}
+
 } // namespace
 
+void ZipFileSystem::ArchiveDeleter::operator()(mz_zip_archive* archive) const
+{
+  mz_zip_reader_end(archive);
+  delete archive;
+}
+
 ZipFileSystem::~ZipFileSystem()
 {
-  mz_zip_reader_end(&m_archive);
+  sharedFileCache().remove(this);
 }
 
-Result<void> ZipFileSystem::doReadDirectory()
+Result<std::vector<ImageFileIndexEntry>> ZipFileSystem::doReadDirectory()
 {
-  mz_zip_zero_struct(&m_archive);
+  using EntriesResult = Result<std::vector<ImageFileIndexEntry>>;
+  return openArchive() | kdl::and_then([&](auto archive) -> EntriesResult {
+           const auto numFiles = mz_zip_reader_get_num_files(archive.get());
+
+           auto entries = std::vector<ImageFileIndexEntry>{};
+           entries.reserve(numFiles);
+
+           for (mz_uint i = 0; i < numFiles; ++i)
+           {
+             auto stat = mz_zip_archive_file_stat{};
+             if (mz_zip_reader_file_stat(archive.get(), i, &stat) && !stat.m_is_directory)
+             {
+               entries.push_back(ImageFileIndexEntry{
+                 std::filesystem::path{filename(*archive, i)},
+                 i,
+                 stat.m_comp_size,
+                 stat.m_uncomp_size,
+                 stat.m_method});
+             }
+           }
+
+           const auto err = mz_zip_get_last_error(archive.get());
+           if (err != MZ_ZIP_NO_ERROR)
+           {
+             return Error{
+               std::string{"Error while reading compressed file: "}
+               + mz_zip_get_error_string(err)};
+           }
+
+           releaseArchive(std::move(archive));
+           return entries;
+         });
+}
 
-  if (mz_zip_reader_init_cfile(&m_archive, m_file->file(), m_file->size(), 0) != MZ_TRUE)
+GetImageFile ZipFileSystem::doMakeGetFile(const ImageFileIndexEntry& entry)
+{
+  // the entry's offset is its index in the archive's central directory
+  return [&, fileIndex = mz_uint(entry.offset), path = entry.path]() {
+    return extractFile(fileIndex, path);
+  };
+}
+
+Result<ZipFileSystem::ArchivePtr> ZipFileSystem::openArchive() const
+{
+  auto archive = ArchivePtr{new mz_zip_archive{}};
+  mz_zip_zero_struct(archive.get());
+
+  archive->m_pRead = readZipData;
+  archive->m_pIO_opaque = m_file.get();
+  if (mz_zip_reader_init(archive.get(), m_file->size(), 0) != MZ_TRUE)
   {
-    return Error{"Error calling mz_zip_reader_init_cfile"};
+    // mz_zip_reader_end does nothing for an archive that failed to initialize
+    return Error{"Error calling mz_zip_reader_init"};
   }
 
-  const auto numFiles = mz_zip_reader_get_num_files(&m_archive);
-  for (mz_uint i = 0; i < numFiles; ++i)
+  return archive;
+}
+
+Result<ZipFileSystem::ArchivePtr> ZipFileSystem::acquireArchive()
+{
   {
-    if (!mz_zip_reader_is_file_a_directory(&m_archive, i))
+    auto lock = std::lock_guard{m_archiveMutex};
+    if (!m_idleArchives.empty())
     {
-      const auto path = std::filesystem::path{filename(m_archive, i)};
-      addFile(path, [&, i, path]() -> Result<std::shared_ptr<File>> {
-        auto loadFileGoard = std::lock_guard{m_mutex};
-
-        auto stat = mz_zip_archive_file_stat{};
-        if (!mz_zip_reader_file_stat(&m_archive, i, &stat))
-        {
-          return Error{fmt::format("mz_zip_reader_file_stat failed for {}", path)};
-        }
-
-        const auto uncompressedSize = static_cast<size_t>(stat.m_uncomp_size);
-        auto data = std::make_unique<char[]>(uncompressedSize);
-        auto* begin = data.get();
-
-        if (!mz_zip_reader_extract_to_mem(&m_archive, i, begin, uncompressedSize, 0))
-        {
-          return Error{fmt::format("mz_zip_reader_extract_to_mem failed for {}", path)};
-        }
-
-        return std::static_pointer_cast<File>(
-          std::make_shared<OwningBufferFile>(std::move(data), uncompressedSize));
-      });
+      auto archive = std::move(m_idleArchives.back());
+      m_idleArchives.pop_back();
+      return archive;
     }
   }
 
-  const auto err = mz_zip_get_last_error(&m_archive);
-  if (err != MZ_ZIP_NO_ERROR)
+  // Every thread that extracts a file concurrently gets its own archive reader.
+  return openArchive();
+}
+
+void ZipFileSystem::releaseArchive(ArchivePtr archive)
+{
+  auto lock = std::lock_guard{m_archiveMutex};
+  m_idleArchives.push_back(std::move(archive));
+}
+
+Result<std::shared_ptr<File>> ZipFileSystem::extractFile(
+  const mz_uint fileIndex, const std::filesystem::path& path)
+{
+  if (auto file = sharedFileCache().find(this, fileIndex))
   {
-    return Error{
-      std::string{"Error while reading compressed file: "}
-      + mz_zip_get_error_string(err)};
+    return file;
   }
 
-  return kdl::void_success;
+  using FileResult = Result<std::shared_ptr<File>>;
+  return acquireArchive() | kdl::and_then([&](auto archive) -> FileResult {
+           auto stat = mz_zip_archive_file_stat{};
+           if (!mz_zip_reader_file_stat(archive.get(), fileIndex, &stat))
+           {
+             releaseArchive(std::move(archive));
+             return Error{fmt::format("mz_zip_reader_file_stat failed for {}", path)};
+           }
+
+           const auto uncompressedSize = static_cast<size_t>(stat.m_uncomp_size);
+           auto data = std::make_unique<char[]>(uncompressedSize);
+           auto* begin = data.get();
+
+           if (!mz_zip_reader_extract_to_mem(
+                 archive.get(), fileIndex, begin, uncompressedSize, 0))
+           {
+             releaseArchive(std::move(archive));
+             return Error{
+               fmt::format("mz_zip_reader_extract_to_mem failed for {}", path)};
+           }
+           releaseArchive(std::move(archive));
+
+           auto file = std::static_pointer_cast<File>(
+             std::make_shared<OwningBufferFile>(std::move(data), uncompressedSize));
+           sharedFileCache().add(this, fileIndex, file);
+           return file;
+         });
 }
 
 } // namespace tb::io
@@ -24,23 +24,53 @@
 
 #include <miniz/miniz.h>
 
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace tb::io
 {
-class CFile;
+class File;
 
-class ZipFileSystem : public ImageFileSystem<CFile>
+/**
+ * A file system that is backed by a zip archive.
+ *
+ * Files can be extracted concurrently. Every extraction uses its own archive reader,
+ * which is taken from a pool of idle readers and returned to it afterwards. Recently
+ * extracted files are kept in a cache that is shared by all zip file systems and limited
+ * by the total size of the cached files.
+ */
+class ZipFileSystem : public ImageFileSystem<File>
 {
 private:
-  mz_zip_archive m_archive;
-  std::mutex m_mutex;
+  struct ArchiveDeleter
+  {
+    void operator()(mz_zip_archive* archive) const;
+  };
+  using ArchivePtr = std::unique_ptr<mz_zip_archive, ArchiveDeleter>;
+
+  std::vector<ArchivePtr> m_idleArchives;
+  std::mutex m_archiveMutex;
 
 public:
+  /**
+   * The maximum total size of the files kept in the cache of all zip file systems, in
+   * bytes.
+   */
+  static constexpr size_t MaxCacheSize = 64 * 1024 * 1024;
+
   using ImageFileSystem::ImageFileSystem;
   ~ZipFileSystem() override;
 
 private:
-  Result<void> doReadDirectory() override;
+  Result<std::vector<ImageFileIndexEntry>> doReadDirectory() override;
+  GetImageFile doMakeGetFile(const ImageFileIndexEntry& entry) override;
+
+  Result<ArchivePtr> openArchive() const;
+  Result<ArchivePtr> acquireArchive();
+  void releaseArchive(ArchivePtr archive);
+
+  Result<std::shared_ptr<File>> extractFile(
+    mz_uint fileIndex, const std::filesystem::path& path);
 };
 } // namespace tb::io
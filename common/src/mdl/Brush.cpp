@@ -38,7 +38,9 @@
 #include "vm/segment.h"
 #include "vm/util.h"
 
+#include <algorithm>
 #include <iterator>
+#include <numeric>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -49,35 +51,15 @@ namespace tb::mdl
 
 kdl_reflect_impl(Brush);
 
-class Brush::CopyCallback : public BrushGeometry::CopyCallback
-{
-public:
-  void faceWasCopied(
-    const BrushFaceGeometry* original, BrushFaceGeometry* copy) const override
-  {
-    copy->setPayload(original->payload());
-  }
-};
-
 Brush::Brush() {}
 
 Brush::Brush(const Brush& other)
   : m_faces{other.m_faces}
-  , m_geometry{
-      other.m_geometry
-        ? std::make_unique<BrushGeometry>(*other.m_geometry, CopyCallback())
-        : nullptr}
+  , m_geometry{other.m_geometry}
 {
-  if (m_geometry)
+  for (size_t i = 0; i < m_faces.size(); ++i)
   {
-    for (BrushFaceGeometry* faceGeometry : m_geometry->faces())
-    {
-      if (const auto faceIndex = faceGeometry->payload())
-      {
-        BrushFace& face = m_faces[*faceIndex];
-        face.setGeometry(faceGeometry);
-      }
-    }
+    m_faces[i].setGeometry(other.m_faces[i].geometry());
   }
 }
 
@@ -160,12 +142,94 @@ Result<void> Brush::updateGeometryFromFaces(const vm::bbox3d& worldBounds)
   return kdl::void_success;
 }
 
+std::unique_ptr<BrushGeometry> Brush::buildGeometryFromFaces(
+  const vm::bbox3d& worldBounds) const
+{
+  // Clip in the order used by updateGeometryFromFaces so that we get the same geometry,
+  // but without moving the faces, which are referred to by their indices.
+  auto clipOrder = std::vector<size_t>(m_faces.size());
+  std::iota(clipOrder.begin(), clipOrder.end(), 0u);
+  std::sort(clipOrder.begin(), clipOrder.end(), [&](const auto lhs, const auto rhs) {
+    return BrushFace::compareBoundaries(m_faces[lhs], m_faces[rhs]);
+  });
+
+  auto geometry = std::make_unique<BrushGeometry>(worldBounds);
+  for (const auto i : clipOrder)
+  {
+    const auto result = geometry->clip(m_faces[i].boundary());
+    if (!result.success())
+    {
+      return nullptr;
+    }
+    result.face()->setPayload(i);
+  }
+
+  geometry->correctVertexPositions();
+  if (!geometry->healEdges() || geometry->faceCount() != m_faces.size())
+  {
+    return nullptr;
+  }
+
+  for (const BrushFaceGeometry* faceGeometry : geometry->faces())
+  {
+    if (!faceGeometry->payload().has_value())
+    {
+      return nullptr;
+    }
+  }
+
+  return geometry;
+}
+
 const vm::bbox3d& Brush::bounds() const
 {
   ensure(m_geometry != nullptr, "geometry is null");
   return m_geometry->bounds();
 }
 
+bool Brush::hasGeometry() const
+{
+  return m_geometry != nullptr;
+}
+
+bool Brush::hasSharedGeometry() const
+{
+  return m_geometry.use_count() > 1;
+}
+
+void Brush::releaseGeometry()
+{
+  for (auto& face : m_faces)
+  {
+    face.setGeometry(nullptr);
+  }
+  m_geometry.reset();
+}
+
+Result<void> Brush::restoreGeometry(const vm::bbox3d& worldBounds)
+{
+  if (m_geometry)
+  {
+    return kdl::void_success;
+  }
+
+  auto geometry = buildGeometryFromFaces(worldBounds);
+  if (!geometry)
+  {
+    return Error{"Brush geometry cannot be restored"};
+  }
+
+  for (BrushFaceGeometry* faceGeometry : geometry->faces())
+  {
+    m_faces[*faceGeometry->payload()].setGeometry(faceGeometry);
+  }
+  m_geometry = std::move(geometry);
+
+  assert(checkFaceLinks());
+
+  return kdl::void_success;
+}
+
 std::optional<size_t> Brush::findFace(const std::string& materialName) const
 {
   return kdl::index_of(m_faces, [&](const BrushFace& face) {
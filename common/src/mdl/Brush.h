@@ -46,8 +46,6 @@ enum class MapFormat;
 class Brush
 {
 private:
-  class CopyCallback;
-
   /**
    * Epsilon value to use when finding a vertex after applying a vertex operation
    */
@@ -59,7 +57,12 @@ public:
 
 private:
   std::vector<BrushFace> m_faces;
-  std::unique_ptr<BrushGeometry> m_geometry;
+
+  /**
+   * The geometry is shared between copies of a brush and must never be modified. Every
+   * operation that changes the geometry replaces it with a new one instead.
+   */
+  std::shared_ptr<BrushGeometry> m_geometry;
 
   kdl_reflect_decl(Brush, m_faces);
 
@@ -82,9 +85,40 @@ private:
 
   Result<void> updateGeometryFromFaces(const vm::bbox3d& worldBounds);
 
+  /**
+   * Builds a geometry from this brush's faces without changing their order. The payload
+   * of each face geometry is set to the index of its face. Returns null if the geometry
+   * does not have exactly one face for every face of this brush.
+   */
+  std::unique_ptr<BrushGeometry> buildGeometryFromFaces(
+    const vm::bbox3d& worldBounds) const;
+
 public:
   const vm::bbox3d& bounds() const;
 
+public: // geometry management
+  bool hasGeometry() const;
+
+  /**
+   * Indicates whether this brush's geometry is shared with a copy of this brush.
+   */
+  bool hasSharedGeometry() const;
+
+  /**
+   * Discards this brush's geometry and keeps only its faces. The brush cannot be used
+   * until its geometry is restored.
+   *
+   * Every brush geometry is built by clipping the faces in the order used by
+   * restoreGeometry, so the restored geometry is the same as the discarded one.
+   */
+  void releaseGeometry();
+
+  /**
+   * Rebuilds this brush's geometry from its faces if it was released, keeping the face
+   * order intact. The given world bounds must be the ones that the brush was built with.
+   */
+  Result<void> restoreGeometry(const vm::bbox3d& worldBounds);
+
 public: // face management:
   std::optional<size_t> findFace(const std::string& materialName) const;
   std::optional<size_t> findFace(const vm::vec3d& normal) const;
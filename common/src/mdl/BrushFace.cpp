@@ -226,6 +226,15 @@ BrushFace::BrushFace(
   ensure(m_uvCoordSystem != nullptr, "uvCoordSystem is null");
 }
 
+bool BrushFace::compareBoundaries(const BrushFace& lhs, const BrushFace& rhs)
+{
+  const auto& lhsBoundary = lhs.boundary();
+  const auto& rhsBoundary = rhs.boundary();
+
+  const auto cmp = vm::compare(lhsBoundary.normal, rhsBoundary.normal);
+  return cmp < 0 ? true : cmp > 0 ? false : lhsBoundary.distance < rhsBoundary.distance;
+}
+
 void BrushFace::sortFaces(std::vector<BrushFace>& faces)
 {
   // Originally, the idea to sort faces came from TxQBSP, but the sorting used there was
@@ -233,13 +242,7 @@ void BrushFace::sortFaces(std::vector<BrushFace>& faces)
   // in which the faces are added to the brush, so I chose to just sort the faces by
   // their normals.
 
-  std::sort(std::begin(faces), std::end(faces), [](const auto& lhs, const auto& rhs) {
-    const auto& lhsBoundary = lhs.boundary();
-    const auto& rhsBoundary = rhs.boundary();
-
-    const auto cmp = vm::compare(lhsBoundary.normal, rhsBoundary.normal);
-    return cmp < 0 ? true : cmp > 0 ? false : lhsBoundary.distance < rhsBoundary.distance;
-  });
+  std::sort(std::begin(faces), std::end(faces), compareBoundaries);
 }
 
 std::unique_ptr<UVCoordSystemSnapshot> BrushFace::takeUVCoordSystemSnapshot() const
@@ -401,7 +404,7 @@ void BrushFace::setAttributes(const BrushFaceAttributes& attributes)
 bool BrushFace::setAttributes(const BrushFace& other)
 {
   auto result = false;
-  result |= m_attributes.setMaterialName(other.attributes().materialName());
+  result |= m_attributes.setMaterialName(other.attributes().internedMaterialName());
   result |= m_attributes.setXOffset(other.attributes().xOffset());
   result |= m_attributes.setYOffset(other.attributes().yOffset());
   result |= m_attributes.setRotation(other.attributes().rotation());
@@ -170,6 +170,11 @@ public:
     BrushFaceAttributes attributes,
     std::unique_ptr<UVCoordSystem> uvCoordSystem);
 
+  /**
+   * Orders faces by their boundary normals and distances. This is the order in which
+   * faces are added to a brush geometry.
+   */
+  static bool compareBoundaries(const BrushFace& lhs, const BrushFace& rhs);
   static void sortFaces(std::vector<BrushFace>& faces);
 
   std::unique_ptr<UVCoordSystemSnapshot> takeUVCoordSystemSnapshot() const;
@@ -51,6 +51,11 @@ BrushFaceAttributes::BrushFaceAttributes(
 kdl_reflect_impl(BrushFaceAttributes);
 
 const std::string& BrushFaceAttributes::materialName() const
+{
+  return m_materialName.str();
+}
+
+const kdl::interned_string& BrushFaceAttributes::internedMaterialName() const
 {
   return m_materialName;
 }
@@ -133,6 +138,11 @@ bool BrushFaceAttributes::valid() const
 }
 
 bool BrushFaceAttributes::setMaterialName(const std::string& materialName)
+{
+  return setMaterialName(kdl::interned_string{materialName});
+}
+
+bool BrushFaceAttributes::setMaterialName(const kdl::interned_string& materialName)
 {
   if (materialName != m_materialName)
   {
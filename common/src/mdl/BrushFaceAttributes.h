@@ -21,6 +21,7 @@
 
 #include "Color.h"
 
+#include "kdl/interned_string.h"
 #include "kdl/reflection_decl.h"
 
 #include "vm/vec.h"
@@ -39,7 +40,7 @@ public:
   static const std::string NoMaterialName;
 
 private:
-  std::string m_materialName;
+  kdl::interned_string m_materialName;
 
   vm::vec2f m_offset = vm::vec2f{0, 0};
   vm::vec2f m_scale = vm::vec2f{1, 1};
@@ -67,6 +68,7 @@ public:
     m_color);
 
   const std::string& materialName() const;
+  const kdl::interned_string& internedMaterialName() const;
 
   const vm::vec2f& offset() const;
   float xOffset() const;
@@ -90,6 +92,7 @@ public:
   bool valid() const;
 
   bool setMaterialName(const std::string& materialName);
+  bool setMaterialName(const kdl::interned_string& materialName);
   bool setOffset(const vm::vec2f& offset);
   bool setXOffset(float xOffset);
   bool setYOffset(float yOffset);
@@ -21,6 +21,8 @@
 
 #include "Color.h"
 
+#include "kdl/interned_string.h"
+
 #include <optional>
 #include <string>
 
@@ -65,7 +67,7 @@ public:
   };
 
 private:
-  std::string m_materialName;
+  kdl::interned_string m_materialName;
   float m_xOffset = 0.0f;
   float m_yOffset = 0.0f;
   float m_rotation = 0.0f;
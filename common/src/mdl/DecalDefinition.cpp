@@ -19,6 +19,7 @@
 
 #include "DecalDefinition.h"
 
+#include "el/CompiledExpression.h"
 #include "el/EvaluationContext.h"
 #include "el/Expression.h"
 #include "el/Types.h"
@@ -61,15 +62,14 @@ DecalSpecification convertToDecal(
 }
 } // namespace
 
-kdl_reflect_impl(DecalSpecification);
-
 DecalDefinition::DecalDefinition()
-  : m_expression{el::LiteralExpression{el::Value::Undefined}}
+  : m_expression{el::ExpressionNode{el::LiteralExpression{el::Value::Undefined}}}
 {
 }
 
 DecalDefinition::DecalDefinition(const FileLocation& location)
-  : m_expression{el::LiteralExpression{el::Value::Undefined}, location}
+  : m_expression{
+      el::ExpressionNode{el::LiteralExpression{el::Value::Undefined}, location}}
 {
 }
 
@@ -80,11 +80,12 @@ DecalDefinition::DecalDefinition(el::ExpressionNode expression)
 
 void DecalDefinition::append(const DecalDefinition& other)
 {
-  const auto location = m_expression.location();
+  const auto location = m_expression.expression().location();
 
-  auto cases =
-    std::vector<el::ExpressionNode>{std::move(m_expression), other.m_expression};
-  m_expression = el::ExpressionNode{el::SwitchExpression{std::move(cases)}, location};
+  auto cases = std::vector<el::ExpressionNode>{
+    m_expression.expression(), other.m_expression.expression()};
+  m_expression = el::CompiledExpression{
+    el::ExpressionNode{el::SwitchExpression{std::move(cases)}, location}};
 }
 
 Result<DecalSpecification> DecalDefinition::decalSpecification(
@@ -102,6 +103,11 @@ Result<DecalSpecification> DecalDefinition::defaultDecalSpecification() const
   return decalSpecification(el::NullVariableStore{});
 }
 
+const std::vector<std::string>& DecalDefinition::referencedVariableNames() const
+{
+  return m_expression.referencedVariableNames();
+}
+
 kdl_reflect_impl(DecalDefinition);
 
 } // namespace tb::mdl
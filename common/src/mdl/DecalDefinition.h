@@ -20,10 +20,15 @@
 #pragma once
 
 #include "Result.h"
+#include "el/CompiledExpression.h"
 #include "el/Expression.h"
+#include "mdl/DecalSpecification.h"
 
 #include "kdl/reflection_decl.h"
 
+#include <string>
+#include <vector>
+
 namespace tb
 {
 struct FileLocation;
@@ -37,17 +42,10 @@ namespace DecalSpecificationKeys
 constexpr auto Material = "texture";
 } // namespace DecalSpecificationKeys
 
-struct DecalSpecification
-{
-  std::string materialName;
-
-  kdl_reflect_decl(DecalSpecification, materialName);
-};
-
 class DecalDefinition
 {
 private:
-  el::ExpressionNode m_expression;
+  el::CompiledExpression m_expression;
 
 public:
   DecalDefinition();
@@ -73,6 +71,12 @@ public:
    */
   Result<DecalSpecification> defaultDecalSpecification() const;
 
+  /**
+   * Returns the sorted names of the variables that the decal expression reads. The
+   * decal specification only depends on the values of these variables.
+   */
+  const std::vector<std::string>& referencedVariableNames() const;
+
   kdl_reflect_decl(DecalDefinition, m_expression);
 };
 
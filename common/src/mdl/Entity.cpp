@@ -19,6 +19,7 @@
 
 #include "Entity.h"
 
+#include "mdl/DecalDefinition.h"
 #include "mdl/EntityDefinition.h"
 #include "mdl/EntityModel.h"
 #include "mdl/EntityProperties.h"
@@ -94,6 +95,7 @@ void Entity::setProperties(std::vector<EntityProperty> properties)
   m_cachedOrigin = std::nullopt;
   m_cachedRotation = std::nullopt;
   m_cachedModelTransformation = std::nullopt;
+  invalidateCachedSpecifications();
 }
 
 const std::vector<std::string>& Entity::protectedProperties() const
@@ -147,6 +149,7 @@ void Entity::setDefinition(const EntityDefinition* definition)
 
   m_cachedRotation = std::nullopt;
   m_cachedModelTransformation = std::nullopt;
+  invalidateCachedSpecifications();
 }
 
 const EntityModel* Entity::model() const
@@ -182,16 +185,24 @@ const EntityModelFrame* Entity::modelFrame() const
 
 Result<ModelSpecification> Entity::modelSpecification() const
 {
-  if (const auto* pointEntityDefinition = getPointEntityDefinition(definition()))
+  if (!m_cachedModelSpecification)
   {
-    const auto variableStore = EntityPropertiesVariableStore{*this};
-    return pointEntityDefinition->modelDefinition.modelSpecification(variableStore);
+    if (const auto* pointEntityDefinition = getPointEntityDefinition(definition()))
+    {
+      const auto variableStore = EntityPropertiesVariableStore{*this};
+      m_cachedModelSpecification =
+        pointEntityDefinition->modelDefinition.modelSpecification(variableStore);
+    }
+    else
+    {
+      m_cachedModelSpecification = ModelSpecification{};
+    }
   }
-  return ModelSpecification{};
+  return *m_cachedModelSpecification;
 }
 
 const vm::mat4x4d& Entity::modelTransformation(
-  const std::optional<el::ExpressionNode>& defaultModelScaleExpression) const
+  const std::optional<el::CompiledExpression>& defaultModelScaleExpression) const
 {
   if (!m_cachedModelTransformation)
   {
@@ -213,12 +224,20 @@ const vm::mat4x4d& Entity::modelTransformation(
 
 Result<DecalSpecification> Entity::decalSpecification() const
 {
-  if (const auto* pointDefinition = getPointEntityDefinition(definition()))
+  if (!m_cachedDecalSpecification)
   {
-    const auto variableStore = EntityPropertiesVariableStore{*this};
-    return pointDefinition->decalDefinition.decalSpecification(variableStore);
+    if (const auto* pointDefinition = getPointEntityDefinition(definition()))
+    {
+      const auto variableStore = EntityPropertiesVariableStore{*this};
+      m_cachedDecalSpecification =
+        pointDefinition->decalDefinition.decalSpecification(variableStore);
+    }
+    else
+    {
+      m_cachedDecalSpecification = DecalSpecification{};
+    }
   }
-  return DecalSpecification{};
+  return *m_cachedDecalSpecification;
 }
 
 void Entity::unsetEntityDefinitionAndModel()
@@ -232,11 +251,14 @@ void Entity::unsetEntityDefinitionAndModel()
   m_model = nullptr;
   m_cachedRotation = std::nullopt;
   m_cachedModelTransformation = std::nullopt;
+  invalidateCachedSpecifications();
 }
 
 void Entity::addOrUpdateProperty(
   std::string key, std::string value, const bool defaultToProtected)
 {
+  invalidateCachedSpecifications(key);
+
   auto it = findEntityProperty(m_properties, key);
   if (it != std::end(m_properties))
   {
@@ -282,6 +304,8 @@ void Entity::renameProperty(const std::string& oldKey, std::string newKey)
       m_properties.erase(newIt);
     }
 
+    invalidateCachedSpecifications(oldKey);
+    invalidateCachedSpecifications(newKey);
     oldIt->setKey(std::move(newKey));
 
     m_cachedClassname = std::nullopt;
@@ -302,6 +326,7 @@ void Entity::removeProperty(const std::string& key)
     m_cachedOrigin = std::nullopt;
     m_cachedRotation = std::nullopt;
     m_cachedModelTransformation = std::nullopt;
+    invalidateCachedSpecifications(key);
   }
 }
 
@@ -317,6 +342,7 @@ void Entity::removeNumberedProperty(const std::string& prefix)
     m_cachedOrigin = std::nullopt;
     m_cachedRotation = std::nullopt;
     m_cachedModelTransformation = std::nullopt;
+    invalidateCachedSpecifications();
   }
 }
 
@@ -468,4 +494,27 @@ void Entity::transform(const vm::mat4x4d& transformation, const bool updateAngle
   }
 }
 
+void Entity::invalidateCachedSpecifications()
+{
+  m_cachedModelSpecification = std::nullopt;
+  m_cachedDecalSpecification = std::nullopt;
+}
+
+void Entity::invalidateCachedSpecifications(const std::string& key)
+{
+  if (const auto* pointDefinition = getPointEntityDefinition(definition()))
+  {
+    if (std::ranges::binary_search(
+          pointDefinition->modelDefinition.referencedVariableNames(), key))
+    {
+      m_cachedModelSpecification = std::nullopt;
+    }
+    if (std::ranges::binary_search(
+          pointDefinition->decalDefinition.referencedVariableNames(), key))
+    {
+      m_cachedDecalSpecification = std::nullopt;
+    }
+  }
+}
+
 } // namespace tb::mdl
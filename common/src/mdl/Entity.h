@@ -22,7 +22,9 @@
 #include "Result.h"
 #include "el/EL_Forward.h" // IWYU pragma: keep
 #include "mdl/AssetReference.h"
+#include "mdl/DecalSpecification.h"
 #include "mdl/EntityProperties.h"
+#include "mdl/ModelSpecification.h"
 
 #include "kdl/reflection_decl.h"
 
@@ -36,12 +38,10 @@
 
 namespace tb::mdl
 {
-struct DecalSpecification;
 class Entity;
 struct EntityDefinition;
 class EntityModel;
 class EntityModelFrame;
-struct ModelSpecification;
 
 enum class SetDefaultPropertyMode
 {
@@ -108,6 +108,14 @@ private:
   mutable std::optional<vm::mat4x4d> m_cachedRotation;
   mutable std::optional<vm::mat4x4d> m_cachedModelTransformation;
 
+  /**
+   * The model and decal specifications only depend on the properties referenced by the
+   * respective definition expression, so they are only invalidated when one of these
+   * properties or the definition changes.
+   */
+  mutable std::optional<Result<ModelSpecification>> m_cachedModelSpecification;
+  mutable std::optional<Result<DecalSpecification>> m_cachedDecalSpecification;
+
 public:
   Entity();
   explicit Entity(std::vector<EntityProperty> properties);
@@ -147,7 +155,7 @@ public: // property management
   const EntityModelFrame* modelFrame() const;
   Result<ModelSpecification> modelSpecification() const;
   const vm::mat4x4d& modelTransformation(
-    const std::optional<el::ExpressionNode>& defaultModelScaleExpression) const;
+    const std::optional<el::CompiledExpression>& defaultModelScaleExpression) const;
 
   Result<DecalSpecification> decalSpecification() const;
 
@@ -181,6 +189,10 @@ public: // property management
   std::vector<EntityProperty> numberedProperties(const std::string& property) const;
 
   void transform(const vm::mat4x4d& transformation, bool updateAngleProperty);
+
+private:
+  void invalidateCachedSpecifications();
+  void invalidateCachedSpecifications(const std::string& key);
 };
 
 } // namespace tb::mdl
@@ -19,6 +19,7 @@ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
 
 #pragma once
 
+#include "flat_octree.h"
 #include "mdl/EntityModelDataResource.h"
 #include "mdl/EntityModel_Forward.h"
 #include "octree.h"
@@ -97,7 +98,11 @@ private:
   // For hit testing
   std::vector<vm::vec3f> m_tris;
   using TriNum = size_t;
+#ifdef TB_ENABLE_FLAT_OCTREE
+  using SpacialTree = flat_octree<float, TriNum>;
+#else
   using SpacialTree = octree<float, TriNum>;
+#endif
   SpacialTree m_spacialTree;
 
   kdl_reflect_decl(EntityModelFrame, m_index, m_name, m_bounds, m_skinOffset);
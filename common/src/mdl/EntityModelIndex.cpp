@@ -0,0 +1,72 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EntityModelIndex.h"
+
+namespace tb::mdl
+{
+
+void EntityModelIndex::setEntityModel(EntityNode* node, const EntityModel* model)
+{
+  removeEntityNode(node);
+  if (model)
+  {
+    m_nodesByModel[model].insert(node);
+    m_modelsByNode[node] = model;
+  }
+}
+
+void EntityModelIndex::removeEntityNode(EntityNode* node)
+{
+  if (const auto iModel = m_modelsByNode.find(node); iModel != m_modelsByNode.end())
+  {
+    if (const auto iNodes = m_nodesByModel.find(iModel->second);
+        iNodes != m_nodesByModel.end())
+    {
+      iNodes->second.erase(node);
+      if (iNodes->second.empty())
+      {
+        m_nodesByModel.erase(iNodes);
+      }
+    }
+    m_modelsByNode.erase(iModel);
+  }
+}
+
+void EntityModelIndex::clear()
+{
+  m_nodesByModel.clear();
+  m_modelsByNode.clear();
+}
+
+std::vector<EntityNode*> EntityModelIndex::findEntityNodes(
+  const std::vector<const EntityModel*>& models) const
+{
+  auto result = std::vector<EntityNode*>{};
+  for (const auto* model : models)
+  {
+    if (const auto iNodes = m_nodesByModel.find(model); iNodes != m_nodesByModel.end())
+    {
+      result.insert(result.end(), iNodes->second.begin(), iNodes->second.end());
+    }
+  }
+  return result;
+}
+
+} // namespace tb::mdl
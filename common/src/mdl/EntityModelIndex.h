@@ -0,0 +1,56 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace tb::mdl
+{
+class EntityModel;
+class EntityNode;
+
+/**
+ * Maps entity models to the entity nodes that use them.
+ *
+ * The index remembers the model under which each node was added, so a node can be
+ * removed even if its entity has been replaced in the meantime.
+ */
+class EntityModelIndex
+{
+private:
+  std::unordered_map<const EntityModel*, std::unordered_set<EntityNode*>> m_nodesByModel;
+  std::unordered_map<EntityNode*, const EntityModel*> m_modelsByNode;
+
+public:
+  /**
+   * Records that the given node uses the given model, replacing the model that was
+   * previously recorded for the node. If the model is null, the node is removed.
+   */
+  void setEntityModel(EntityNode* node, const EntityModel* model);
+  void removeEntityNode(EntityNode* node);
+  void clear();
+
+  std::vector<EntityNode*> findEntityNodes(
+    const std::vector<const EntityModel*>& models) const;
+};
+
+} // namespace tb::mdl
@@ -19,7 +19,7 @@
 
 #pragma once
 
-#include "el/Expression.h"
+#include "el/CompiledExpression.h"
 
 #include "kdl/reflection_decl.h"
 
@@ -81,7 +81,7 @@ extern const std::string LayerOmitFromExportValue;
 
 struct EntityPropertyConfig
 {
-  std::optional<el::ExpressionNode> defaultModelScaleExpression;
+  std::optional<el::CompiledExpression> defaultModelScaleExpression;
   bool setDefaultProperties{false};
   bool updateAnglePropertyAfterTransform{true};
 
@@ -20,7 +20,7 @@
 #pragma once
 
 #include "Color.h"
-#include "el/Expression.h"
+#include "el/CompiledExpression.h"
 #include "mdl/BrushFaceAttributes.h"
 #include "mdl/CompilationConfig.h"
 #include "mdl/GameEngineConfig.h"
@@ -80,7 +80,7 @@ struct EntityConfig
 {
   std::vector<std::filesystem::path> defFilePaths;
   Color defaultColor;
-  std::optional<el::ExpressionNode> scaleExpression;
+  std::optional<el::CompiledExpression> scaleExpression;
   bool setDefaultProperties;
 
   kdl_reflect_decl(
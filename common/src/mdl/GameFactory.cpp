@@ -29,6 +29,7 @@
 #include "io/GameConfigParser.h"
 #include "io/GameEngineConfigParser.h"
 #include "io/GameEngineConfigWriter.h"
+#include "io/ImageFileIndex.h"
 #include "io/PathInfo.h"
 #include "io/TraversalMode.h"
 #include "mdl/Game.h"
@@ -42,6 +43,7 @@
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <chrono>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -53,6 +55,9 @@ namespace tb::mdl
 namespace
 {
 
+// index files that have not been used for this long are removed from the index cache
+constexpr auto MaxIndexFileAge = std::chrono::days{30};
+
 Result<void> migrateConfigFiles(
   const std::filesystem::path& userGameDir, const GameConfig& config)
 {
@@ -93,6 +98,7 @@ void GameFactory::reset()
 {
   m_userGameDir = std::filesystem::path{};
   m_configFs.reset();
+  m_indexCache.reset();
 
   m_names.clear();
   m_configs.clear();
@@ -126,7 +132,8 @@ size_t GameFactory::gameCount() const
 
 std::shared_ptr<Game> GameFactory::createGame(const std::string& gameName, Logger& logger)
 {
-  return std::make_shared<GameImpl>(gameConfig(gameName), gamePath(gameName), logger);
+  return std::make_shared<GameImpl>(
+    gameConfig(gameName), gamePath(gameName), m_indexCache, logger);
 }
 
 std::vector<std::string> GameFactory::fileFormats(const std::string& gameName) const
@@ -244,6 +251,18 @@ Result<void> GameFactory::initializeFileSystem(const GamePathConfig& gamePathCon
     virtualFs.mount({}, std::make_unique<io::DiskFileSystem>(path));
   }
 
+  if (!gamePathConfig.indexCacheDir.empty())
+  {
+    auto indexCache =
+      std::make_shared<io::ImageFileIndexCache>(gamePathConfig.indexCacheDir);
+
+    // the cache is only an optimization, so failing to clean it up is not an error
+    indexCache->removeStaleIndexFiles(MaxIndexFileAge)
+      | kdl::transform_error([](const auto&) {});
+
+    m_indexCache = std::move(indexCache);
+  }
+
   m_userGameDir = userGameDir;
   return io::Disk::createDirectory(m_userGameDir) | kdl::transform([&](auto) {
            m_configFs = std::make_unique<io::WritableVirtualFileSystem>(
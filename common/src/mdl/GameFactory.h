@@ -38,6 +38,7 @@ class Preference;
 
 namespace tb::io
 {
+class ImageFileIndexCache;
 class Path;
 class WritableVirtualFileSystem;
 } // namespace tb::io
@@ -53,6 +54,12 @@ struct GamePathConfig
 {
   std::vector<std::filesystem::path> gameConfigSearchDirs;
   std::filesystem::path userGameDir;
+
+  /**
+   * The directory in which the directories of package and wad files are cached, or an
+   * empty path to disable the cache.
+   */
+  std::filesystem::path indexCacheDir = {};
 };
 
 class GameFactory
@@ -63,6 +70,7 @@ private:
 
   std::filesystem::path m_userGameDir;
   std::unique_ptr<io::WritableVirtualFileSystem> m_configFs;
+  std::shared_ptr<const io::ImageFileIndexCache> m_indexCache;
 
   std::vector<std::string> m_names;
   ConfigMap m_configs;
@@ -24,6 +24,7 @@
 #include "io/DiskIO.h"
 #include "io/DkPakFileSystem.h"
 #include "io/IdPakFileSystem.h"
+#include "io/ImageFileIndex.h"
 #include "io/PathInfo.h"
 #include "io/SystemPaths.h"
 #include "io/TraversalMode.h"
@@ -40,6 +41,12 @@
 namespace tb::mdl
 {
 
+void GameFileSystem::setIndexCache(
+  std::shared_ptr<const io::ImageFileIndexCache> indexCache)
+{
+  m_indexCache = std::move(indexCache);
+}
+
 void GameFileSystem::initialize(
   const GameConfig& config,
   const std::filesystem::path& gamePath,
@@ -123,34 +130,38 @@ void GameFileSystem::addFileSystemPath(const std::filesystem::path& path, Logger
 
 namespace
 {
-Result<std::unique_ptr<io::FileSystem>> createImageFileSystem(
-  const std::string& packageFormat, const std::filesystem::path& path)
+template <typename T>
+Result<std::unique_ptr<io::FileSystem>> openImageFileSystem(
+  const std::filesystem::path& path,
+  const std::shared_ptr<const io::ImageFileIndexCache>& indexCache)
 {
-  const auto setMetadataAndCast = [&](auto fs) {
-    fs->setMetadata(io::makeImageFileSystemMetadata(path));
-    return std::unique_ptr<io::FileSystem>{std::move(fs)};
-  };
+  // image files stay open while they are mounted, so they must not be mapped into memory
+  return io::Disk::openUnmappedFile(path) | kdl::and_then([&](auto file) {
+           auto fs = std::make_unique<T>(std::move(file));
+           fs->setMetadata(io::makeImageFileSystemMetadata(path));
+           fs->setIndexCache(indexCache, path);
+           return fs->reload() | kdl::transform([&]() {
+                    return std::unique_ptr<io::FileSystem>{std::move(fs)};
+                  });
+         });
+}
 
+Result<std::unique_ptr<io::FileSystem>> createImageFileSystem(
+  const std::string& packageFormat,
+  const std::filesystem::path& path,
+  const std::shared_ptr<const io::ImageFileIndexCache>& indexCache)
+{
   if (kdl::ci::str_is_equal(packageFormat, "idpak"))
   {
-    return io::Disk::openFile(path) | kdl::and_then([&](auto file) {
-             return io::createImageFileSystem<io::IdPakFileSystem>(std::move(file));
-           })
-           | kdl::transform(setMetadataAndCast);
+    return openImageFileSystem<io::IdPakFileSystem>(path, indexCache);
   }
   else if (kdl::ci::str_is_equal(packageFormat, "dkpak"))
   {
-    return io::Disk::openFile(path) | kdl::and_then([&](auto file) {
-             return io::createImageFileSystem<io::DkPakFileSystem>(std::move(file));
-           })
-           | kdl::transform(setMetadataAndCast);
+    return openImageFileSystem<io::DkPakFileSystem>(path, indexCache);
   }
   else if (kdl::ci::str_is_equal(packageFormat, "zip"))
   {
-    return io::Disk::openFile(path) | kdl::and_then([&](auto file) {
-             return io::createImageFileSystem<io::ZipFileSystem>(std::move(file));
-           })
-           | kdl::transform(setMetadataAndCast);
+    return openImageFileSystem<io::ZipFileSystem>(path, indexCache);
   }
   return Error{"Unknown package format: " + packageFormat};
 }
@@ -180,7 +191,7 @@ void GameFileSystem::addFileSystemPackages(
                      return diskFS.makeAbsolute(packagePath)
                             | kdl::and_then([&](const auto& absPackagePath) {
                                 return createImageFileSystem(
-                                  packageFormat, absPackagePath);
+                                  packageFormat, absPackagePath, m_indexCache);
                               })
                             | kdl::transform([&](auto fs) {
                                 logger.info()
@@ -205,14 +216,13 @@ void GameFileSystem::mountWads(
   for (const auto& wadPath : wadPaths)
   {
     const auto resolvedWadPath = io::Disk::resolvePath(wadSearchPaths, wadPath);
-    io::Disk::openFile(resolvedWadPath) | kdl::and_then([](auto file) {
-      return io::createImageFileSystem<io::WadFileSystem>(std::move(file));
-    }) | kdl::transform([&](auto fs) {
-      fs->setMetadata(io::makeImageFileSystemMetadata(resolvedWadPath));
-      m_wadMountPoints.push_back(mount(rootPath, std::move(fs)));
-    }) | kdl::transform_error([&](auto e) {
-      logger.error() << "Could not load wad file at '" << wadPath << "': " << e.msg;
-    });
+    openImageFileSystem<io::WadFileSystem>(resolvedWadPath, m_indexCache)
+      | kdl::transform([&](auto fs) {
+          m_wadMountPoints.push_back(mount(rootPath, std::move(fs)));
+        })
+      | kdl::transform_error([&](auto e) {
+          logger.error() << "Could not load wad file at '" << wadPath << "': " << e.msg;
+        });
   }
 }
 
@@ -22,6 +22,7 @@
 #include "io/VirtualFileSystem.h"
 
 #include <filesystem>
+#include <memory>
 #include <vector>
 
 namespace tb
@@ -29,6 +30,11 @@ namespace tb
 class Logger;
 }
 
+namespace tb::io
+{
+class ImageFileIndexCache;
+}
+
 namespace tb::mdl
 {
 struct GameConfig;
@@ -37,8 +43,15 @@ class GameFileSystem : public io::VirtualFileSystem
 {
 private:
   std::vector<io::VirtualMountPointId> m_wadMountPoints;
+  std::shared_ptr<const io::ImageFileIndexCache> m_indexCache;
 
 public:
+  /**
+   * Sets the cache for the directories of the packages and wad files that are mounted
+   * by this file system. Takes effect the next time they are mounted.
+   */
+  void setIndexCache(std::shared_ptr<const io::ImageFileIndexCache> indexCache);
+
   void initialize(
     const GameConfig& config,
     const std::filesystem::path& gamePath,
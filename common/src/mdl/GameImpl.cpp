@@ -51,15 +51,21 @@
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace tb::mdl
 {
-GameImpl::GameImpl(GameConfig& config, std::filesystem::path gamePath, Logger& logger)
+GameImpl::GameImpl(
+  GameConfig& config,
+  std::filesystem::path gamePath,
+  std::shared_ptr<const io::ImageFileIndexCache> indexCache,
+  Logger& logger)
   : m_config{config}
   , m_gamePath{std::move(gamePath)}
 {
+  m_fs.setIndexCache(std::move(indexCache));
   initializeFileSystem(logger);
 }
 
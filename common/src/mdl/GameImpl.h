@@ -24,6 +24,7 @@
 #include "mdl/GameFileSystem.h"
 
 #include <filesystem>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -45,7 +46,17 @@ private:
   std::vector<std::filesystem::path> m_additionalSearchPaths;
 
 public:
-  GameImpl(GameConfig& config, std::filesystem::path gamePath, Logger& logger);
+  /**
+   * Creates a game for the given config and game path.
+   *
+   * The given index cache is used to cache the directories of the game's packages and wad
+   * files and may be null to disable caching.
+   */
+  GameImpl(
+    GameConfig& config,
+    std::filesystem::path gamePath,
+    std::shared_ptr<const io::ImageFileIndexCache> indexCache,
+    Logger& logger);
 
 public: // implement EntityDefinitionLoader interface:
   Result<std::vector<EntityDefinition>> loadEntityDefinitions(
@@ -278,45 +278,43 @@ Result<std::vector<std::unique_ptr<Node>>> cloneAndTransformChildren(
 
   // In parallel, produce pairs { node pointer, transformed contents } from the nodes in
   // `nodesToClone`
-  auto tasks =
-    nodesToClone | std::views::transform([&](const auto& nodeToTransform) {
-      return std::function{[&]() {
-        return nodeToTransform->accept(kdl::overload(
-          [](const WorldNode*) -> TransformResult {
-            ensure(false, "Linked group structure is valid");
-          },
-          [](const LayerNode*) -> TransformResult {
-            ensure(false, "Linked group structure is valid");
-          },
-          [&](const GroupNode* groupNode) -> TransformResult {
-            auto group = groupNode->group();
-            group.transform(transformation);
-            return std::make_pair(nodeToTransform, NodeContents{std::move(group)});
-          },
-          [&](const EntityNode* entityNode) -> TransformResult {
-            const auto updateAngleProperty =
-              entityNode->entityPropertyConfig().updateAnglePropertyAfterTransform;
-            auto entity = entityNode->entity();
-            entity.transform(transformation, updateAngleProperty);
-            return std::make_pair(nodeToTransform, NodeContents{std::move(entity)});
-          },
-          [&](const BrushNode* brushNode) -> TransformResult {
-            auto brush = brushNode->brush();
-            return brush.transform(worldBounds, transformation, true)
-                   | kdl::and_then([&]() -> TransformResult {
-                       return std::make_pair(
-                         nodeToTransform, NodeContents{std::move(brush)});
-                     });
-          },
-          [&](const PatchNode* patchNode) -> TransformResult {
-            auto patch = patchNode->patch();
-            patch.transform(transformation);
-            return std::make_pair(nodeToTransform, NodeContents{std::move(patch)});
-          }));
-      }};
+  auto transformResults =
+    taskManager.parallel_transform(nodesToClone, [&](const auto& nodeToTransform) {
+      return nodeToTransform->accept(kdl::overload(
+        [](const WorldNode*) -> TransformResult {
+          ensure(false, "Linked group structure is valid");
+        },
+        [](const LayerNode*) -> TransformResult {
+          ensure(false, "Linked group structure is valid");
+        },
+        [&](const GroupNode* groupNode) -> TransformResult {
+          auto group = groupNode->group();
+          group.transform(transformation);
+          return std::make_pair(nodeToTransform, NodeContents{std::move(group)});
+        },
+        [&](const EntityNode* entityNode) -> TransformResult {
+          const auto updateAngleProperty =
+            entityNode->entityPropertyConfig().updateAnglePropertyAfterTransform;
+          auto entity = entityNode->entity();
+          entity.transform(transformation, updateAngleProperty);
+          return std::make_pair(nodeToTransform, NodeContents{std::move(entity)});
+        },
+        [&](const BrushNode* brushNode) -> TransformResult {
+          auto brush = brushNode->brush();
+          return brush.transform(worldBounds, transformation, true)
+                 | kdl::and_then([&]() -> TransformResult {
+                     return std::make_pair(
+                       nodeToTransform, NodeContents{std::move(brush)});
+                   });
+        },
+        [&](const PatchNode* patchNode) -> TransformResult {
+          auto patch = patchNode->patch();
+          patch.transform(transformation);
+          return std::make_pair(nodeToTransform, NodeContents{std::move(patch)});
+        }));
     });
 
-  return taskManager.run_tasks_and_wait(tasks) | kdl::fold
+  return std::move(transformResults) | kdl::fold
          | kdl::or_else(
            [](const auto&) -> Result<std::vector<std::pair<const Node*, NodeContents>>> {
              return Error{"Failed to transform a linked node"};
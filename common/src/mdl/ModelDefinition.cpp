@@ -19,6 +19,7 @@
 
 #include "ModelDefinition.h"
 
+#include "el/CompiledExpression.h"
 #include "el/ELExceptions.h"
 #include "el/EvaluationContext.h"
 #include "el/Expression.h"
@@ -142,12 +143,13 @@ std::optional<vm::vec3d> convertToScale(
 } // namespace
 
 ModelDefinition::ModelDefinition()
-  : m_expression{el::LiteralExpression{el::Value::Undefined}}
+  : m_expression{el::ExpressionNode{el::LiteralExpression{el::Value::Undefined}}}
 {
 }
 
 ModelDefinition::ModelDefinition(const FileLocation& location)
-  : m_expression{el::LiteralExpression{el::Value::Undefined}, location}
+  : m_expression{
+      el::ExpressionNode{el::LiteralExpression{el::Value::Undefined}, location}}
 {
 }
 
@@ -158,10 +160,11 @@ ModelDefinition::ModelDefinition(el::ExpressionNode expression)
 
 void ModelDefinition::append(ModelDefinition other)
 {
-  const auto location = m_expression.location();
+  const auto location = m_expression.expression().location();
 
-  auto cases = std::vector{std::move(m_expression), std::move(other.m_expression)};
-  m_expression = el::ExpressionNode{el::SwitchExpression{std::move(cases)}, location};
+  auto cases = std::vector{m_expression.expression(), other.m_expression.expression()};
+  m_expression = el::CompiledExpression{
+    el::ExpressionNode{el::SwitchExpression{std::move(cases)}, location}};
 }
 
 Result<ModelSpecification> ModelDefinition::modelSpecification(
@@ -181,9 +184,14 @@ Result<ModelSpecification> ModelDefinition::defaultModelSpecification() const
   });
 }
 
+const std::vector<std::string>& ModelDefinition::referencedVariableNames() const
+{
+  return m_expression.referencedVariableNames();
+}
+
 Result<vm::vec3d> ModelDefinition::scale(
   const el::VariableStore& variableStore,
-  const std::optional<el::ExpressionNode>& defaultScaleExpression) const
+  const std::optional<el::CompiledExpression>& defaultScaleExpression) const
 {
   return el::withEvaluationContext(
     [&](auto& context) {
@@ -228,7 +236,7 @@ kdl_reflect_impl(ModelDefinition);
 vm::vec3d safeGetModelScale(
   const ModelDefinition& definition,
   const el::VariableStore& variableStore,
-  const std::optional<el::ExpressionNode>& defaultScaleExpression)
+  const std::optional<el::CompiledExpression>& defaultScaleExpression)
 {
   return definition.scale(variableStore, defaultScaleExpression)
     .value_or(vm::vec3d{1, 1, 1});
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Result.h"
+#include "el/CompiledExpression.h"
 #include "el/Expression.h"
 #include "mdl/ModelSpecification.h"
 
@@ -28,6 +29,8 @@
 #include "vm/vec.h"
 
 #include <optional>
+#include <string>
+#include <vector>
 
 namespace tb
 {
@@ -48,7 +51,7 @@ constexpr auto Scale = "scale";
 class ModelDefinition
 {
 private:
-  el::ExpressionNode m_expression;
+  el::CompiledExpression m_expression;
 
 public:
   ModelDefinition();
@@ -85,7 +88,13 @@ public:
    */
   Result<vm::vec3d> scale(
     const el::VariableStore& variableStore,
-    const std::optional<el::ExpressionNode>& defaultScaleExpression) const;
+    const std::optional<el::CompiledExpression>& defaultScaleExpression) const;
+
+  /**
+   * Returns the sorted names of the variables that the model expression reads. The
+   * model specification only depends on the values of these variables.
+   */
+  const std::vector<std::string>& referencedVariableNames() const;
 
   kdl_reflect_decl(ModelDefinition, m_expression);
 };
@@ -97,6 +106,6 @@ public:
 vm::vec3d safeGetModelScale(
   const ModelDefinition& definition,
   const el::VariableStore& variableStore,
-  const std::optional<el::ExpressionNode>& defaultScaleExpression);
+  const std::optional<el::CompiledExpression>& defaultScaleExpression);
 
 } // namespace tb::mdl
@@ -24,9 +24,14 @@
 #include "mdl/BrushFaceHandle.h"
 #include "mdl/EditorContext.h"
 #include "mdl/NodeQueries.h"
+#include "mdl/WorldNode.h"
 
+#include "kdl/task_manager.h"
 #include "kdl/vector_utils.h"
 
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace tb::mdl
@@ -169,30 +174,30 @@ std::map<Node*, std::vector<Node*>> parentChildrenMap(const std::vector<Node*>&
  * pair of node and brush.
  *
  * The given predicate must be a function that maps a node and a brush to true or false.
+ * It must only return true if the brush's logical bounds intersect the node's physical
+ * bounds. Nodes that are stored in the node tree of a visited world are only tested
+ * against the brushes found by querying that tree, and the tests are run in parallel.
  */
 template <typename P>
 static std::vector<Node*> collectMatchingNodes(
   const std::vector<Node*>& nodes,
   const std::vector<BrushNode*>& brushes,
-  const P& predicate)
+  const P& predicate,
+  kdl::task_manager& taskManager)
 {
-  auto result = std::vector<Node*>{};
+  const auto brushSet =
+    std::unordered_set<const BrushNode*>{brushes.begin(), brushes.end()};
 
-  const auto collectIfMatching = [&](auto* node) {
-    for (const auto* brush : brushes)
-    {
-      if (predicate(node, brush))
-      {
-        result.push_back(node);
-        return;
-      }
-    }
-  };
+  auto candidates = std::vector<Node*>{};
+  auto worlds = std::vector<const WorldNode*>{};
 
   for (auto* node : nodes)
   {
     node->accept(kdl::overload(
-      [](auto&& thisLambda, WorldNode* world) { world->visitChildren(thisLambda); },
+      [&](auto&& thisLambda, WorldNode* world) {
+        worlds.push_back(world);
+        world->visitChildren(thisLambda);
+      },
       [](auto&& thisLambda, LayerNode* layer) { layer->visitChildren(thisLambda); },
       [&](auto&& thisLambda, GroupNode* group) {
         if (group->opened() || group->hasOpenedDescendant())
@@ -201,7 +206,7 @@ static std::vector<Node*> collectMatchingNodes(
         }
         else
         {
-          collectIfMatching(group);
+          candidates.push_back(group);
         }
       },
       [&](auto&& thisLambda, EntityNode* entity) {
@@ -211,39 +216,96 @@ static std::vector<Node*> collectMatchingNodes(
         }
         else
         {
-          collectIfMatching(entity);
+          candidates.push_back(entity);
         }
       },
       [&](BrushNode* brush) {
         // if `brush` is one of the search query nodes, don't count it as touching
-        if (!kdl::vec_contains(brushes, brush))
+        if (!brushSet.contains(brush))
         {
-          collectIfMatching(brush);
+          candidates.push_back(brush);
         }
       },
-      [&](PatchNode* patch) {
-        // if `patch` is one of the search query nodes, don't count it as touching
-        collectIfMatching(patch);
-      }));
+      [&](PatchNode* patch) { candidates.push_back(patch); }));
+  }
+
+  // Broad phase: query the node trees of the visited worlds for the nodes whose bounds
+  // intersect the bounds of each brush. The predicates can only hold if the bounds
+  // intersect, so no other brush needs to be tested against these nodes.
+  auto brushesByNode = std::unordered_map<const Node*, std::vector<const BrushNode*>>{};
+  for (const auto* world : worlds)
+  {
+    for (const auto* brush : brushes)
+    {
+      for (const auto* node : world->nodeTree().find_intersectors(brush->logicalBounds()))
+      {
+        brushesByNode[node].push_back(brush);
+      }
+    }
   }
 
+  const auto findCandidateBrushes = [&](Node* node) {
+    if (std::ranges::any_of(
+          worlds, [&](const auto* world) { return world->nodeTree().contains(node); }))
+    {
+      const auto iBrushes = brushesByNode.find(node);
+      return iBrushes != brushesByNode.end() ? iBrushes->second
+                                              : std::vector<const BrushNode*>{};
+    }
+
+    // groups are not stored in the node tree, so we must test their bounds here
+    auto result = std::vector<const BrushNode*>{};
+    for (const auto* brush : brushes)
+    {
+      if (brush->logicalBounds().intersects(node->physicalBounds()))
+      {
+        result.push_back(brush);
+      }
+    }
+    return result;
+  };
+
+  // Narrow phase: run the exact tests in parallel, then collect the matching nodes in
+  // the order in which they were visited.
+  const auto matches = taskManager.parallel_transform(candidates, [&](Node* node) {
+    return std::ranges::any_of(findCandidateBrushes(node), [&](const auto* brush) {
+      return predicate(node, brush);
+    });
+  });
+
+  auto result = std::vector<Node*>{};
+  for (size_t i = 0; i < candidates.size(); ++i)
+  {
+    if (matches[i])
+    {
+      result.push_back(candidates[i]);
+    }
+  }
   return result;
 }
 
 std::vector<Node*> collectTouchingNodes(
-  const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes)
+  const std::vector<Node*>& nodes,
+  const std::vector<BrushNode*>& brushes,
+  kdl::task_manager& taskManager)
 {
-  return collectMatchingNodes(nodes, brushes, [](const auto* node, const auto* brush) {
-    return brush->intersects(node);
-  });
+  return collectMatchingNodes(
+    nodes,
+    brushes,
+    [](const auto* node, const auto* brush) { return brush->intersects(node); },
+    taskManager);
 }
 
 std::vector<Node*> collectContainedNodes(
-  const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes)
+  const std::vector<Node*>& nodes,
+  const std::vector<BrushNode*>& brushes,
+  kdl::task_manager& taskManager)
 {
-  return collectMatchingNodes(nodes, brushes, [](const auto* node, const auto* brush) {
-    return brush->contains(node);
-  });
+  return collectMatchingNodes(
+    nodes,
+    brushes,
+    [](const auto* node, const auto* brush) { return brush->contains(node); },
+    taskManager);
 }
 
 std::vector<Node*> collectSelectedNodes(const std::vector<Node*>& nodes)
@@ -346,6 +408,49 @@ vm::bbox3d computePhysicalBounds(
   return builder.initialized() ? builder.bounds() : defaultBounds;
 }
 
+std::vector<const Issue*> collectIssues(
+  const std::vector<Node*>& nodes,
+  const std::vector<const Validator*>& validators,
+  kdl::task_manager& taskManager)
+{
+  auto allNodes = std::vector<Node*>{};
+  Node::visitAll(
+    nodes,
+    kdl::overload(
+      [&](auto&& thisLambda, WorldNode* world) {
+        allNodes.push_back(world);
+        world->visitChildren(thisLambda);
+      },
+      [&](auto&& thisLambda, LayerNode* layer) {
+        allNodes.push_back(layer);
+        layer->visitChildren(thisLambda);
+      },
+      [&](auto&& thisLambda, GroupNode* group) {
+        allNodes.push_back(group);
+        group->visitChildren(thisLambda);
+      },
+      [&](auto&& thisLambda, EntityNode* entity) {
+        allNodes.push_back(entity);
+        entity->visitChildren(thisLambda);
+      },
+      [&](BrushNode* brush) { allNodes.push_back(brush); },
+      [&](PatchNode* patch) { allNodes.push_back(patch); }));
+
+  const auto invalidNodes =
+    kdl::vec_filter(allNodes, [](const auto* node) { return !node->issuesValid(); });
+  taskManager.parallel_for(0, invalidNodes.size(), [&](const auto i) {
+    invalidNodes[i]->validateIssues(validators);
+  });
+
+  auto result = std::vector<const Issue*>{};
+  for (auto* node : allNodes)
+  {
+    const auto issues = node->issues(validators);
+    result.insert(result.end(), issues.begin(), issues.end());
+  }
+  return result;
+}
+
 std::vector<BrushNode*> filterBrushNodes(const std::vector<Node*>& nodes)
 {
   auto result = std::vector<BrushNode*>{};
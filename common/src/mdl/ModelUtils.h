@@ -26,6 +26,11 @@
 #include <map>
 #include <vector>
 
+namespace kdl
+{
+class task_manager;
+}
+
 namespace tb::mdl
 {
 
@@ -36,6 +41,8 @@ class BrushNode;
 class EntityNode;
 class LayerNode;
 class EditorContext;
+class Issue;
+class Validator;
 
 HitType::Type nodeHitType();
 
@@ -59,9 +66,13 @@ std::vector<GroupNode*> collectGroups(const std::vector<Node*>& nodes);
 std::map<Node*, std::vector<Node*>> parentChildrenMap(const std::vector<Node*>& nodes);
 
 std::vector<Node*> collectTouchingNodes(
-  const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes);
+  const std::vector<Node*>& nodes,
+  const std::vector<BrushNode*>& brushes,
+  kdl::task_manager& taskManager);
 std::vector<Node*> collectContainedNodes(
-  const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes);
+  const std::vector<Node*>& nodes,
+  const std::vector<BrushNode*>& brushes,
+  kdl::task_manager& taskManager);
 
 std::vector<Node*> collectSelectedNodes(const std::vector<Node*>& nodes);
 
@@ -77,6 +88,17 @@ vm::bbox3d computeLogicalBounds(
 vm::bbox3d computePhysicalBounds(
   const std::vector<Node*>& nodes, const vm::bbox3d& defaultBounds = vm::bbox3d());
 
+/**
+ * Returns the issues of the given nodes and their descendants.
+ *
+ * Nodes whose issues were invalidated are validated again in parallel, all other nodes
+ * keep their issues.
+ */
+std::vector<const Issue*> collectIssues(
+  const std::vector<Node*>& nodes,
+  const std::vector<const Validator*>& validators,
+  kdl::task_manager& taskManager);
+
 std::vector<BrushNode*> filterBrushNodes(const std::vector<Node*>& nodes);
 std::vector<EntityNode*> filterEntityNodes(const std::vector<Node*>& nodes);
 
@@ -828,6 +828,11 @@ void Node::setIssueHidden(const IssueType type, const bool hidden)
   }
 }
 
+bool Node::issuesValid() const
+{
+  return m_issuesValid;
+}
+
 void Node::validateIssues(const std::vector<const Validator*>& validators)
 {
   if (!m_issuesValid)
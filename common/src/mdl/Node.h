@@ -354,12 +354,17 @@ public: // issue management
   bool issueHidden(IssueType type) const;
   void setIssueHidden(IssueType type, bool hidden);
 
-public: // should only be called from this and from the world
-  void invalidateIssues() const;
+  bool issuesValid() const;
 
-private:
+  /**
+   * Runs the given validators on this node unless its issues are still valid. This only
+   * modifies the issues of this node, so different nodes can be validated concurrently.
+   */
   void validateIssues(const std::vector<const Validator*>& validators);
 
+public: // should only be called from this and from the world
+  void invalidateIssues() const;
+
 public: // visitors
   /**
    * Visit this node with the given lambda and return the lambda's return value or nothing
@@ -28,6 +28,7 @@
 #include "vm/util.h"
 #include "vm/vec.h"
 
+#include <cstddef>
 #include <initializer_list>
 #include <limits>
 #include <optional>
@@ -122,6 +123,13 @@ private:
   explicit Polyhedron_Vertex(const vm::vec<T, 3>& position);
 
 public:
+  /**
+   * Allocates vertices from a pool that is shared by all polyhedra of this type to avoid
+   * many small heap allocations when a polyhedron is built or copied.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr) noexcept;
+
   /**
    * Returns the position of this vertex.
    */
@@ -274,6 +282,12 @@ private:
   explicit Polyhedron_Edge(HalfEdge* first, HalfEdge* second = nullptr);
 
 public:
+  /**
+   * Allocates edges from a pool, see Polyhedron_Vertex::operator new.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr) noexcept;
+
   /**
    * Returns the origin of the first half edge.
    */
@@ -595,6 +609,12 @@ private:
   explicit Polyhedron_HalfEdge(Vertex* origin);
 
 public:
+  /**
+   * Allocates half edges from a pool, see Polyhedron_Vertex::operator new.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr) noexcept;
+
   /**
    * Returns the origin vertex of this half edge.
    */
@@ -826,6 +846,12 @@ private:
   explicit Polyhedron_Face(HalfEdgeList&& boundary, const vm::plane<T, 3>& plane);
 
 public:
+  /**
+   * Allocates faces from a pool, see Polyhedron_Vertex::operator new.
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr) noexcept;
+
   /**
    * Returns the circular list of half edges that make up the boundary of this face.
    */
@@ -22,12 +22,17 @@
 #include "Macros.h"
 #include "Polyhedron.h"
 
+#include "kdl/object_pool.h"
+
 #include "vm/distance.h"
 #include "vm/plane.h"
 #include "vm/scalar.h"
 #include "vm/segment.h"
 #include "vm/vec.h"
 
+#include <cassert>
+#include <cstddef>
+
 namespace tb::mdl
 {
 
@@ -73,6 +78,19 @@ Polyhedron_Edge<T, FP, VP>::Polyhedron_Edge(HalfEdge* first, HalfEdge* second)
   }
 }
 
+template <typename T, typename FP, typename VP>
+void* Polyhedron_Edge<T, FP, VP>::operator new([[maybe_unused]] const std::size_t size)
+{
+  assert(size == sizeof(Polyhedron_Edge));
+  return kdl::object_pool<Polyhedron_Edge>::allocate();
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron_Edge<T, FP, VP>::operator delete(void* ptr) noexcept
+{
+  kdl::object_pool<Polyhedron_Edge>::deallocate(ptr);
+}
+
 template <typename T, typename FP, typename VP>
 typename Polyhedron_Edge<T, FP, VP>::Vertex* Polyhedron_Edge<T, FP, VP>::firstVertex()
   const
@@ -22,6 +22,7 @@
 #include "Macros.h"
 #include "Polyhedron.h"
 
+#include "kdl/object_pool.h"
 #include "kdl/optional_utils.h"
 
 #include "vm/constants.h"
@@ -32,6 +33,8 @@
 #include "vm/util.h"
 #include "vm/vec.h"
 
+#include <cassert>
+#include <cstddef>
 #include <unordered_set>
 
 namespace tb::mdl
@@ -77,6 +80,19 @@ Polyhedron_Face<T, FP, VP>::Polyhedron_Face(
   countAndSetFace(m_boundary.front(), m_boundary.back(), this);
 }
 
+template <typename T, typename FP, typename VP>
+void* Polyhedron_Face<T, FP, VP>::operator new([[maybe_unused]] const std::size_t size)
+{
+  assert(size == sizeof(Polyhedron_Face));
+  return kdl::object_pool<Polyhedron_Face>::allocate();
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron_Face<T, FP, VP>::operator delete(void* ptr) noexcept
+{
+  kdl::object_pool<Polyhedron_Face>::deallocate(ptr);
+}
+
 template <typename T, typename FP, typename VP>
 const typename Polyhedron_Face<T, FP, VP>::HalfEdgeList& Polyhedron_Face<T, FP, VP>::
   boundary() const
@@ -21,6 +21,11 @@
 
 #include "Polyhedron.h"
 
+#include "kdl/object_pool.h"
+
+#include <cassert>
+#include <cstddef>
+
 namespace tb::mdl
 {
 template <typename T, typename FP, typename VP>
@@ -59,6 +64,20 @@ Polyhedron_HalfEdge<T, FP, VP>::Polyhedron_HalfEdge(Vertex* origin)
   setAsLeaving();
 }
 
+template <typename T, typename FP, typename VP>
+void* Polyhedron_HalfEdge<T, FP, VP>::operator new(
+  [[maybe_unused]] const std::size_t size)
+{
+  assert(size == sizeof(Polyhedron_HalfEdge));
+  return kdl::object_pool<Polyhedron_HalfEdge>::allocate();
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron_HalfEdge<T, FP, VP>::operator delete(void* ptr) noexcept
+{
+  kdl::object_pool<Polyhedron_HalfEdge>::deallocate(ptr);
+}
+
 template <typename T, typename FP, typename VP>
 typename Polyhedron_HalfEdge<T, FP, VP>::Vertex* Polyhedron_HalfEdge<T, FP, VP>::origin()
   const
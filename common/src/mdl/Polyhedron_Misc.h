@@ -272,6 +272,9 @@ public:
     const CopyCallback& callback)
     : m_destination{destination}
   {
+    m_vertexMap.reserve(originalVertices.size());
+    m_halfEdgeMap.reserve(2 * originalEdges.size());
+
     copyVertices(originalVertices, callback);
     copyFaces(originalFaces, callback);
     copyEdges(originalEdges);
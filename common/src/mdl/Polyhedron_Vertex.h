@@ -22,6 +22,10 @@
 #include "Polyhedron.h"
 
 #include "kdl/intrusive_circular_list.h"
+#include "kdl/object_pool.h"
+
+#include <cassert>
+#include <cstddef>
 
 namespace tb::mdl
 {
@@ -63,6 +67,19 @@ Polyhedron_Vertex<T, FP, VP>::Polyhedron_Vertex(const vm::vec<T, 3>& position)
 {
 }
 
+template <typename T, typename FP, typename VP>
+void* Polyhedron_Vertex<T, FP, VP>::operator new([[maybe_unused]] const std::size_t size)
+{
+  assert(size == sizeof(Polyhedron_Vertex));
+  return kdl::object_pool<Polyhedron_Vertex>::allocate();
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron_Vertex<T, FP, VP>::operator delete(void* ptr) noexcept
+{
+  kdl::object_pool<Polyhedron_Vertex>::deallocate(ptr);
+}
+
 template <typename T, typename FP, typename VP>
 const vm::vec<T, 3>& Polyhedron_Vertex<T, FP, VP>::position() const
 {
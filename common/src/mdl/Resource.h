@@ -275,6 +275,13 @@ public:
       m_state);
   }
 
+  bool isUnloaded() const
+  {
+    return std::holds_alternative<ResourceUnloaded<T>>(m_state);
+  }
+
+  bool isLoading() const { return std::holds_alternative<ResourceLoading<T>>(m_state); }
+
   bool isDropped() const { return std::holds_alternative<ResourceDropped>(m_state); }
 
   bool needsProcessing() const
@@ -0,0 +1,310 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ResourceManager.h"
+
+#include "kdl/invoke.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace tb::mdl
+{
+namespace detail
+{
+
+void ResourceIdQueue::push(ResourceId id)
+{
+  auto lock = std::unique_lock{m_mutex};
+  m_ids.push_back(std::move(id));
+
+  const auto callback = m_callback;
+  if (!callback)
+  {
+    return;
+  }
+
+  ++m_runningCallbackCount;
+  lock.unlock();
+
+  const auto finishCallback = kdl::invoke_later{[&]() {
+    lock.lock();
+    if (--m_runningCallbackCount == 0)
+    {
+      m_callbacksFinished.notify_all();
+    }
+  }};
+
+  (*callback)();
+}
+
+std::vector<ResourceId> ResourceIdQueue::popAll()
+{
+  auto lock = std::lock_guard{m_mutex};
+  return std::exchange(m_ids, {});
+}
+
+bool ResourceIdQueue::empty() const
+{
+  auto lock = std::lock_guard{m_mutex};
+  return m_ids.empty();
+}
+
+void ResourceIdQueue::setCallback(std::function<void()> callback)
+{
+  auto lock = std::unique_lock{m_mutex};
+  m_callback = callback ? std::make_shared<const std::function<void()>>(
+                            std::move(callback))
+                        : nullptr;
+  m_callbacksFinished.wait(lock, [&]() { return m_runningCallbackCount == 0; });
+}
+
+} // namespace detail
+
+ResourceManager::ResourceManager(const size_t maxConcurrentLoads)
+  : m_maxConcurrentLoads{maxConcurrentLoads}
+{
+}
+
+ResourceManager::~ResourceManager()
+{
+  // loader tasks and users may outlive this manager and still push into the queues
+  setProcessingRequestedCallback({});
+}
+
+void ResourceManager::setProcessingRequestedCallback(std::function<void()> callback)
+{
+  m_changedResourceIds->setCallback(callback);
+  m_releasedResourceIds->setCallback(std::move(callback));
+}
+
+bool ResourceManager::needsProcessing() const
+{
+  return m_loadingCount > 0 || !m_waitingResources.empty()
+         || !m_changedResourceIds->empty() || !m_releasedResourceIds->empty();
+}
+
+bool ResourceManager::hasWaitingResources() const
+{
+  // changed resources may not have been added to the waiting resources yet
+  return !m_waitingResources.empty() || !m_changedResourceIds->empty();
+}
+
+bool ResourceManager::hasCancelledResources() const
+{
+  return m_cancelledCount > 0;
+}
+
+std::vector<const ResourceWrapperBase*> ResourceManager::resources() const
+{
+  auto entries = std::vector<const Entry*>{};
+  entries.reserve(m_resources.size());
+  for (const auto& [id, entry] : m_resources)
+  {
+    entries.push_back(&entry);
+  }
+
+  std::ranges::sort(entries, [](const auto* lhs, const auto* rhs) {
+    return lhs->sequenceNumber < rhs->sequenceNumber;
+  });
+
+  auto result = std::vector<const ResourceWrapperBase*>{};
+  result.reserve(entries.size());
+  for (const auto* entry : entries)
+  {
+    result.push_back(entry->resourceWrapper.get());
+  }
+  return result;
+}
+
+void ResourceManager::setPriority(const ResourceId& id, const ResourcePriority priority)
+{
+  if (const auto it = m_resources.find(id); it != m_resources.end())
+  {
+    auto& entry = it->second;
+    if (entry.waiting)
+    {
+      auto node =
+        m_waitingResources.extract(WaitingResource{entry.priority, entry.sequenceNumber});
+      node.key().priority = priority;
+      m_waitingResources.insert(std::move(node));
+    }
+    entry.priority = priority;
+
+    if (std::exchange(entry.loadingCancelled, false))
+    {
+      --m_cancelledCount;
+      m_changedResourceIds->push(id);
+    }
+  }
+}
+
+void ResourceManager::cancelLoading(const ResourceId& id)
+{
+  if (const auto it = m_resources.find(id); it != m_resources.end())
+  {
+    auto& entry = it->second;
+    if (entry.resourceWrapper->isUnloaded())
+    {
+      removeWaitingResource(entry);
+      if (!std::exchange(entry.loadingCancelled, true))
+      {
+        ++m_cancelledCount;
+      }
+    }
+  }
+}
+
+std::vector<ResourceId> ResourceManager::process(
+  TaskRunner taskRunner,
+  const ProcessContext& processContext,
+  std::optional<std::chrono::milliseconds> timeout)
+{
+  const auto checkTimeout =
+    timeout ? std::function{[timeout_ = *timeout,
+                             startTime = std::chrono::steady_clock::now()]() {
+      return std::chrono::steady_clock::now() - startTime < timeout_;
+    }}
+            : std::function{[]() { return true; }};
+
+  auto changedResources = std::vector<std::pair<size_t, ResourceId>>{};
+  const auto addChangedResource = [&](ResourceId id, const bool released) {
+    if (const auto it = m_resources.find(id); it != m_resources.end())
+    {
+      it->second.released = it->second.released || released;
+      changedResources.emplace_back(it->second.sequenceNumber, std::move(id));
+    }
+  };
+
+  for (auto& id : m_releasedResourceIds->popAll())
+  {
+    addChangedResource(std::move(id), true);
+  }
+  for (auto& id : m_changedResourceIds->popAll())
+  {
+    addChangedResource(std::move(id), false);
+  }
+
+  // process the resources in the order in which they were added
+  std::ranges::sort(changedResources, {}, [](const auto& x) { return x.first; });
+  const auto [first, last] =
+    std::ranges::unique(changedResources, {}, [](const auto& x) { return x.first; });
+  changedResources.erase(first, last);
+
+  auto result = std::vector<ResourceId>{};
+
+  for (auto& changedResource : changedResources)
+  {
+    auto& id = changedResource.second;
+    if (!checkTimeout())
+    {
+      m_changedResourceIds->push(std::move(id));
+      continue;
+    }
+
+    auto& entry = m_resources.find(id)->second;
+    if (!entry.released && entry.resourceWrapper->isUnloaded())
+    {
+      if (!entry.waiting && !entry.loadingCancelled)
+      {
+        m_waitingResources.emplace(
+          WaitingResource{entry.priority, entry.sequenceNumber}, std::move(id));
+        entry.waiting = true;
+      }
+      continue;
+    }
+
+    processResource(id, taskRunner, processContext, result);
+  }
+
+  while (!m_waitingResources.empty() && m_loadingCount < m_maxConcurrentLoads
+         && checkTimeout())
+  {
+    auto id = std::move(m_waitingResources.extract(m_waitingResources.begin()).mapped());
+    m_resources.find(id)->second.waiting = false;
+
+    processResource(id, taskRunner, processContext, result);
+  }
+
+  return result;
+}
+
+void ResourceManager::processResource(
+  const ResourceId& id,
+  const TaskRunner& taskRunner,
+  const ProcessContext& processContext,
+  std::vector<ResourceId>& processedResourceIds)
+{
+  const auto it = m_resources.find(id);
+  auto& entry = it->second;
+  auto& resourceWrapper = *entry.resourceWrapper;
+
+  const auto wasLoading = resourceWrapper.isLoading();
+  if (entry.released && !resourceWrapper.isDropped())
+  {
+    resourceWrapper.drop();
+  }
+
+  if (resourceWrapper.needsProcessing())
+  {
+    // the loader task reports back when it has finished
+    const auto notifyingTaskRunner = [&](Task task) {
+      return taskRunner(
+        [task = std::move(task), changedResourceIds = m_changedResourceIds, id]() {
+          auto taskResult = task();
+          changedResourceIds->push(id);
+          return taskResult;
+        });
+    };
+
+    if (resourceWrapper.process(notifyingTaskRunner, processContext))
+    {
+      processedResourceIds.push_back(id);
+    }
+  }
+
+  const auto isLoading = resourceWrapper.isLoading();
+  m_loadingCount = m_loadingCount + (isLoading ? 1u : 0u) - (wasLoading ? 1u : 0u);
+
+  if (entry.released && resourceWrapper.isDropped())
+  {
+    removeWaitingResource(entry);
+    if (entry.loadingCancelled)
+    {
+      --m_cancelledCount;
+    }
+    m_resources.erase(it);
+  }
+  else if (resourceWrapper.needsProcessing() && (!isLoading || wasLoading))
+  {
+    // The resource needs another transition, or its loader task has reported back
+    // before its result became available.
+    m_changedResourceIds->push(id);
+  }
+}
+
+void ResourceManager::removeWaitingResource(Entry& entry)
+{
+  if (std::exchange(entry.waiting, false))
+  {
+    m_waitingResources.erase(WaitingResource{entry.priority, entry.sequenceNumber});
+  }
+}
+
+} // namespace tb::mdl
@@ -21,12 +21,17 @@
 
 #include "mdl/Resource.h"
 
-#include "kdl/collection_utils.h"
 #include "kdl/reflection_impl.h"
-#include "kdl/vector_utils.h"
 
 #include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 #include <vector>
 
 namespace tb::mdl
@@ -39,8 +44,8 @@ public:
 
   virtual const ResourceId& id() const = 0;
 
-  virtual long useCount() const = 0;
-
+  virtual bool isUnloaded() const = 0;
+  virtual bool isLoading() const = 0;
   virtual bool isDropped() const = 0;
   virtual bool needsProcessing() const = 0;
 
@@ -63,7 +68,8 @@ public:
   }
 
   const ResourceId& id() const override { return m_resource->id(); }
-  long useCount() const override { return m_resource.use_count(); }
+  bool isUnloaded() const override { return m_resource->isUnloaded(); }
+  bool isLoading() const override { return m_resource->isLoading(); }
   bool isDropped() const override { return m_resource->isDropped(); }
   bool needsProcessing() const override { return m_resource->needsProcessing(); }
   void drop() override { m_resource->drop(); }
@@ -81,70 +87,183 @@ public:
   };
 };
 
-class ResourceManager
+namespace detail
+{
+
+/**
+ * A queue of resource IDs that can be pushed from any thread. Pushing an ID invokes the
+ * callback, which must therefore be thread safe as well. The callback is invoked without
+ * holding the queue's lock, so it may push IDs itself.
+ */
+class ResourceIdQueue
 {
 private:
-  std::vector<std::unique_ptr<ResourceWrapperBase>> m_resources;
+  mutable std::mutex m_mutex;
+  std::condition_variable m_callbacksFinished;
+  std::vector<ResourceId> m_ids;
+  std::shared_ptr<const std::function<void()>> m_callback;
+  size_t m_runningCallbackCount = 0;
 
 public:
-  bool needsProcessing() const
+  void push(ResourceId id);
+  std::vector<ResourceId> popAll();
+  bool empty() const;
+
+  /**
+   * Replaces the callback and waits until all invocations of the previous callback have
+   * returned. Therefore, this must not be called from within the callback.
+   */
+  void setCallback(std::function<void()> callback);
+};
+
+} // namespace detail
+
+/**
+ * Determines the order in which the manager starts loading its resources.
+ */
+enum class ResourcePriority
+{
+  Low,
+  Normal,
+  High,
+};
+
+/**
+ * Owns resources and drives their state transitions.
+ *
+ * Rather than visiting every resource on each call to process, the manager only visits
+ * resources whose state has changed: resources that were just added, resources whose
+ * loader task has finished, resources that need another transition, and resources that
+ * were released by all of their users. Loader tasks and released resources report
+ * themselves through thread safe queues.
+ *
+ * Unloaded resources wait in a queue until they can be loaded. At most a given number of
+ * resources are loading at the same time, and the waiting resources are started by
+ * priority and then in the order in which they were added. This allows clients to change
+ * the priority of a resource or to cancel loading it while it is waiting.
+ */
+class ResourceManager
+{
+private:
+  struct Entry
   {
-    return kdl::any_of(m_resources, [](const auto& resourceWrapper) {
-      return resourceWrapper->useCount() == 1 || resourceWrapper->needsProcessing();
-    });
-  }
+    size_t sequenceNumber;
+    std::unique_ptr<ResourceWrapperBase> resourceWrapper;
+    ResourcePriority priority = ResourcePriority::Normal;
+    bool released = false;
+    bool waiting = false;
+    bool loadingCancelled = false;
+  };
 
-  std::vector<const ResourceWrapperBase*> resources() const
+  struct WaitingResource
   {
-    return kdl::vec_transform(m_resources, [](const auto& resourceWrapper) {
-      return static_cast<const ResourceWrapperBase*>(resourceWrapper.get());
-    });
-  }
+    ResourcePriority priority;
+    size_t sequenceNumber;
+
+    bool operator<(const WaitingResource& other) const
+    {
+      return priority != other.priority ? priority > other.priority
+                                        : sequenceNumber < other.sequenceNumber;
+    }
+  };
+
+  size_t m_maxConcurrentLoads;
 
+  std::unordered_map<ResourceId, Entry> m_resources;
+  std::map<WaitingResource, ResourceId> m_waitingResources;
+  size_t m_nextSequenceNumber = 0;
+  size_t m_loadingCount = 0;
+  size_t m_cancelledCount = 0;
+
+  std::shared_ptr<detail::ResourceIdQueue> m_changedResourceIds =
+    std::make_shared<detail::ResourceIdQueue>();
+  std::shared_ptr<detail::ResourceIdQueue> m_releasedResourceIds =
+    std::make_shared<detail::ResourceIdQueue>();
+
+public:
+  explicit ResourceManager(
+    size_t maxConcurrentLoads = std::numeric_limits<size_t>::max());
+  ~ResourceManager();
+
+  /**
+   * Sets a callback that is invoked whenever a resource needs processing, possibly from
+   * another thread.
+   */
+  void setProcessingRequestedCallback(std::function<void()> callback);
+
+  bool needsProcessing() const;
+
+  /**
+   * Indicates whether any resource has not started loading yet and is not cancelled.
+   * Changing priorities has no effect otherwise.
+   */
+  bool hasWaitingResources() const;
+
+  /**
+   * Indicates whether loading any resource was cancelled.
+   */
+  bool hasCancelledResources() const;
+
+  std::vector<const ResourceWrapperBase*> resources() const;
+
+  /**
+   * Sets the priority with which the given resource is loaded. If loading the resource
+   * was cancelled, it will be loaded again.
+   *
+   * Has no effect if the resource has already started loading.
+   */
+  void setPriority(const ResourceId& id, ResourcePriority priority);
+
+  /**
+   * Prevents the given resource from being loaded until its priority is set again.
+   *
+   * Has no effect if the resource has already started loading.
+   */
+  void cancelLoading(const ResourceId& id);
+
+  /**
+   * Adds the given resource to this manager and returns a pointer for its users.
+   *
+   * The manager keeps its own reference to the resource. Once the returned pointer and
+   * all of its copies are destroyed, the resource is dropped during the next call to
+   * process and then removed.
+   */
   template <typename ResourceT>
-  void addResource(std::shared_ptr<Resource<ResourceT>> resource)
+  std::shared_ptr<Resource<ResourceT>> addResource(
+    std::shared_ptr<Resource<ResourceT>> resource)
   {
-    m_resources.push_back(
-      std::make_unique<ResourceWrapper<ResourceT>>(std::move(resource)));
+    const auto id = resource->id();
+    auto* resourcePtr = resource.get();
+
+    auto result = std::shared_ptr<Resource<ResourceT>>{
+      resourcePtr,
+      [owner = resource, releasedResourceIds = m_releasedResourceIds, id](auto*) {
+        releasedResourceIds->push(id);
+      }};
+
+    m_resources.emplace(
+      id,
+      Entry{
+        m_nextSequenceNumber++,
+        std::make_unique<ResourceWrapper<ResourceT>>(std::move(resource)),
+      });
+    m_changedResourceIds->push(id);
+
+    return result;
   }
 
   std::vector<ResourceId> process(
     TaskRunner taskRunner,
     const ProcessContext& processContext,
-    std::optional<std::chrono::milliseconds> timeout = std::nullopt)
-  {
-    const auto checkTimeout =
-      timeout ? std::function{[timeout_ = *timeout,
-                               startTime = std::chrono::steady_clock::now()]() {
-        return std::chrono::steady_clock::now() - startTime < timeout_;
-      }}
-              : std::function{[]() { return true; }};
-
-    auto result = std::vector<ResourceId>{};
-
-    for (auto it = m_resources.begin(); it != m_resources.end() && checkTimeout();)
-    {
-      auto& resourceWrapper = *it;
-      if (resourceWrapper->useCount() == 1 && !resourceWrapper->isDropped())
-      {
-        resourceWrapper->drop();
-      }
-
-      if (resourceWrapper->needsProcessing())
-      {
-        if (resourceWrapper->process(taskRunner, processContext))
-        {
-          result.push_back(resourceWrapper->id());
-        }
-      }
-
-      it = resourceWrapper->useCount() == 1 && resourceWrapper->isDropped()
-             ? m_resources.erase(it)
-             : std::next(it);
-    }
+    std::optional<std::chrono::milliseconds> timeout = std::nullopt);
 
-    return result;
-  }
+private:
+  void processResource(
+    const ResourceId& id,
+    const TaskRunner& taskRunner,
+    const ProcessContext& processContext,
+    std::vector<ResourceId>& processedResourceIds);
+  void removeWaitingResource(Entry& entry);
 };
 
 } // namespace tb::mdl
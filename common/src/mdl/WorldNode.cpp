@@ -38,8 +38,10 @@
 
 #include "vm/bbox_io.h" // IWYU pragma: keep
 
+#include <ranges>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace tb::mdl
@@ -244,11 +246,9 @@ void WorldNode::rebuildNodeTree()
     [&](BrushNode* brush) { addNode(brush); },
     [&](PatchNode* patch) { addNode(patch); }));
 
-  m_nodeTree->clear();
-  for (auto* node : nodes)
-  {
-    m_nodeTree->insert(node->physicalBounds(), node);
-  }
+  m_nodeTree->build(nodes | std::views::transform([](auto* node) {
+                      return std::pair{node->physicalBounds(), node};
+                    }));
 }
 
 void WorldNode::invalidateAllIssues()
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Macros.h"
+#include "flat_octree.h"
 #include "mdl/EntityNodeBase.h"
 #include "mdl/EntityProperties.h"
 #include "mdl/IdType.h"
@@ -49,7 +50,11 @@ private:
   std::unique_ptr<EntityNodeIndex> m_entityNodeIndex;
   std::unique_ptr<ValidatorRegistry> m_validatorRegistry;
 
+#ifdef TB_ENABLE_FLAT_OCTREE
+  using NodeTree = flat_octree<double, Node*>;
+#else
   using NodeTree = octree<double, Node*>;
+#endif
   std::unique_ptr<NodeTree> m_nodeTree;
   bool m_updateNodeTree;
 
@@ -36,6 +36,19 @@ namespace
          || (is_valid(x) && is_valid(y) && is_valid(z));
 }
 
+// spreads the lower 21 bits of the given value so that there are two zero bits between
+// each pair of consecutive bits
+std::uint64_t spread_bits(std::uint64_t v)
+{
+  v &= 0x1fffff;
+  v = (v | v << 32) & 0x1f00000000ffff;
+  v = (v | v << 16) & 0x1f0000ff0000ff;
+  v = (v | v << 8) & 0x100f00f00f00f00f;
+  v = (v | v << 4) & 0x10c30c30c30c30c3;
+  v = (v | v << 2) & 0x1249249249249249;
+  return v;
+}
+
 } // namespace
 
 node_address::node_address(
@@ -149,4 +162,16 @@ node_address get_container(const node_address& address1, const node_address& add
   return container;
 }
 
+std::uint64_t get_morton_code(const node_address& address, const node_address& root)
+{
+  assert(root.contains(address));
+
+  // the quadrant index has the x bit in the lowest position, so that the Morton order of
+  // the quadrants matches the order of the quadrant indices
+  const auto x = std::uint64_t(address.x - root.x);
+  const auto y = std::uint64_t(address.y - root.y);
+  const auto z = std::uint64_t(address.z - root.z);
+  return spread_bits(x) | (spread_bits(y) << 1) | (spread_bits(z) << 2);
+}
+
 } // namespace tb::detail
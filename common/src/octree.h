@@ -36,6 +36,7 @@
 #include <cmath>
 #include <cstdint>
 #include <optional>
+#include <ranges>
 #include <unordered_map>
 #include <variant>
 #include <vector>
@@ -94,9 +95,12 @@ node_address get_container(const node_address& address1, const node_address& add
 template <typename T>
 node_address get_container(const vm::bbox<T, 3>& bounds, const T min_size)
 {
-  // Check if any dimension of the bounding box crosses zero.
-  const auto sum_of_signs = vm::sign(bounds.min) + vm::sign(bounds.max);
-  if (sum_of_signs.x() == T(0) || sum_of_signs.y() == T(0) || sum_of_signs.z() == T(0))
+  // Check if any dimension of the bounding box crosses zero. A dimension that is
+  // degenerate at zero does not cross it, so it can be placed in a leaf node.
+  const auto crosses_zero = [&](const size_t i) {
+    return bounds.min[i] < T(0) && bounds.max[i] > T(0);
+  };
+  if (crosses_zero(0) || crosses_zero(1) || crosses_zero(2))
   {
     // The returned address denotes a bounding box that centers around 0,0,0.
     const auto abs_max =
@@ -117,6 +121,140 @@ node_address get_container(const vm::bbox<T, 3>& bounds, const T min_size)
   return min_address;
 }
 
+/**
+ * Returns the Morton code of the min corner of the given address relative to the min
+ * corner of the given root address.
+ */
+std::uint64_t get_morton_code(const node_address& address, const node_address& root);
+
+template <typename U>
+struct build_item
+{
+  node_address address;
+  std::uint64_t morton_code;
+  U data;
+};
+
+/**
+ * Computes the node addresses of the given (bounds, data) pairs for a bulk build.
+ *
+ * @throws NodeTreeException if any bounds are invalid
+ */
+template <typename T, typename U, std::ranges::range R>
+std::vector<build_item<U>> make_build_items(R&& range, const T min_size)
+{
+  auto result = std::vector<build_item<U>>{};
+  if constexpr (std::ranges::sized_range<R>)
+  {
+    result.reserve(std::ranges::size(range));
+  }
+
+  for (auto&& element : range)
+  {
+    const auto& [bounds, data] = element;
+    if (vm::is_nan(bounds.min) || vm::is_nan(bounds.max))
+    {
+      throw NodeTreeException("Cannot add node to octree with invalid bounds");
+    }
+
+    result.push_back({get_container(bounds, min_size), 0, data});
+  }
+
+  return result;
+}
+
+/**
+ * Returns the smallest root address that contains all of the given items.
+ */
+template <typename U>
+node_address get_build_root(const std::vector<build_item<U>>& items)
+{
+  assert(!items.empty());
+
+  auto result = is_root(items.front().address) ? items.front().address
+                                               : get_root(items.front().address);
+  for (const auto& item : items)
+  {
+    const auto root = is_root(item.address) ? item.address : get_root(item.address);
+    if (root.size > result.size)
+    {
+      result = root;
+    }
+  }
+  return result;
+}
+
+/**
+ * Moves the items with root addresses to the front of the given vector and sorts the
+ * remaining items by the Morton code of their addresses, larger addresses first if the
+ * codes are equal.
+ *
+ * Afterwards, the items of every subtree form a contiguous range in which the items
+ * stored in the subtree's root come first, followed by the items of its quadrants in
+ * quadrant order.
+ *
+ * Returns an iterator to the first item that does not have a root address.
+ */
+template <typename U>
+auto sort_build_items(std::vector<build_item<U>>& items, const node_address& root)
+{
+  const auto first_non_root = std::stable_partition(
+    items.begin(), items.end(), [](const auto& item) { return is_root(item.address); });
+
+  for (auto i = first_non_root; i != items.end(); ++i)
+  {
+    i->morton_code = get_morton_code(i->address, root);
+  }
+
+  std::sort(first_non_root, items.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.morton_code < rhs.morton_code
+           || (lhs.morton_code == rhs.morton_code && lhs.address.size > rhs.address.size);
+  });
+
+  return first_non_root;
+}
+
+/**
+ * Returns an iterator to the first of the given items that must not be stored in the
+ * node with the given address, but in one of its quadrants. The given items must be
+ * sorted by sort_build_items and must all be contained in the given address.
+ */
+template <typename I>
+I find_first_quadrant_item(const node_address& address, I first, const I last)
+{
+  while (first != last && first->address == address)
+  {
+    ++first;
+  }
+  return first;
+}
+
+/**
+ * Calls the given function for every non empty quadrant of the node with the given
+ * address. The given items must be sorted by sort_build_items and must all be contained
+ * in one of the quadrants of the given address.
+ *
+ * The function is called with the quadrant and the range of items in that quadrant.
+ */
+template <typename I, typename F>
+void for_each_build_quadrant(
+  const node_address& address, const I first, const I last, const F& f)
+{
+  auto i = first;
+  while (i != last)
+  {
+    const auto quadrant = *get_quadrant(address, i->address);
+    auto j = std::next(i);
+    while (j != last && get_quadrant(address, j->address) == quadrant)
+    {
+      ++j;
+    }
+
+    f(quadrant, i, j);
+    i = j;
+  }
+}
+
 } // namespace detail
 
 /**
@@ -451,6 +589,65 @@ public:
   }
 
 
+  /**
+   * Replaces the contents of this tree with the given data.
+   *
+   * This is much faster than inserting the data one by one because the tree is built
+   * bottom up in a single pass over the data sorted by the Morton codes of their node
+   * addresses.
+   *
+   * @param range a range of pairs of bounds and data
+   *
+   * @throws NodeTreeException if any bounds are invalid or if any data is contained more
+   * than once
+   */
+  template <std::ranges::range R>
+  void build(R&& range)
+  {
+    auto items = detail::make_build_items<T, U>(std::forward<R>(range), m_min_size);
+
+    clear();
+    if (items.empty())
+    {
+      return;
+    }
+
+    const auto root_address = detail::get_build_root(items);
+    const auto first_non_root = detail::sort_build_items(items, root_address);
+
+    auto node_address_for_data = std::unordered_map<U, detail::node_address>{};
+    node_address_for_data.reserve(items.size());
+
+    const auto add_data =
+      [&](auto& data, auto first, const auto last, const auto address) {
+        data.reserve(size_t(std::distance(first, last)));
+        for (; first != last; ++first)
+        {
+          if (!node_address_for_data.emplace(first->data, address).second)
+          {
+            throw NodeTreeException("Data already in tree");
+          }
+          data.push_back(first->data);
+        }
+      };
+
+    auto root_data = std::vector<U>{};
+    add_data(root_data, items.begin(), first_non_root, root_address);
+
+    if (first_non_root == items.end())
+    {
+      m_root = leaf_node{root_address, std::move(root_data)};
+    }
+    else
+    {
+      auto root = inner_node{root_address, std::move(root_data)};
+      build_children(root, first_non_root, items.end(), add_data);
+      m_root = std::move(root);
+    }
+
+    m_node_address_for_data = std::move(node_address_for_data);
+  }
+
   /**
    * Removes the node with the given data from this tree.
    *
@@ -630,9 +827,86 @@ public:
     }
   }
 
+  /**
+   * Finds every data item stored in a node whose bounds satisfy the given predicate and
+   * returns a list of those items.
+   *
+   * @tparam P the predicate type, a unary function that accepts a vm::bbox<T, 3>
+   * @param predicate the predicate to apply to the node bounds
+   * @return a list containing all found data items
+   */
+  template <typename P>
+  std::vector<U> find_if(const P& predicate) const
+  {
+    auto result = std::vector<U>{};
+    find_if(predicate, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item stored in a node whose bounds satisfy the given predicate and
+   * appends it to the given output iterator.
+   *
+   * The bounds of a node contain the bounds of its children and of the data stored in
+   * it, so the predicate is not evaluated for the children of a node that fails it. The
+   * predicate must therefore accept any bounds that might contain a matching item; the
+   * caller is responsible for testing the returned items precisely.
+   *
+   * @tparam P the predicate type, a unary function that accepts a vm::bbox<T, 3>
+   * @tparam O the output iterator type
+   * @param predicate the predicate to apply to the node bounds
+   * @param out the output iterator to append to
+   */
+  template <typename P, typename O>
+  void find_if(const P& predicate, O out) const
+  {
+    if (m_root)
+    {
+      visit_node_if(
+        *m_root,
+        [&](const auto& node) {
+          const auto& data = get_data(node);
+          std::copy(data.begin(), data.end(), out);
+        },
+        [&](const auto& node) {
+          return predicate(get_address(node).to_bounds(m_min_size));
+        });
+    }
+  }
+
   kdl_reflect_inline(octree, m_root, m_min_size, m_node_address_for_data);
 
 private:
+  template <typename I, typename F>
+  static node build_node(
+    const detail::node_address& address, const I first, const I last, const F& add_data)
+  {
+    auto data = std::vector<U>{};
+    const auto first_quadrant_item =
+      detail::find_first_quadrant_item(address, first, last);
+    add_data(data, first, first_quadrant_item, address);
+
+    if (first_quadrant_item == last)
+    {
+      return leaf_node{address, std::move(data)};
+    }
+
+    auto result = inner_node{address, std::move(data)};
+    build_children(result, first_quadrant_item, last, add_data);
+    return result;
+  }
+
+  template <typename I, typename F>
+  static void build_children(
+    inner_node& parent, const I first, const I last, const F& add_data)
+  {
+    detail::for_each_build_quadrant(
+      parent.address, first, last, [&](const auto quadrant, const auto i, const auto j) {
+        const auto address = get_container(i->address, std::prev(j)->address);
+        parent.children[quadrant] = build_node(address, i, j, add_data);
+      });
+  }
+
   void check(const vm::bbox<T, 3>& bounds) const
   {
     if (vm::is_nan(bounds.min) || vm::is_nan(bounds.max))
@@ -31,8 +31,12 @@
 #include "render/BrushRendererBrushCache.h"
 #include "render/RenderContext.h"
 
+#include "kdl/task_manager.h"
+
+#include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <tuple>
 #include <vector>
 
 namespace tb::render
@@ -63,6 +67,27 @@ public:
   }
 };
 
+bool renderNothing(const BrushRenderer::Filter::RenderSettings& settings)
+{
+  const auto [facePolicy, edgePolicy] = settings;
+  return facePolicy == BrushRenderer::Filter::FaceRenderPolicy::RenderNone
+         && edgePolicy == BrushRenderer::Filter::EdgeRenderPolicy::RenderNone;
+}
+
+BrushIndexRanges makeIndexRanges(std::vector<const AllocationTracker::Block*> blocks)
+{
+  std::sort(blocks.begin(), blocks.end(), [](const auto* lhs, const auto* rhs) {
+    return lhs->pos < rhs->pos;
+  });
+
+  auto ranges = BrushIndexRanges{};
+  for (const auto* block : blocks)
+  {
+    ranges.add(block->pos, block->size);
+  }
+  return ranges;
+}
+
 } // namespace
 
 // Filter
@@ -237,6 +262,7 @@ void BrushRenderer::clear()
   m_edgeIndices = std::make_shared<BrushIndexArray>();
   m_transparentFaces = std::make_shared<MaterialToBrushIndicesMap>();
   m_opaqueFaces = std::make_shared<MaterialToBrushIndicesMap>();
+  invalidateRenderedBrushRanges();
 
   m_opaqueFaceRenderer = FaceRenderer{m_vertexArray, m_opaqueFaces, m_faceColor};
   m_transparentFaceRenderer =
@@ -311,6 +337,21 @@ void BrushRenderer::setShowHiddenBrushes(const bool showHiddenBrushes)
   }
 }
 
+void BrushRenderer::setRenderedBrushes(
+  const Camera& camera, std::optional<std::vector<const mdl::BrushNode*>> brushes)
+{
+  if (brushes)
+  {
+    auto& renderedBrushes = m_renderedBrushes[&camera];
+    renderedBrushes.brushes = std::move(*brushes);
+    renderedBrushes.rangesValid = false;
+  }
+  else
+  {
+    m_renderedBrushes.erase(&camera);
+  }
+}
+
 void BrushRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch)
 {
   renderOpaque(renderContext, renderBatch);
@@ -325,6 +366,7 @@ void BrushRenderer::renderOpaque(RenderContext& renderContext, RenderBatch& rend
     {
       validate();
     }
+    validateRenderedBrushRanges(renderContext.camera());
     if (renderContext.showFaces())
     {
       renderOpaqueFaces(renderBatch);
@@ -345,6 +387,7 @@ void BrushRenderer::renderTransparent(
     {
       validate();
     }
+    validateRenderedBrushRanges(renderContext.camera());
     if (renderContext.showFaces())
     {
       renderTransparentFaces(renderBatch);
@@ -352,6 +395,79 @@ void BrushRenderer::renderTransparent(
   }
 }
 
+void BrushRenderer::invalidateRenderedBrushRanges()
+{
+  for (auto& [camera, renderedBrushes] : m_renderedBrushes)
+  {
+    renderedBrushes.rangesValid = false;
+  }
+}
+
+void BrushRenderer::validateRenderedBrushRanges(const Camera& camera)
+{
+  const auto it = m_renderedBrushes.find(&camera);
+  if (it == m_renderedBrushes.end())
+  {
+    m_opaqueFaceRenderer.setIndexRanges(nullptr);
+    m_transparentFaceRenderer.setIndexRanges(nullptr);
+    m_edgeRenderer.setIndexRanges(nullptr);
+    return;
+  }
+
+  auto& renderedBrushes = it->second;
+  if (!renderedBrushes.rangesValid)
+  {
+    using Blocks = std::vector<const AllocationTracker::Block*>;
+    auto edgeBlocks = Blocks{};
+    auto transparentFaceBlocks = std::unordered_map<const mdl::Material*, Blocks>{};
+    auto opaqueFaceBlocks = std::unordered_map<const mdl::Material*, Blocks>{};
+
+    for (const auto* brushNode : renderedBrushes.brushes)
+    {
+      if (const auto infoIt = m_brushInfo.find(brushNode); infoIt != m_brushInfo.end())
+      {
+        const auto& info = infoIt->second;
+        if (info.edgeIndicesKey != nullptr)
+        {
+          edgeBlocks.push_back(info.edgeIndicesKey);
+        }
+        for (const auto& [material, key] : info.transparentFaceIndicesKeys)
+        {
+          transparentFaceBlocks[material].push_back(key);
+        }
+        for (const auto& [material, key] : info.opaqueFaceIndicesKeys)
+        {
+          opaqueFaceBlocks[material].push_back(key);
+        }
+      }
+    }
+
+    renderedBrushes.edgeRanges =
+      std::make_shared<BrushIndexRanges>(makeIndexRanges(std::move(edgeBlocks)));
+
+    renderedBrushes.transparentFaceRanges =
+      std::make_shared<MaterialToBrushIndexRangesMap>();
+    for (auto& [material, blocks] : transparentFaceBlocks)
+    {
+      renderedBrushes.transparentFaceRanges->emplace(
+        material, makeIndexRanges(std::move(blocks)));
+    }
+
+    renderedBrushes.opaqueFaceRanges = std::make_shared<MaterialToBrushIndexRangesMap>();
+    for (auto& [material, blocks] : opaqueFaceBlocks)
+    {
+      renderedBrushes.opaqueFaceRanges->emplace(
+        material, makeIndexRanges(std::move(blocks)));
+    }
+
+    renderedBrushes.rangesValid = true;
+  }
+
+  m_opaqueFaceRenderer.setIndexRanges(renderedBrushes.opaqueFaceRanges);
+  m_transparentFaceRenderer.setIndexRanges(renderedBrushes.transparentFaceRanges);
+  m_edgeRenderer.setIndexRanges(renderedBrushes.edgeRanges);
+}
+
 void BrushRenderer::renderOpaqueFaces(RenderBatch& renderBatch)
 {
   m_opaqueFaceRenderer.setGrayscale(m_grayscale);
@@ -382,9 +498,39 @@ void BrushRenderer::validate()
 {
   assert(!valid());
 
-  for (auto* brushNode : m_invalidBrushes)
+  invalidateRenderedBrushRanges();
+
+  const auto invalidBrushes =
+    std::vector<const mdl::BrushNode*>{m_invalidBrushes.begin(), m_invalidBrushes.end()};
+  auto settings = std::vector<Filter::RenderSettings>(invalidBrushes.size());
+
+  const auto wrapper = FilterWrapper{*m_filter, m_showHiddenBrushes};
+  const auto prepareBrush = [&](const size_t i) {
+    const auto& brushNode = *invalidBrushes[i];
+
+    // evaluate filter. only evaluate the filter once per brush.
+    settings[i] = wrapper.markFaces(brushNode);
+    if (!renderNothing(settings[i]))
+    {
+      brushNode.brushRendererBrushCache().validateVertexCache(brushNode);
+    }
+  };
+
+  if (m_taskManager)
   {
-    validateBrush(*brushNode);
+    m_taskManager->parallel_for(size_t(0), invalidBrushes.size(), prepareBrush);
+  }
+  else
+  {
+    for (size_t i = 0; i < invalidBrushes.size(); ++i)
+    {
+      prepareBrush(i);
+    }
+  }
+
+  for (size_t i = 0; i < invalidBrushes.size(); ++i)
+  {
+    validateBrush(*invalidBrushes[i], settings[i]);
   }
   m_invalidBrushes.clear();
   assert(valid());
@@ -508,31 +654,25 @@ bool BrushRenderer::shouldDrawFaceInTransparentPass(
   return false;
 }
 
-void BrushRenderer::validateBrush(const mdl::BrushNode& brushNode)
+void BrushRenderer::validateBrush(
+  const mdl::BrushNode& brushNode, const Filter::RenderSettings settings)
 {
   assert(m_allBrushes.find(&brushNode) != std::end(m_allBrushes));
   assert(m_invalidBrushes.find(&brushNode) != std::end(m_invalidBrushes));
   assert(m_brushInfo.find(&brushNode) == std::end(m_brushInfo));
 
-  const auto wrapper = FilterWrapper{*m_filter, m_showHiddenBrushes};
-
-  // evaluate filter. only evaluate the filter once per brush.
-  const auto settings = wrapper.markFaces(brushNode);
-  const auto [facePolicy, edgePolicy] = settings;
-
-  if (
-    facePolicy == Filter::FaceRenderPolicy::RenderNone
-    && edgePolicy == Filter::EdgeRenderPolicy::RenderNone)
+  if (renderNothing(settings))
   {
     // NOTE: this skips inserting the brush into m_brushInfo
     return;
   }
 
+  const auto edgePolicy = std::get<Filter::EdgeRenderPolicy>(settings);
+
   BrushInfo& info = m_brushInfo[&brushNode];
 
-  // collect vertices
-  auto& brushCache = brushNode.brushRendererBrushCache();
-  brushCache.validateVertexCache(brushNode);
+  // collect vertices, the vertex cache was built in validate
+  const auto& brushCache = brushNode.brushRendererBrushCache();
   const auto& cachedVertices = brushCache.cachedVertices();
   ensure(!cachedVertices.empty(), "Brush must have cached vertices");
 
@@ -710,6 +850,7 @@ void BrushRenderer::removeBrushFromVbo(const mdl::BrushNode& brushNode)
   }
 
   const auto& info = it->second;
+  invalidateRenderedBrushRanges();
 
   // update Vbo's
   m_vertexArray->deleteVerticesWithKey(info.vertexHolderKey);
@@ -27,11 +27,17 @@
 #include "render/FaceRenderer.h"
 
 #include <memory>
+#include <optional>
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+namespace kdl
+{
+class task_manager;
+}
+
 namespace tb::mdl
 {
 class BrushNode;
@@ -41,6 +47,7 @@ class EditorContext;
 
 namespace tb::render
 {
+class Camera;
 
 class BrushRenderer
 {
@@ -75,6 +82,8 @@ public:
      *
      * Otherwise, markFaces() should call BrushFace::setMarked() on *all* faces, passing
      * true or false as needed to select the faces to be rendered.
+     *
+     * This may be called concurrently for different brushes.
      */
     virtual RenderSettings markFaces(const mdl::BrushNode& brush) const = 0;
 
@@ -118,6 +127,7 @@ public:
 
 private:
   std::unique_ptr<Filter> m_filter;
+  kdl::task_manager* m_taskManager = nullptr;
 
   struct BrushInfo
   {
@@ -151,6 +161,29 @@ private:
   std::shared_ptr<MaterialToBrushIndicesMap> m_transparentFaces;
   std::shared_ptr<MaterialToBrushIndicesMap> m_opaqueFaces;
 
+  using MaterialToBrushIndexRangesMap =
+    std::unordered_map<const mdl::Material*, BrushIndexRanges>;
+
+  /**
+   * The brushes to render for one camera. Their index ranges are computed lazily
+   * whenever the arrays or the brushes have changed.
+   */
+  struct RenderedBrushes
+  {
+    std::vector<const mdl::BrushNode*> brushes;
+    bool rangesValid = false;
+    std::shared_ptr<BrushIndexRanges> edgeRanges;
+    std::shared_ptr<MaterialToBrushIndexRangesMap> transparentFaceRanges;
+    std::shared_ptr<MaterialToBrushIndexRangesMap> opaqueFaceRanges;
+  };
+
+  /**
+   * If a camera has an entry, only the entry's brushes are rendered for that camera.
+   * Each view has its own camera, so the views that share this renderer keep their
+   * index ranges when they are drawn in turn.
+   */
+  std::unordered_map<const Camera*, RenderedBrushes> m_renderedBrushes;
+
   FaceRenderer m_opaqueFaceRenderer;
   FaceRenderer m_transparentFaceRenderer;
   IndexedEdgeRenderer m_edgeRenderer;
@@ -169,9 +202,15 @@ private:
   bool m_showHiddenBrushes = false;
 
 public:
+  /**
+   * Creates a brush renderer with the given filter. If a task manager is given, the
+   * filter is evaluated and the brushes' vertex caches are built in parallel when the
+   * renderer is validated.
+   */
   template <typename FilterT>
-  explicit BrushRenderer(FilterT filter)
+  explicit BrushRenderer(FilterT filter, kdl::task_manager* taskManager = nullptr)
     : m_filter{std::make_unique<FilterT>(std::move(filter))}
+    , m_taskManager{taskManager}
   {
     clear();
   }
@@ -270,18 +309,39 @@ public:
    */
   void setShowHiddenBrushes(bool showHiddenBrushes);
 
+  /**
+   * Restricts rendering with the given camera to the given brushes, e.g. the brushes
+   * that are in its view. All brushes stay in the shared vertex and index arrays, and
+   * only the index ranges of the given brushes are drawn, still with one draw call per
+   * material. If std::nullopt is given, all brushes are rendered with the given camera.
+   *
+   * Brushes that were not added to this renderer are ignored.
+   */
+  void setRenderedBrushes(
+    const Camera& camera, std::optional<std::vector<const mdl::BrushNode*>> brushes);
+
 public: // rendering
   void render(RenderContext& renderContext, RenderBatch& renderBatch);
   void renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
   void renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
 
 private:
+  void invalidateRenderedBrushRanges();
+  void validateRenderedBrushRanges(const Camera& camera);
   void renderOpaqueFaces(RenderBatch& renderBatch);
   void renderTransparentFaces(RenderBatch& renderBatch);
   void renderEdges(RenderBatch& renderBatch);
 
 public:
   /**
+   * Uploads the invalid brushes into the vertex and index arrays.
+   *
+   * This happens in two phases. First, the filter is evaluated and the vertex cache is
+   * built for every invalid brush. Since this only touches the brushes themselves, it
+   * runs in parallel if this renderer has a task manager. Then the blocks are allocated
+   * in the arrays and the vertices and indices are copied into them on the calling
+   * thread.
+   *
    * Only exposed for benchmarking.
    */
   void validate();
@@ -289,7 +349,7 @@ public:
 private:
   bool shouldDrawFaceInTransparentPass(
     const mdl::BrushNode& brushNode, const mdl::BrushFace& face) const;
-  void validateBrush(const mdl::BrushNode& brushNode);
+  void validateBrush(const mdl::BrushNode& brushNode, Filter::RenderSettings settings);
 
 public:
   /**
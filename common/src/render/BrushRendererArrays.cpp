@@ -102,6 +102,27 @@ void IndexHolder::render(const PrimType primType, const size_t offset, size_t co
   glAssert(glDrawElements(toGL(primType), renderCount, glType<Index>(), renderOffset));
 }
 
+void IndexHolder::render(
+  const PrimType primType, const GLIndices& offsets, const GLCounts& counts) const
+{
+  assert(offsets.size() == counts.size());
+
+  auto renderOffsets = std::vector<const GLvoid*>{};
+  renderOffsets.reserve(offsets.size());
+  for (const auto offset : offsets)
+  {
+    renderOffsets.push_back(reinterpret_cast<const GLvoid*>(
+      m_vbo->offset() + sizeof(Index) * static_cast<size_t>(offset)));
+  }
+
+  glAssert(glMultiDrawElements(
+    toGL(primType),
+    counts.data(),
+    glType<Index>(),
+    renderOffsets.data(),
+    static_cast<GLsizei>(counts.size())));
+}
+
 std::shared_ptr<IndexHolder> IndexHolder::swap(std::vector<IndexHolder::Index>& elements)
 {
   return std::make_shared<IndexHolder>(elements);
@@ -109,6 +130,38 @@ std::shared_ptr<IndexHolder> IndexHolder::swap(std::vector<IndexHolder::Index>&
 
 VertexArrayInterface::~VertexArrayInterface() {}
 
+// BrushIndexRanges
+
+void BrushIndexRanges::add(const size_t offset, const size_t count)
+{
+  if (
+    !m_offsets.empty()
+    && static_cast<size_t>(m_offsets.back() + m_counts.back()) == offset)
+  {
+    m_counts.back() += static_cast<GLsizei>(count);
+  }
+  else
+  {
+    m_offsets.push_back(static_cast<GLint>(offset));
+    m_counts.push_back(static_cast<GLsizei>(count));
+  }
+}
+
+bool BrushIndexRanges::empty() const
+{
+  return m_offsets.empty();
+}
+
+const GLIndices& BrushIndexRanges::offsets() const
+{
+  return m_offsets;
+}
+
+const GLCounts& BrushIndexRanges::counts() const
+{
+  return m_counts;
+}
+
 // BrushIndexArray
 
 BrushIndexArray::BrushIndexArray() = default;
@@ -157,6 +210,13 @@ void BrushIndexArray::render(const PrimType primType) const
   m_indexHolder.render(primType, 0, m_indexHolder.size());
 }
 
+void BrushIndexArray::render(
+  const PrimType primType, const BrushIndexRanges& ranges) const
+{
+  assert(m_indexHolder.prepared());
+  m_indexHolder.render(primType, ranges.offsets(), ranges.counts());
+}
+
 bool BrushIndexArray::prepared() const
 {
   return m_indexHolder.prepared();
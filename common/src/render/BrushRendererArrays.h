@@ -27,7 +27,9 @@
 #include "render/ShaderManager.h" // IWYU pragma: keep
 #include "render/Vbo.h"
 #include "render/VboManager.h"
+#include "render/VertexArray.h"
 
+#include <algorithm>
 #include <cassert>
 #include <memory>
 #include <vector>
@@ -220,6 +222,8 @@ public:
 
   size_t size() const { return m_snapshot.size(); }
 
+  const std::vector<T>& elements() const { return m_snapshot; }
+
   void bindBlock() { m_vbo->bind(); }
 
   void unbindBlock() { m_vbo->unbind(); }
@@ -237,10 +241,29 @@ public:
   explicit IndexHolder(std::vector<Index>& elements);
   void zeroRange(size_t offsetWithinBlock, size_t count);
   void render(PrimType primType, size_t offset, size_t count) const;
+  void render(PrimType primType, const GLIndices& offsets, const GLCounts& counts) const;
 
   static std::shared_ptr<IndexHolder> swap(std::vector<Index>& elements);
 };
 
+/**
+ * Ranges of indices in a BrushIndexArray that are rendered with a single draw call. A
+ * range that starts where the previously added range ends is merged with it.
+ */
+class BrushIndexRanges
+{
+private:
+  GLIndices m_offsets;
+  GLCounts m_counts;
+
+public:
+  void add(size_t offset, size_t count);
+  bool empty() const;
+
+  const GLIndices& offsets() const;
+  const GLCounts& counts() const;
+};
+
 /**
  * VboBlock handle that supports dynamically allocating ranges of indices, grows as
  * needed, and also supports freeing allocations and zeroing the corresponding indicies so
@@ -279,6 +302,12 @@ public:
   void zeroElementsWithKey(AllocationTracker::Block* key);
 
   void render(PrimType primType) const;
+
+  /**
+   * Renders only the given ranges of indices.
+   */
+  void render(PrimType primType, const BrushIndexRanges& ranges) const;
+
   bool prepared() const;
   void prepare(VboManager& vboManager);
 
@@ -377,4 +406,73 @@ public:
   bool prepared() const;
   void prepare(VboManager& vboManager);
 };
+
+/**
+ * Same as BrushVertexArray but for any vertex type, and for drawing the vertices directly
+ * instead of through indices. Therefore, deleteVerticesWithKey() zeroes the deleted
+ * vertices so that they become degenerate primitives.
+ */
+template <typename V>
+class DynamicVertexArray
+{
+private:
+  std::shared_ptr<VertexHolder<V>> m_vertexHolder = std::make_shared<VertexHolder<V>>();
+  AllocationTracker m_allocationTracker;
+
+public:
+  /**
+   * Call this to request writing the given number of vertices.
+   *
+   * The VboBlock will be expanded if needed to accommodate the allocation.
+   *
+   * Returns a AllocationTracker::Block pointer which can be used later in a call to
+   * deleteVerticesWithKey(), and also a Vertex pointer where the caller should write
+   * `elementCount` Vertex objects.
+   */
+  std::pair<AllocationTracker::Block*, V*> getPointerToInsertVerticesAt(
+    const size_t vertexCount)
+  {
+    auto* block = m_allocationTracker.allocate(vertexCount);
+    if (block == nullptr)
+    {
+      const auto newSize = std::max(
+        2 * m_allocationTracker.capacity(), m_allocationTracker.capacity() + vertexCount);
+      m_allocationTracker.expand(newSize);
+      m_vertexHolder->resize(newSize);
+
+      block = m_allocationTracker.allocate(vertexCount);
+      assert(block != nullptr);
+    }
+
+    auto* dest = m_vertexHolder->getPointerToWriteElementsTo(block->pos, vertexCount);
+    return {block, dest};
+  }
+
+  /**
+   * Zeroes the vertices for the given key and marks the allocation as free.
+   */
+  void deleteVerticesWithKey(AllocationTracker::Block* key)
+  {
+    auto* dest = m_vertexHolder->getPointerToWriteElementsTo(key->pos, key->size);
+    std::fill_n(dest, key->size, V{});
+    m_allocationTracker.free(key);
+  }
+
+  /**
+   * Returns all vertices of this array, including the zeroed ones.
+   */
+  const std::vector<V>& vertices() const { return m_vertexHolder->elements(); }
+
+  /**
+   * Returns a vertex array that renders all vertices of this array, including the
+   * zeroed ones. The returned vertex array only covers the current capacity of this
+   * array, so it must be recreated when this array grows.
+   */
+  VertexArray vertexArray() const
+  {
+    return VertexArray::shared(
+      m_vertexHolder, m_vertexHolder->size(), m_vertexHolder->size() * sizeof(V));
+  }
+};
+
 } // namespace tb::render
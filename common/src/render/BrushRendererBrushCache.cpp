@@ -67,6 +67,13 @@ void BrushRendererBrushCache::validateVertexCache(const mdl::BrushNode& brushNod
   m_cachedFacesSortedByMaterial.clear();
   m_cachedFacesSortedByMaterial.reserve(brush.faceCount());
 
+  // Maps each vertex to its index relative to the brush's first vertex being 0. This is
+  // used below when building the edge cache. We cannot store the indices in the vertex
+  // payloads because the brush geometry may be shared with other brushes whose caches
+  // are validated concurrently.
+  auto vertexIndices = std::vector<std::pair<const mdl::BrushVertex*, size_t>>{};
+  vertexIndices.reserve(2u * brush.edgeCount());
+
   for (const auto& face : brush.faces())
   {
     const auto indexOfFirstVertexRelativeToBrush = m_cachedVertices.size();
@@ -75,15 +82,13 @@ void BrushRendererBrushCache::validateVertexCache(const mdl::BrushNode& brushNod
     auto& boundary = face.geometry()->boundary();
     for (auto it = std::rbegin(boundary), end = std::rend(boundary); it != end; ++it)
     {
-      auto* currentHalfEdge = *it;
-      auto* vertex = currentHalfEdge->origin();
+      const auto* currentHalfEdge = *it;
+      const auto* vertex = currentHalfEdge->origin();
 
-      // Set the vertex payload to the index, relative to the brush's first vertex being
-      // 0. This is used below when building the edge cache. NOTE: we'll overwrite the
-      // payload as we visit the same vertex several times while visiting different faces,
-      // this is fine.
+      // NOTE: we'll visit the same vertex several times while visiting different faces,
+      // but we only need to remember one of its indices.
       const auto currentIndex = m_cachedVertices.size();
-      vertex->setPayload(static_cast<GLuint>(currentIndex));
+      vertexIndices.emplace_back(vertex, currentIndex);
 
       const auto& position = vertex->position();
       m_cachedVertices.emplace_back(
@@ -105,6 +110,17 @@ void BrushRendererBrushCache::validateVertexCache(const mdl::BrushNode& brushNod
     m_cachedFacesSortedByMaterial.end(),
     [](const CachedFace& a, const CachedFace& b) { return a.material < b.material; });
 
+  std::sort(vertexIndices.begin(), vertexIndices.end());
+  const auto vertexIndex = [&](const mdl::BrushVertex* vertex) {
+    const auto it = std::lower_bound(
+      vertexIndices.begin(),
+      vertexIndices.end(),
+      vertex,
+      [](const auto& entry, const auto* v) { return entry.first < v; });
+    assert(it != vertexIndices.end() && it->first == vertex);
+    return it->second;
+  };
+
   // Build edge index cache
 
   m_cachedEdges.clear();
@@ -119,8 +135,8 @@ void BrushRendererBrushCache::validateVertexCache(const mdl::BrushNode& brushNod
     const auto& face1 = brush.face(*faceIndex1);
     const auto& face2 = brush.face(*faceIndex2);
 
-    const auto vertexIndex1RelativeToBrush = currentEdge->firstVertex()->payload();
-    const auto vertexIndex2RelativeToBrush = currentEdge->secondVertex()->payload();
+    const auto vertexIndex1RelativeToBrush = vertexIndex(currentEdge->firstVertex());
+    const auto vertexIndex2RelativeToBrush = vertexIndex(currentEdge->secondVertex());
 
     m_cachedEdges.push_back(CachedEdge{
       &face1, &face2, vertexIndex1RelativeToBrush, vertexIndex2RelativeToBrush});
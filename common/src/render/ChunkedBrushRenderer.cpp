@@ -0,0 +1,172 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ChunkedBrushRenderer.h"
+
+#include "mdl/BrushNode.h"
+#include "render/RenderContext.h"
+#include "render/ViewFrustum.h"
+
+#include "kdl/vector_utils.h"
+
+namespace tb::render
+{
+
+void ChunkedBrushRenderer::clear()
+{
+  m_renderer.clear();
+  m_chunks.clear();
+  m_visibleChunks.clear();
+}
+
+void ChunkedBrushRenderer::invalidate()
+{
+  m_renderer.invalidate();
+}
+
+void ChunkedBrushRenderer::invalidateMaterials(
+  const std::vector<const mdl::Material*>& materials)
+{
+  m_renderer.invalidateMaterials(materials);
+}
+
+void ChunkedBrushRenderer::invalidateBrush(const mdl::BrushNode* brushNode)
+{
+  if (const auto oldAddress = m_chunks.address(brushNode))
+  {
+    if (m_chunks.insert(brushNode) != *oldAddress)
+    {
+      m_visibleChunks.clear();
+    }
+    m_renderer.invalidateBrush(brushNode);
+  }
+}
+
+void ChunkedBrushRenderer::setFaceColor(const Color& faceColor)
+{
+  m_renderer.setFaceColor(faceColor);
+}
+
+void ChunkedBrushRenderer::setShowEdges(const bool showEdges)
+{
+  m_renderer.setShowEdges(showEdges);
+}
+
+void ChunkedBrushRenderer::setEdgeColor(const Color& edgeColor)
+{
+  m_renderer.setEdgeColor(edgeColor);
+}
+
+void ChunkedBrushRenderer::setTint(const bool tint)
+{
+  m_renderer.setTint(tint);
+}
+
+void ChunkedBrushRenderer::setTintColor(const Color& tintColor)
+{
+  m_renderer.setTintColor(tintColor);
+}
+
+void ChunkedBrushRenderer::setShowOccludedEdges(const bool showOccludedEdges)
+{
+  m_renderer.setShowOccludedEdges(showOccludedEdges);
+}
+
+void ChunkedBrushRenderer::setOccludedEdgeColor(const Color& occludedEdgeColor)
+{
+  m_renderer.setOccludedEdgeColor(occludedEdgeColor);
+}
+
+void ChunkedBrushRenderer::setTransparencyAlpha(const float transparencyAlpha)
+{
+  m_renderer.setTransparencyAlpha(transparencyAlpha);
+}
+
+void ChunkedBrushRenderer::setShowHiddenBrushes(const bool showHiddenBrushes)
+{
+  m_renderer.setShowHiddenBrushes(showHiddenBrushes);
+}
+
+void ChunkedBrushRenderer::addBrush(const mdl::BrushNode* brushNode)
+{
+  if (!m_chunks.address(brushNode))
+  {
+    m_chunks.insert(brushNode);
+    m_renderer.addBrush(brushNode);
+    m_visibleChunks.clear();
+  }
+}
+
+void ChunkedBrushRenderer::removeBrush(const mdl::BrushNode* brushNode)
+{
+  if (m_chunks.remove(brushNode))
+  {
+    m_renderer.removeBrush(brushNode);
+    m_visibleChunks.clear();
+  }
+}
+
+void ChunkedBrushRenderer::renderOpaque(
+  RenderContext& renderContext, RenderBatch& renderBatch)
+{
+  updateRenderedBrushes(renderContext);
+  m_renderer.renderOpaque(renderContext, renderBatch);
+}
+
+void ChunkedBrushRenderer::renderTransparent(
+  RenderContext& renderContext, RenderBatch& renderBatch)
+{
+  updateRenderedBrushes(renderContext);
+  m_renderer.renderTransparent(renderContext, renderBatch);
+}
+
+vm::bbox3d ChunkedBrushRenderer::getBrushBounds(const mdl::BrushNode* const& brushNode)
+{
+  return brushNode->logicalBounds();
+}
+
+void ChunkedBrushRenderer::updateRenderedBrushes(const RenderContext& renderContext)
+{
+  const auto& camera = renderContext.camera();
+  const auto frustum = ViewFrustum::fromCamera(camera);
+  auto visibleChunks = m_chunks.visibleChunks(frustum);
+  if (const auto it = m_visibleChunks.find(&camera);
+      it != m_visibleChunks.end() && it->second == visibleChunks)
+  {
+    return;
+  }
+
+  if (visibleChunks.size() == m_chunks.chunkCount())
+  {
+    m_renderer.setRenderedBrushes(camera, std::nullopt);
+  }
+  else
+  {
+    auto brushes = std::vector<const mdl::BrushNode*>{};
+    for (const auto& address : visibleChunks)
+    {
+      kdl::vec_concat(brushes, m_chunks.objects(address));
+    }
+    m_renderer.setRenderedBrushes(camera, std::move(brushes));
+  }
+
+  m_visibleChunks[&camera] = std::move(visibleChunks);
+}
+
+} // namespace tb::render
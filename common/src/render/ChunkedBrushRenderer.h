@@ -0,0 +1,121 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Color.h"
+#include "render/BrushRenderer.h"
+#include "render/RenderChunks.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace kdl
+{
+class task_manager;
+}
+
+namespace tb::mdl
+{
+class BrushNode;
+class Material;
+} // namespace tb::mdl
+
+namespace tb::render
+{
+class Camera;
+class RenderBatch;
+class RenderContext;
+
+/**
+ * Renders brushes in spatial chunks. All brushes share the vertex and index arrays of a
+ * single brush renderer. Only the brushes in chunks that intersect the camera's view
+ * frustum are drawn, using their index ranges in the shared arrays, so the number of
+ * draw calls does not grow with the number of chunks.
+ */
+class ChunkedBrushRenderer
+{
+private:
+  BrushRenderer m_renderer;
+  RenderChunks<const mdl::BrushNode*> m_chunks;
+
+  /**
+   * The chunks that were visible to each camera when the brushes to render with it were
+   * last determined. Each view has its own camera, so the views that share this renderer
+   * do not replace each other's brushes when they are drawn in turn.
+   */
+  std::unordered_map<const Camera*, std::vector<RenderChunkAddress>> m_visibleChunks;
+
+public:
+  /**
+   * Creates a chunked brush renderer. The given filter and task manager are passed to
+   * the brush renderer.
+   */
+  template <typename FilterT>
+  explicit ChunkedBrushRenderer(FilterT filter, kdl::task_manager* taskManager = nullptr)
+    : m_renderer{std::move(filter), taskManager}
+    , m_chunks{getBrushBounds}
+  {
+  }
+
+  void clear();
+  void invalidate();
+  void invalidateMaterials(const std::vector<const mdl::Material*>& materials);
+
+  /**
+   * Causes the given brush to be validated again. If its bounds have changed, it may be
+   * moved to another chunk.
+   */
+  void invalidateBrush(const mdl::BrushNode* brushNode);
+
+  void setFaceColor(const Color& faceColor);
+  void setShowEdges(bool showEdges);
+  void setEdgeColor(const Color& edgeColor);
+  void setTint(bool tint);
+  void setTintColor(const Color& tintColor);
+  void setShowOccludedEdges(bool showOccludedEdges);
+  void setOccludedEdgeColor(const Color& occludedEdgeColor);
+  void setTransparencyAlpha(float transparencyAlpha);
+  void setShowHiddenBrushes(bool showHiddenBrushes);
+
+  /**
+   * Adds a brush. Calling with an already-added brush is allowed, but ignored.
+   */
+  void addBrush(const mdl::BrushNode* brushNode);
+
+  /**
+   * Removes a brush. Calling with an unknown brush is allowed, but ignored.
+   */
+  void removeBrush(const mdl::BrushNode* brushNode);
+
+public: // rendering
+  void renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
+  void renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
+
+private:
+  static vm::bbox3d getBrushBounds(const mdl::BrushNode* const& brushNode);
+
+  /**
+   * Passes the brushes in the chunks visible to the given context's camera to the brush
+   * renderer if the visible chunks have changed since the last call with that camera.
+   */
+  void updateRenderedBrushes(const RenderContext& renderContext);
+};
+
+} // namespace tb::render
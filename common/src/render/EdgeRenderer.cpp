@@ -226,10 +226,12 @@ void DirectEdgeRenderer::doRender(
 IndexedEdgeRenderer::Render::Render(
   const EdgeRenderer::Params& params,
   std::shared_ptr<BrushVertexArray> vertexArray,
-  std::shared_ptr<BrushIndexArray> indexArray)
+  std::shared_ptr<BrushIndexArray> indexArray,
+  std::shared_ptr<const BrushIndexRanges> indexRanges)
   : RenderBase{params}
   , m_vertexArray{std::move(vertexArray)}
   , m_indexArray{std::move(indexArray)}
+  , m_indexRanges{std::move(indexRanges)}
 {
 }
 
@@ -241,7 +243,7 @@ void IndexedEdgeRenderer::Render::prepareVerticesAndIndices(VboManager& vboManag
 
 void IndexedEdgeRenderer::Render::doRender(RenderContext& renderContext)
 {
-  if (m_indexArray->hasValidIndices())
+  if (m_indexArray->hasValidIndices() && (!m_indexRanges || !m_indexRanges->empty()))
   {
     renderEdges(renderContext);
   }
@@ -251,7 +253,14 @@ void IndexedEdgeRenderer::Render::doRenderVertices(RenderContext&)
 {
   m_vertexArray->setupVertices();
   m_indexArray->setupIndices();
-  m_indexArray->render(PrimType::Lines);
+  if (m_indexRanges)
+  {
+    m_indexArray->render(PrimType::Lines, *m_indexRanges);
+  }
+  else
+  {
+    m_indexArray->render(PrimType::Lines);
+  }
   m_vertexArray->cleanupVertices();
   m_indexArray->cleanupIndices();
 }
@@ -268,10 +277,16 @@ IndexedEdgeRenderer::IndexedEdgeRenderer(
 {
 }
 
+void IndexedEdgeRenderer::setIndexRanges(
+  std::shared_ptr<const BrushIndexRanges> indexRanges)
+{
+  m_indexRanges = std::move(indexRanges);
+}
+
 void IndexedEdgeRenderer::doRender(
   RenderBatch& renderBatch, const EdgeRenderer::Params& params)
 {
-  renderBatch.addOneShot(new Render{params, m_vertexArray, m_indexArray});
+  renderBatch.addOneShot(new Render{params, m_vertexArray, m_indexArray, m_indexRanges});
 }
 
 } // namespace tb::render
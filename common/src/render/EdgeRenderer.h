@@ -29,6 +29,7 @@
 namespace tb::render
 {
 class BrushIndexArray;
+class BrushIndexRanges;
 class BrushVertexArray;
 class RenderBatch;
 
@@ -147,12 +148,14 @@ private:
   private:
     std::shared_ptr<BrushVertexArray> m_vertexArray;
     std::shared_ptr<BrushIndexArray> m_indexArray;
+    std::shared_ptr<const BrushIndexRanges> m_indexRanges;
 
   public:
     Render(
       const Params& params,
       std::shared_ptr<BrushVertexArray> vertexArray,
-      std::shared_ptr<BrushIndexArray> indexArray);
+      std::shared_ptr<BrushIndexArray> indexArray,
+      std::shared_ptr<const BrushIndexRanges> indexRanges);
 
   private:
     void prepareVerticesAndIndices(VboManager& vboManager) override;
@@ -163,6 +166,7 @@ private:
 private:
   std::shared_ptr<BrushVertexArray> m_vertexArray;
   std::shared_ptr<BrushIndexArray> m_indexArray;
+  std::shared_ptr<const BrushIndexRanges> m_indexRanges;
 
 public:
   IndexedEdgeRenderer();
@@ -170,6 +174,12 @@ public:
     std::shared_ptr<BrushVertexArray> vertexArray,
     std::shared_ptr<BrushIndexArray> indexArray);
 
+  /**
+   * Restricts rendering to the given ranges of the index array. If null, all indices are
+   * rendered.
+   */
+  void setIndexRanges(std::shared_ptr<const BrushIndexRanges> indexRanges);
+
 private:
   void doRender(RenderBatch& renderBatch, const EdgeRenderer::Params& params) override;
 };
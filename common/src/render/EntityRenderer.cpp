@@ -32,11 +32,13 @@
 #include "render/RenderContext.h"
 #include "render/RenderService.h"
 #include "render/TextAnchor.h"
+#include "render/ViewFrustum.h"
 
 #include "vm/mat.h"
 #include "vm/mat_ext.h"
 #include "vm/vec.h"
 
+#include <algorithm>
 #include <vector>
 
 namespace tb::render
@@ -73,12 +75,15 @@ EntityRenderer::EntityRenderer(
   const mdl::EditorContext& editorContext)
   : m_entityModelManager{entityModelManager}
   , m_editorContext{editorContext}
+  , m_chunks{[](const auto* entity) { return entity->physicalBounds(); }}
   , m_modelRenderer{logger, m_entityModelManager, m_editorContext}
 {
+  invalidateBounds();
 }
 
 void EntityRenderer::invalidate()
 {
+  m_chunks.invalidateBounds();
   invalidateBounds();
   reloadModels();
 }
@@ -86,6 +91,8 @@ void EntityRenderer::invalidate()
 void EntityRenderer::clear()
 {
   m_entities.clear();
+  m_chunks.clear();
+  invalidateBounds();
   m_pointEntityWireframeBoundsRenderer = DirectEdgeRenderer();
   m_brushEntityWireframeBoundsRenderer = DirectEdgeRenderer();
   m_solidBoundsRenderer = TriangleRenderer();
@@ -101,8 +108,9 @@ void EntityRenderer::addEntity(const mdl::EntityNode* entity)
 {
   if (m_entities.insert(entity).second)
   {
+    m_chunks.insert(entity);
     m_modelRenderer.addEntity(entity);
-    invalidateBounds();
+    invalidateEntityBounds(entity);
   }
 }
 
@@ -111,15 +119,21 @@ void EntityRenderer::removeEntity(const mdl::EntityNode* entity)
   if (auto it = m_entities.find(entity); it != std::end(m_entities))
   {
     m_entities.erase(it);
+    m_chunks.remove(entity);
     m_modelRenderer.removeEntity(entity);
-    invalidateBounds();
+    invalidateEntityBounds(entity);
   }
 }
 
 void EntityRenderer::invalidateEntity(const mdl::EntityNode* entity)
 {
+  if (m_chunks.address(entity))
+  {
+    // the entity's bounds may have changed
+    m_chunks.insert(entity);
+  }
   m_modelRenderer.updateEntity(entity);
-  invalidateBounds();
+  invalidateEntityBounds(entity);
 }
 
 void EntityRenderer::invalidateEntityModels(
@@ -168,12 +182,21 @@ void EntityRenderer::setTintColor(const Color& tintColor)
 
 void EntityRenderer::setOverrideBoundsColor(const bool overrideBoundsColor)
 {
-  m_overrideBoundsColor = overrideBoundsColor;
+  if (overrideBoundsColor != m_overrideBoundsColor)
+  {
+    m_overrideBoundsColor = overrideBoundsColor;
+    // the solid bounds are colored with the override color
+    invalidateBounds();
+  }
 }
 
 void EntityRenderer::setBoundsColor(const Color& boundsColor)
 {
-  m_boundsColor = boundsColor;
+  if (boundsColor != m_boundsColor)
+  {
+    m_boundsColor = boundsColor;
+    invalidateBounds();
+  }
 }
 
 void EntityRenderer::setShowOccludedBounds(const bool showOccludedBounds)
@@ -212,6 +235,24 @@ void EntityRenderer::render(RenderContext& renderContext, RenderBatch& renderBat
   }
 }
 
+const DynamicVertexArray<EntityRenderer::WireframeVertex>& EntityRenderer::
+  pointEntityWireframeVertices() const
+{
+  return *m_pointEntityWireframeVertices;
+}
+
+const DynamicVertexArray<EntityRenderer::WireframeVertex>& EntityRenderer::
+  brushEntityWireframeVertices() const
+{
+  return *m_brushEntityWireframeVertices;
+}
+
+const DynamicVertexArray<EntityRenderer::SolidVertex>& EntityRenderer::
+  solidBoundsVertices() const
+{
+  return *m_solidBoundsVertices;
+}
+
 void EntityRenderer::renderBounds(RenderContext& renderContext, RenderBatch& renderBatch)
 {
   if (!m_boundsValid)
@@ -288,8 +329,9 @@ void EntityRenderer::renderClassnames(
     renderService.setForegroundColor(m_overlayTextColor);
     renderService.setBackgroundColor(m_overlayBackgroundColor);
 
-    for (const auto* entity : m_entities)
-    {
+    // only the entities in chunks that intersect the view frustum can be on screen
+    const auto frustum = ViewFrustum::fromCamera(renderContext.camera());
+    m_chunks.forEachVisibleObject(frustum, [&](const auto* entity) {
       if (m_showHiddenEntities || m_editorContext.visible(entity))
       {
         if (
@@ -308,7 +350,7 @@ void EntityRenderer::renderClassnames(
           renderService.renderString(entityString(entity), EntityClassnameAnchor{entity});
         }
       }
-    }
+    });
   }
 }
 
@@ -324,11 +366,11 @@ void EntityRenderer::renderAngles(RenderContext& renderContext, RenderBatch& ren
     renderService.setShowOccludedObjectsTransparent();
     renderService.setForegroundColor(m_angleColor);
 
-    for (const auto* entityNode : m_entities)
-    {
+    const auto frustum = ViewFrustum::fromCamera(renderContext.camera());
+    m_chunks.forEachVisibleObject(frustum, [&](const auto* entityNode) {
       if (!m_showHiddenEntities && !m_editorContext.visible(entityNode))
       {
-        continue;
+        return;
       }
 
       const auto rotation = vm::mat4x4f{entityNode->entity().rotation()};
@@ -342,13 +384,13 @@ void EntityRenderer::renderAngles(RenderContext& renderContext, RenderBatch& ren
         renderContext.camera().perspectiveProjection()
         && vm::squared_length(toCam) > maxDistance2)
       {
-        continue;
+        return;
       }
 
       auto onPlane = toCam - vm::dot(toCam, direction) * direction;
       if (vm::is_zero(onPlane, vm::Cf::almost_zero()))
       {
-        continue;
+        return;
       }
 
       onPlane = vm::normalize(onPlane);
@@ -363,7 +405,7 @@ void EntityRenderer::renderAngles(RenderContext& renderContext, RenderBatch& ren
       const auto vertices =
         kdl::vec_transform(arrow, [&](const auto& x) { return matrix * x; });
       renderService.renderPolygonOutline(vertices);
-    }
+    });
   }
 }
 
@@ -380,19 +422,24 @@ std::vector<vm::vec3f> EntityRenderer::arrowHead(
 
 void EntityRenderer::invalidateBounds()
 {
+  m_pointEntityWireframeVertices =
+    std::make_unique<DynamicVertexArray<WireframeVertex>>();
+  m_brushEntityWireframeVertices =
+    std::make_unique<DynamicVertexArray<WireframeVertex>>();
+  m_solidBoundsVertices = std::make_unique<DynamicVertexArray<SolidVertex>>();
+  m_boundsBlocks.clear();
+  m_invalidBounds = {m_entities.begin(), m_entities.end()};
   m_boundsValid = false;
 }
 
-namespace
+void EntityRenderer::invalidateEntityBounds(const mdl::EntityNode* entityNode)
 {
+  m_invalidBounds.insert(entityNode);
+  m_boundsValid = false;
+}
 
-auto makeWireFrameBoundsVertexBuilder(std::vector<GLVertexTypes::P3::Vertex>& vertices)
+namespace
 {
-  return [&](const vm::vec3d& v1, const vm::vec3d& v2) {
-    vertices.emplace_back(vm::vec3f{v1});
-    vertices.emplace_back(vm::vec3f{v2});
-  };
-}
 
 auto makeColoredWireFrameBoundsVertexBuilder(
   std::vector<GLVertexTypes::P3C4::Vertex>& vertices, const Color& color)
@@ -419,99 +466,98 @@ auto makeColoredSolidBoundsVertexBuilder(
   };
 }
 
+template <typename V>
+AllocationTracker::Block* insertVertices(
+  DynamicVertexArray<V>& vertexArray, const std::vector<V>& vertices)
+{
+  auto [block, dest] = vertexArray.getPointerToInsertVerticesAt(vertices.size());
+  std::ranges::copy(vertices, dest);
+  return block;
+}
+
 } // namespace
 
 void EntityRenderer::validateBounds()
 {
-  auto solidVertices = std::vector<GLVertexTypes::P3NC4::Vertex>{};
-  solidVertices.reserve(36 * m_entities.size());
-
-  if (m_overrideBoundsColor)
+  // only the invalid entities are rewritten, the bounds of all other entities stay where
+  // they are in the vertex arrays
+  for (const auto* entityNode : m_invalidBounds)
   {
-    using Vertex = GLVertexTypes::P3::Vertex;
-    auto pointEntityWireframeVertices = std::vector<Vertex>{};
-    auto brushEntityWireframeVertices = std::vector<Vertex>{};
+    // the entity may have been removed already, so only dereference it if it's known
+    removeEntityBounds(entityNode);
+    if (m_entities.count(entityNode) && m_editorContext.visible(entityNode))
+    {
+      addEntityBounds(entityNode);
+    }
+  }
+  m_invalidBounds.clear();
 
-    pointEntityWireframeVertices.reserve(24 * m_entities.size());
-    brushEntityWireframeVertices.reserve(24 * m_entities.size());
+  // the renderers share the vertex arrays and upload only the changed vertices
+  m_pointEntityWireframeBoundsRenderer =
+    DirectEdgeRenderer{m_pointEntityWireframeVertices->vertexArray(), PrimType::Lines};
+  m_brushEntityWireframeBoundsRenderer =
+    DirectEdgeRenderer{m_brushEntityWireframeVertices->vertexArray(), PrimType::Lines};
+  m_solidBoundsRenderer =
+    TriangleRenderer{m_solidBoundsVertices->vertexArray(), PrimType::Quads};
+
+  m_boundsValid = true;
+}
+
+void EntityRenderer::addEntityBounds(const mdl::EntityNode* entityNode)
+{
+  auto& blocks = m_boundsBlocks[entityNode];
+  const auto& bounds = entityNode->logicalBounds();
+
+  // if the bounds color is overridden, it is applied when rendering the wireframe
+  auto wireframeVertices = std::vector<WireframeVertex>{};
+  bounds.for_each_edge(
+    makeColoredWireFrameBoundsVertexBuilder(wireframeVertices, boundsColor(entityNode)));
 
-    for (const auto* entityNode : m_entities)
+  const auto isPointEntity = !entityNode->hasChildren();
+  if (isPointEntity)
+  {
+    blocks.pointEntityWireframe =
+      insertVertices(*m_pointEntityWireframeVertices, wireframeVertices);
+
+    const auto hasModel =
+      entityNode->entity().model() && entityNode->entity().model()->data();
+    if (!hasModel)
     {
-      if (m_editorContext.visible(entityNode))
-      {
-        const auto pointEntity = !entityNode->hasChildren();
-        if (pointEntity)
-        {
-          entityNode->logicalBounds().for_each_edge(
-            makeWireFrameBoundsVertexBuilder(pointEntityWireframeVertices));
+      const auto& solidColor =
+        m_overrideBoundsColor ? m_boundsColor : boundsColor(entityNode);
 
-          const auto hasModel =
-            entityNode->entity().model() && entityNode->entity().model()->data();
-          if (!hasModel)
-          {
-            entityNode->logicalBounds().for_each_face(
-              makeColoredSolidBoundsVertexBuilder(solidVertices, m_boundsColor));
-          }
-        }
-        else
-        {
-          entityNode->logicalBounds().for_each_edge(
-            makeWireFrameBoundsVertexBuilder(brushEntityWireframeVertices));
-        }
-      }
+      auto solidVertices = std::vector<SolidVertex>{};
+      bounds.for_each_face(
+        makeColoredSolidBoundsVertexBuilder(solidVertices, solidColor));
+      blocks.solid = insertVertices(*m_solidBoundsVertices, solidVertices);
     }
-
-    m_pointEntityWireframeBoundsRenderer = DirectEdgeRenderer{
-      VertexArray::move(std::move(pointEntityWireframeVertices)), PrimType::Lines};
-    m_brushEntityWireframeBoundsRenderer = DirectEdgeRenderer{
-      VertexArray::move(std::move(brushEntityWireframeVertices)), PrimType::Lines};
   }
   else
   {
-    using Vertex = GLVertexTypes::P3C4::Vertex;
-    auto pointEntityWireframeVertices = std::vector<Vertex>{};
-    auto brushEntityWireframeVertices = std::vector<Vertex>{};
-
-    pointEntityWireframeVertices.reserve(24 * m_entities.size());
-    brushEntityWireframeVertices.reserve(24 * m_entities.size());
+    blocks.brushEntityWireframe =
+      insertVertices(*m_brushEntityWireframeVertices, wireframeVertices);
+  }
+}
 
-    for (auto* entityNode : m_entities)
+void EntityRenderer::removeEntityBounds(const mdl::EntityNode* entityNode)
+{
+  if (const auto it = m_boundsBlocks.find(entityNode); it != m_boundsBlocks.end())
+  {
+    const auto& blocks = it->second;
+    if (blocks.pointEntityWireframe)
     {
-      if (m_editorContext.visible(entityNode))
-      {
-        const auto isPointEntity = !entityNode->hasChildren();
-        if (isPointEntity)
-        {
-          entityNode->logicalBounds().for_each_edge(
-            makeColoredWireFrameBoundsVertexBuilder(
-              pointEntityWireframeVertices, boundsColor(entityNode)));
-
-          const auto hasModel =
-            entityNode->entity().model() && entityNode->entity().model()->data();
-          if (!hasModel)
-          {
-            entityNode->logicalBounds().for_each_face(makeColoredSolidBoundsVertexBuilder(
-              solidVertices, boundsColor(entityNode)));
-          }
-        }
-        else
-        {
-          entityNode->logicalBounds().for_each_edge(
-            makeColoredWireFrameBoundsVertexBuilder(
-              brushEntityWireframeVertices, boundsColor(entityNode)));
-        }
-      }
+      m_pointEntityWireframeVertices->deleteVerticesWithKey(blocks.pointEntityWireframe);
     }
-
-    m_pointEntityWireframeBoundsRenderer = DirectEdgeRenderer(
-      VertexArray::move(std::move(pointEntityWireframeVertices)), PrimType::Lines);
-    m_brushEntityWireframeBoundsRenderer = DirectEdgeRenderer(
-      VertexArray::move(std::move(brushEntityWireframeVertices)), PrimType::Lines);
+    if (blocks.brushEntityWireframe)
+    {
+      m_brushEntityWireframeVertices->deleteVerticesWithKey(blocks.brushEntityWireframe);
+    }
+    if (blocks.solid)
+    {
+      m_solidBoundsVertices->deleteVerticesWithKey(blocks.solid);
+    }
+    m_boundsBlocks.erase(it);
   }
-
-  m_solidBoundsRenderer =
-    TriangleRenderer{VertexArray::move(std::move(solidVertices)), PrimType::Quads};
-  m_boundsValid = true;
 }
 
 AttrString EntityRenderer::entityString(const mdl::EntityNode* entityNode) const
@@ -20,13 +20,20 @@
 #pragma once
 
 #include "Color.h"
+#include "render/AllocationTracker.h"
+#include "render/BrushRendererArrays.h"
 #include "render/EdgeRenderer.h"
 #include "render/EntityModelRenderer.h"
+#include "render/GLVertexType.h"
+#include "render/RenderChunks.h"
 #include "render/Renderable.h"
 #include "render/TriangleRenderer.h"
 
 #include "kdl/vector_set.h"
 
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace tb
@@ -48,10 +55,31 @@ class AttrString;
 
 class EntityRenderer
 {
+public:
+  using WireframeVertex = GLVertexTypes::P3C4::Vertex;
+  using SolidVertex = GLVertexTypes::P3NC4::Vertex;
+
 private:
+  /**
+   * The blocks that the bounds of an entity occupy in the bounds vertex arrays.
+   */
+  struct BoundsBlocks
+  {
+    AllocationTracker::Block* pointEntityWireframe = nullptr;
+    AllocationTracker::Block* brushEntityWireframe = nullptr;
+    AllocationTracker::Block* solid = nullptr;
+  };
+
   mdl::EntityModelManager& m_entityModelManager;
   const mdl::EditorContext& m_editorContext;
   kdl::vector_set<const mdl::EntityNode*> m_entities;
+  RenderChunks<const mdl::EntityNode*> m_chunks;
+
+  std::unique_ptr<DynamicVertexArray<WireframeVertex>> m_pointEntityWireframeVertices;
+  std::unique_ptr<DynamicVertexArray<WireframeVertex>> m_brushEntityWireframeVertices;
+  std::unique_ptr<DynamicVertexArray<SolidVertex>> m_solidBoundsVertices;
+  std::unordered_map<const mdl::EntityNode*, BoundsBlocks> m_boundsBlocks;
+  std::unordered_set<const mdl::EntityNode*> m_invalidBounds;
 
   DirectEdgeRenderer m_pointEntityWireframeBoundsRenderer;
   DirectEdgeRenderer m_brushEntityWireframeBoundsRenderer;
@@ -133,6 +161,17 @@ public:
 public: // rendering
   void render(RenderContext& renderContext, RenderBatch& renderBatch);
 
+public: // for testing
+  /**
+   * Writes the bounds of the invalid entities into the bounds vertex arrays. This is
+   * called by render().
+   */
+  void validateBounds();
+
+  const DynamicVertexArray<WireframeVertex>& pointEntityWireframeVertices() const;
+  const DynamicVertexArray<WireframeVertex>& brushEntityWireframeVertices() const;
+  const DynamicVertexArray<SolidVertex>& solidBoundsVertices() const;
+
 private:
   void renderBounds(RenderContext& renderContext, RenderBatch& renderBatch);
   void renderPointEntityWireframeBounds(RenderBatch& renderBatch);
@@ -143,8 +182,16 @@ private:
   void renderAngles(RenderContext& renderContext, RenderBatch& renderBatch);
   std::vector<vm::vec3f> arrowHead(float length, float width) const;
 
+  /**
+   * Rebuilds the bounds of all entities on the next render() call.
+   */
   void invalidateBounds();
-  void validateBounds();
+  /**
+   * Rewrites the bounds of the given entity on the next render() call.
+   */
+  void invalidateEntityBounds(const mdl::EntityNode* entityNode);
+  void addEntityBounds(const mdl::EntityNode* entityNode);
+  void removeEntityBounds(const mdl::EntityNode* entityNode);
 
   AttrString entityString(const mdl::EntityNode* entityNode) const;
   const Color& boundsColor(const mdl::EntityNode* entityNode) const;
@@ -120,6 +120,12 @@ void FaceRenderer::setAlpha(const float alpha)
   m_alpha = alpha;
 }
 
+void FaceRenderer::setIndexRanges(
+  std::shared_ptr<MaterialToBrushIndexRangesMap> indexRangesMap)
+{
+  m_indexRangesMap = std::move(indexRangesMap);
+}
+
 void FaceRenderer::render(RenderBatch& renderBatch)
 {
   renderBatch.add(this);
@@ -186,7 +192,10 @@ void FaceRenderer::doRender(RenderContext& context)
     }
     for (const auto& [material, brushIndexHolderPtr] : *m_indexArrayMap)
     {
-      if (brushIndexHolderPtr->hasValidIndices())
+      const auto* indexRanges = findIndexRanges(material);
+      if (
+        brushIndexHolderPtr->hasValidIndices()
+        && (!m_indexRangesMap || (indexRanges && !indexRanges->empty())))
       {
         const auto* texture = getTexture(material);
         const auto enableMasked = texture && texture->mask() == mdl::TextureMask::On;
@@ -197,7 +206,14 @@ void FaceRenderer::doRender(RenderContext& context)
 
         func.before(material);
         brushIndexHolderPtr->setupIndices();
-        brushIndexHolderPtr->render(PrimType::Triangles);
+        if (indexRanges)
+        {
+          brushIndexHolderPtr->render(PrimType::Triangles, *indexRanges);
+        }
+        else
+        {
+          brushIndexHolderPtr->render(PrimType::Triangles);
+        }
         brushIndexHolderPtr->cleanupIndices();
         func.after(material);
       }
@@ -210,4 +226,16 @@ void FaceRenderer::doRender(RenderContext& context)
   }
 }
 
+const BrushIndexRanges* FaceRenderer::findIndexRanges(const mdl::Material* material) const
+{
+  if (m_indexRangesMap)
+  {
+    if (const auto it = m_indexRangesMap->find(material); it != m_indexRangesMap->end())
+    {
+      return &it->second;
+    }
+  }
+  return nullptr;
+}
+
 } // namespace tb::render
@@ -33,6 +33,7 @@ class Material;
 namespace tb::render
 {
 class BrushIndexArray;
+class BrushIndexRanges;
 class BrushVertexArray;
 class RenderBatch;
 
@@ -41,9 +42,12 @@ class FaceRenderer : public IndexedRenderable
 private:
   using MaterialToBrushIndicesMap =
     const std::unordered_map<const mdl::Material*, std::shared_ptr<BrushIndexArray>>;
+  using MaterialToBrushIndexRangesMap =
+    const std::unordered_map<const mdl::Material*, BrushIndexRanges>;
 
   std::shared_ptr<BrushVertexArray> m_vertexArray;
   std::shared_ptr<MaterialToBrushIndicesMap> m_indexArrayMap;
+  std::shared_ptr<MaterialToBrushIndexRangesMap> m_indexRangesMap;
   Color m_faceColor;
   bool m_grayscale = false;
   bool m_tint = false;
@@ -62,11 +66,19 @@ public:
   void setTintColor(const Color& color);
   void setAlpha(float alpha);
 
+  /**
+   * Restricts rendering to the given ranges of each material's index array. Materials
+   * without ranges are skipped. If null, all indices are rendered.
+   */
+  void setIndexRanges(std::shared_ptr<MaterialToBrushIndexRangesMap> indexRangesMap);
+
   void render(RenderBatch& renderBatch);
 
 private:
   void prepareVerticesAndIndices(VboManager& vboManager) override;
   void doRender(RenderContext& context) override;
+
+  const BrushIndexRanges* findIndexRanges(const mdl::Material* material) const;
 };
 
 } // namespace tb::render
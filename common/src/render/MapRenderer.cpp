@@ -166,7 +166,8 @@ std::unique_ptr<ObjectRenderer> createDefaultRenderer(
     *kdl::mem_lock(document),
     kdl::mem_lock(document)->entityModelManager(),
     kdl::mem_lock(document)->editorContext(),
-    UnselectedBrushRendererFilter{kdl::mem_lock(document)->editorContext()});
+    UnselectedBrushRendererFilter{kdl::mem_lock(document)->editorContext()},
+    kdl::mem_lock(document)->taskManager());
 }
 
 std::unique_ptr<ObjectRenderer> createSelectionRenderer(
@@ -176,7 +177,8 @@ std::unique_ptr<ObjectRenderer> createSelectionRenderer(
     *kdl::mem_lock(document),
     kdl::mem_lock(document)->entityModelManager(),
     kdl::mem_lock(document)->editorContext(),
-    SelectedBrushRendererFilter{kdl::mem_lock(document)->editorContext()});
+    SelectedBrushRendererFilter{kdl::mem_lock(document)->editorContext()},
+    kdl::mem_lock(document)->taskManager());
 }
 
 std::unique_ptr<ObjectRenderer> createLockRenderer(
@@ -186,7 +188,8 @@ std::unique_ptr<ObjectRenderer> createLockRenderer(
     *kdl::mem_lock(document),
     kdl::mem_lock(document)->entityModelManager(),
     kdl::mem_lock(document)->editorContext(),
-    LockedBrushRendererFilter{kdl::mem_lock(document)->editorContext()});
+    LockedBrushRendererFilter{kdl::mem_lock(document)->editorContext()},
+    kdl::mem_lock(document)->taskManager());
 }
 
 std::unique_ptr<EntityDecalRenderer> createEntityDecalRenderer(
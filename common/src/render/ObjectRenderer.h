@@ -20,13 +20,18 @@
 #pragma once
 
 #include "Macros.h"
-#include "render/BrushRenderer.h"
+#include "render/ChunkedBrushRenderer.h"
 #include "render/EntityRenderer.h"
 #include "render/GroupRenderer.h"
 #include "render/PatchRenderer.h"
 
 #include <vector>
 
+namespace kdl
+{
+class task_manager;
+}
+
 namespace tb
 {
 class Color;
@@ -55,7 +60,7 @@ class ObjectRenderer
 private:
   GroupRenderer m_groupRenderer;
   EntityRenderer m_entityRenderer;
-  BrushRenderer m_brushRenderer;
+  ChunkedBrushRenderer m_brushRenderer;
   PatchRenderer m_patchRenderer;
 
 public:
@@ -64,10 +69,11 @@ public:
     Logger& logger,
     mdl::EntityModelManager& entityModelManager,
     const mdl::EditorContext& editorContext,
-    const BrushFilterT& brushFilter)
+    const BrushFilterT& brushFilter,
+    kdl::task_manager& taskManager)
     : m_groupRenderer{editorContext}
     , m_entityRenderer{logger, entityModelManager, editorContext}
-    , m_brushRenderer{brushFilter}
+    , m_brushRenderer{brushFilter, &taskManager}
     , m_patchRenderer{editorContext}
   {
   }
@@ -0,0 +1,292 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "octree.h"
+#include "render/ViewFrustum.h"
+
+#include "vm/bbox.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tb::render
+{
+
+/**
+ * The address of a render chunk. Render chunks use the cell addresses of the world
+ * octree.
+ */
+using RenderChunkAddress = detail::node_address;
+
+struct RenderChunkAddressHash
+{
+  std::size_t operator()(const RenderChunkAddress& address) const
+  {
+    const auto key = (std::uint64_t(std::uint16_t(address.x)) << 48)
+                     | (std::uint64_t(std::uint16_t(address.y)) << 32)
+                     | (std::uint64_t(std::uint16_t(address.z)) << 16)
+                     | std::uint64_t(address.size);
+    return std::hash<std::uint64_t>{}(key);
+  }
+};
+
+constexpr auto DefaultRenderChunkSize = 1024.0;
+
+/**
+ * Partitions objects into spatial chunks so that renderers can skip the objects that are
+ * not in view.
+ *
+ * Every chunk is a cell of the smallest size in an octree with the given chunk size, and
+ * an object belongs to the chunk that contains the center of its bounds. The bounds of a
+ * chunk are the union of the bounds of its objects, so they may extend beyond its cell.
+ * They are recomputed lazily when an object is added, removed or updated.
+ *
+ * @tparam T the object type
+ */
+template <typename T>
+class RenderChunks
+{
+public:
+  using GetBounds = std::function<vm::bbox3d(const T&)>;
+
+private:
+  struct Chunk
+  {
+    std::vector<T> objects;
+    mutable vm::bbox3d bounds;
+    mutable bool boundsValid = false;
+  };
+
+  /**
+   * The chunk that contains an object and the object's index in that chunk.
+   */
+  struct Location
+  {
+    RenderChunkAddress address;
+    std::size_t index;
+  };
+
+  GetBounds m_getBounds;
+  double m_chunkSize;
+  std::unordered_map<RenderChunkAddress, Chunk, RenderChunkAddressHash> m_chunks;
+  std::unordered_map<T, Location> m_locations;
+
+public:
+  /**
+   * Creates an empty set of chunks. The given function must return the current bounds of
+   * an object.
+   */
+  explicit RenderChunks(
+    GetBounds getBounds, const double chunkSize = DefaultRenderChunkSize)
+    : m_getBounds{std::move(getBounds)}
+    , m_chunkSize{chunkSize}
+  {
+    assert(m_chunkSize > 0.0);
+  }
+
+  bool empty() const { return m_chunks.empty(); }
+
+  std::size_t chunkCount() const { return m_chunks.size(); }
+
+  /**
+   * Indicates whether a chunk with the given address exists.
+   */
+  bool contains(const RenderChunkAddress& address) const
+  {
+    return m_chunks.contains(address);
+  }
+
+  /**
+   * Returns the address of the chunk that contains the given object, or std::nullopt if
+   * the given object was not added.
+   */
+  std::optional<RenderChunkAddress> address(const T& object) const
+  {
+    if (const auto it = m_locations.find(object); it != m_locations.end())
+    {
+      return it->second.address;
+    }
+    return std::nullopt;
+  }
+
+  /**
+   * Adds the given object to the chunk that contains the center of its current bounds.
+   * If the object was already added, it is moved to that chunk if necessary.
+   *
+   * Call this again whenever the bounds of an object change.
+   *
+   * @return the address of the chunk that now contains the object
+   */
+  RenderChunkAddress insert(const T& object)
+  {
+    const auto newAddress =
+      detail::get_address(m_getBounds(object).center(), m_chunkSize);
+
+    if (const auto oldAddress = address(object))
+    {
+      if (*oldAddress == newAddress)
+      {
+        m_chunks.at(newAddress).boundsValid = false;
+        return newAddress;
+      }
+      remove(object);
+    }
+
+    auto& chunk = m_chunks[newAddress];
+    m_locations.emplace(object, Location{newAddress, chunk.objects.size()});
+    chunk.objects.push_back(object);
+    chunk.boundsValid = false;
+    return newAddress;
+  }
+
+  /**
+   * Removes the given object in constant time. The last object of its chunk takes its
+   * place. Empty chunks are removed.
+   *
+   * @return the address of the chunk that contained the object, or std::nullopt if the
+   * given object was not added
+   */
+  std::optional<RenderChunkAddress> remove(const T& object)
+  {
+    const auto it = m_locations.find(object);
+    if (it == m_locations.end())
+    {
+      return std::nullopt;
+    }
+
+    const auto [result, index] = it->second;
+    m_locations.erase(it);
+
+    auto chunkIt = m_chunks.find(result);
+    assert(chunkIt != m_chunks.end());
+
+    auto& chunk = chunkIt->second;
+    assert(index < chunk.objects.size() && chunk.objects[index] == object);
+    if (index + 1 < chunk.objects.size())
+    {
+      chunk.objects[index] = std::move(chunk.objects.back());
+      m_locations.at(chunk.objects[index]).index = index;
+    }
+    chunk.objects.pop_back();
+    chunk.boundsValid = false;
+    if (chunk.objects.empty())
+    {
+      m_chunks.erase(chunkIt);
+    }
+
+    return result;
+  }
+
+  void clear()
+  {
+    m_chunks.clear();
+    m_locations.clear();
+  }
+
+  /**
+   * Causes the bounds of every chunk to be recomputed. Call this if the bounds of objects
+   * may have changed without them being inserted again.
+   */
+  void invalidateBounds()
+  {
+    for (auto& [address, chunk] : m_chunks)
+    {
+      chunk.boundsValid = false;
+    }
+  }
+
+  /**
+   * Returns the objects in the chunk with the given address. The chunk must exist.
+   */
+  const std::vector<T>& objects(const RenderChunkAddress& address) const
+  {
+    return m_chunks.at(address).objects;
+  }
+
+  /**
+   * Returns the bounds of the chunk with the given address. The chunk must exist.
+   */
+  const vm::bbox3d& bounds(const RenderChunkAddress& address) const
+  {
+    return validBounds(m_chunks.at(address));
+  }
+
+  /**
+   * Returns the addresses of all chunks whose bounds intersect the given frustum.
+   */
+  std::vector<RenderChunkAddress> visibleChunks(const ViewFrustum& frustum) const
+  {
+    auto result = std::vector<RenderChunkAddress>{};
+    for (const auto& [address, chunk] : m_chunks)
+    {
+      if (frustum.intersects(vm::bbox3f{validBounds(chunk)}))
+      {
+        result.push_back(address);
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Calls the given function for every object in a chunk whose bounds intersect the given
+   * frustum.
+   */
+  template <typename F>
+  void forEachVisibleObject(const ViewFrustum& frustum, const F& f) const
+  {
+    for (const auto& [address, chunk] : m_chunks)
+    {
+      if (frustum.intersects(vm::bbox3f{validBounds(chunk)}))
+      {
+        for (const auto& object : chunk.objects)
+        {
+          f(object);
+        }
+      }
+    }
+  }
+
+private:
+  const vm::bbox3d& validBounds(const Chunk& chunk) const
+  {
+    if (!chunk.boundsValid)
+    {
+      assert(!chunk.objects.empty());
+
+      auto builder = vm::bbox3d::builder{};
+      for (const auto& object : chunk.objects)
+      {
+        builder.add(m_getBounds(object));
+      }
+      chunk.bounds = builder.bounds();
+      chunk.boundsValid = true;
+    }
+    return chunk.bounds;
+  }
+};
+
+} // namespace tb::render
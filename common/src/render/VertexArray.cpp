@@ -19,6 +19,7 @@
 
 #include "VertexArray.h"
 
+#include "render/BrushRendererArrays.h"
 #include "render/PrimType.h"
 
 #include <cassert>
@@ -28,8 +29,52 @@ namespace tb::render
 
 VertexArray::BaseHolder::~BaseHolder() = default;
 
+VertexArray::SharedHolder::SharedHolder(
+  std::shared_ptr<VertexArrayInterface> vertices,
+  const size_t vertexCount,
+  const size_t sizeInBytes)
+  : m_vertices{std::move(vertices)}
+  , m_vertexCount{vertexCount}
+  , m_sizeInBytes{sizeInBytes}
+{
+}
+
+size_t VertexArray::SharedHolder::vertexCount() const
+{
+  return m_vertexCount;
+}
+
+size_t VertexArray::SharedHolder::sizeInBytes() const
+{
+  return m_sizeInBytes;
+}
+
+void VertexArray::SharedHolder::prepare(VboManager& vboManager)
+{
+  m_vertices->prepareVertices(vboManager);
+}
+
+void VertexArray::SharedHolder::setup()
+{
+  m_vertices->setupVertices();
+}
+
+void VertexArray::SharedHolder::cleanup()
+{
+  m_vertices->cleanupVertices();
+}
+
 VertexArray::VertexArray() = default;
 
+VertexArray VertexArray::shared(
+  std::shared_ptr<VertexArrayInterface> vertices,
+  const size_t vertexCount,
+  const size_t sizeInBytes)
+{
+  return VertexArray{std::make_shared<SharedHolder>(
+    std::move(vertices), vertexCount, sizeInBytes)};
+}
+
 bool VertexArray::empty() const
 {
   return vertexCount() == 0;
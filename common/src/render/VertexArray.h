@@ -34,6 +34,7 @@
 namespace tb::render
 {
 enum class PrimType;
+class VertexArrayInterface;
 
 /**
  * Represents an array of vertices. Optionally, multiple instances of this class can share
@@ -170,6 +171,26 @@ private:
     const VertexList& doGetVertices() const override { return m_vertices; }
   };
 
+  class SharedHolder : public BaseHolder
+  {
+  private:
+    std::shared_ptr<VertexArrayInterface> m_vertices;
+    size_t m_vertexCount;
+    size_t m_sizeInBytes;
+
+  public:
+    SharedHolder(
+      std::shared_ptr<VertexArrayInterface> vertices,
+      size_t vertexCount,
+      size_t sizeInBytes);
+
+    size_t vertexCount() const override;
+    size_t sizeInBytes() const override;
+    void prepare(VboManager& vboManager) override;
+    void setup() override;
+    void cleanup() override;
+  };
+
 private:
   std::shared_ptr<BaseHolder> m_holder;
   bool m_prepared = false;
@@ -230,6 +251,21 @@ public:
       std::make_shared<ByRefHolder<typename GLVertex<Attrs...>::Type>>(vertices));
   }
 
+  /**
+   * Creates a new vertex array that renders the given vertices, which may be shared with
+   * other vertex arrays. Unlike the vertices of the other kinds of vertex arrays, the
+   * given vertices are uploaded incrementally whenever this vertex array is prepared.
+   *
+   * @param vertices the vertices to render
+   * @param vertexCount the number of vertices to render
+   * @param sizeInBytes the size of the vertices to render in bytes
+   * @return the vertex array
+   */
+  static VertexArray shared(
+    std::shared_ptr<VertexArrayInterface> vertices,
+    size_t vertexCount,
+    size_t sizeInBytes);
+
   /**
    * Indicates whether this vertex array is empty.
    *
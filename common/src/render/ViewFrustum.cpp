@@ -0,0 +1,60 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ViewFrustum.h"
+
+#include "render/Camera.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace tb::render
+{
+
+ViewFrustum::ViewFrustum(std::vector<vm::plane3f> planes)
+  : m_planes{std::move(planes)}
+{
+}
+
+ViewFrustum ViewFrustum::fromCamera(const Camera& camera)
+{
+  auto planes = std::vector<vm::plane3f>(4);
+  camera.frustumPlanes(planes[0], planes[1], planes[2], planes[3]);
+  return ViewFrustum{std::move(planes)};
+}
+
+const std::vector<vm::plane3f>& ViewFrustum::planes() const
+{
+  return m_planes;
+}
+
+bool ViewFrustum::intersects(const vm::bbox3f& bounds) const
+{
+  return std::ranges::none_of(m_planes, [&](const auto& plane) {
+    // the corner of the bounds that is furthest behind the plane
+    const auto corner = vm::vec3f{
+      plane.normal.x() >= 0.0f ? bounds.min.x() : bounds.max.x(),
+      plane.normal.y() >= 0.0f ? bounds.min.y() : bounds.max.y(),
+      plane.normal.z() >= 0.0f ? bounds.min.z() : bounds.max.z(),
+    };
+    return plane.point_distance(corner) > 0.0f;
+  });
+}
+
+} // namespace tb::render
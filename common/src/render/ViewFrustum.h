@@ -0,0 +1,59 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "vm/bbox.h"
+#include "vm/plane.h"
+
+#include <vector>
+
+namespace tb::render
+{
+class Camera;
+
+/**
+ * The region of space that a camera can see, given by the planes that bound it. The
+ * normals of the planes point out of the frustum.
+ */
+class ViewFrustum
+{
+private:
+  std::vector<vm::plane3f> m_planes;
+
+public:
+  explicit ViewFrustum(std::vector<vm::plane3f> planes);
+
+  /**
+   * Creates the view frustum of the given camera. The frustum is bounded by the top,
+   * right, bottom and left planes of the camera, but not by its near and far planes.
+   */
+  static ViewFrustum fromCamera(const Camera& camera);
+
+  const std::vector<vm::plane3f>& planes() const;
+
+  /**
+   * Indicates whether the given bounds intersect this frustum. This test is
+   * conservative: bounds that are entirely outside of the frustum, but not entirely
+   * outside of any single plane, are reported as intersecting.
+   */
+  bool intersects(const vm::bbox3f& bounds) const;
+};
+
+} // namespace tb::render
@@ -31,7 +31,7 @@ namespace tb::ui
 
 BrushVertexCommandBase::BrushVertexCommandBase(
   std::string name, std::vector<std::pair<mdl::Node*, mdl::NodeContents>> nodes)
-  : SwapNodeContentsCommand{std::move(name), std::move(nodes)}
+  : SwapNodeContentsCommand{std::move(name), std::move(nodes), false}
 {
 }
 
@@ -31,6 +31,7 @@
 #include "kdl/vector_utils.h"
 
 #include <algorithm>
+#include <limits>
 
 namespace tb::ui
 {
@@ -104,6 +105,24 @@ private:
     return std::make_unique<CommandResult>(true);
   }
 
+  size_t memoryUsage() const override
+  {
+    auto result = size_t(0);
+    for (const auto& command : m_commands)
+    {
+      result += command->memoryUsage();
+    }
+    return result;
+  }
+
+  void releaseMemory() override
+  {
+    for (auto& command : m_commands)
+    {
+      command->releaseMemory();
+    }
+  }
+
   bool doCollateWith(UndoableCommand& other) override
   {
     if (auto* transactionCommand = dynamic_cast<TransactionCommand*>(&other))
@@ -165,6 +184,7 @@ CommandProcessor::CommandProcessor(
   MapDocumentCommandFacade& document, const std::chrono::milliseconds collationInterval)
   : m_document{document}
   , m_collationInterval{collationInterval}
+  , m_memoryBudget{std::numeric_limits<size_t>::max()}
   , m_lastCommandTimestamp{std::chrono::time_point<std::chrono::system_clock>{}}
 {
 }
@@ -247,6 +267,7 @@ std::unique_ptr<CommandResult> CommandProcessor::execute(std::unique_ptr<Command
   {
     m_undoStack.clear();
     m_redoStack.clear();
+    m_undoStackMemoryUsage = 0;
   }
   return result;
 }
@@ -305,9 +326,16 @@ void CommandProcessor::clear()
 
   m_undoStack.clear();
   m_redoStack.clear();
+  m_undoStackMemoryUsage = 0;
   m_lastCommandTimestamp = std::chrono::time_point<std::chrono::system_clock>();
 }
 
+void CommandProcessor::setMemoryBudget(const size_t memoryBudget)
+{
+  m_memoryBudget = memoryBudget;
+  enforceMemoryBudget();
+}
+
 CommandProcessor::SubmitAndStoreResult CommandProcessor::executeAndStoreCommand(
   std::unique_ptr<UndoableCommand> command, const bool collate)
 {
@@ -435,13 +463,19 @@ bool CommandProcessor::pushToUndoStack(
   if (collatable(collate, timestamp))
   {
     auto& lastCommand = m_undoStack.back();
+    const auto lastMemoryUsage = lastCommand->memoryUsage();
     if (lastCommand->collateWith(*command))
     {
+      m_undoStackMemoryUsage =
+        m_undoStackMemoryUsage - lastMemoryUsage + lastCommand->memoryUsage();
+      enforceMemoryBudget();
       return false;
     }
   }
 
+  m_undoStackMemoryUsage += command->memoryUsage();
   m_undoStack.push_back(std::move(command));
+  enforceMemoryBudget();
   return true;
 }
 
@@ -450,9 +484,32 @@ std::unique_ptr<UndoableCommand> CommandProcessor::popFromUndoStack()
   assert(m_transactionStack.empty());
   assert(!m_undoStack.empty());
 
+  m_undoStackMemoryUsage -= m_undoStack.back()->memoryUsage();
   return kdl::vec_pop_back(m_undoStack);
 }
 
+void CommandProcessor::enforceMemoryBudget()
+{
+  // First release the memory that the oldest commands can recover later
+  for (auto it = m_undoStack.begin();
+       m_undoStackMemoryUsage > m_memoryBudget && it != m_undoStack.end();
+       ++it)
+  {
+    const auto memoryUsage = (*it)->memoryUsage();
+    (*it)->releaseMemory();
+    m_undoStackMemoryUsage = m_undoStackMemoryUsage - memoryUsage + (*it)->memoryUsage();
+  }
+
+  // Then remove the oldest commands, but always keep the most recent one
+  auto it = m_undoStack.begin();
+  while (m_undoStackMemoryUsage > m_memoryBudget && m_undoStack.end() - it > 1)
+  {
+    m_undoStackMemoryUsage -= (*it)->memoryUsage();
+    ++it;
+  }
+  m_undoStack.erase(m_undoStack.begin(), it);
+}
+
 bool CommandProcessor::collatable(
   const bool collate, const std::chrono::system_clock::time_point timestamp) const
 {
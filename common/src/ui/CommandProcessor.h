@@ -65,6 +65,17 @@ private:
    */
   std::chrono::milliseconds m_collationInterval;
 
+  /**
+   * The number of bytes that the commands on the undo stack may hold on to. If the
+   * commands exceed this budget, the oldest commands are removed from the undo stack.
+   */
+  size_t m_memoryBudget;
+
+  /**
+   * The sum of the memory usage of the commands on the undo stack.
+   */
+  size_t m_undoStackMemoryUsage = 0;
+
   /**
    * Holds the commands that were executed so far, with the most recently executed command
    * at the end of the vector.
@@ -271,6 +282,15 @@ public:
    */
   void clear();
 
+  /**
+   * Sets the number of bytes that the commands on the undo stack may hold on to, as
+   * estimated by their `memoryUsage` method. Whenever this budget is exceeded, the
+   * oldest commands are asked to release their memory first. If that is not enough, the
+   * oldest commands are removed from the undo stack, but the most recently executed
+   * command is always kept.
+   */
+  void setMemoryBudget(size_t memoryBudget);
+
 private:
   /**
    * Executes and stores the given command. The command will only be stored if it was
@@ -371,6 +391,12 @@ private:
    */
   std::unique_ptr<UndoableCommand> popFromUndoStack();
 
+  /**
+   * Releases the memory held by the oldest commands on the undo stack, and then removes
+   * the oldest commands from the undo stack until the memory budget is met.
+   */
+  void enforceMemoryBudget();
+
   bool collatable(bool collate, std::chrono::system_clock::time_point timestamp) const;
 
   /**
@@ -82,7 +82,7 @@ EntityBrowserView::~EntityBrowserView()
 }
 
 void EntityBrowserView::setDefaultModelScaleExpression(
-  std::optional<el::ExpressionNode> defaultScaleExpression)
+  std::optional<el::CompiledExpression> defaultScaleExpression)
 {
   m_defaultScaleModelExpression = std::move(defaultScaleExpression);
 }
@@ -20,7 +20,7 @@
 #pragma once
 
 #include "NotifierConnection.h"
-#include "el/Expression.h"
+#include "el/CompiledExpression.h"
 #include "render/FontDescriptor.h"
 #include "render/GLVertexType.h"
 #include "ui/CellView.h"
@@ -84,7 +84,7 @@ private:
   static constexpr auto CameraUp = vm::vec3f{0, 0, 1};
 
   std::weak_ptr<MapDocument> m_document;
-  std::optional<el::ExpressionNode> m_defaultScaleModelExpression;
+  std::optional<el::CompiledExpression> m_defaultScaleModelExpression;
   vm::quatf m_rotation;
 
   bool m_group = false;
@@ -103,7 +103,7 @@ public:
 
 public:
   void setDefaultModelScaleExpression(
-    std::optional<el::ExpressionNode> defaultModelScaleExpression);
+    std::optional<el::CompiledExpression> defaultModelScaleExpression);
 
   void setSortOrder(mdl::EntityDefinitionSortOrder sortOrder);
   void setGroup(bool group);
@@ -25,23 +25,20 @@
 #include <QMenu>
 #include <QTableView>
 
-#include "mdl/BrushNode.h"
-#include "mdl/EntityNode.h"
-#include "mdl/GroupNode.h"
 #include "mdl/Issue.h"
 #include "mdl/IssueQuickFix.h"
-#include "mdl/LayerNode.h"
-#include "mdl/PatchNode.h"
+#include "mdl/ModelUtils.h"
 #include "mdl/WorldNode.h"
 #include "ui/MapDocument.h"
 #include "ui/QtUtils.h"
 #include "ui/Transaction.h"
 
 #include "kdl/memory_utils.h"
-#include "kdl/overload.h"
 #include "kdl/vector_set.h"
 #include "kdl/vector_utils.h"
 
+#include <iterator>
+#include <utility>
 #include <vector>
 
 namespace tb::ui
@@ -133,48 +130,24 @@ void IssueBrowserView::updateIssues()
   {
     const auto validators = document->world()->registeredValidators();
 
-    auto issues = std::vector<const mdl::Issue*>{};
-    const auto collectIssues = [&](auto* node) {
-      for (auto* issue : node->issues(validators))
-      {
-        if (
-          m_showHiddenIssues
-          || (!issue->hidden() && (issue->type() & m_hiddenIssueTypes) == 0))
-        {
-          issues.push_back(issue);
-        }
-      }
-    };
-
-    document->world()->accept(kdl::overload(
-      [&](auto&& thisLambda, mdl::WorldNode* world) {
-        collectIssues(world);
-        world->visitChildren(thisLambda);
-      },
-      [&](auto&& thisLambda, mdl::LayerNode* layer) {
-        collectIssues(layer);
-        layer->visitChildren(thisLambda);
-      },
-      [&](auto&& thisLambda, mdl::GroupNode* group) {
-        collectIssues(group);
-        group->visitChildren(thisLambda);
-      },
-      [&](auto&& thisLambda, mdl::EntityNode* entity) {
-        collectIssues(entity);
-        entity->visitChildren(thisLambda);
-      },
-      [&](mdl::BrushNode* brush) { collectIssues(brush); },
-      [&](mdl::PatchNode* patch) { collectIssues(patch); }));
+    auto issues = kdl::vec_filter(
+      mdl::collectIssues({document->world()}, validators, document->taskManager()),
+      [&](const auto* issue) {
+        return m_showHiddenIssues
+               || (!issue->hidden() && (issue->type() & m_hiddenIssueTypes) == 0);
+      });
 
     issues = kdl::vec_sort(std::move(issues), [](const auto* lhs, const auto* rhs) {
       return lhs->seqId() > rhs->seqId();
     });
-    m_tableModel->setIssues(std::move(issues));
+    m_tableModel->setIssues(issues);
   }
 }
 
 void IssueBrowserView::applyQuickFix(const mdl::IssueQuickFix& quickFix)
 {
+  validate();
+
   auto document = kdl::mem_lock(m_document);
   const auto issues = collectIssues(getSelection());
 
@@ -198,7 +171,7 @@ std::vector<const mdl::Issue*> IssueBrowserView::collectIssues(
     if (index.isValid())
     {
       const auto row = static_cast<size_t>(index.row());
-      result.insert(m_tableModel->issues().at(row));
+      result.insert(m_tableModel->issue(row));
     }
   }
   return result.release_data();
@@ -219,7 +192,7 @@ std::vector<const mdl::IssueQuickFix*> IssueBrowserView::collectQuickFixes(
     {
       continue;
     }
-    const auto* issue = m_tableModel->issues().at(static_cast<size_t>(index.row()));
+    const auto* issue = m_tableModel->issue(static_cast<size_t>(index.row()));
     issueTypes &= issue->type();
   }
 
@@ -240,6 +213,8 @@ mdl::IssueType IssueBrowserView::issueTypeMask() const
 
 void IssueBrowserView::setIssueVisibility(const bool show)
 {
+  validate();
+
   auto document = kdl::mem_lock(m_document);
   for (const auto* issue : collectIssues(getSelection()))
   {
@@ -272,6 +247,8 @@ void IssueBrowserView::bindEvents()
 
 void IssueBrowserView::itemRightClicked(const QPoint& pos)
 {
+  validate();
+
   const auto selectedIndexes = m_tableView->selectionModel()->selectedIndexes();
   if (selectedIndexes.empty())
   {
@@ -307,6 +284,7 @@ void IssueBrowserView::itemRightClicked(const QPoint& pos)
 
 void IssueBrowserView::itemSelectionChanged()
 {
+  validate();
   updateSelection();
 }
 
@@ -322,8 +300,9 @@ void IssueBrowserView::hideIssues()
 
 void IssueBrowserView::invalidate()
 {
+  // The rows of the table model may refer to issues which have already been destroyed.
+  // They must not be accessed until the model has been updated by validate.
   m_valid = false;
-  m_tableModel->setIssues({});
 
   QMetaObject::invokeMethod(this, "validate", Qt::QueuedConnection);
 }
@@ -332,8 +311,9 @@ void IssueBrowserView::validate()
 {
   if (!m_valid)
   {
-    updateIssues();
+    // updating the model may change the selection, which validates again
     m_valid = true;
+    updateIssues();
   }
 }
 
@@ -344,21 +324,101 @@ IssueBrowserModel::IssueBrowserModel(QObject* parent)
 {
 }
 
-void IssueBrowserModel::setIssues(std::vector<const mdl::Issue*> issues)
+void IssueBrowserModel::setIssues(const std::vector<const mdl::Issue*>& issues)
 {
-  beginResetModel();
-  m_issues = std::move(issues);
-  endResetModel();
+  auto newRows = kdl::vec_transform(issues, [](const auto* issue) {
+    return IssueRow{
+      issue, issue->seqId(), issue->lineNumber(), issue->description(), issue->hidden()};
+  });
+
+  // Both the current and the new rows are sorted by descending sequence number, so the
+  // removed and inserted rows can be found by merging them. The removed ranges refer to
+  // the current rows and the inserted ranges refer to the new rows.
+  auto removedRanges = std::vector<std::pair<size_t, size_t>>{};
+  auto insertedRanges = std::vector<std::pair<size_t, size_t>>{};
+  auto changedRows = std::vector<size_t>{};
+
+  const auto addToRanges = [](auto& ranges, const size_t row) {
+    if (!ranges.empty() && ranges.back().second == row)
+    {
+      ++ranges.back().second;
+    }
+    else
+    {
+      ranges.emplace_back(row, row + 1);
+    }
+  };
+
+  auto oldRow = size_t(0);
+  auto newRow = size_t(0);
+  while (oldRow < m_rows.size() || newRow < newRows.size())
+  {
+    if (
+      newRow == newRows.size()
+      || (oldRow < m_rows.size() && m_rows[oldRow].seqId > newRows[newRow].seqId))
+    {
+      addToRanges(removedRanges, oldRow++);
+    }
+    else if (oldRow == m_rows.size() || newRows[newRow].seqId > m_rows[oldRow].seqId)
+    {
+      addToRanges(insertedRanges, newRow++);
+    }
+    else
+    {
+      if (m_rows[oldRow] != newRows[newRow])
+      {
+        changedRows.push_back(newRow);
+      }
+      ++oldRow;
+      ++newRow;
+    }
+  }
+
+  // updating a view row by row is slower than resetting it if many rows have changed
+  constexpr auto MaxIncrementalChanges = size_t(64);
+  if (removedRanges.size() + insertedRanges.size() > MaxIncrementalChanges)
+  {
+    beginResetModel();
+    m_rows = std::move(newRows);
+    endResetModel();
+    return;
+  }
+
+  for (auto it = removedRanges.rbegin(); it != removedRanges.rend(); ++it)
+  {
+    const auto [first, last] = *it;
+    beginRemoveRows(QModelIndex{}, static_cast<int>(first), static_cast<int>(last - 1));
+    m_rows.erase(
+      std::next(m_rows.begin(), static_cast<long>(first)),
+      std::next(m_rows.begin(), static_cast<long>(last)));
+    endRemoveRows();
+  }
+
+  for (const auto& [first, last] : insertedRanges)
+  {
+    beginInsertRows(QModelIndex{}, static_cast<int>(first), static_cast<int>(last - 1));
+    m_rows.insert(
+      std::next(m_rows.begin(), static_cast<long>(first)),
+      std::next(newRows.begin(), static_cast<long>(first)),
+      std::next(newRows.begin(), static_cast<long>(last)));
+    endInsertRows();
+  }
+
+  for (const auto row : changedRows)
+  {
+    m_rows[row] = std::move(newRows[row]);
+    emit dataChanged(index(static_cast<int>(row), 0), index(static_cast<int>(row), 1));
+  }
 }
 
-const std::vector<const mdl::Issue*>& IssueBrowserModel::issues()
+const mdl::Issue* IssueBrowserModel::issue(const size_t row) const
 {
-  return m_issues;
+  return m_rows.at(row).issue;
 }
 
 int IssueBrowserModel::rowCount(const QModelIndex& parent) const
 {
-  return parent.isValid() ? 0 : static_cast<int>(m_issues.size());
+  return parent.isValid() ? 0 : static_cast<int>(m_rows.size());
 }
 
 int IssueBrowserModel::columnCount(const QModelIndex& parent) const
@@ -370,31 +430,31 @@ QVariant IssueBrowserModel::data(const QModelIndex& index, const int role) const
 {
   if (
     !index.isValid() || index.row() < 0
-    || index.row() >= static_cast<int>(m_issues.size()) || index.column() < 0
+    || index.row() >= static_cast<int>(m_rows.size()) || index.column() < 0
     || index.column() >= 2)
   {
     return QVariant{};
   }
 
-  const auto* issue = m_issues.at(static_cast<size_t>(index.row()));
+  const auto& row = m_rows.at(static_cast<size_t>(index.row()));
 
   if (role == Qt::DisplayRole)
   {
     if (index.column() == 0)
     {
-      if (issue->lineNumber() > 0)
+      if (row.lineNumber > 0)
       {
-        return QVariant::fromValue<size_t>(issue->lineNumber());
+        return QVariant::fromValue<size_t>(row.lineNumber);
       }
     }
     else
     {
-      return QVariant{QString::fromStdString(issue->description())};
+      return QVariant{QString::fromStdString(row.description)};
     }
   }
   else if (role == Qt::FontRole)
   {
-    if (issue->hidden())
+    if (row.hidden)
     {
       // hidden issues are italic
       auto italicFont = QFont{};
@@ -25,6 +25,7 @@
 #include "mdl/IssueType.h"
 
 #include <memory>
+#include <string>
 #include <vector>
 
 class QWidget;
@@ -98,20 +99,35 @@ public slots:
 };
 
 /**
- * Trivial QAbstractTableModel subclass, when the issues list changes,
- * it just refreshes the entire list with beginResetModel()/endResetModel().
+ * Table model that shows issues sorted by descending sequence number. When the issues
+ * change, only the rows of added and removed issues are inserted and removed unless too
+ * many rows have changed.
+ *
+ * Every row caches the data it shows because the issue it refers to is destroyed as soon
+ * as its node is invalidated, which may happen before the model is updated.
  */
 class IssueBrowserModel : public QAbstractTableModel
 {
   Q_OBJECT
 private:
-  std::vector<const mdl::Issue*> m_issues;
+  struct IssueRow
+  {
+    const mdl::Issue* issue;
+    size_t seqId;
+    size_t lineNumber;
+    std::string description;
+    bool hidden;
+
+    bool operator==(const IssueRow& other) const = default;
+  };
+
+  std::vector<IssueRow> m_rows;
 
 public:
   explicit IssueBrowserModel(QObject* parent);
 
-  void setIssues(std::vector<const mdl::Issue*> issues);
-  const std::vector<const mdl::Issue*>& issues();
+  void setIssues(const std::vector<const mdl::Issue*>& issues);
+  const mdl::Issue* issue(size_t row) const;
 
 public: // QAbstractTableModel overrides
   int rowCount(const QModelIndex& parent) const override;
@@ -54,6 +54,7 @@
 #include "mdl/EntityDefinitionFileSpec.h"
 #include "mdl/EntityDefinitionGroup.h"
 #include "mdl/EntityDefinitionManager.h"
+#include "mdl/EntityModelIndex.h"
 #include "mdl/EntityModelManager.h"
 #include "mdl/EntityNode.h"
 #include "mdl/EntityProperties.h"
@@ -144,6 +145,7 @@
 #include <string>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 
@@ -389,16 +391,16 @@ const std::string MapDocument::DefaultDocumentName("unnamed.map");
 
 MapDocument::MapDocument(kdl::task_manager& taskManager)
   : m_taskManager{taskManager}
-  , m_resourceManager{std::make_unique<mdl::ResourceManager>()}
+  , m_resourceManager{std::make_unique<mdl::ResourceManager>(
+      std::max(size_t{1}, 2 * taskManager.worker_count()))}
   , m_entityDefinitionManager{std::make_unique<mdl::EntityDefinitionManager>()}
   , m_entityModelManager{std::make_unique<mdl::EntityModelManager>(
       [&](auto resourceLoader) {
-        auto resource =
-          std::make_shared<mdl::EntityModelDataResource>(std::move(resourceLoader));
-        m_resourceManager->addResource(resource);
-        return resource;
+        return m_resourceManager->addResource(
+          std::make_shared<mdl::EntityModelDataResource>(std::move(resourceLoader)));
       },
       logger())}
+  , m_entityModelIndex{std::make_unique<mdl::EntityModelIndex>()}
   , m_materialManager{std::make_unique<mdl::MaterialManager>(logger())}
   , m_tagManager{std::make_unique<mdl::TagManager>()}
   , m_editorContext{std::make_unique<mdl::EditorContext>()}
@@ -1437,7 +1439,7 @@ void MapDocument::selectTouching(const bool del)
 {
   const auto nodes = kdl::vec_filter(
     mdl::collectTouchingNodes(
-      std::vector<mdl::Node*>{m_world.get()}, m_selectedNodes.brushes()),
+      std::vector<mdl::Node*>{m_world.get()}, m_selectedNodes.brushes(), m_taskManager),
     [&](mdl::Node* node) { return m_editorContext->selectable(node); });
 
   auto transaction = Transaction{*this, "Select Touching"};
@@ -1457,7 +1459,7 @@ void MapDocument::selectInside(const bool del)
 {
   const auto nodes = kdl::vec_filter(
     mdl::collectContainedNodes(
-      std::vector<mdl::Node*>{m_world.get()}, m_selectedNodes.brushes()),
+      std::vector<mdl::Node*>{m_world.get()}, m_selectedNodes.brushes(), m_taskManager),
     [&](mdl::Node* node) { return m_editorContext->selectable(node); });
 
   auto transaction = Transaction{*this, "Select Inside"};
@@ -1678,7 +1680,8 @@ void MapDocument::selectTall(const vm::axis::type cameraAxis)
         const auto nodesToSelect = kdl::vec_filter(
           mdl::collectContainedNodes(
             {world()},
-            kdl::vec_transform(tallBrushes, [](const auto& b) { return b.get(); })),
+            kdl::vec_transform(tallBrushes, [](const auto& b) { return b.get(); }),
+            m_taskManager),
           [&](const auto* node) { return editorContext().selectable(node); });
         selectNodes(nodesToSelect);
 
@@ -3140,48 +3143,46 @@ bool MapDocument::transform(
   const auto updateAngleProperty =
     m_world->entityPropertyConfig().updateAnglePropertyAfterTransform;
 
-  auto tasks =
-    nodesToTransform | std::views::transform([&](auto& node) {
-      return std::function{[&]() {
-        return node->accept(kdl::overload(
-          [&](mdl::WorldNode*) -> TransformResult {
-            ensure(false, "Unexpected world node");
-          },
-          [&](mdl::LayerNode*) -> TransformResult {
-            ensure(false, "Unexpected layer node");
-          },
-          [&](mdl::GroupNode* groupNode) -> TransformResult {
-            auto group = groupNode->group();
-            group.transform(transformation);
-            return std::make_pair(groupNode, mdl::NodeContents{std::move(group)});
-          },
-          [&](mdl::EntityNode* entityNode) -> TransformResult {
-            auto entity = entityNode->entity();
-            entity.transform(transformation, updateAngleProperty);
-            return std::make_pair(entityNode, mdl::NodeContents{std::move(entity)});
-          },
-          [&](mdl::BrushNode* brushNode) -> TransformResult {
-            const auto* containingGroup = brushNode->containingGroup();
-            const bool lockAlignment =
-            alignmentLock
-            || (containingGroup && containingGroup->closed() && mdl::collectLinkedNodes({m_world.get()}, *brushNode).size() > 1);
-
-            auto brush = brushNode->brush();
-            return brush.transform(m_worldBounds, transformation, lockAlignment)
-                   | kdl::and_then([&]() -> TransformResult {
-                       return std::make_pair(
-                         brushNode, mdl::NodeContents{std::move(brush)});
-                     });
-          },
-          [&](mdl::PatchNode* patchNode) -> TransformResult {
-            auto patch = patchNode->patch();
-            patch.transform(transformation);
-            return std::make_pair(patchNode, mdl::NodeContents{std::move(patch)});
-          }));
-      }};
+  auto transformResults =
+    m_taskManager.parallel_transform(nodesToTransform, [&](auto& node) {
+      return node->accept(kdl::overload(
+        [&](mdl::WorldNode*) -> TransformResult {
+          ensure(false, "Unexpected world node");
+        },
+        [&](mdl::LayerNode*) -> TransformResult {
+          ensure(false, "Unexpected layer node");
+        },
+        [&](mdl::GroupNode* groupNode) -> TransformResult {
+          auto group = groupNode->group();
+          group.transform(transformation);
+          return std::make_pair(groupNode, mdl::NodeContents{std::move(group)});
+        },
+        [&](mdl::EntityNode* entityNode) -> TransformResult {
+          auto entity = entityNode->entity();
+          entity.transform(transformation, updateAngleProperty);
+          return std::make_pair(entityNode, mdl::NodeContents{std::move(entity)});
+        },
+        [&](mdl::BrushNode* brushNode) -> TransformResult {
+          const auto* containingGroup = brushNode->containingGroup();
+          const bool lockAlignment =
+          alignmentLock
+          || (containingGroup && containingGroup->closed() && mdl::collectLinkedNodes({m_world.get()}, *brushNode).size() > 1);
+
+          auto brush = brushNode->brush();
+          return brush.transform(m_worldBounds, transformation, lockAlignment)
+                 | kdl::and_then([&]() -> TransformResult {
+                     return std::make_pair(
+                       brushNode, mdl::NodeContents{std::move(brush)});
+                   });
+        },
+        [&](mdl::PatchNode* patchNode) -> TransformResult {
+          auto patch = patchNode->patch();
+          patch.transform(transformation);
+          return std::make_pair(patchNode, mdl::NodeContents{std::move(patch)});
+        }));
     });
 
-  return m_taskManager.run_tasks_and_wait(tasks) | kdl::fold
+  return std::move(transformResults) | kdl::fold
          | kdl::and_then([&](auto nodesToUpdate) -> Result<bool> {
              const auto success = swapNodeContents(
                commandName,
@@ -3370,17 +3371,28 @@ bool MapDocument::csgSubtract()
   auto toRemove =
     std::vector<mdl::Node*>{std::begin(subtrahendNodes), std::end(subtrahendNodes)};
 
+  // the subtractions are independent of each other, so we can compute them in parallel
+  // and merge their results in the order of the minuends afterwards
+  auto subtractionResults =
+    m_taskManager.parallel_transform(minuendNodes, [&](auto* minuendNode) {
+      const auto& minuend = minuendNode->brush();
+      auto currentSubtractionResults = minuend.subtract(
+        m_world->mapFormat(), m_worldBounds, currentMaterialName(), subtrahends);
+
+      return std::make_pair(
+        minuendNode,
+        kdl::vec_filter(
+          std::move(currentSubtractionResults),
+          [](const auto r) { return r | kdl::is_success(); })
+          | kdl::fold);
+    });
+
   return kdl::vec_transform(
-           minuendNodes,
-           [&](auto* minuendNode) {
-             const auto& minuend = minuendNode->brush();
-             auto currentSubtractionResults = minuend.subtract(
-               m_world->mapFormat(), m_worldBounds, currentMaterialName(), subtrahends);
-
-             return kdl::vec_filter(
-                      std::move(currentSubtractionResults),
-                      [](const auto r) { return r | kdl::is_success(); })
-                    | kdl::fold | kdl::transform([&](auto currentBrushes) {
+           std::move(subtractionResults),
+           [&](auto subtractionResult) {
+             auto* minuendNode = subtractionResult.first;
+             return std::move(subtractionResult.second)
+                    | kdl::transform([&](auto currentBrushes) {
                         if (!currentBrushes.empty())
                         {
                           auto resultNodes = kdl::vec_transform(
@@ -3418,21 +3430,37 @@ bool MapDocument::csgIntersect()
     return false;
   }
 
-  auto intersection = brushes.front()->brush();
-
-  bool valid = true;
-  for (auto it = std::next(std::begin(brushes)), end = std::end(brushes);
-       it != end && valid;
-       ++it)
+  // Intersect adjacent pairs of brushes in parallel until only one brush is left. The
+  // pairs don't depend on the number of workers, so the result is always the same.
+  auto intersections = kdl::vec_transform(brushes, [](const auto* brushNode) {
+    return Result<mdl::Brush>{brushNode->brush()};
+  });
+  while (intersections.size() > 1)
   {
-    auto* brushNode = *it;
-    const auto& brush = brushNode->brush();
-    valid = intersection.intersect(m_worldBounds, brush) | kdl::if_error([&](auto e) {
-              error() << "Could not intersect brushes: " << e.msg;
-            })
-            | kdl::is_success();
+    const auto count = intersections.size();
+    intersections = m_taskManager.parallel_transform(
+      std::views::iota(size_t(0), (count + 1) / 2), [&](const size_t i) {
+        auto lhs = std::move(intersections[2 * i]);
+        if (2 * i + 1 == count)
+        {
+          return lhs;
+        }
+
+        return std::move(lhs) | kdl::and_then([&](auto intersection) {
+                 return intersections[2 * i + 1] | kdl::and_then([&](const auto& brush) {
+                          return intersection.intersect(m_worldBounds, brush)
+                                 | kdl::transform(
+                                   [&]() { return std::move(intersection); });
+                        });
+               });
+      });
   }
 
+  auto intersection = std::move(intersections.front()) | kdl::if_error([&](auto e) {
+                        error() << "Could not intersect brushes: " << e.msg;
+                      });
+  const auto valid = intersection | kdl::is_success();
+
   const auto toRemove = std::vector<mdl::Node*>{std::begin(brushes), std::end(brushes)};
 
   auto transaction = Transaction{*this, "CSG Intersect"};
@@ -3440,7 +3468,8 @@ bool MapDocument::csgIntersect()
 
   if (valid)
   {
-    auto* intersectionNode = new mdl::BrushNode{std::move(intersection)};
+    auto* intersectionNode =
+      new mdl::BrushNode{std::move(intersection) | kdl::value()};
     if (addNodes({{parentForNodes(toRemove), {intersectionNode}}}).empty())
     {
       transaction.cancel();
@@ -3469,32 +3498,39 @@ bool MapDocument::csgHollow()
   auto toAdd = std::map<mdl::Node*, std::vector<mdl::Node*>>{};
   auto toRemove = std::vector<mdl::Node*>{};
 
-  for (auto* brushNode : brushNodes)
-  {
+  // hollow the brushes in parallel, then merge the fragments in the order of the brushes
+  const auto delta = -double(m_grid->actualSize());
+  auto hollowResults = m_taskManager.parallel_transform(brushNodes, [&](auto* brushNode) {
     const auto& originalBrush = brushNode->brush();
 
     auto shrunkenBrush = originalBrush;
-    shrunkenBrush.expand(m_worldBounds, -double(m_grid->actualSize()), true)
-      | kdl::and_then([&]() {
-          didHollowAnything = true;
-
-          return originalBrush.subtract(
-                   m_world->mapFormat(),
-                   m_worldBounds,
-                   currentMaterialName(),
-                   shrunkenBrush)
-                 | kdl::fold | kdl::transform([&](auto fragments) {
-                     auto fragmentNodes =
-                       kdl::vec_transform(std::move(fragments), [](auto&& b) {
-                         return new mdl::BrushNode{std::forward<decltype(b)>(b)};
-                       });
-
-                     auto& toAddForParent = toAdd[brushNode->parent()];
-                     toAddForParent =
-                       kdl::vec_concat(std::move(toAddForParent), fragmentNodes);
-                     toRemove.push_back(brushNode);
+    return std::make_pair(
+      brushNode,
+      shrunkenBrush.expand(m_worldBounds, delta, true) | kdl::transform([&]() {
+        return originalBrush.subtract(
+          m_world->mapFormat(), m_worldBounds, currentMaterialName(), shrunkenBrush);
+      }));
+  });
+
+  for (auto& hollowResult : hollowResults)
+  {
+    auto* brushNode = hollowResult.first;
+    std::move(hollowResult.second) | kdl::and_then([&](auto fragmentResults) {
+      didHollowAnything = true;
+
+      return std::move(fragmentResults) | kdl::fold
+             | kdl::transform([&](auto fragments) {
+                 auto fragmentNodes =
+                   kdl::vec_transform(std::move(fragments), [](auto&& b) {
+                     return new mdl::BrushNode{std::forward<decltype(b)>(b)};
                    });
-        })
+
+                 auto& toAddForParent = toAdd[brushNode->parent()];
+                 toAddForParent =
+                   kdl::vec_concat(std::move(toAddForParent), fragmentNodes);
+                 toRemove.push_back(brushNode);
+               });
+    })
       | kdl::transform_error(
         [&](const auto& e) { error() << "Could not hollow brush: " << e; });
   }
@@ -4530,6 +4566,11 @@ bool MapDocument::needsResourceProcessing()
   return m_resourceManager->needsProcessing();
 }
 
+void MapDocument::setResourceProcessingRequestedCallback(std::function<void()> callback)
+{
+  m_resourceManager->setProcessingRequestedCallback(std::move(callback));
+}
+
 void MapDocument::pick(const vm::ray3d& pickRay, mdl::PickResult& pickResult) const
 {
   if (m_world)
@@ -4572,6 +4613,7 @@ void MapDocument::setWorld(
 
 void MapDocument::clearWorld()
 {
+  m_entityModelIndex->clear();
   m_world.reset();
   m_currentLayer = nullptr;
 }
@@ -4691,6 +4733,7 @@ void MapDocument::loadAssets()
   loadEntityModels();
   loadMaterials();
   setMaterials();
+  updateMaterialLoadPriorities();
 }
 
 void MapDocument::unloadAssets()
@@ -4761,9 +4804,8 @@ void MapDocument::loadMaterials()
     m_game->gameFileSystem(),
     m_game->config().materialConfig,
     [&](auto resourceLoader) {
-      auto resource = std::make_shared<mdl::TextureResource>(std::move(resourceLoader));
-      m_resourceManager->addResource(resource);
-      return resource;
+      return m_resourceManager->addResource(
+        std::make_shared<mdl::TextureResource>(std::move(resourceLoader)));
     },
     m_taskManager);
 }
@@ -4849,6 +4891,74 @@ void MapDocument::unsetMaterials(const std::vector<mdl::Node*>& nodes)
   materialUsageCountsDidChangeNotifier();
 }
 
+void MapDocument::updateMaterialLoadPriorities()
+{
+  // Priorities only matter for materials that are still waiting to be loaded, and
+  // cancelled materials may have to be loaded again.
+  if (
+    !m_world
+    || (!m_resourceManager->hasWaitingResources()
+        && !m_resourceManager->hasCancelledResources()))
+  {
+    return;
+  }
+
+  // Materials of visible faces are loaded first, then the remaining materials used in
+  // the map, and then the other materials of the enabled collections. Materials of
+  // disabled collections are only loaded if they are used in the map.
+  auto visibleMaterials = std::unordered_set<const mdl::Material*>{};
+  auto usedMaterials = std::unordered_set<const mdl::Material*>{};
+
+  const auto addMaterial = [&](const auto* material, const bool visible) {
+    if (material)
+    {
+      (visible ? visibleMaterials : usedMaterials).insert(material);
+    }
+  };
+
+  m_world->accept(kdl::overload(
+    [](auto&& thisLambda, mdl::WorldNode* world) { world->visitChildren(thisLambda); },
+    [](auto&& thisLambda, mdl::LayerNode* layer) { layer->visitChildren(thisLambda); },
+    [](auto&& thisLambda, mdl::GroupNode* group) { group->visitChildren(thisLambda); },
+    [](auto&& thisLambda, mdl::EntityNode* entity) { entity->visitChildren(thisLambda); },
+    [&](mdl::BrushNode* brushNode) {
+      for (const auto& face : brushNode->brush().faces())
+      {
+        addMaterial(face.material(), m_editorContext->visible(brushNode, face));
+      }
+    },
+    [&](mdl::PatchNode* patchNode) {
+      addMaterial(patchNode->patch().material(), m_editorContext->visible(patchNode));
+    }));
+
+  const auto enabledCollections = enabledMaterialCollections();
+  for (const auto& collection : m_materialManager->collections())
+  {
+    const auto enabled =
+      std::ranges::binary_search(enabledCollections, collection.path());
+    for (const auto& material : collection.materials())
+    {
+      const auto& resourceId = material.textureResource().id();
+      if (visibleMaterials.contains(&material))
+      {
+        m_resourceManager->setPriority(resourceId, mdl::ResourcePriority::High);
+      }
+      else if (usedMaterials.contains(&material))
+      {
+        m_resourceManager->setPriority(resourceId, mdl::ResourcePriority::Normal);
+      }
+      else if (enabled)
+      {
+        m_resourceManager->setPriority(resourceId, mdl::ResourcePriority::Low);
+      }
+      else
+      {
+        m_resourceManager->cancelLoading(resourceId);
+      }
+    }
+  }
+}
+
 static auto makeSetEntityDefinitionsVisitor(mdl::EntityDefinitionManager& manager)
 {
   // this helper lambda must be captured by value
@@ -4918,7 +5028,8 @@ void MapDocument::clearEntityModels()
   m_entityModelManager->clear();
 }
 
-static auto makeSetEntityModelsVisitor(mdl::EntityModelManager& manager, Logger& logger)
+static auto makeSetEntityModelsVisitor(
+  mdl::EntityModelManager& manager, mdl::EntityModelIndex& index, Logger& logger)
 {
   return kdl::overload(
     [](auto&& thisLambda, mdl::WorldNode* world) { world->visitChildren(thisLambda); },
@@ -4931,40 +5042,46 @@ static auto makeSetEntityModelsVisitor(mdl::EntityModelManager& manager, Logger&
         });
       const auto* model = manager.model(modelSpec.path);
       entityNode->setModel(model);
+      index.setEntityModel(entityNode, model);
     },
     [](mdl::BrushNode*) {},
     [](mdl::PatchNode*) {});
 }
 
-static auto makeUnsetEntityModelsVisitor()
+static auto makeUnsetEntityModelsVisitor(mdl::EntityModelIndex& index)
 {
   return kdl::overload(
     [](auto&& thisLambda, mdl::WorldNode* world) { world->visitChildren(thisLambda); },
     [](auto&& thisLambda, mdl::LayerNode* layer) { layer->visitChildren(thisLambda); },
     [](auto&& thisLambda, mdl::GroupNode* group) { group->visitChildren(thisLambda); },
-    [](mdl::EntityNode* entity) { entity->setModel(nullptr); },
+    [&](mdl::EntityNode* entity) {
+      entity->setModel(nullptr);
+      index.removeEntityNode(entity);
+    },
     [](mdl::BrushNode*) {},
     [](mdl::PatchNode*) {});
 }
 
 void MapDocument::setEntityModels()
 {
-  m_world->accept(makeSetEntityModelsVisitor(*m_entityModelManager, *this));
+  m_world->accept(
+    makeSetEntityModelsVisitor(*m_entityModelManager, *m_entityModelIndex, *this));
 }
 
 void MapDocument::setEntityModels(const std::vector<mdl::Node*>& nodes)
 {
-  mdl::Node::visitAll(nodes, makeSetEntityModelsVisitor(*m_entityModelManager, *this));
+  mdl::Node::visitAll(
+    nodes, makeSetEntityModelsVisitor(*m_entityModelManager, *m_entityModelIndex, *this));
 }
 
 void MapDocument::unsetEntityModels()
 {
-  m_world->accept(makeUnsetEntityModelsVisitor());
+  m_world->accept(makeUnsetEntityModelsVisitor(*m_entityModelIndex));
 }
 
 void MapDocument::unsetEntityModels(const std::vector<mdl::Node*>& nodes)
 {
-  mdl::Node::visitAll(nodes, makeUnsetEntityModelsVisitor());
+  mdl::Node::visitAll(nodes, makeUnsetEntityModelsVisitor(*m_entityModelIndex));
 }
 
 std::vector<std::filesystem::path> MapDocument::externalSearchPaths() const
@@ -5253,6 +5370,26 @@ void MapDocument::updateFaceTagsAfterResourcesWhereProcessed(
     [](mdl::PatchNode*) {}));
 }
 
+void MapDocument::updateEntityBoundsAfterResourcesWereProcessed(
+  const std::vector<mdl::ResourceId>& resourceIds)
+{
+  // Entity models are loaded asynchronously and an entity uses default bounds until its
+  // model has been loaded, so we must update the bounds of the entities whose models
+  // were loaded.
+
+  const auto entityModels =
+    m_entityModelManager->findEntityModelsByTextureResourceId(resourceIds);
+  if (entityModels.empty())
+  {
+    return;
+  }
+
+  for (auto* entityNode : m_entityModelIndex->findEntityNodes(entityModels))
+  {
+    entityNode->nodePhysicalBoundsDidChange();
+  }
+}
+
 bool MapDocument::persistent() const
 {
   return m_path.is_absolute() && io::Disk::pathInfo(m_path) == io::PathInfo::File;
@@ -5321,6 +5458,21 @@ void MapDocument::connectObservers()
     prefs.preferenceDidChangeNotifier.connect(this, &MapDocument::preferenceDidChange);
   m_notifierConnection += m_editorContext->editorContextDidChangeNotifier.connect(
     editorContextDidChangeNotifier);
+  m_notifierConnection += editorContextDidChangeNotifier.connect([&]() {
+    // the visibility of faces only affects the order in which the materials that are
+    // still waiting are loaded
+    if (m_resourceManager->hasWaitingResources())
+    {
+      updateMaterialLoadPriorities();
+    }
+  });
+  m_notifierConnection += nodesDidChangeNotifier.connect([&](const auto& nodes) {
+    // the world node stores the enabled material collections
+    if (std::ranges::find(nodes, m_world.get()) != nodes.end())
+    {
+      updateMaterialLoadPriorities();
+    }
+  });
   m_notifierConnection += commandDoneNotifier.connect(this, &MapDocument::commandDone);
   m_notifierConnection +=
     commandUndoneNotifier.connect(this, &MapDocument::commandUndone);
@@ -5346,6 +5498,8 @@ void MapDocument::connectObservers()
     modsDidChangeNotifier.connect(this, &MapDocument::updateAllFaceTags);
   m_notifierConnection += resourcesWereProcessedNotifier.connect(
     this, &MapDocument::updateFaceTagsAfterResourcesWhereProcessed);
+  m_notifierConnection += resourcesWereProcessedNotifier.connect(
+    this, &MapDocument::updateEntityBoundsAfterResourcesWereProcessed);
 }
 
 void MapDocument::materialCollectionsWillChange()
@@ -5357,6 +5511,7 @@ void MapDocument::materialCollectionsDidChange()
 {
   loadMaterials();
   setMaterials();
+  updateMaterialLoadPriorities();
   updateAllFaceTags();
 }
 
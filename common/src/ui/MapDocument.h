@@ -39,6 +39,7 @@
 #include "vm/util.h"
 
 #include <filesystem>
+#include <functional>
 #include <map>
 #include <memory>
 #include <optional>
@@ -66,6 +67,7 @@ class Entity;
 struct EntityDefinition;
 class EntityDefinitionFileSpec;
 class EntityDefinitionManager;
+class EntityModelIndex;
 class EntityModelManager;
 class Game;
 class Issue;
@@ -130,6 +132,7 @@ protected:
   std::unique_ptr<mdl::ResourceManager> m_resourceManager;
   std::unique_ptr<mdl::EntityDefinitionManager> m_entityDefinitionManager;
   std::unique_ptr<mdl::EntityModelManager> m_entityModelManager;
+  std::unique_ptr<mdl::EntityModelIndex> m_entityModelIndex;
   std::unique_ptr<mdl::MaterialManager> m_materialManager;
   std::unique_ptr<mdl::TagManager> m_tagManager;
 
@@ -701,6 +704,7 @@ public: // asset state management
   void processResourcesSync(const mdl::ProcessContext& processContext);
   void processResourcesAsync(const mdl::ProcessContext& processContext);
   bool needsResourceProcessing();
+  void setResourceProcessingRequestedCallback(std::function<void()> callback);
 
 public: // picking
   void pick(const vm::ray3d& pickRay, mdl::PickResult& pickResult) const;
@@ -751,6 +755,7 @@ protected:
   void setMaterials(const std::vector<mdl::BrushFaceHandle>& faceHandles);
   void unsetMaterials();
   void unsetMaterials(const std::vector<mdl::Node*>& nodes);
+  void updateMaterialLoadPriorities();
 
   void setEntityDefinitions();
   void setEntityDefinitions(const std::vector<mdl::Node*>& nodes);
@@ -807,6 +812,9 @@ private:
   void updateFaceTagsAfterResourcesWhereProcessed(
     const std::vector<mdl::ResourceId>& resourceIds);
 
+  void updateEntityBoundsAfterResourcesWereProcessed(
+    const std::vector<mdl::ResourceId>& resourceIds);
+
 public: // document path
   bool persistent() const;
   std::string filename() const;
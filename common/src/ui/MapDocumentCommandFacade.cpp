@@ -20,6 +20,8 @@
 #include "MapDocumentCommandFacade.h"
 
 #include "Ensure.h"
+#include "PreferenceManager.h"
+#include "Preferences.h"
 #include "mdl/Brush.h"
 #include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
@@ -46,6 +48,7 @@
 #include "kdl/vector_set.h"
 #include "kdl/vector_utils.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <string>
@@ -81,6 +84,7 @@ MapDocumentCommandFacade::MapDocumentCommandFacade(kdl::task_manager& taskManage
   : MapDocument{taskManager}
   , m_commandProcessor{std::make_unique<CommandProcessor>(*this)}
 {
+  updateUndoMemoryBudget();
   connectObservers();
 }
 
@@ -624,6 +628,24 @@ void MapDocumentCommandFacade::connectObservers()
     m_commandProcessor->transactionDoneNotifier.connect(transactionDoneNotifier);
   m_notifierConnection +=
     m_commandProcessor->transactionUndoneNotifier.connect(transactionUndoneNotifier);
+
+  auto& prefs = PreferenceManager::instance();
+  m_notifierConnection += prefs.preferenceDidChangeNotifier.connect(
+    this, &MapDocumentCommandFacade::undoPreferenceDidChange);
+}
+
+void MapDocumentCommandFacade::undoPreferenceDidChange(const std::filesystem::path& path)
+{
+  if (path == Preferences::UndoMemoryBudget.path())
+  {
+    updateUndoMemoryBudget();
+  }
+}
+
+void MapDocumentCommandFacade::updateUndoMemoryBudget()
+{
+  m_commandProcessor->setMemoryBudget(
+    size_t(std::max(0, pref(Preferences::UndoMemoryBudget))) * 1024u * 1024u);
 }
 
 bool MapDocumentCommandFacade::isCurrentDocumentStateObservable() const
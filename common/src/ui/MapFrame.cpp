@@ -149,6 +149,20 @@ MapFrame::MapFrame(FrameManager& frameManager, std::shared_ptr<MapDocument> docu
   m_autosaveTimer->start(1000);
   m_processResourcesTimer->start(20);
 
+  // the resource manager calls this from loader threads, so restarting the timer must
+  // happen on the main thread
+  m_document->setResourceProcessingRequestedCallback([this]() {
+    QMetaObject::invokeMethod(
+      this,
+      [this]() {
+        if (!m_processResourcesTimer->isActive())
+        {
+          m_processResourcesTimer->start();
+        }
+      },
+      Qt::QueuedConnection);
+  });
+
   connectObservers();
   bindEvents();
 
@@ -176,6 +190,7 @@ MapFrame::~MapFrame()
   m_mapView->deactivateCurrentTool();
 
   m_notifierConnection.disconnect();
+  m_document->setResourceProcessingRequestedCallback(nullptr);
   removeRecentDocumentsMenu();
 
   // The order of deletion here is important because both the document and the children
@@ -2473,6 +2488,11 @@ void MapFrame::triggerProcessResources()
   auto document = kdl::mem_lock(m_document);
   document->processResourcesAsync(mdl::ProcessContext{
     true, [&](const auto&, const auto& error) { logger().error() << error; }});
+
+  if (!document->needsResourceProcessing())
+  {
+    m_processResourcesTimer->stop();
+  }
 }
 
 // DebugPaletteWindow
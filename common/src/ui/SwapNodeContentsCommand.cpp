@@ -19,18 +19,64 @@
 
 #include "SwapNodeContentsCommand.h"
 
+#include "mdl/BrushFace.h"
+#include "mdl/BrushGeometry.h"
+#include "mdl/EntityProperties.h"
 #include "mdl/Node.h"
 #include "ui/MapDocumentCommandFacade.h"
 
+#include "kdl/overload.h"
+#include "kdl/task_manager.h"
 #include "kdl/vector_utils.h"
 
+#include <algorithm>
+
 namespace tb::ui
 {
+namespace
+{
+
+size_t contentsMemoryUsage(const mdl::NodeContents& contents)
+{
+  return std::visit(
+    kdl::overload(
+      [](const mdl::Brush& brush) {
+        auto result = sizeof(mdl::Brush) + brush.faceCount() * sizeof(mdl::BrushFace);
+        if (brush.hasGeometry() && !brush.hasSharedGeometry())
+        {
+          result += brush.vertexCount() * sizeof(mdl::BrushVertex)
+                    + brush.edgeCount()
+                        * (sizeof(mdl::BrushEdge) + 2u * sizeof(mdl::BrushHalfEdge))
+                    + brush.faceCount() * sizeof(mdl::BrushFaceGeometry);
+        }
+        return result;
+      },
+      [](const mdl::Entity& entity) {
+        auto result = sizeof(mdl::Entity);
+        for (const auto& property : entity.properties())
+        {
+          result += sizeof(mdl::EntityProperty) + property.key().capacity()
+                    + property.value().capacity();
+        }
+        return result;
+      },
+      [](const mdl::BezierPatch& patch) {
+        return sizeof(mdl::BezierPatch)
+               + patch.controlPoints().size() * sizeof(mdl::BezierPatch::Point);
+      },
+      [](const auto& other) { return sizeof(other); }),
+    contents.get());
+}
+
+} // namespace
 
 SwapNodeContentsCommand::SwapNodeContentsCommand(
-  std::string name, std::vector<std::pair<mdl::Node*, mdl::NodeContents>> nodes)
+  std::string name,
+  std::vector<std::pair<mdl::Node*, mdl::NodeContents>> nodes,
+  const bool releaseBrushGeometry)
   : UpdateLinkedGroupsCommandBase{std::move(name), true}
   , m_nodes{std::move(nodes)}
+  , m_releaseBrushGeometry{releaseBrushGeometry}
 {
 }
 
@@ -39,15 +85,13 @@ SwapNodeContentsCommand::~SwapNodeContentsCommand() = default;
 std::unique_ptr<CommandResult> SwapNodeContentsCommand::doPerformDo(
   MapDocumentCommandFacade& document)
 {
-  document.performSwapNodeContents(m_nodes);
-  return std::make_unique<CommandResult>(true);
+  return swapNodeContents(document);
 }
 
 std::unique_ptr<CommandResult> SwapNodeContentsCommand::doPerformUndo(
   MapDocumentCommandFacade& document)
 {
-  document.performSwapNodeContents(m_nodes);
-  return std::make_unique<CommandResult>(true);
+  return swapNodeContents(document);
 }
 
 bool SwapNodeContentsCommand::doCollateWith(UndoableCommand& command)
@@ -68,4 +112,68 @@ bool SwapNodeContentsCommand::doCollateWith(UndoableCommand& command)
   return false;
 }
 
+size_t SwapNodeContentsCommand::memoryUsage() const
+{
+  return m_memoryUsage;
+}
+
+void SwapNodeContentsCommand::releaseMemory()
+{
+  if (!m_releaseBrushGeometry)
+  {
+    return;
+  }
+
+  m_memoryUsage = 0u;
+  for (auto& pair : m_nodes)
+  {
+    // A shared geometry is still in use, so releasing it would not save any memory.
+    if (auto* brush = std::get_if<mdl::Brush>(&pair.second.get());
+        brush && !brush->hasSharedGeometry())
+    {
+      brush->releaseGeometry();
+    }
+    m_memoryUsage += contentsMemoryUsage(pair.second);
+  }
+}
+
+std::unique_ptr<CommandResult> SwapNodeContentsCommand::swapNodeContents(
+  MapDocumentCommandFacade& document)
+{
+  if (!restoreBrushGeometry(document))
+  {
+    return std::make_unique<CommandResult>(false);
+  }
+
+  document.performSwapNodeContents(m_nodes);
+
+  m_memoryUsage = 0u;
+  for (const auto& pair : m_nodes)
+  {
+    m_memoryUsage += contentsMemoryUsage(pair.second);
+  }
+
+  return std::make_unique<CommandResult>(true);
+}
+
+bool SwapNodeContentsCommand::restoreBrushGeometry(MapDocumentCommandFacade& document)
+{
+  auto brushes = std::vector<mdl::Brush*>{};
+  for (auto& pair : m_nodes)
+  {
+    if (auto* brush = std::get_if<mdl::Brush>(&pair.second.get());
+        brush && !brush->hasGeometry())
+    {
+      brushes.push_back(brush);
+    }
+  }
+
+  const auto& worldBounds = document.worldBounds();
+  const auto results = document.taskManager().parallel_transform(
+    brushes, [&](mdl::Brush* brush) { return brush->restoreGeometry(worldBounds); });
+
+  return std::ranges::all_of(
+    results, [](const auto& result) { return result.is_success(); });
+}
+
 } // namespace tb::ui
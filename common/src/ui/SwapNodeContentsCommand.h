@@ -40,9 +40,20 @@ class SwapNodeContentsCommand : public UpdateLinkedGroupsCommandBase
 protected:
   std::vector<std::pair<mdl::Node*, mdl::NodeContents>> m_nodes;
 
+private:
+  /**
+   * Whether the geometry of the stored brushes may be released when the undo history
+   * exceeds its memory budget. The geometry is rebuilt from the brush faces before the
+   * brushes are swapped back into their nodes.
+   */
+  bool m_releaseBrushGeometry;
+  size_t m_memoryUsage = 0;
+
 public:
   SwapNodeContentsCommand(
-    std::string name, std::vector<std::pair<mdl::Node*, mdl::NodeContents>> nodes);
+    std::string name,
+    std::vector<std::pair<mdl::Node*, mdl::NodeContents>> nodes,
+    bool releaseBrushGeometry = true);
   ~SwapNodeContentsCommand() override;
 
   std::unique_ptr<CommandResult> doPerformDo(MapDocumentCommandFacade& document) override;
@@ -51,6 +62,18 @@ public:
 
   bool doCollateWith(UndoableCommand& command) override;
 
+  size_t memoryUsage() const override;
+  void releaseMemory() override;
+
+private:
+  std::unique_ptr<CommandResult> swapNodeContents(MapDocumentCommandFacade& document);
+
+  /**
+   * Rebuilds the geometry of the stored brushes whose geometry was released. Returns
+   * false if the geometry of any brush could not be rebuilt.
+   */
+  bool restoreBrushGeometry(MapDocumentCommandFacade& document);
+
   deleteCopyAndMove(SwapNodeContentsCommand);
 };
 
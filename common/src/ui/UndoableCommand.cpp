@@ -78,6 +78,13 @@ bool UndoableCommand::doCollateWith(UndoableCommand&)
   return false;
 }
 
+size_t UndoableCommand::memoryUsage() const
+{
+  return 0u;
+}
+
+void UndoableCommand::releaseMemory() {}
+
 void UndoableCommand::setModificationCount(MapDocumentCommandFacade& document) const
 {
   if (m_modificationCount)
@@ -45,6 +45,19 @@ public:
 
   virtual bool collateWith(UndoableCommand& command);
 
+  /**
+   * Returns an estimate of the number of bytes this command holds on to so that it can
+   * be undone or redone.
+   */
+  virtual size_t memoryUsage() const;
+
+  /**
+   * Releases memory that this command can recover when it is undone or redone. This is
+   * called when the undo history exceeds its memory budget, before the oldest commands
+   * are removed from it.
+   */
+  virtual void releaseMemory();
+
 protected:
   virtual std::unique_ptr<CommandResult> doPerformUndo(
     MapDocumentCommandFacade& document) = 0;
@@ -25,13 +25,67 @@
 #include "mdl/Polyhedron.h"
 #include "ui/Grid.h"
 
+#include "vm/bbox.h"
 #include "vm/distance.h"
+#include "vm/intersection.h"
 #include "vm/polygon.h"
 #include "vm/ray.h"
 #include "vm/vec.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace tb::ui
 {
+namespace
+{
+
+/**
+ * Returns a test that accepts the bounds of every octree node which might contain a
+ * handle that is hit by the given pick ray.
+ *
+ * Every pick test in this file intersects the pick ray with a sphere around a point
+ * that lies within the bounds of the handle. The sphere's radius is scaled by the
+ * camera's perspective scaling factor, which is an affine function of the position, so
+ * its magnitude within the node bounds is greatest at one of the corners. A node can
+ * only contain a hit handle if the ray intersects its bounds expanded by that radius.
+ */
+auto makePickBoundsTest(const vm::ray3d& pickRay, const render::Camera& camera)
+{
+  const auto handleRadius = double(pref(Preferences::HandleRadius));
+  return [&, handleRadius](const vm::bbox3d& bounds) {
+    auto maxScaling = 0.0;
+    for (const auto& corner : bounds.vertices())
+    {
+      const auto scaling = camera.perspectiveScalingFactor(vm::vec3f{corner});
+      maxScaling = std::max(maxScaling, std::abs(static_cast<double>(scaling)));
+    }
+
+    // allow for the scaling factor being computed with single precision
+    const auto pickRadius = 2.0 * handleRadius * maxScaling * 1.01;
+    const auto pickBounds = bounds.expand(pickRadius);
+    return pickBounds.contains(pickRay.origin)
+           || vm::intersect_ray_bbox(pickRay, pickBounds);
+  };
+}
+
+} // namespace
+
+vm::bbox3d handleBounds(const vm::vec3d& handle)
+{
+  return vm::bbox3d{handle, handle};
+}
+
+vm::bbox3d handleBounds(const vm::segment3d& handle)
+{
+  return vm::bbox3d{
+    vm::min(handle.start(), handle.end()), vm::max(handle.start(), handle.end())};
+}
+
+vm::bbox3d handleBounds(const vm::polygon3d& handle)
+{
+  return vm::bbox3d::merge_all(handle.vertices().begin(), handle.vertices().end());
+}
 
 VertexHandleManagerBase::~VertexHandleManagerBase() = default;
 
@@ -42,8 +96,9 @@ void VertexHandleManager::pick(
   const render::Camera& camera,
   mdl::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
+  for (const auto* handle : findHandles(makePickBoundsTest(pickRay, camera)))
   {
+    const auto& position = *handle;
     if (
       const auto distance = camera.pickPointHandle(
         pickRay, position, double(pref(Preferences::HandleRadius))))
@@ -55,21 +110,21 @@ void VertexHandleManager::pick(
   }
 }
 
-void VertexHandleManager::addHandles(const mdl::BrushNode* brushNode)
+void VertexHandleManager::addHandles(mdl::BrushNode* brushNode)
 {
   const auto& brush = brushNode->brush();
   for (const auto* vertex : brush.vertices())
   {
-    add(vertex->position());
+    add(vertex->position(), brushNode);
   }
 }
 
-void VertexHandleManager::removeHandles(const mdl::BrushNode* brushNode)
+void VertexHandleManager::removeHandles(mdl::BrushNode* brushNode)
 {
   const auto& brush = brushNode->brush();
   for (const auto* vertex : brush.vertices())
   {
-    assertResult(remove(vertex->position()));
+    assertResult(remove(vertex->position(), brushNode));
   }
 }
 
@@ -78,13 +133,6 @@ mdl::HitType::Type VertexHandleManager::hitType() const
   return HandleHitType;
 }
 
-bool VertexHandleManager::isIncident(
-  const Handle& handle, const mdl::BrushNode* brushNode) const
-{
-  const auto& brush = brushNode->brush();
-  return brush.hasVertex(handle);
-}
-
 const mdl::HitType::Type EdgeHandleManager::HandleHitType = mdl::HitType::freeType();
 
 void EdgeHandleManager::pickGridHandle(
@@ -93,8 +141,9 @@ void EdgeHandleManager::pickGridHandle(
   const Grid& grid,
   mdl::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
+  for (const auto* handle : findHandles(makePickBoundsTest(pickRay, camera)))
   {
+    const auto& position = *handle;
     if (
       const auto edgeDist = camera.pickLineSegmentHandle(
         pickRay, position, double(pref(Preferences::HandleRadius))))
@@ -121,8 +170,9 @@ void EdgeHandleManager::pickCenterHandle(
   const render::Camera& camera,
   mdl::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
+  for (const auto* handle : findHandles(makePickBoundsTest(pickRay, camera)))
   {
+    const auto& position = *handle;
     const auto pointHandle = position.center();
 
     if (
@@ -135,22 +185,25 @@ void EdgeHandleManager::pickCenterHandle(
   }
 }
 
-void EdgeHandleManager::addHandles(const mdl::BrushNode* brushNode)
+void EdgeHandleManager::addHandles(mdl::BrushNode* brushNode)
 {
   const auto& brush = brushNode->brush();
   for (const auto* edge : brush.edges())
   {
-    add(vm::segment3d{edge->firstVertex()->position(), edge->secondVertex()->position()});
+    add(
+      vm::segment3d{edge->firstVertex()->position(), edge->secondVertex()->position()},
+      brushNode);
   }
 }
 
-void EdgeHandleManager::removeHandles(const mdl::BrushNode* brushNode)
+void EdgeHandleManager::removeHandles(mdl::BrushNode* brushNode)
 {
   const auto& brush = brushNode->brush();
   for (const auto* edge : brush.edges())
   {
     assertResult(remove(
-      vm::segment3d{edge->firstVertex()->position(), edge->secondVertex()->position()}));
+      vm::segment3d{edge->firstVertex()->position(), edge->secondVertex()->position()},
+      brushNode));
   }
 }
 
@@ -159,13 +212,6 @@ mdl::HitType::Type EdgeHandleManager::hitType() const
   return HandleHitType;
 }
 
-bool EdgeHandleManager::isIncident(
-  const Handle& handle, const mdl::BrushNode* brushNode) const
-{
-  const auto& brush = brushNode->brush();
-  return brush.hasEdge(handle);
-}
-
 const mdl::HitType::Type FaceHandleManager::HandleHitType = mdl::HitType::freeType();
 
 void FaceHandleManager::pickGridHandle(
@@ -174,8 +220,9 @@ void FaceHandleManager::pickGridHandle(
   const Grid& grid,
   mdl::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
+  for (const auto* handle : findHandles(makePickBoundsTest(pickRay, camera)))
   {
+    const auto& position = *handle;
     if (
       const auto plane =
         vm::from_points(position.vertices().begin(), position.vertices().end()))
@@ -205,8 +252,9 @@ void FaceHandleManager::pickCenterHandle(
   const render::Camera& camera,
   mdl::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
+  for (const auto* handle : findHandles(makePickBoundsTest(pickRay, camera)))
   {
+    const auto& position = *handle;
     const auto pointHandle = position.center();
 
     if (
@@ -219,21 +267,21 @@ void FaceHandleManager::pickCenterHandle(
   }
 }
 
-void FaceHandleManager::addHandles(const mdl::BrushNode* brushNode)
+void FaceHandleManager::addHandles(mdl::BrushNode* brushNode)
 {
   const auto& brush = brushNode->brush();
   for (const auto& face : brush.faces())
   {
-    add(face.polygon());
+    add(face.polygon(), brushNode);
   }
 }
 
-void FaceHandleManager::removeHandles(const mdl::BrushNode* brushNode)
+void FaceHandleManager::removeHandles(mdl::BrushNode* brushNode)
 {
   const auto& brush = brushNode->brush();
   for (const auto& face : brush.faces())
   {
-    assertResult(remove(face.polygon()));
+    assertResult(remove(face.polygon(), brushNode));
   }
 }
 
@@ -242,11 +290,4 @@ mdl::HitType::Type FaceHandleManager::hitType() const
   return HandleHitType;
 }
 
-bool FaceHandleManager::isIncident(
-  const Handle& handle, const mdl::BrushNode* brushNode) const
-{
-  const auto& brush = brushNode->brush();
-  return brush.hasFace(handle);
-}
-
 } // namespace tb::ui
@@ -19,15 +19,23 @@
 
 #pragma once
 
+#include "Macros.h"
 #include "mdl/BrushNode.h"
 #include "mdl/HitType.h"
 #include "mdl/PickResult.h"
+#include "octree.h"
 #include "render/Camera.h"
 
 #include "kdl/map_utils.h"
 #include "kdl/range_to.h"
+#include "kdl/range_to_vector.h"
 #include "kdl/vector_utils.h"
 
+#include "vm/bbox.h"
+#include "vm/polygon.h"
+#include "vm/segment.h"
+
+#include <algorithm>
 #include <iterator>
 #include <map>
 #include <ranges>
@@ -68,7 +76,7 @@ public:
    *
    * @param brushNode the brush whose handles to add
    */
-  virtual void addHandles(const mdl::BrushNode* brushNode) = 0;
+  virtual void addHandles(mdl::BrushNode* brushNode) = 0;
 
   /**
    * Removes all handles of the given range of brushes from this handle manager.
@@ -90,9 +98,16 @@ public:
    *
    * @param brushNode the brush whose handles to remove
    */
-  virtual void removeHandles(const mdl::BrushNode* brushNode) = 0;
+  virtual void removeHandles(mdl::BrushNode* brushNode) = 0;
 };
 
+/**
+ * Returns the bounds by which the given handle is indexed spatially.
+ */
+vm::bbox3d handleBounds(const vm::vec3d& handle);
+vm::bbox3d handleBounds(const vm::segment3d& handle);
+vm::bbox3d handleBounds(const vm::polygon3d& handle);
+
 template <typename H>
 class VertexHandleManagerBaseT : public VertexHandleManagerBase
 {
@@ -101,12 +116,12 @@ public:
 
 protected:
   /**
-   * Represents the status of a handle, i.e., how many duplicates exist at the same
+   * Represents the status of a handle, i.e., which brushes have a handle at the same
    * coordinates and whether or not all of these are selected.
    */
   struct HandleInfo
   {
-    size_t count = 0;
+    std::vector<mdl::BrushNode*> brushes;
     bool selected = false;
 
     /**
@@ -131,27 +146,46 @@ protected:
     bool toggle() { return std::exchange(selected, !selected); }
 
     /**
-     * Increments the number of handles at the same coordinates.
+     * Registers the given brush as having a handle at the same coordinates.
      */
-    void inc() { ++count; }
+    void addBrush(mdl::BrushNode* brushNode) { brushes.push_back(brushNode); }
 
     /**
-     * Deccrements the number of handles at the same coordinates.
+     * Unregisters the given brush.
+     *
+     * @return true if and only if the given brush was registered
      */
-    void dec() { --count; }
+    bool removeBrush(mdl::BrushNode* brushNode)
+    {
+      if (const auto it = std::ranges::find(brushes, brushNode); it != brushes.end())
+      {
+        brushes.erase(it);
+        return true;
+      }
+      return false;
+    }
   };
 
+  using HandleEntry = typename std::map<H, HandleInfo>::value_type;
+
   /**
    * Maps a handle position to its info.
    */
   std::map<H, HandleInfo> m_handles;
 
+  /**
+   * Indexes the entries of m_handles by the bounds of their handles. The map never
+   * moves its entries, so pointers to them remain valid until they are erased.
+   */
+  octree<double, HandleEntry*> m_handleTree{64.0};
+
   /**
    * The total number of selected handles, not counting duplicates.
    */
   size_t m_selectedHandleCount = 0;
 
 public:
+  VertexHandleManagerBaseT() = default;
   ~VertexHandleManagerBaseT() override = default;
 
 public:
@@ -278,33 +312,43 @@ public:
 
 public:
   /**
-   * Adds the given handle to this manager.
+   * Adds the given handle of the given brush to this manager.
    *
    * @param handle the handle to add
+   * @param brushNode the brush which the handle belongs to
    */
-  void add(const Handle& handle)
+  void add(const Handle& handle, mdl::BrushNode* brushNode)
   {
-    m_handles[handle].inc(); // unknown value gets value constructed, which for HandleInfo
-                             // means its default constructor is called
+    const auto [it, inserted] = m_handles.try_emplace(handle);
+    if (inserted)
+    {
+      m_handleTree.insert(handleBounds(it->first), &*it);
+    }
+    it->second.addBrush(brushNode);
   }
 
   /**
-   * Removes the given handle from this manager.
+   * Removes the given handle of the given brush from this manager.
    *
    * @param handle the handle to remove
-   * @return true if the given handle was contained in this manager (and therefore
-   * removed) and false otherwise
+   * @param brushNode the brush which the handle belongs to
+   * @return true if the given handle was contained in this manager for the given brush
+   * (and therefore removed) and false otherwise
    */
-  bool remove(const Handle& handle)
+  bool remove(const Handle& handle, mdl::BrushNode* brushNode)
   {
     if (const auto it = m_handles.find(handle); it != m_handles.end())
     {
       auto& info = it->second;
-      info.dec();
+      if (!info.removeBrush(brushNode))
+      {
+        return false;
+      }
 
-      if (info.count == 0)
+      if (info.brushes.empty())
       {
         deselect(info);
+        m_handleTree.remove(&*it);
         m_handles.erase(it);
       }
       return true;
@@ -318,6 +362,7 @@ public:
    */
   void clear()
   {
+    m_handleTree.clear();
     m_handles.clear();
     m_selectedHandleCount = 0;
   }
@@ -417,8 +462,12 @@ private:
   void forEachCloseHandle(const H& otherHandle, F fun)
   {
     static const auto epsilon = 0.001 * 0.001;
-    for (auto& [handle, info] : m_handles)
+
+    // any close handle's bounds are within epsilon of the given handle's bounds
+    const auto searchBounds = handleBounds(otherHandle).expand(2.0 * epsilon);
+    for (auto* entry : m_handleTree.find_intersectors(searchBounds))
     {
+      auto& [handle, info] = *entry;
       if (compare(otherHandle, handle, epsilon) == 0)
       {
         fun(info);
@@ -481,75 +530,82 @@ public:
     }
   }
 
+protected:
+  /**
+   * Returns the handles stored in octree nodes whose bounds pass the given test, in the
+   * same order in which they are stored in this manager.
+   *
+   * The test must accept the bounds of every node that might contain a handle which the
+   * caller is looking for, see octree::find_if.
+   *
+   * @tparam P the type of the bounds test
+   * @param boundsTest the test to apply to the octree node bounds
+   * @return the handles that were found
+   */
+  template <typename P>
+  std::vector<const Handle*> findHandles(const P& boundsTest) const
+  {
+    const auto entries = m_handleTree.find_if(boundsTest);
+    auto result = entries
+                  | std::views::transform([](const auto* entry) { return &entry->first; })
+                  | kdl::to_vector;
+    std::ranges::sort(
+      result, [](const auto* lhs, const auto* rhs) { return *lhs < *rhs; });
+    return result;
+  }
+
 public:
   /**
-   * Finds and returns all brushes in the given range which are incident to the given
-   * handle.
+   * Finds and returns all brushes which are incident to the given handle, i.e., all
+   * brushes whose handles at the given position were added to this manager.
    *
-   * @tparam R the type of the given brush range
    * @param handle the handle
-   * @param brushes the handles to add
-   * @return a set of all brushes that are incident to the given handle
+   * @return a vector containing all incident brushes
    */
-  template <std::ranges::range R>
-  std::vector<mdl::BrushNode*> findIncidentBrushes(
-    const Handle& handle, const R& brushes) const
+  std::vector<mdl::BrushNode*> findIncidentBrushes(const Handle& handle) const
   {
     auto result = std::vector<mdl::BrushNode*>{};
-    findIncidentBrushes(handle, brushes, std::back_inserter(result));
+    findIncidentBrushes(handle, std::back_inserter(result));
     return kdl::vec_sort_and_remove_duplicates(std::move(result));
   }
 
   /**
-   * Finds and returns all brushes in the given range which are incident to any handle
-   * in the given range.
+   * Finds and returns all brushes which are incident to any handle in the given range.
    *
-   * @tparam HandleRange the type of the range of handles
-   * @tparam BrushRange the type of the range of brushes
+   * @tparam R the type of the range of handles
    * @param handles the range of handles
-   * @param brushes the range of brushes
    * @return a vector containing all incident brushes
    */
-  template <std::ranges::range HandleRange, std::ranges::range BrushRange>
-  std::vector<mdl::BrushNode*> findIncidentBrushes(
-    const HandleRange& handles, const BrushRange& brushes) const
+  template <std::ranges::range R>
+  std::vector<mdl::BrushNode*> findIncidentBrushes(const R& handles) const
   {
     auto result = std::vector<mdl::BrushNode*>{};
     auto out = std::back_inserter(result);
 
     for (const auto& handle : handles)
     {
-      findIncidentBrushes(handle, brushes, out);
+      findIncidentBrushes(handle, out);
     }
     return kdl::vec_sort_and_remove_duplicates(std::move(result));
   }
 
   /**
-   * Finds all brushes in the given range which are incident to the given handle.
+   * Finds all brushes which are incident to the given handle.
    *
-   * @tparam R the type of the given range of brushes
    * @tparam O an output iterator to append the resulting brushes to
    * @param handle the handle
-   * @param brushes the range of brushes
    * @param out an output iterator that accepts the incident brushes
    */
-  template <std::ranges::range R, typename O>
-  void findIncidentBrushes(const Handle& handle, const R& brushes, O out) const
+  template <typename O>
+  void findIncidentBrushes(const Handle& handle, O out) const
   {
-    std::ranges::copy_if(
-      brushes, out, [&](const auto& brush) { return isIncident(handle, brush); });
+    if (const auto it = m_handles.find(handle); it != m_handles.end())
+    {
+      std::ranges::copy(it->second.brushes, out);
+    }
   }
 
-private:
-  /**
-   * Checks whether the given brush is incident to the given handle.
-   *
-   * @param handle the handle to check
-   * @param brushNode the brush to check
-   * @return true if and only if the given brush is incident to the given handle
-   */
-  virtual bool isIncident(
-    const Handle& handle, const mdl::BrushNode* brushNode) const = 0;
+  deleteCopyAndMove(VertexHandleManagerBaseT);
 };
 
 /**
@@ -579,13 +635,10 @@ public:
     mdl::PickResult& pickResult) const;
 
 public:
-  void addHandles(const mdl::BrushNode* brushNode) override;
-  void removeHandles(const mdl::BrushNode* brushNode) override;
+  void addHandles(mdl::BrushNode* brushNode) override;
+  void removeHandles(mdl::BrushNode* brushNode) override;
 
   mdl::HitType::Type hitType() const override;
-
-private:
-  bool isIncident(const Handle& handle, const mdl::BrushNode* brushNode) const override;
 };
 
 /**
@@ -637,13 +690,10 @@ public:
     mdl::PickResult& pickResult) const;
 
 public:
-  void addHandles(const mdl::BrushNode* brushNode) override;
-  void removeHandles(const mdl::BrushNode* brushNode) override;
+  void addHandles(mdl::BrushNode* brushNode) override;
+  void removeHandles(mdl::BrushNode* brushNode) override;
 
   mdl::HitType::Type hitType() const override;
-
-private:
-  bool isIncident(const Handle& handle, const mdl::BrushNode* brushNode) const override;
 };
 
 /**
@@ -695,13 +745,10 @@ public:
     mdl::PickResult& pickResult) const;
 
 public:
-  void addHandles(const mdl::BrushNode* brushNode) override;
-  void removeHandles(const mdl::BrushNode* brushNode) override;
+  void addHandles(mdl::BrushNode* brushNode) override;
+  void removeHandles(mdl::BrushNode* brushNode) override;
 
   mdl::HitType::Type hitType() const override;
-
-private:
-  bool isIncident(const Handle& handle, const mdl::BrushNode* brushNode) const override;
 };
 
 } // namespace tb::ui
@@ -121,23 +121,14 @@ public:
   std::vector<mdl::BrushNode*> findIncidentBrushes(
     const M& manager, const H2& handle) const
   {
-    return manager.findIncidentBrushes(handle, selectedBrushes());
+    return manager.findIncidentBrushes(handle);
   }
 
   template <typename M, std::ranges::range R>
   std::vector<mdl::BrushNode*> findIncidentBrushes(
     const M& manager, const R& handles) const
   {
-    const auto& brushes = selectedBrushes();
-    auto result = std::vector<mdl::BrushNode*>{};
-    auto out = std::back_inserter(result);
-
-    for (const auto& handle : handles)
-    {
-      manager.findIncidentBrushes(handle, brushes, out);
-    }
-
-    return kdl::vec_sort_and_remove_duplicates(std::move(result));
+    return manager.findIncidentBrushes(handles);
   }
 
   virtual void pick(
@@ -601,15 +592,15 @@ protected:
   void addHandles(
     const std::vector<mdl::Node*>& nodes, VertexHandleManagerBaseT<HT>& handleManager)
   {
-    for (const auto* node : nodes)
+    for (auto* node : nodes)
     {
       node->accept(kdl::overload(
-        [](const mdl::WorldNode*) {},
-        [](const mdl::LayerNode*) {},
-        [](const mdl::GroupNode*) {},
-        [](const mdl::EntityNode*) {},
-        [&](const mdl::BrushNode* brush) { handleManager.addHandles(brush); },
-        [](const mdl::PatchNode*) {}));
+        [](mdl::WorldNode*) {},
+        [](mdl::LayerNode*) {},
+        [](mdl::GroupNode*) {},
+        [](mdl::EntityNode*) {},
+        [&](mdl::BrushNode* brush) { handleManager.addHandles(brush); },
+        [](mdl::PatchNode*) {}));
     }
   }
 
@@ -617,15 +608,15 @@ protected:
   void removeHandles(
     const std::vector<mdl::Node*>& nodes, VertexHandleManagerBaseT<HT>& handleManager)
   {
-    for (const auto* node : nodes)
+    for (auto* node : nodes)
     {
       node->accept(kdl::overload(
-        [](const mdl::WorldNode*) {},
-        [](const mdl::LayerNode*) {},
-        [](const mdl::GroupNode*) {},
-        [](const mdl::EntityNode*) {},
-        [&](const mdl::BrushNode* brush) { handleManager.removeHandles(brush); },
-        [](const mdl::PatchNode*) {}));
+        [](mdl::WorldNode*) {},
+        [](mdl::LayerNode*) {},
+        [](mdl::GroupNode*) {},
+        [](mdl::EntityNode*) {},
+        [&](mdl::BrushNode* brush) { handleManager.removeHandles(brush); },
+        [](mdl::PatchNode*) {}));
     }
   }
 
@@ -362,7 +362,7 @@ GameAndConfig loadGame(const std::string& gameName)
   const auto configStr = io::readTextFile(configPath);
   auto configParser = io::GameConfigParser(configStr, configPath);
   auto config = std::make_unique<mdl::GameConfig>(configParser.parse().value());
-  auto game = std::make_shared<mdl::GameImpl>(*config, gamePath, logger);
+  auto game = std::make_shared<mdl::GameImpl>(*config, gamePath, nullptr, logger);
 
   // We would ideally just return game, but GameImpl captures a raw reference
   // to the GameConfig.
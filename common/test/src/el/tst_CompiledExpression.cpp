@@ -0,0 +1,210 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "el/CompiledExpression.h"
+#include "el/EvaluationContext.h"
+#include "el/Expression.h"
+#include "el/Value.h"
+#include "el/VariableStore.h"
+#include "io/ELParser.h"
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::el
+{
+namespace
+{
+
+auto evaluate(const std::string& expression, const MapType& variables)
+{
+  return withEvaluationContext(
+    [&](auto& context) {
+      return io::ELParser::parseStrict(expression).value().evaluate(context);
+    },
+    VariableTable{variables});
+}
+
+auto evaluateCompiled(const std::string& expression, const MapType& variables)
+{
+  const auto compiledExpression =
+    CompiledExpression{io::ELParser::parseStrict(expression).value()};
+  return withEvaluationContext(
+    [&](auto& context) { return compiledExpression.evaluate(context); },
+    VariableTable{variables});
+}
+
+auto tryEvaluate(const std::string& expression, const MapType& variables)
+{
+  return withEvaluationContext(
+    [&](auto& context) {
+      return io::ELParser::parseStrict(expression).value().tryEvaluate(context);
+    },
+    VariableTable{variables});
+}
+
+auto tryEvaluateCompiled(const std::string& expression, const MapType& variables)
+{
+  const auto compiledExpression =
+    CompiledExpression{io::ELParser::parseStrict(expression).value()};
+  return withEvaluationContext(
+    [&](auto& context) { return compiledExpression.tryEvaluate(context); },
+    VariableTable{variables});
+}
+
+} // namespace
+
+TEST_CASE("CompiledExpression")
+{
+  SECTION("evaluate")
+  {
+    using T = std::tuple<std::string, MapType, Value>;
+
+    // clang-format off
+    const auto
+    [expression,                         variables,                       expectedValue] = GENERATE(values<T>({
+    {"1 + 2 * 3",                        {},                              Value{7}},
+    {"x",                                {{"x", Value{"test"}}},          Value{"test"}},
+    {"x",                                {},                              Value::Undefined},
+    {"-x",                               {{"x", Value{"2"}}},             Value{-2}},
+    {"~x",                               {{"x", Value{2}}},               Value{~2l}},
+    {"!x",                               {{"x", Value{true}}},            Value{false}},
+    {"(x)",                              {{"x", Value{3}}},               Value{3}},
+    {"x + 1",                            {{"x", Value{"2"}}},             Value{3}},
+    {"x + 'b'",                          {{"x", Value{"a"}}},             Value{"ab"}},
+    {"x + [2]",                          {{"x", Value{ArrayType{Value{1}}}}}, Value{ArrayType{Value{1}, Value{2}}}},
+    {"x - true",                         {{"x", Value{3}}},               Value{2}},
+    {"x * 2 / 4 % 2",                    {{"x", Value{3}}},               Value{1.5}},
+    {"x & 6 | 1 ^ 8",                    {{"x", Value{"3"}}},             Value{11}},
+    {"x << 2 >> 1",                      {{"x", Value{"1"}}},             Value{2}},
+    {"x < 2",                            {{"x", Value{"1"}}},             Value{true}},
+    {"x >= 'b'",                         {{"x", Value{"a"}}},             Value{false}},
+    {"x == true",                        {{"x", Value{2}}},               Value{true}},
+    {"x != null",                        {{"x", Value{2}}},               Value{true}},
+    {"x && y",                           {{"x", Value{true}}, {"y", Value{false}}}, Value{false}},
+    {"x && y",                           {{"x", Value::Null}},            Value{false}},
+    {"x && y",                           {},                              Value::Undefined},
+    {"x || y",                           {{"x", Value{true}}},            Value{true}},
+    {"x || y",                           {{"x", Value{false}}, {"y", Value{true}}}, Value{true}},
+    {"false && x + {}",                  {{"x", Value{1}}},               Value{false}},
+    {"[x, 1..3]",                        {{"x", Value{0}}},               Value{ArrayType{Value{0}, Value{1}, Value{2}, Value{3}}}},
+    {"{a: x, b: [y]}",                   {{"x", Value{1}}, {"y", Value{2}}}, Value{MapType{{"a", Value{1}}, {"b", Value{ArrayType{Value{2}}}}}}},
+    {"x[1]",                             {{"x", Value{ArrayType{Value{1}, Value{2}}}}}, Value{2}},
+    {"{a: x}['a']",                      {{"x", Value{"test"}}},          Value{"test"}},
+    {"x -> 1",                           {{"x", Value{""}}},              Value::Undefined},
+    {"{{ x & 1 -> 'a', 'b' }}",          {{"x", Value{"1"}}},             Value{"a"}},
+    {"{{ x & 1 -> 'a', 'b' }}",          {{"x", Value{"2"}}},             Value{"b"}},
+    {"{{ x & 1 -> 'a', 'b' }}",          {{"x", Value{""}}},              Value{"b"}},
+    {"{{ x & 1 -> 'a', 'b' }}",          {},                              Value{"b"}},
+    {"{{ x == 'a' -> 1, x == 'b' -> 2 }}", {{"x", Value{"c"}}},           Value::Undefined},
+    {"{{ false -> 1, x }}",              {{"x", Value{2}}},               Value{2}},
+    {"{{ x -> { path: y, skin: 1 } }}",  {{"x", Value{true}}, {"y", Value{"p"}}}, Value{MapType{{"path", Value{"p"}}, {"skin", Value{1}}}}},
+    }));
+    // clang-format on
+
+    CAPTURE(expression);
+
+    CHECK(evaluateCompiled(expression, variables) == Value{expectedValue});
+    CHECK(evaluateCompiled(expression, variables) == evaluate(expression, variables));
+  }
+
+  SECTION("evaluate reports the same errors as the source expression")
+  {
+    using T = std::tuple<std::string, MapType>;
+
+    // clang-format off
+    const auto
+    [expression,                variables] = GENERATE(values<T>({
+    {"x + {}",                  {{"x", Value{1}}}},
+    {"x + 'a'",                 {{"x", Value{1}}}},
+    {"x & 1",                   {{"x", Value{"a"}}}},
+    {"x < 1",                   {{"x", Value{"a"}}}},
+    {"-x",                      {{"x", Value{"a"}}}},
+    {"x && true",               {{"x", Value{1}}}},
+    {"x[3]",                    {{"x", Value{ArrayType{}}}}},
+    {"{{ x -> 1, 2 }}",         {{"x", Value{ArrayType{}}}}},
+    {"[1, 2][5]",               {}},
+    }));
+    // clang-format on
+
+    CAPTURE(expression);
+
+    const auto expectedResult = evaluate(expression, variables);
+    REQUIRE(expectedResult.is_error());
+    CHECK(evaluateCompiled(expression, variables) == expectedResult);
+  }
+
+  SECTION("tryEvaluate")
+  {
+    using T = std::tuple<std::string, MapType>;
+
+    // clang-format off
+    const auto
+    [expression,                variables] = GENERATE(values<T>({
+    {"x + 1",                   {{"x", Value{1}}}},
+    {"x + {}",                  {{"x", Value{1}}}},
+    {"[x + {}, 1]",             {{"x", Value{1}}}},
+    {"{{ x -> y + {}, 2 }}",    {{"x", Value{true}}, {"y", Value{1}}}},
+    }));
+    // clang-format on
+
+    CAPTURE(expression);
+
+    CHECK(
+      tryEvaluateCompiled(expression, variables) == tryEvaluate(expression, variables));
+  }
+
+  SECTION("referencedVariableNames")
+  {
+    using T = std::tuple<std::string, std::vector<std::string>>;
+
+    // clang-format off
+    const auto
+    [expression,              expectedVariableNames] = GENERATE(values<T>({
+    {"1 + 2",                 {}},
+    {"y + x + y",             {"x", "y"}},
+    {"[x, { a: y }, -z]",     {"x", "y", "z"}},
+    {"x[y]",                  {"x", "y"}},
+    {"false && x",            {"x"}},
+    {"{{ a == 1 -> b, c }}",  {"a", "b", "c"}},
+    }));
+    // clang-format on
+
+    CAPTURE(expression);
+
+    CHECK(
+      CompiledExpression{io::ELParser::parseStrict(expression).value()}
+        .referencedVariableNames()
+      == expectedVariableNames);
+  }
+
+  SECTION("Equality compares source expressions")
+  {
+    const auto expression = io::ELParser::parseStrict("1 + x").value();
+    CHECK(CompiledExpression{expression} == CompiledExpression{expression});
+    CHECK(
+      CompiledExpression{expression}
+      != CompiledExpression{io::ELParser::parseStrict("1 + y").value()});
+  }
+}
+
+} // namespace tb::el
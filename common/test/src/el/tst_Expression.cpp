@@ -1165,6 +1165,10 @@ TEST_CASE("Expression")
     {"[1 + 2, 2, a]",           arr({lit(3), lit(2), var("a")})},
     {"{a:1, b:2, c:3}",         lit(MapType{{"a", Value{1}}, {"b", Value{2}}, {"c", Value{3}}})},
     {"{{ true -> 1, x -> 2 }}", lit(1)},
+    {"{{ false -> 1, 2 }}",     lit(2)},
+    {"{{ x -> 1, false -> 2 }}", swt({
+                                    cs(var("x"), lit(1)),
+                                })},
     {"{{ x -> 2, true -> 1 }}", swt({
                                     cs(var("x"), lit(2)),
                                     lit(1),
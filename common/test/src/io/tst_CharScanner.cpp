@@ -0,0 +1,90 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "io/CharScanner.h"
+
+#include <string>
+
+#include "Catch2.h"
+
+namespace tb::io
+{
+namespace
+{
+
+size_t findFirstOf(const std::string& str, const std::string_view chars)
+{
+  return size_t(io::findFirstOf(str.data(), str.data() + str.size(), chars) - str.data());
+}
+
+size_t findFirstNotOf(const std::string& str, const std::string_view chars)
+{
+  return size_t(
+    io::findFirstNotOf(str.data(), str.data() + str.size(), chars) - str.data());
+}
+
+size_t findFirstNonDigit(const std::string& str)
+{
+  return size_t(io::findFirstNonDigit(str.data(), str.data() + str.size()) - str.data());
+}
+
+} // namespace
+
+TEST_CASE("CharScanner")
+{
+  // cover matches in the first block, in later blocks and in the remainder
+  const auto position =
+    GENERATE(size_t(0), size_t(5), size_t(16), size_t(31), size_t(33), size_t(70));
+  const auto length = size_t(71);
+  CAPTURE(position);
+
+  SECTION("findFirstOf")
+  {
+    auto str = std::string(length, 'a');
+    CHECK(findFirstOf(str, " \t\n\r") == length);
+
+    str[position] = '\n';
+    CHECK(findFirstOf(str, " \t\n\r") == position);
+    CHECK(findFirstOf(str, "0123456789\n") == position);
+
+    str[length - 1] = ' ';
+    CHECK(findFirstOf(str, " \t\n\r") == position);
+  }
+
+  SECTION("findFirstNotOf")
+  {
+    auto str = std::string(length, ' ');
+    CHECK(findFirstNotOf(str, " \t\n\r") == length);
+
+    str[position] = '\xe9';
+    CHECK(findFirstNotOf(str, " \t\n\r") == position);
+    CHECK(findFirstNotOf(str, "0123456789 ") == position);
+  }
+
+  SECTION("findFirstNonDigit")
+  {
+    auto str = std::string(length, '7');
+    CHECK(findFirstNonDigit(str) == length);
+
+    str[position] = GENERATE('/', ':', '.', '\x80', '\xff');
+    CHECK(findFirstNonDigit(str) == position);
+  }
+}
+
+} // namespace tb::io
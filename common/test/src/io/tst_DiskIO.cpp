@@ -23,13 +23,17 @@
 #include "io/DiskIO.h"
 #include "io/File.h"
 #include "io/PathInfo.h"
+#include "io/Reader.h"
 #include "io/TestEnvironment.h"
 #include "io/TraversalMode.h"
 
+#include "kdl/result.h"
+
 #include <fmt/format.h>
 #include <fmt/std.h>
 
 #include <filesystem>
+#include <fstream>
 
 #include "Catch2.h"
 
@@ -203,18 +207,18 @@ TEST_CASE("DiskIO")
 
     CHECK(
       Disk::openFile("asdf/bleh")
-      == Result<std::shared_ptr<CFile>>{Error{fmt::format(
+      == Result<std::shared_ptr<File>>{Error{fmt::format(
         "Failed to open {}: path does not denote a file",
         std::filesystem::path{"asdf/bleh"})}});
     CHECK(
       Disk::openFile(env.dir() / "does/not/exist")
-      == Result<std::shared_ptr<CFile>>{Error{fmt::format(
+      == Result<std::shared_ptr<File>>{Error{fmt::format(
         "Failed to open {}: path does not denote a file",
         env.dir() / "does/not/exist")}});
 
     CHECK(
       Disk::openFile(env.dir() / "does_not_exist.txt")
-      == Result<std::shared_ptr<CFile>>{Error{fmt::format(
+      == Result<std::shared_ptr<File>>{Error{fmt::format(
         "Failed to open {}: path does not denote a file",
         env.dir() / "does_not_exist.txt")}});
 
@@ -229,6 +233,49 @@ TEST_CASE("DiskIO")
 
     file = Disk::openFile(env.dir() / "linkedTest2.map");
     CHECK(file.is_success());
+
+    SECTION("File contents")
+    {
+      file = Disk::openFile(env.dir() / "test.txt");
+      REQUIRE(file.is_success());
+      CHECK(std::dynamic_pointer_cast<MmapFile>(file.value()) != nullptr);
+
+      auto reader = file.value()->reader();
+      CHECK(reader.readString(reader.size()) == "some content");
+
+      // a buffered reader keeps the mapped memory alive
+      const auto bufferedReader =
+        Disk::openFile(env.dir() / "test.txt") | kdl::transform([](auto mappedFile) {
+          return mappedFile->reader().subReaderFromBegin(5).buffer();
+        })
+        | kdl::value();
+      CHECK(bufferedReader.stringView() == "content");
+    }
+
+    SECTION("Empty files are not mapped")
+    {
+      std::ofstream{env.dir() / "empty.txt"};
+
+      CHECK(createMmapFile(env.dir() / "empty.txt").is_error());
+
+      file = Disk::openFile(env.dir() / "empty.txt");
+      REQUIRE(file.is_success());
+      CHECK(std::dynamic_pointer_cast<CFile>(file.value()) != nullptr);
+      CHECK(file.value()->size() == 0u);
+    }
+  }
+
+  SECTION("openUnmappedFile")
+  {
+    CHECK(
+      Disk::openUnmappedFile(env.dir() / "does_not_exist.txt")
+      == Result<std::shared_ptr<CFile>>{Error{fmt::format(
+        "Failed to open {}: path does not denote a file",
+        env.dir() / "does_not_exist.txt")}});
+
+    const auto file = Disk::openUnmappedFile(env.dir() / "test.txt") | kdl::value();
+    auto reader = file->reader();
+    CHECK(reader.readString(reader.size()) == "some content");
   }
 
   SECTION("withStream")
@@ -17,6 +17,7 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "el/CompiledExpression.h"
 #include "el/Expression.h"
 #include "io/DiskIO.h"
 #include "io/GameConfigParser.h"
@@ -745,11 +746,11 @@ TEST_CASE("GameConfigParser")
         mdl::EntityConfig{
           {{"Extras.ent"}},
           Color{0.6f, 0.6f, 0.6f, 1.0f},
-          el::ExpressionNode{el::ArrayExpression{{
+          el::CompiledExpression{el::ExpressionNode{el::ArrayExpression{{
             // the line numbers are not checked
             el::ExpressionNode{el::VariableExpression{"modelscale"}},
             el::ExpressionNode{el::VariableExpression{"modelscale_vec"}},
-          }}},
+          }}}},
           false},
         mdl::FaceAttribsConfig{
           {{{"light",
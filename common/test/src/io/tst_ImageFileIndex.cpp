@@ -0,0 +1,234 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "io/DiskIO.h"
+#include "io/DkPakFileSystem.h"
+#include "io/File.h"
+#include "io/IdPakFileSystem.h"
+#include "io/ImageFileIndex.h"
+#include "io/PathInfo.h"
+#include "io/Reader.h"
+#include "io/TestEnvironment.h"
+#include "io/TraversalMode.h"
+#include "io/WadFileSystem.h"
+#include "io/ZipFileSystem.h"
+
+#include "kdl/result.h"
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::io
+{
+namespace
+{
+
+template <typename FS>
+auto openFS(
+  const std::filesystem::path& path,
+  const std::shared_ptr<const ImageFileIndexCache>& indexCache)
+{
+  return Disk::openFile(path) | kdl::and_then([&](auto file) {
+           auto fs = std::make_unique<FS>(std::move(file));
+           fs->setIndexCache(indexCache, path);
+           return fs->reload() | kdl::transform([&]() {
+                    return std::unique_ptr<FileSystem>{std::move(fs)};
+                  });
+         })
+         | kdl::value();
+}
+
+std::string readContents(const FileSystem& fs, const std::filesystem::path& path)
+{
+  return fs.openFile(path) | kdl::transform([](auto file) {
+           auto reader = file->reader().buffer();
+           return std::string{reader.stringView()};
+         })
+         | kdl::value();
+}
+
+template <typename FS>
+void checkCachedFileSystem(const std::filesystem::path& imageFilePath)
+{
+  auto env = TestEnvironment{};
+  const auto indexCache = std::make_shared<ImageFileIndexCache>(env.dir() / "cache");
+
+  const auto fs = openFS<FS>(imageFilePath, indexCache);
+
+  const auto imageFileStamp = getImageFileStamp(imageFilePath);
+  REQUIRE(imageFileStamp);
+  REQUIRE(indexCache->load(imageFilePath, *imageFileStamp) != std::nullopt);
+
+  const auto cachedFs = openFS<FS>(imageFilePath, indexCache);
+
+  const auto paths = fs->find("", TraversalMode::Recursive) | kdl::value();
+  CHECK(cachedFs->find("", TraversalMode::Recursive) == paths);
+
+  for (const auto& path : paths)
+  {
+    if (fs->pathInfo(path) == PathInfo::File)
+    {
+      CAPTURE(path);
+      CHECK(readContents(*cachedFs, path) == readContents(*fs, path));
+    }
+  }
+}
+
+} // namespace
+
+TEST_CASE("ImageFileIndexCache")
+{
+  auto env = TestEnvironment{};
+  env.createFile("image.pak", "some contents");
+  env.createFile("other.pak", "other contents");
+
+  const auto imageFilePath = env.dir() / "image.pak";
+  const auto otherImageFilePath = env.dir() / "other.pak";
+
+  const auto entries = std::vector<ImageFileIndexEntry>{
+    {"pics/tag1.pcx", 12, 1024, 1024, 0},
+    {"textures/e1u1/bricka2_4.wal", 1036, 256, 512, 1},
+  };
+
+  const auto imageFileStamp = getImageFileStamp(imageFilePath).value();
+  const auto otherImageFileStamp = getImageFileStamp(otherImageFilePath).value();
+
+  const auto indexCache = ImageFileIndexCache{env.dir() / "cache"};
+
+  SECTION("Returns nothing if no index was stored")
+  {
+    CHECK(indexCache.load(imageFilePath, imageFileStamp) == std::nullopt);
+  }
+
+  SECTION("Returns the stored index")
+  {
+    REQUIRE(indexCache.store(imageFilePath, imageFileStamp, entries).is_success());
+    CHECK(indexCache.load(imageFilePath, imageFileStamp) == entries);
+    CHECK(indexCache.load(otherImageFilePath, otherImageFileStamp) == std::nullopt);
+  }
+
+  SECTION("Replaces a previously stored index")
+  {
+    REQUIRE(indexCache.store(imageFilePath, imageFileStamp, entries).is_success());
+    REQUIRE(indexCache.store(imageFilePath, imageFileStamp, {entries.front()})
+              .is_success());
+    CHECK(indexCache.load(imageFilePath, imageFileStamp) == std::vector{entries.front()});
+  }
+
+  SECTION("Ignores the stored index if the stamp differs")
+  {
+    REQUIRE(indexCache.store(imageFilePath, imageFileStamp, entries).is_success());
+
+    auto changedStamp = imageFileStamp;
+    changedStamp.size += 1;
+    CHECK(indexCache.load(imageFilePath, changedStamp) == std::nullopt);
+
+    changedStamp = imageFileStamp;
+    changedStamp.modificationTime += 1;
+    CHECK(indexCache.load(imageFilePath, changedStamp) == std::nullopt);
+  }
+
+  SECTION("Removes stale index files")
+  {
+    REQUIRE(indexCache.store(imageFilePath, imageFileStamp, entries).is_success());
+    REQUIRE(
+      indexCache.store(otherImageFilePath, otherImageFileStamp, entries).is_success());
+
+    const auto indexFiles =
+      Disk::find(indexCache.directory(), TraversalMode::Flat) | kdl::value();
+    REQUIRE(indexFiles.size() == 2u);
+
+    // make both index files old, then use one of them
+    const auto oldTime =
+      std::filesystem::file_time_type::clock::now() - std::chrono::days{2};
+    for (const auto& indexFile : indexFiles)
+    {
+      std::filesystem::last_write_time(indexFile, oldTime);
+    }
+    REQUIRE(indexCache.load(imageFilePath, imageFileStamp) == entries);
+
+    CHECK(indexCache.removeStaleIndexFiles(std::chrono::days{1}).is_success());
+    CHECK(indexCache.load(imageFilePath, imageFileStamp) == entries);
+    CHECK(indexCache.load(otherImageFilePath, otherImageFileStamp) == std::nullopt);
+    CHECK(
+      (Disk::find(indexCache.directory(), TraversalMode::Flat) | kdl::value()).size()
+      == 1u);
+  }
+
+  SECTION("Removing stale index files succeeds if the cache directory does not exist")
+  {
+    CHECK(indexCache.removeStaleIndexFiles(std::chrono::days{1}).is_success());
+  }
+}
+
+TEST_CASE("getImageFileStamp")
+{
+  auto env = TestEnvironment{};
+  env.createFile("image.pak", "some contents");
+
+  const auto imageFilePath = env.dir() / "image.pak";
+  const auto imageFileStamp = getImageFileStamp(imageFilePath);
+  REQUIRE(imageFileStamp);
+  CHECK(imageFileStamp->size == 13u);
+
+  SECTION("Changes if the image file is changed")
+  {
+    env.createFile("image.pak", "some other contents");
+    CHECK(getImageFileStamp(imageFilePath) != imageFileStamp);
+  }
+
+  SECTION("Returns nothing if the image file does not exist")
+  {
+    std::filesystem::remove(imageFilePath);
+    CHECK(getImageFileStamp(imageFilePath) == std::nullopt);
+  }
+}
+
+TEST_CASE("ImageFileSystem with ImageFileIndexCache")
+{
+  const auto fsTestPath = std::filesystem::current_path() / "fixture/test/io/";
+
+  SECTION("IdPakFileSystem")
+  {
+    checkCachedFileSystem<IdPakFileSystem>(fsTestPath / "Pak/idpak.pak");
+  }
+
+  SECTION("DkPakFileSystem")
+  {
+    checkCachedFileSystem<DkPakFileSystem>(fsTestPath / "Pak/dkpak.pak");
+  }
+
+  SECTION("ZipFileSystem")
+  {
+    checkCachedFileSystem<ZipFileSystem>(fsTestPath / "Zip/zip.zip");
+  }
+
+  SECTION("WadFileSystem")
+  {
+    checkCachedFileSystem<WadFileSystem>(fsTestPath / "Wad/cr8_czg.wad");
+  }
+}
+
+} // namespace tb::io
@@ -24,9 +24,14 @@
 #include "io/PathInfo.h"
 #include "io/TraversalMode.h"
 #include "io/WadFileSystem.h"
+#include "io/Reader.h"
 #include "io/ZipFileSystem.h"
 
+#include "kdl/task_manager.h"
+
 #include <filesystem>
+#include <string>
+#include <vector>
 
 #include "catch/Matchers.h"
 
@@ -984,6 +989,72 @@ TEST_CASE("Flat ImageFileSystems")
   }
 }
 
+TEST_CASE("ZipFileSystem")
+{
+  const auto zipPath = std::filesystem::current_path() / "fixture/test/io/Zip/zip.zip";
+
+  const auto readFile = [](const FileSystem& fs, const std::filesystem::path& path) {
+    if (fs.pathInfo(path) != PathInfo::File)
+    {
+      return std::string{};
+    }
+
+    const auto file = fs.openFile(path) | kdl::value();
+    auto reader = file->reader();
+    return reader.readString(reader.size());
+  };
+
+  SECTION("Files can be extracted concurrently")
+  {
+    const auto fs = std::shared_ptr<FileSystem>{openFS<ZipFileSystem>(zipPath)};
+    const auto paths = fs->find("", TraversalMode::Recursive) | kdl::value();
+
+    auto expected = std::vector<std::string>{};
+    {
+      const auto sequentialFs =
+        std::shared_ptr<FileSystem>{openFS<ZipFileSystem>(zipPath)};
+      for (const auto& path : paths)
+      {
+        expected.push_back(readFile(*sequentialFs, path));
+      }
+    }
+
+    auto taskManager = kdl::task_manager{4};
+    for (size_t i = 0; i < 4; ++i)
+    {
+      const auto actual = taskManager.parallel_transform(
+        paths, [&](const auto& path) { return readFile(*fs, path); }, 1);
+      CHECK(actual == expected);
+    }
+  }
+
+  SECTION("Extracted files are cached")
+  {
+    const auto fs = std::shared_ptr<FileSystem>{openFS<ZipFileSystem>(zipPath)};
+
+    const auto file1 = fs->openFile("amnet.cfg") | kdl::value();
+    const auto file2 = fs->openFile("amnet.cfg") | kdl::value();
+    CHECK(file1 == file2);
+  }
+
+  SECTION("Cached files are kept apart for every zip file system")
+  {
+    auto fs1 = std::shared_ptr<FileSystem>{openFS<ZipFileSystem>(zipPath)};
+    const auto fs2 = std::shared_ptr<FileSystem>{openFS<ZipFileSystem>(zipPath)};
+
+    const auto file1 = fs1->openFile("amnet.cfg") | kdl::value();
+    const auto file2 = fs2->openFile("amnet.cfg") | kdl::value();
+    CHECK(file1 != file2);
+
+    // destroying a file system removes its files from the cache, but not from its users
+    const auto contents = readFile(*fs1, "amnet.cfg");
+    fs1.reset();
+    auto reader = file1->reader();
+    CHECK(reader.readString(reader.size()) == contents);
+    CHECK((fs2->openFile("amnet.cfg") | kdl::value()) == file2);
+  }
+}
+
 TEST_CASE("WadFileSystem")
 {
   SECTION("Wad files can be replaced while wad file system exists")
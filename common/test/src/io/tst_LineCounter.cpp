@@ -0,0 +1,98 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FileLocation.h"
+#include "io/LineCounter.h"
+
+#include <string_view>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::io
+{
+
+TEST_CASE("LineCounter")
+{
+  using namespace std::string_view_literals;
+
+  SECTION("Empty string")
+  {
+    const auto lineCounter = LineCounter{""sv};
+    CHECK(lineCounter.location(0) == FileLocation{1, 1});
+    CHECK(lineCounter.location(1) == FileLocation{1, 1});
+  }
+
+  SECTION("Initial line and column")
+  {
+    const auto lineCounter = LineCounter{"ab\ncd"sv, 7, 3};
+    CHECK(lineCounter.location(0) == FileLocation{7, 3});
+    CHECK(lineCounter.location(1) == FileLocation{7, 4});
+    CHECK(lineCounter.location(4) == FileLocation{8, 2});
+    CHECK(lineCounter.location(1) == FileLocation{7, 4});
+  }
+
+  SECTION("Line endings")
+  {
+    // line feed, carriage return and line feed, single carriage return
+    const auto str = "a\nbc\r\nd\re"sv;
+    const auto lineCounter = LineCounter{str};
+
+    const auto expected = std::vector<FileLocation>{
+      {1, 1}, // a
+      {1, 2}, // \n
+      {2, 1}, // b
+      {2, 2}, // c
+      {2, 3}, // \r
+      {2, 4}, // \n
+      {3, 1}, // d
+      {3, 2}, // \r
+      {4, 1}, // e
+      {4, 2}, // end
+    };
+
+    SECTION("Ascending queries")
+    {
+      for (size_t i = 0; i < expected.size(); ++i)
+      {
+        CAPTURE(i);
+        CHECK(lineCounter.location(i) == expected[i]);
+      }
+    }
+
+    SECTION("Descending queries")
+    {
+      for (size_t i = expected.size(); i > 0; --i)
+      {
+        CAPTURE(i - 1);
+        CHECK(lineCounter.location(i - 1) == expected[i - 1]);
+      }
+    }
+  }
+
+  SECTION("setLocation")
+  {
+    auto lineCounter = LineCounter{"abc\ndef\nghi"sv};
+    lineCounter.setLocation(5, 10, 20);
+    CHECK(lineCounter.location(6) == FileLocation{10, 21});
+    CHECK(lineCounter.location(9) == FileLocation{11, 2});
+  }
+}
+
+} // namespace tb::io
@@ -0,0 +1,343 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "io/StandardMapParser.h"
+#include "mdl/MapFormat.h"
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::io
+{
+
+TEST_CASE("findEntityOffsets")
+{
+  using namespace std::string_view_literals;
+  using Offsets = std::optional<std::vector<size_t>>;
+
+  SECTION("Empty string")
+  {
+    CHECK(findEntityOffsets(""sv) == Offsets{std::vector<size_t>{}});
+    CHECK(findEntityOffsets(" \n\t\r\n"sv) == Offsets{std::vector<size_t>{}});
+  }
+
+  SECTION("Single entity")
+  {
+    CHECK(findEntityOffsets("{}"sv) == Offsets{{0}});
+    CHECK(findEntityOffsets("\n  { \"classname\" \"worldspawn\" }\n"sv) == Offsets{{3}});
+  }
+
+  SECTION("Multiple entities")
+  {
+    CHECK(findEntityOffsets("{}{}\n{\n}"sv) == Offsets{{0, 2, 5}});
+  }
+
+  SECTION("Entities with brushes and patches")
+  {
+    const auto str = R"({
+"classname" "worldspawn"
+{
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) {fence 0 0 0 1 1
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) }fence 0 0 0 1 1
+}
+{
+patchDef2
+{
+common/caulk
+( 3 3 0 0 0 )
+(
+( (0 0 0 0 0 ) (0 0 0 0 0 ) (0 0 0 0 0 ) )
+)
+}
+}
+}
+{
+"classname" "info_player_start"
+}
+)"sv;
+    CHECK(findEntityOffsets(str) == Offsets{{0, str.rfind("{\n\"classname\"")}});
+  }
+
+  SECTION("Braces in comments and quoted strings are ignored")
+  {
+    CHECK(findEntityOffsets("// {\n{}"sv) == Offsets{{5}});
+    CHECK(findEntityOffsets("; {\n{}"sv) == Offsets{{4}});
+    CHECK(findEntityOffsets("{ \"}\" \"{\" }{}"sv) == Offsets{{0, 11}});
+    CHECK(findEntityOffsets(R"({ "a\"b}" "c" }{})"sv) == Offsets{{0, 15}});
+  }
+
+  SECTION("Quoted strings with trailing backslashes")
+  {
+    CHECK(findEntityOffsets("{ \"path\" \"a\\\"\n}{}"sv) == Offsets{{0, 15}});
+    CHECK(findEntityOffsets(R"({ "path" "a\"}{})"sv) == Offsets{{0, 14}});
+
+    // the tokenizer ends such strings within brushes, too
+    const auto str = R"({
+{
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) "textures\"
+}
+}
+{
+}
+)"sv;
+    CHECK(findEntityOffsets(str) == Offsets{{0, str.rfind("{\n}")}});
+  }
+
+  SECTION("Malformed input")
+  {
+    CHECK(findEntityOffsets("{"sv) == std::nullopt);
+    CHECK(findEntityOffsets("}"sv) == std::nullopt);
+    CHECK(findEntityOffsets("{}}"sv) == std::nullopt);
+    CHECK(findEntityOffsets("{ \"unterminated }"sv) == std::nullopt);
+    CHECK(findEntityOffsets("\"classname\" \"worldspawn\""sv) == std::nullopt);
+    CHECK(findEntityOffsets("{} garbage {}"sv) == std::nullopt);
+    CHECK(findEntityOffsets(R"({ "a\"}" "b" }{})"sv) == std::nullopt);
+    CHECK(findEntityOffsets("/// comment\n{}"sv) == std::nullopt);
+  }
+}
+
+TEST_CASE("detectMapFormats")
+{
+  using mdl::MapFormat;
+
+  const auto allFormats = std::vector<MapFormat>{
+    MapFormat::Standard,
+    MapFormat::Quake2,
+    MapFormat::Quake2_Valve,
+    MapFormat::Valve,
+    MapFormat::Hexen2,
+    MapFormat::Daikatana,
+    MapFormat::Quake3_Legacy,
+    MapFormat::Quake3_Valve,
+    MapFormat::Quake3,
+  };
+
+  SECTION("Returns all candidates if there are no brushes")
+  {
+    CHECK(detectMapFormats("", allFormats) == allFormats);
+    CHECK(detectMapFormats(R"({ "classname" "worldspawn" })", allFormats) == allFormats);
+  }
+
+  SECTION("Returns all candidates if the map is malformed")
+  {
+    CHECK(detectMapFormats("{ { ( 0 0 ) }", allFormats) == allFormats);
+    CHECK(detectMapFormats("} {", allFormats) == allFormats);
+  }
+
+  SECTION("Returns all candidates if none is compatible")
+  {
+    const auto data = R"(
+{
+"classname" "worldspawn"
+{
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) tex 0 0 0 1 1 0 0 0
+}
+}
+)";
+    const auto candidates = std::vector<MapFormat>{MapFormat::Standard, MapFormat::Valve};
+    CHECK(detectMapFormats(data, candidates) == candidates);
+  }
+
+  SECTION("Standard faces")
+  {
+    const auto data = R"(
+{
+"classname" "worldspawn"
+{
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) {fence 0 0 0 1 1
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) "quoted name" 0 0 0 1 1
+}
+}
+)";
+    CHECK(
+      detectMapFormats(data, allFormats)
+      == std::vector<MapFormat>{
+        MapFormat::Standard,
+        MapFormat::Quake2,
+        MapFormat::Hexen2,
+        MapFormat::Daikatana,
+        MapFormat::Quake3_Legacy,
+        MapFormat::Quake3,
+      });
+  }
+
+  SECTION("Quake 2 faces")
+  {
+    const auto data = R"(
+{
+"classname" "worldspawn"
+{
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) e1u1/floor 0 0 0 1 1 0 0 0
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) e1u1/floor 0 0 0 1 1
+}
+}
+)";
+    CHECK(
+      detectMapFormats(data, allFormats)
+      == std::vector<MapFormat>{
+        MapFormat::Quake2,
+        MapFormat::Daikatana,
+        MapFormat::Quake3_Legacy,
+        MapFormat::Quake3,
+      });
+  }
+
+  SECTION("Daikatana faces")
+  {
+    const auto data = R"(
+{
+"classname" "worldspawn"
+{
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) e1m1/floor 0 0 0 1 1 0 0 0 255 128 0
+}
+}
+)";
+    CHECK(
+      detectMapFormats(data, allFormats) == std::vector<MapFormat>{MapFormat::Daikatana});
+  }
+
+  SECTION("Hexen 2 faces")
+  {
+    const auto data = R"(
+{
+"classname" "worldspawn"
+{
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) tex 0 0 0 1 1 -1
+}
+}
+)";
+    CHECK(
+      detectMapFormats(data, allFormats) == std::vector<MapFormat>{MapFormat::Hexen2});
+  }
+
+  SECTION("Valve faces")
+  {
+    const auto data = R"(
+{
+"classname" "worldspawn"
+{
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) tex [ 1 0 0 0 ] [ 0 -1 0 0 ] 0 1 1
+}
+}
+)";
+    CHECK(
+      detectMapFormats(data, allFormats)
+      == std::vector<MapFormat>{
+        MapFormat::Quake2_Valve, MapFormat::Valve, MapFormat::Quake3_Valve});
+  }
+
+  SECTION("Quake 2 Valve faces")
+  {
+    const auto data = R"(
+{
+"classname" "worldspawn"
+{
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) tex [ 1 0 0 0 ] [ 0 -1 0 0 ] 0 1 1 0 0 0
+}
+}
+)";
+    CHECK(
+      detectMapFormats(data, allFormats)
+      == std::vector<MapFormat>{MapFormat::Quake2_Valve, MapFormat::Quake3_Valve});
+  }
+
+  SECTION("Patches")
+  {
+    const auto data = R"(
+{
+"classname" "worldspawn"
+{
+patchDef2
+{
+{fence
+( 3 3 0 0 0 )
+(
+( ( 0 0 0 0 0 ) ( 0 0 0 0 0 ) ( 0 0 0 0 0 ) )
+)
+}
+}
+{
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) tex 0 0 0 1 1 0 0 0
+}
+}
+)";
+    CHECK(
+      detectMapFormats(data, allFormats)
+      == std::vector<MapFormat>{MapFormat::Quake3_Legacy, MapFormat::Quake3});
+  }
+
+  SECTION("Brush primitives")
+  {
+    const auto data = R"(
+{
+"classname" "worldspawn"
+{
+brushDef
+{
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) ( ( 1 0 0 ) ( 0 1 0 ) ) tex 0 0 0
+}
+}
+}
+)";
+    CHECK(
+      detectMapFormats(data, allFormats) == std::vector<MapFormat>{MapFormat::Quake3});
+  }
+
+  SECTION("Faces followed by comments are not inspected")
+  {
+    const auto data = R"(
+{
+"classname" "worldspawn"
+{
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) tex 0 0 0 1 1
+/// comment
+}
+}
+)";
+    CHECK(detectMapFormats(data, allFormats) == allFormats);
+  }
+
+  SECTION("Inspects at most the given number of faces")
+  {
+    const auto data = R"(
+{
+"classname" "worldspawn"
+{
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) tex 0 0 0 1 1
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) tex 0 0 0 1 1 0 0 0
+}
+}
+)";
+    CHECK(
+      detectMapFormats(data, allFormats, 1)
+      == std::vector<MapFormat>{
+        MapFormat::Standard,
+        MapFormat::Quake2,
+        MapFormat::Hexen2,
+        MapFormat::Daikatana,
+        MapFormat::Quake3_Legacy,
+        MapFormat::Quake3,
+      });
+  }
+}
+
+} // namespace tb::io
@@ -1257,6 +1257,93 @@ common/caulk
       }));
   }
 
+  SECTION("parseEntitiesInParallel")
+  {
+    auto data = std::string{R"(
+// leading comment with an unbalanced brace {
+{
+"classname" "worldspawn"
+{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) tex1 0 0 0 1 1
+( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0  -0 ) tex2 0 0 0 1 1
+( -0 -0 -16 ) ( 64 -0 -16 ) ( -0 64 -16 ) tex3 0 0 0 1 1
+( 64 64  -0 ) ( -0 64  -0 ) ( 64 64 -16 ) tex4 0 0 0 1 1
+( 64 64  -0 ) ( 64 64 -16 ) ( 64 -0  -0 ) tex5 0 0 0 1 1
+( 64 64  -0 ) ( 64 -0  -0 ) ( -0 64  -0 ) tex6 0 0 0 1 1
+}
+}
+)"};
+
+    for (size_t i = 0; i < 32; ++i)
+    {
+      data += fmt::format(
+        R"(// entity {0}
+{{
+"classname" "func_detail"
+"index" "{0}"
+"index" "duplicate"
+{{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) tex1 0 0 0 1 1
+( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0  -0 ) tex2 0 0 0 1 1
+( -0 -0 -16 ) ( 64 -0 -16 ) ( -0 64 -16 ) tex3 0 0 0 1 1
+( 64 64  -0 ) ( -0 64  -0 ) ( 64 64 -16 ) tex4 0 0 0 1 1
+( 64 64  -0 ) ( 64 64 -16 ) ( 64 -0  -0 ) tex5 0 0 0 1 1
+( 64 64  -0 ) ( 64 -0  -0 ) ( -0 64  -0 ) tex6 0 0 0 1 1
+}}
+}}
+)",
+        i);
+    }
+
+    auto sequentialTaskManager = kdl::task_manager{0};
+    auto sequentialStatus = TestParserStatus{};
+    auto sequentialReader = WorldReader{data, mdl::MapFormat::Standard, {}};
+    auto sequentialResult =
+      sequentialReader.read(worldBounds, sequentialStatus, sequentialTaskManager);
+    REQUIRE(sequentialResult.is_success());
+
+    auto parallelTaskManager = kdl::task_manager{4};
+    auto parallelStatus = TestParserStatus{};
+    auto parallelReader = WorldReader{data, mdl::MapFormat::Standard, {}};
+    auto parallelResult =
+      parallelReader.read(worldBounds, parallelStatus, parallelTaskManager);
+    REQUIRE(parallelResult.is_success());
+
+    const auto& sequentialWorld = sequentialResult.value();
+    const auto& parallelWorld = parallelResult.value();
+
+    CHECK(sequentialWorld->lineNumber() == parallelWorld->lineNumber());
+
+    const auto* sequentialLayer = sequentialWorld->children().front();
+    const auto* parallelLayer = parallelWorld->children().front();
+    REQUIRE(parallelLayer->childCount() == 33u);
+    REQUIRE(sequentialLayer->childCount() == parallelLayer->childCount());
+
+    for (size_t i = 0; i < parallelLayer->childCount(); ++i)
+    {
+      const auto* sequentialNode = sequentialLayer->children()[i];
+      const auto* parallelNode = parallelLayer->children()[i];
+      CHECK(sequentialNode->lineNumber() == parallelNode->lineNumber());
+      REQUIRE(parallelNode->childCount() == sequentialNode->childCount());
+
+      if (i > 0)
+      {
+        const auto* entityNode = dynamic_cast<const mdl::EntityNode*>(parallelNode);
+        REQUIRE(entityNode != nullptr);
+        CHECK(*entityNode->entity().property("index") == std::to_string(i - 1));
+        REQUIRE(entityNode->childCount() == 1u);
+        CHECK(
+          entityNode->children().front()->lineNumber()
+          == sequentialNode->children().front()->lineNumber());
+      }
+    }
+
+    CHECK(parallelStatus.countStatus(LogLevel::Warn) == 32u);
+    CHECK(
+      parallelStatus.messages(LogLevel::Warn)
+      == sequentialStatus.messages(LogLevel::Warn));
+  }
+
   SECTION("parseMultipleClassnames")
   {
     // See https://github.com/TrenchBroom/TrenchBroom/issues/1485
@@ -249,6 +249,90 @@ TEST_CASE("BrushTest.constructBrushWithRedundantFaces")
           .is_error());
 }
 
+TEST_CASE("BrushTest.copySharesGeometry")
+{
+  const auto worldBounds = vm::bbox3d{4096.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  const auto original =
+    builder.createCube(64.0, "left", "right", "front", "back", "top", "bottom")
+    | kdl::value();
+  const auto originalVertexPositions = original.vertexPositions();
+
+  auto copy = original;
+  CHECK(original.hasSharedGeometry());
+  CHECK(copy.hasSharedGeometry());
+  for (size_t i = 0; i < copy.faceCount(); ++i)
+  {
+    CHECK(copy.face(i).geometry() == original.face(i).geometry());
+  }
+
+  SECTION("Changing face attributes keeps the geometry shared")
+  {
+    auto attributes = copy.face(0).attributes();
+    attributes.setMaterialName("other");
+    copy.face(0).setAttributes(attributes);
+
+    CHECK(copy.face(0).geometry() == original.face(0).geometry());
+    CHECK(copy.hasSharedGeometry());
+  }
+
+  SECTION("Changing the geometry unshares it")
+  {
+    REQUIRE(copy
+              .transform(
+                worldBounds, vm::translation_matrix(vm::vec3d{16, 0, 0}), false)
+              .is_success());
+
+    CHECK_FALSE(copy.hasSharedGeometry());
+    CHECK_FALSE(original.hasSharedGeometry());
+    CHECK(original.vertexPositions() == originalVertexPositions);
+    CHECK(copy.bounds() == original.bounds().translate(vm::vec3d{16, 0, 0}));
+  }
+}
+
+TEST_CASE("BrushTest.releaseAndRestoreGeometry")
+{
+  const auto worldBounds = vm::bbox3d{4096.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto brush = builder.createCube(64.0, "left", "right", "front", "back", "top", "bottom")
+               | kdl::value();
+
+  SECTION("Brush created from faces")
+  {
+    const auto transform = vm::rotation_matrix(vm::vec3d{0, 0, 1}, vm::to_radians(30.0));
+    REQUIRE(brush.transform(worldBounds, transform, false).is_success());
+  }
+
+  SECTION("Brush created from vertices")
+  {
+    const auto transform = vm::translation_matrix(vm::vec3d{-16, -16, 0});
+    REQUIRE(
+      brush.transformVertices(worldBounds, {vm::vec3d{32, 32, 32}}, transform)
+        .is_success());
+  }
+
+  const auto original = brush;
+
+  brush.releaseGeometry();
+  CHECK_FALSE(brush.hasGeometry());
+  CHECK(brush == original);
+
+  CHECK(brush.restoreGeometry(worldBounds).is_success());
+  CHECK(brush.hasGeometry());
+  CHECK(brush == original);
+  CHECK(brush.vertexPositions() == original.vertexPositions());
+  for (size_t i = 0; i < brush.faceCount(); ++i)
+  {
+    CHECK(brush.face(i).vertexPositions() == original.face(i).vertexPositions());
+  }
+
+  // restoring a brush that has a geometry does nothing
+  CHECK(brush.restoreGeometry(worldBounds).is_success());
+  CHECK(brush.vertexPositions() == original.vertexPositions());
+}
+
 TEST_CASE("BrushTest.cloneFaceAttributesFrom")
 {
   const auto worldBounds = vm::bbox3d{4096.0};
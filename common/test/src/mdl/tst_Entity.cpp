@@ -17,6 +17,7 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "el/CompiledExpression.h"
 #include "el/Expression.h"
 #include "io/ELParser.h"
 #include "mdl/Entity.h"
@@ -69,7 +70,7 @@ TEST_CASE("EntityTest")
       entity.setDefinition(&definition);
 
       const auto defaultModelScaleExpression =
-        el::ExpressionNode{el::LiteralExpression{el::Value{2.0}}};
+        el::CompiledExpression{el::ExpressionNode{el::LiteralExpression{el::Value{2.0}}}};
 
       REQUIRE(
         entity.modelTransformation(defaultModelScaleExpression)
@@ -167,7 +168,7 @@ TEST_CASE("EntityTest")
       auto entity = Entity{};
 
       const auto defaultModelScaleExpression =
-        el::ExpressionNode{el::LiteralExpression{el::Value{2.0}}};
+        el::CompiledExpression{el::ExpressionNode{el::LiteralExpression{el::Value{2.0}}}};
 
       REQUIRE(
         entity.modelTransformation(defaultModelScaleExpression)
@@ -207,6 +208,46 @@ TEST_CASE("EntityTest")
 
     entity.addOrUpdateProperty(EntityPropertyKeys::Spawnflags, "1");
     CHECK(entity.modelSpecification() == ModelSpecification{"maps/b_shell1.bsp", 0, 0});
+
+    SECTION("Cached specification is updated when referenced properties change")
+    {
+      entity.addOrUpdateProperty("some_key", "1");
+      CHECK(entity.modelSpecification() == ModelSpecification{"maps/b_shell1.bsp", 0, 0});
+
+      entity.renameProperty(EntityPropertyKeys::Spawnflags, "some_other_key");
+      CHECK(entity.modelSpecification() == ModelSpecification{"maps/b_shell0.bsp", 0, 0});
+
+      entity.renameProperty("some_key", EntityPropertyKeys::Spawnflags);
+      CHECK(entity.modelSpecification() == ModelSpecification{"maps/b_shell1.bsp", 0, 0});
+
+      entity.removeProperty(EntityPropertyKeys::Spawnflags);
+      CHECK(entity.modelSpecification() == ModelSpecification{"maps/b_shell0.bsp", 0, 0});
+
+      entity.setProperties({{EntityPropertyKeys::Spawnflags, "2"}});
+      CHECK(entity.modelSpecification() == ModelSpecification{"maps/b_shell2.bsp", 0, 0});
+    }
+
+    SECTION("Cached specification is updated when the definition changes")
+    {
+      const auto otherDefinition = EntityDefinition{
+        "some_name",
+        Color{},
+        "",
+        {},
+        PointEntityDefinition{
+          vm::bbox3d{32.0},
+          ModelDefinition{
+            io::ELParser::parseStrict(R"("maps/b_shell3.bsp")").value()},
+          {},
+        },
+      };
+
+      entity.setDefinition(&otherDefinition);
+      CHECK(entity.modelSpecification() == ModelSpecification{"maps/b_shell3.bsp", 0, 0});
+
+      entity.unsetEntityDefinitionAndModel();
+      CHECK(entity.modelSpecification() == ModelSpecification{});
+    }
   }
 
   SECTION("decalSpecification")
@@ -252,7 +293,7 @@ TEST_CASE("EntityTest")
     entity.setDefinition(&definition);
 
     const auto defaultModelScaleExpression =
-      el::ExpressionNode{el::LiteralExpression{el::Value{2.0}}};
+      el::CompiledExpression{el::ExpressionNode{el::LiteralExpression{el::Value{2.0}}}};
 
     REQUIRE(
       entity.modelTransformation(defaultModelScaleExpression)
@@ -301,14 +342,14 @@ TEST_CASE("EntityTest")
     {
       entity.setDefinition(&definition);
       REQUIRE(
-        entity.modelTransformation(
-          el::ExpressionNode{el::LiteralExpression{el::Value{1.0}}})
+        entity.modelTransformation(el::CompiledExpression{
+          el::ExpressionNode{el::LiteralExpression{el::Value{1.0}}}})
         == vm::scaling_matrix(vm::vec3d{1, 1, 1}));
 
       entity.addOrUpdateProperty("something", "else");
       CHECK(
-        entity.modelTransformation(
-          el::ExpressionNode{el::LiteralExpression{el::Value{2.0}}})
+        entity.modelTransformation(el::CompiledExpression{
+          el::ExpressionNode{el::LiteralExpression{el::Value{2.0}}}})
         == vm::scaling_matrix(vm::vec3d{2, 2, 2}));
     }
   }
@@ -370,7 +411,7 @@ TEST_CASE("EntityTest")
     SECTION("Updates cached model transformation")
     {
       const auto defaultModelScaleExpression =
-        el::ExpressionNode{el::LiteralExpression{el::Value{2.0}}};
+        el::CompiledExpression{el::ExpressionNode{el::LiteralExpression{el::Value{2.0}}}};
 
       entity.setDefinition(&definition);
       entity.addOrUpdateProperty("something", "1 2 3");
@@ -442,7 +483,7 @@ TEST_CASE("EntityTest")
       entity.addOrUpdateProperty("modelscale", "1 2 3");
 
       const auto defaultModelScaleExpression =
-        el::ExpressionNode{el::LiteralExpression{el::Value{2.0}}};
+        el::CompiledExpression{el::ExpressionNode{el::LiteralExpression{el::Value{2.0}}}};
 
       REQUIRE(
         entity.modelTransformation(defaultModelScaleExpression)
@@ -649,7 +690,7 @@ TEST_CASE("EntityTest")
       entity.setDefinition(&definition);
 
       const auto defaultModelScaleExpression =
-        el::ExpressionNode{el::LiteralExpression{el::Value{2.0}}};
+        el::CompiledExpression{el::ExpressionNode{el::LiteralExpression{el::Value{2.0}}}};
 
       REQUIRE(
         entity.modelTransformation(defaultModelScaleExpression)
@@ -759,7 +800,7 @@ TEST_CASE("EntityTest")
       entity.setClassname("some_class");
 
       const auto defaultModelScaleExpression =
-        el::ExpressionNode{el::LiteralExpression{el::Value{2.0}}};
+        el::CompiledExpression{el::ExpressionNode{el::LiteralExpression{el::Value{2.0}}}};
 
       entity.setDefinition(&otherDefinition);
       REQUIRE(
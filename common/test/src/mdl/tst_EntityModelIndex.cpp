@@ -0,0 +1,100 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/Entity.h"
+#include "mdl/EntityModel.h"
+#include "mdl/EntityModelDataResource.h"
+#include "mdl/EntityModelIndex.h"
+#include "mdl/EntityNode.h"
+
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::mdl
+{
+namespace
+{
+
+EntityModel createEntityModel()
+{
+  return EntityModel{
+    "",
+    createEntityModelDataResource(
+      EntityModelData{PitchType::Normal, Orientation::Oriented})};
+}
+
+} // namespace
+
+TEST_CASE("EntityModelIndex")
+{
+  auto index = EntityModelIndex{};
+
+  const auto model1 = createEntityModel();
+  const auto model2 = createEntityModel();
+
+  auto entity1 = EntityNode{Entity{}};
+  auto entity2 = EntityNode{Entity{}};
+  auto entity3 = EntityNode{Entity{}};
+
+  index.setEntityModel(&entity1, &model1);
+  index.setEntityModel(&entity2, &model1);
+  index.setEntityModel(&entity3, &model2);
+
+  SECTION("findEntityNodes")
+  {
+    CHECK(index.findEntityNodes({}).empty());
+    CHECK_THAT(
+      index.findEntityNodes({&model1}),
+      Catch::UnorderedEquals(std::vector<EntityNode*>{&entity1, &entity2}));
+    CHECK_THAT(
+      index.findEntityNodes({&model1, &model2}),
+      Catch::UnorderedEquals(std::vector<EntityNode*>{&entity1, &entity2, &entity3}));
+  }
+
+  SECTION("setEntityModel replaces the previous model")
+  {
+    index.setEntityModel(&entity1, &model2);
+    CHECK(index.findEntityNodes({&model1}) == std::vector<EntityNode*>{&entity2});
+    CHECK_THAT(
+      index.findEntityNodes({&model2}),
+      Catch::UnorderedEquals(std::vector<EntityNode*>{&entity1, &entity3}));
+
+    index.setEntityModel(&entity2, nullptr);
+    CHECK(index.findEntityNodes({&model1}).empty());
+  }
+
+  SECTION("removeEntityNode")
+  {
+    index.removeEntityNode(&entity3);
+    CHECK(index.findEntityNodes({&model2}).empty());
+
+    // removing a node that is not in the index does nothing
+    index.removeEntityNode(&entity3);
+    CHECK(index.findEntityNodes({&model1}).size() == 2u);
+  }
+
+  SECTION("clear")
+  {
+    index.clear();
+    CHECK(index.findEntityNodes({&model1, &model2}).empty());
+  }
+}
+
+} // namespace tb::mdl
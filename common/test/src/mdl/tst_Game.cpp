@@ -52,7 +52,7 @@ TEST_CASE("GameTest.loadCorruptPackages")
     auto logger = NullLogger();
     UNSCOPED_INFO(
       "Should not throw when loading corrupted package file for game " << game);
-    CHECK_NOTHROW(GameImpl(config, gamePath, logger));
+    CHECK_NOTHROW(GameImpl(config, gamePath, nullptr, logger));
   }
 }
 
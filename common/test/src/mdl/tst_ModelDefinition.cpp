@@ -17,6 +17,7 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "el/CompiledExpression.h"
 #include "el/Expression.h"
 #include "el/VariableStore.h"
 #include "io/ELParser.h"
@@ -155,9 +156,8 @@ TEST_CASE("ModelDefinition")
 
     const auto defaultScaleExpression =
       globalScaleExpressionStr
-        ? std::optional<el::ExpressionNode>{io::ELParser::parseStrict(
-                                              *globalScaleExpressionStr)
-                                              .value()}
+        ? std::optional{el::CompiledExpression{
+            io::ELParser::parseStrict(*globalScaleExpressionStr).value()}}
         : std::nullopt;
 
     CHECK(modelDefinition.scale(variables, defaultScaleExpression) == expectedScale);
@@ -25,14 +25,17 @@
 #include "mdl/BrushFaceHandle.h"
 #include "mdl/BrushNode.h"
 #include "mdl/EditorContext.h"
+#include "mdl/EmptyGroupValidator.h"
 #include "mdl/Entity.h"
 #include "mdl/EntityNode.h"
+#include "mdl/EntityProperties.h"
 #include "mdl/Group.h"
 #include "mdl/GroupNode.h"
 #include "mdl/Layer.h"
 #include "mdl/LayerNode.h"
 #include "mdl/LockState.h"
 #include "mdl/MapFormat.h"
+#include "mdl/MissingClassnameValidator.h"
 #include "mdl/ModelUtils.h"
 #include "mdl/PatchNode.h"
 #include "mdl/WorldNode.h"
@@ -235,22 +238,23 @@ TEST_CASE("ModelUtils.collectTouchingNodes")
 
   const auto allNodes = std::vector<Node*>{
     &worldNode, &layerNode, &groupNode, &entityNode, &brushNode, &patchNode};
+  auto taskManager = createTestTaskManager();
 
   CHECK_THAT(
-    collectTouchingNodes(allNodes, {&touchesAll}),
+    collectTouchingNodes(allNodes, {&touchesAll}, *taskManager),
     Catch::Matchers::Equals(
       std::vector<Node*>{&groupNode, &entityNode, &brushNode, &patchNode}));
 
   CHECK_THAT(
-    collectTouchingNodes(allNodes, {&touchesNothing}),
+    collectTouchingNodes(allNodes, {&touchesNothing}, *taskManager),
     Catch::Matchers::Equals(std::vector<Node*>{}));
 
   CHECK_THAT(
-    collectTouchingNodes(allNodes, {&touchesBrush}),
+    collectTouchingNodes(allNodes, {&touchesBrush}, *taskManager),
     Catch::Matchers::Equals(std::vector<Node*>{&brushNode}));
 
   CHECK_THAT(
-    collectTouchingNodes(allNodes, {&touchesBrush, &touchesAll}),
+    collectTouchingNodes(allNodes, {&touchesBrush, &touchesAll}, *taskManager),
     Catch::Matchers::Equals(
       std::vector<Node*>{&groupNode, &entityNode, &brushNode, &patchNode}));
 }
@@ -313,26 +317,98 @@ TEST_CASE("ModelUtils.collectContainedNodes")
 
   const auto allNodes = std::vector<Node*>{
     &worldNode, &layerNode, &groupNode, &entityNode, &brushNode, &patchNode};
+  auto taskManager = createTestTaskManager();
 
   CHECK_THAT(
-    collectContainedNodes(allNodes, {&containsAll}),
+    collectContainedNodes(allNodes, {&containsAll}, *taskManager),
     Catch::Matchers::Equals(
       std::vector<Node*>{&groupNode, &entityNode, &brushNode, &patchNode}));
 
   CHECK_THAT(
-    collectContainedNodes(allNodes, {&containsNothing}),
+    collectContainedNodes(allNodes, {&containsNothing}, *taskManager),
     Catch::Matchers::Equals(std::vector<Node*>{}));
 
   CHECK_THAT(
-    collectContainedNodes(allNodes, {&containsPatch}),
+    collectContainedNodes(allNodes, {&containsPatch}, *taskManager),
     Catch::Matchers::Equals(std::vector<Node*>{&patchNode}));
 
   CHECK_THAT(
-    collectContainedNodes(allNodes, {&containsPatch, &containsAll}),
+    collectContainedNodes(allNodes, {&containsPatch, &containsAll}, *taskManager),
     Catch::Matchers::Equals(
       std::vector<Node*>{&groupNode, &entityNode, &brushNode, &patchNode}));
 }
 
+TEST_CASE("ModelUtils.collectMatchingNodesInWorld")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  auto taskManager = createTestTaskManager();
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+  auto builder = BrushBuilder{mapFormat, worldBounds};
+
+  auto* groupNode = new GroupNode{Group{"group"}};
+  groupNode->addChild(new EntityNode{Entity{}});
+  auto* entityNode = new EntityNode{Entity{}};
+  auto* brushNode = new BrushNode{builder.createCube(64.0, "material") | kdl::value()};
+  auto* farBrushNode = new BrushNode{
+    builder.createCuboid(vm::bbox3d{{1024, 1024, 1024}, {1088, 1088, 1088}}, "material")
+    | kdl::value()};
+
+  auto* layerNode = worldNode.defaultLayer();
+  layerNode->addChild(groupNode);
+  layerNode->addChild(entityNode);
+  layerNode->addChild(brushNode);
+  layerNode->addChild(farBrushNode);
+
+  REQUIRE(worldNode.nodeTree().contains(entityNode));
+  REQUIRE(worldNode.nodeTree().contains(brushNode));
+  REQUIRE(worldNode.nodeTree().contains(farBrushNode));
+
+  const auto allNodes = std::vector<Node*>{&worldNode};
+
+  SECTION("collectTouchingNodes")
+  {
+    auto touchesAll = BrushNode{builder.createCube(24.0, "material") | kdl::value()};
+    auto touchesFarBrush = BrushNode{
+      builder.createCuboid(vm::bbox3d{{1080, 1080, 1080}, {1100, 1100, 1100}}, "material")
+      | kdl::value()};
+
+    CHECK_THAT(
+      collectTouchingNodes(allNodes, {&touchesAll}, *taskManager),
+      Catch::Matchers::Equals(std::vector<Node*>{groupNode, entityNode, brushNode}));
+
+    CHECK_THAT(
+      collectTouchingNodes(allNodes, {&touchesFarBrush}, *taskManager),
+      Catch::Matchers::Equals(std::vector<Node*>{farBrushNode}));
+
+    CHECK_THAT(
+      collectTouchingNodes(allNodes, {&touchesFarBrush, &touchesAll}, *taskManager),
+      Catch::Matchers::Equals(
+        std::vector<Node*>{groupNode, entityNode, brushNode, farBrushNode}));
+
+    CHECK_THAT(
+      collectTouchingNodes(allNodes, {brushNode}, *taskManager),
+      Catch::Matchers::Equals(std::vector<Node*>{groupNode, entityNode}));
+  }
+
+  SECTION("collectContainedNodes")
+  {
+    auto containsAll = BrushNode{builder.createCube(128.0, "material") | kdl::value()};
+    auto containsNothing = BrushNode{
+      builder.createCuboid(vm::bbox3d{{1080, 1080, 1080}, {1100, 1100, 1100}}, "material")
+      | kdl::value()};
+
+    CHECK_THAT(
+      collectContainedNodes(allNodes, {&containsAll}, *taskManager),
+      Catch::Matchers::Equals(std::vector<Node*>{groupNode, entityNode, brushNode}));
+
+    CHECK_THAT(
+      collectContainedNodes(allNodes, {&containsNothing}, *taskManager),
+      Catch::Matchers::Equals(std::vector<Node*>{}));
+  }
+}
+
 TEST_CASE("ModelUtils.collectSelectedNodes")
 {
   constexpr auto worldBounds = vm::bbox3d{8192.0};
@@ -599,6 +675,47 @@ TEST_CASE("ModelUtils.computePhysicalBounds")
     == vm::bbox3d{vm::vec3d{-8, -32, -32}, vm::vec3d{96, 32, 32}});
 }
 
+TEST_CASE("ModelUtils.collectIssues")
+{
+  auto worldNode = WorldNode{{}, {}, MapFormat::Quake3};
+
+  auto* groupNode = new GroupNode{Group{"group"}};
+  worldNode.defaultLayer()->addChild(groupNode);
+
+  auto entityNodes = std::vector<EntityNode*>{};
+  for (size_t i = 0; i < 100; ++i)
+  {
+    auto* entityNode = new EntityNode{Entity{}};
+    worldNode.defaultLayer()->addChild(entityNode);
+    entityNodes.push_back(entityNode);
+  }
+
+  const auto emptyGroupValidator = EmptyGroupValidator{};
+  const auto missingClassnameValidator = MissingClassnameValidator{};
+  const auto validators =
+    std::vector<const Validator*>{&emptyGroupValidator, &missingClassnameValidator};
+
+  auto taskManager = createTestTaskManager();
+
+  const auto issues = collectIssues({&worldNode}, validators, *taskManager);
+  CHECK(issues.size() == 101);
+  CHECK(std::ranges::all_of(entityNodes, [](const auto* entityNode) {
+    return entityNode->issuesValid();
+  }));
+
+  const auto groupIssues = groupNode->issues(validators);
+  REQUIRE(groupIssues.size() == 1);
+
+  entityNodes.front()->setEntity(Entity{{{EntityPropertyKeys::Classname, "light"}}});
+  REQUIRE_FALSE(entityNodes.front()->issuesValid());
+
+  const auto updatedIssues = collectIssues({&worldNode}, validators, *taskManager);
+  CHECK(updatedIssues.size() == 100);
+
+  // the issues of unchanged nodes are kept
+  CHECK(std::ranges::find(updatedIssues, groupIssues.front()) != updatedIssues.end());
+}
+
 TEST_CASE("ModelUtils.filterNodes")
 {
   constexpr auto worldBounds = vm::bbox3d{8192.0};
@@ -17,6 +17,7 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "el/CompiledExpression.h"
 #include "el/Expression.h"
 #include "el/Value.h"
 #include "io/NodeWriter.h"
@@ -850,7 +851,8 @@ TEST_CASE("NodeTest.entityPropertyConfig")
   };
 
   const auto config =
-    EntityPropertyConfig{{el::ExpressionNode{el::LiteralExpression{el::Value{2.0}}}}};
+    EntityPropertyConfig{{el::CompiledExpression{
+      el::ExpressionNode{el::LiteralExpression{el::Value{2.0}}}}}};
   auto root = std::make_unique<RootNode>(config);
   REQUIRE(root->entityPropertyConfig() == config);
 
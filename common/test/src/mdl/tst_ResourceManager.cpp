@@ -25,6 +25,10 @@
 #include "kdl/reflection_impl.h"
 #include "kdl/vector_utils.h"
 
+#include <atomic>
+#include <future>
+#include <thread>
+
 #include "Catch2.h"
 
 namespace tb::mdl
@@ -70,6 +74,63 @@ bool operator==(
 
 } // namespace
 
+TEST_CASE("ResourceIdQueue")
+{
+  auto queue = detail::ResourceIdQueue{};
+
+  SECTION("push invokes the callback")
+  {
+    auto callbackCount = 0;
+    queue.setCallback([&]() { ++callbackCount; });
+
+    queue.push(ResourceId{});
+    queue.push(ResourceId{});
+    CHECK(callbackCount == 2);
+    CHECK(queue.popAll().size() == 2);
+    CHECK(queue.empty());
+  }
+
+  SECTION("the callback can access the queue")
+  {
+    auto callbackCount = 0;
+    queue.setCallback([&]() {
+      if (++callbackCount == 1)
+      {
+        CHECK_FALSE(queue.empty());
+        queue.push(ResourceId{});
+      }
+    });
+
+    queue.push(ResourceId{});
+    CHECK(callbackCount == 2);
+    CHECK(queue.popAll().size() == 2);
+  }
+
+  SECTION("setCallback waits for running callbacks")
+  {
+    auto callbackStarted = std::promise<void>{};
+    auto finishCallback = std::promise<void>{};
+    auto callbackFinished = std::atomic<bool>{false};
+    queue.setCallback([&]() {
+      callbackStarted.set_value();
+      finishCallback.get_future().wait();
+      callbackFinished = true;
+    });
+
+    auto thread = std::thread{[&]() { queue.push(ResourceId{}); }};
+    callbackStarted.get_future().wait();
+
+    auto resetCallback = std::async(std::launch::async, [&]() {
+      queue.setCallback({});
+      return callbackFinished.load();
+    });
+
+    finishCallback.set_value();
+    CHECK(resetCallback.get());
+    thread.join();
+  }
+}
+
 TEST_CASE("ResourceManager")
 {
   const auto mockResourceLoader = [&]() { return Result<MockResource>{MockResource{}}; };
@@ -86,8 +147,8 @@ TEST_CASE("ResourceManager")
   {
     CHECK(!resourceManager.needsProcessing());
 
-    auto resource1 = std::make_shared<ResourceT>(mockResourceLoader);
-    resourceManager.addResource(resource1);
+    auto resource1 =
+      resourceManager.addResource(std::make_shared<ResourceT>(mockResourceLoader));
 
     REQUIRE(std::holds_alternative<ResourceUnloaded<MockResource>>(resource1->state()));
     CHECK(resourceManager.needsProcessing());
@@ -105,8 +166,8 @@ TEST_CASE("ResourceManager")
     REQUIRE(std::holds_alternative<ResourceReady<MockResource>>(resource1->state()));
     CHECK(!resourceManager.needsProcessing());
 
-    auto resource2 = std::make_shared<ResourceT>(mockResourceLoader);
-    resourceManager.addResource(resource2);
+    auto resource2 =
+      resourceManager.addResource(std::make_shared<ResourceT>(mockResourceLoader));
     REQUIRE(std::holds_alternative<ResourceReady<MockResource>>(resource1->state()));
     REQUIRE(std::holds_alternative<ResourceUnloaded<MockResource>>(resource2->state()));
     CHECK(resourceManager.needsProcessing());
@@ -144,27 +205,146 @@ TEST_CASE("ResourceManager")
 
   SECTION("addResource")
   {
-    auto resource1 = std::make_shared<ResourceT>(mockResourceLoader);
-    resourceManager.addResource(resource1);
+    auto resource1 =
+      resourceManager.addResource(std::make_shared<ResourceT>(mockResourceLoader));
 
     CHECK(resourceManager.resources() == std::vector{resource1});
-    CHECK(resource1.use_count() == 2);
+    // the manager's own reference is not shared with the returned pointer
+    CHECK(resource1.use_count() == 1);
     CHECK(std::holds_alternative<ResourceUnloaded<MockResource>>(resource1->state()));
 
-    auto resource2 = std::make_shared<ResourceT>(mockResourceLoader);
-    resourceManager.addResource(resource2);
+    auto resource2 =
+      resourceManager.addResource(std::make_shared<ResourceT>(mockResourceLoader));
 
     CHECK(resourceManager.resources() == std::vector{resource1, resource2});
   }
 
+  SECTION("setProcessingRequestedCallback")
+  {
+    auto callbackCount = 0;
+    resourceManager.setProcessingRequestedCallback([&]() { ++callbackCount; });
+
+    auto resource1 =
+      resourceManager.addResource(std::make_shared<ResourceT>(mockResourceLoader));
+    CHECK(callbackCount == 1);
+
+    resourceManager.process(taskRunner, processContext);
+    REQUIRE(std::holds_alternative<ResourceLoading<MockResource>>(resource1->state()));
+    CHECK(callbackCount == 1);
+
+    // the finished loader task requests processing
+    mockTaskRunner.resolveNextPromise();
+    CHECK(callbackCount == 2);
+
+    // the loaded resource requests processing to be uploaded
+    resourceManager.process(taskRunner, processContext);
+    REQUIRE(std::holds_alternative<ResourceLoaded<MockResource>>(resource1->state()));
+    CHECK(callbackCount == 3);
+
+    resourceManager.process(taskRunner, processContext);
+    REQUIRE(std::holds_alternative<ResourceReady<MockResource>>(resource1->state()));
+    CHECK(callbackCount == 3);
+
+    // releasing the resource requests processing to drop it
+    resource1.reset();
+    CHECK(callbackCount == 4);
+  }
+
+  SECTION("setPriority")
+  {
+    auto limitedResourceManager = ResourceManager{1};
+
+    auto resource1 = limitedResourceManager.addResource(
+      std::make_shared<ResourceT>(mockResourceLoader));
+    auto resource2 = limitedResourceManager.addResource(
+      std::make_shared<ResourceT>(mockResourceLoader));
+    auto resource3 = limitedResourceManager.addResource(
+      std::make_shared<ResourceT>(mockResourceLoader));
+
+    limitedResourceManager.setPriority(resource1->id(), ResourcePriority::Low);
+    limitedResourceManager.setPriority(resource3->id(), ResourcePriority::High);
+
+    CHECK(
+      limitedResourceManager.process(taskRunner, processContext)
+      == std::vector{resource3->id()});
+    CHECK(std::holds_alternative<ResourceUnloaded<MockResource>>(resource1->state()));
+    CHECK(std::holds_alternative<ResourceUnloaded<MockResource>>(resource2->state()));
+    CHECK(std::holds_alternative<ResourceLoading<MockResource>>(resource3->state()));
+
+    // the priority of a waiting resource can still be changed
+    limitedResourceManager.setPriority(resource1->id(), ResourcePriority::High);
+
+    mockTaskRunner.resolveNextPromise();
+    CHECK(
+      limitedResourceManager.process(taskRunner, processContext)
+      == std::vector{resource3->id(), resource1->id()});
+    CHECK(std::holds_alternative<ResourceLoading<MockResource>>(resource1->state()));
+    CHECK(std::holds_alternative<ResourceUnloaded<MockResource>>(resource2->state()));
+    CHECK(std::holds_alternative<ResourceLoaded<MockResource>>(resource3->state()));
+
+    mockTaskRunner.resolveNextPromise();
+    CHECK(
+      limitedResourceManager.process(taskRunner, processContext)
+      == std::vector{resource1->id(), resource3->id(), resource2->id()});
+    CHECK(std::holds_alternative<ResourceLoaded<MockResource>>(resource1->state()));
+    CHECK(std::holds_alternative<ResourceLoading<MockResource>>(resource2->state()));
+    CHECK(std::holds_alternative<ResourceReady<MockResource>>(resource3->state()));
+  }
+
+  SECTION("cancelLoading")
+  {
+    auto limitedResourceManager = ResourceManager{1};
+
+    auto resource1 = limitedResourceManager.addResource(
+      std::make_shared<ResourceT>(mockResourceLoader));
+    auto resource2 = limitedResourceManager.addResource(
+      std::make_shared<ResourceT>(mockResourceLoader));
+
+    limitedResourceManager.cancelLoading(resource1->id());
+    CHECK(limitedResourceManager.hasCancelledResources());
+    CHECK(limitedResourceManager.hasWaitingResources());
+
+    limitedResourceManager.process(taskRunner, processContext);
+    mockTaskRunner.resolveNextPromise();
+    limitedResourceManager.process(taskRunner, processContext);
+    limitedResourceManager.process(taskRunner, processContext);
+
+    CHECK(std::holds_alternative<ResourceUnloaded<MockResource>>(resource1->state()));
+    CHECK(std::holds_alternative<ResourceReady<MockResource>>(resource2->state()));
+    CHECK(!limitedResourceManager.needsProcessing());
+    CHECK(!limitedResourceManager.hasWaitingResources());
+    CHECK(limitedResourceManager.hasCancelledResources());
+
+    // setting the priority resumes loading
+    limitedResourceManager.setPriority(resource1->id(), ResourcePriority::Normal);
+    CHECK(limitedResourceManager.needsProcessing());
+    CHECK(limitedResourceManager.hasWaitingResources());
+    CHECK(!limitedResourceManager.hasCancelledResources());
+
+    limitedResourceManager.process(taskRunner, processContext);
+    CHECK(std::holds_alternative<ResourceLoading<MockResource>>(resource1->state()));
+
+    SECTION("released resources are removed while waiting")
+    {
+      auto resource3 = limitedResourceManager.addResource(
+        std::make_shared<ResourceT>(mockResourceLoader));
+      limitedResourceManager.process(taskRunner, processContext);
+      REQUIRE(std::holds_alternative<ResourceUnloaded<MockResource>>(resource3->state()));
+
+      resource3.reset();
+      limitedResourceManager.process(taskRunner, processContext);
+      CHECK(limitedResourceManager.resources().size() == 2);
+    }
+  }
+
   SECTION("process")
   {
     SECTION("resource loading")
     {
-      auto resource1 = std::make_shared<ResourceT>(mockResourceLoader);
-      auto resource2 = std::make_shared<ResourceT>(mockResourceLoader);
-      resourceManager.addResource(resource1);
-      resourceManager.addResource(resource2);
+      auto resource1 =
+        resourceManager.addResource(std::make_shared<ResourceT>(mockResourceLoader));
+      auto resource2 =
+        resourceManager.addResource(std::make_shared<ResourceT>(mockResourceLoader));
 
       CHECK(
         resourceManager.process(taskRunner, processContext)
@@ -233,30 +413,27 @@ TEST_CASE("ResourceManager")
     {
       auto mockDropCalls = std::array{std::optional<bool>{}, std::optional<bool>{}};
       auto sharedResources = std::array{
-        std::make_shared<ResourceT>([&]() {
+        resourceManager.addResource(std::make_shared<ResourceT>([&]() {
           return Result<MockResource>{MockResource{
             [](auto) {},
             [&](const auto i_glContextAvailable) {
               mockDropCalls[0] = i_glContextAvailable;
             },
           }};
-        }),
-        std::make_shared<ResourceT>([&]() {
+        })),
+        resourceManager.addResource(std::make_shared<ResourceT>([&]() {
           return Result<MockResource>{MockResource{
             [](auto) {},
             [&](const auto i_glContextAvailable) {
               mockDropCalls[1] = i_glContextAvailable;
             },
           }};
-        }),
+        })),
       };
 
       const auto resourceIds = kdl::vec_transform(
         sharedResources, [](const auto& resource) { return resource->id(); });
 
-      resourceManager.addResource(sharedResources[0]);
-      resourceManager.addResource(sharedResources[1]);
-
       resourceManager.process(taskRunner, processContext);
       mockTaskRunner.resolveNextPromise();
       mockTaskRunner.resolveNextPromise();
@@ -0,0 +1,55 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "render/BrushRendererArrays.h"
+
+#include "Catch2.h"
+
+namespace tb::render
+{
+
+TEST_CASE("BrushIndexRanges")
+{
+  auto ranges = BrushIndexRanges{};
+  CHECK(ranges.empty());
+
+  SECTION("Adjacent ranges are merged")
+  {
+    ranges.add(0, 6);
+    ranges.add(6, 3);
+    ranges.add(9, 12);
+
+    CHECK_FALSE(ranges.empty());
+    CHECK(ranges.offsets() == GLIndices{0});
+    CHECK(ranges.counts() == GLCounts{21});
+  }
+
+  SECTION("Ranges with gaps are kept separate")
+  {
+    ranges.add(0, 6);
+    ranges.add(12, 3);
+    ranges.add(15, 6);
+    ranges.add(30, 3);
+
+    CHECK(ranges.offsets() == GLIndices{0, 12, 30});
+    CHECK(ranges.counts() == GLCounts{6, 9, 3});
+  }
+}
+
+} // namespace tb::render
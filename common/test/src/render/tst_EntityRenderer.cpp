@@ -0,0 +1,210 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Color.h"
+#include "Logger.h"
+#include "mdl/CreateResource.h"
+#include "mdl/EditorContext.h"
+#include "mdl/Entity.h"
+#include "mdl/EntityModelManager.h"
+#include "mdl/EntityNode.h"
+#include "render/EntityRenderer.h"
+#include "render/GLVertex.h"
+
+#include "vm/bbox.h"
+#include "vm/vec.h"
+
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::render
+{
+namespace
+{
+
+constexpr auto WireframeVertexCount = size_t(24);
+constexpr auto SolidVertexCount = size_t(24);
+
+template <typename V>
+std::vector<vm::vec3f> positions(
+  const DynamicVertexArray<V>& vertexArray, const size_t offset, const size_t count)
+{
+  const auto& vertices = vertexArray.vertices();
+  REQUIRE(offset + count <= vertices.size());
+
+  auto result = std::vector<vm::vec3f>{};
+  for (size_t i = offset; i < offset + count; ++i)
+  {
+    result.push_back(getVertexComponent<0>(vertices[i]));
+  }
+  return result;
+}
+
+std::vector<vm::vec3f> wireframePositions(const vm::bbox3d& bounds)
+{
+  auto result = std::vector<vm::vec3f>{};
+  bounds.for_each_edge([&](const vm::vec3d& v1, const vm::vec3d& v2) {
+    result.emplace_back(v1);
+    result.emplace_back(v2);
+  });
+  return result;
+}
+
+std::vector<vm::vec3f> zeroPositions(const size_t count)
+{
+  return std::vector<vm::vec3f>(count, vm::vec3f{0, 0, 0});
+}
+
+} // namespace
+
+TEST_CASE("EntityRenderer")
+{
+  auto logger = NullLogger{};
+  auto entityModelManager = mdl::EntityModelManager{
+    [](auto resourceLoader) {
+      return mdl::createResourceSync(std::move(resourceLoader));
+    },
+    logger};
+  const auto editorContext = mdl::EditorContext{};
+
+  // the renderer holds pointers to the entity nodes, so it must be destroyed first
+  auto entityNode1 = mdl::EntityNode{mdl::Entity{{{"origin", "0 0 0"}}}};
+  auto entityNode2 = mdl::EntityNode{mdl::Entity{{{"origin", "64 0 0"}}}};
+  auto entityNode3 = mdl::EntityNode{mdl::Entity{{{"origin", "0 64 0"}}}};
+
+  auto entityRenderer = EntityRenderer{logger, entityModelManager, editorContext};
+
+  const auto& wireframeVertices = entityRenderer.pointEntityWireframeVertices();
+  const auto& solidVertices = entityRenderer.solidBoundsVertices();
+
+  SECTION("Adding an entity writes its bounds")
+  {
+    entityRenderer.addEntity(&entityNode1);
+    entityRenderer.validateBounds();
+
+    CHECK(
+      positions(wireframeVertices, 0, WireframeVertexCount)
+      == wireframePositions(entityNode1.logicalBounds()));
+    CHECK(solidVertices.vertices().size() == SolidVertexCount);
+    CHECK(entityRenderer.brushEntityWireframeVertices().vertices().empty());
+  }
+
+  SECTION("Adding an entity keeps the bounds of other entities")
+  {
+    entityRenderer.addEntity(&entityNode1);
+    entityRenderer.validateBounds();
+
+    entityRenderer.addEntity(&entityNode2);
+    entityRenderer.validateBounds();
+
+    CHECK(
+      positions(wireframeVertices, 0, WireframeVertexCount)
+      == wireframePositions(entityNode1.logicalBounds()));
+    CHECK(
+      positions(wireframeVertices, WireframeVertexCount, WireframeVertexCount)
+      == wireframePositions(entityNode2.logicalBounds()));
+  }
+
+  SECTION("Updating an entity rewrites only its bounds")
+  {
+    entityRenderer.addEntity(&entityNode1);
+    entityRenderer.validateBounds();
+    entityRenderer.addEntity(&entityNode2);
+    entityRenderer.validateBounds();
+
+    entityNode1.setEntity(mdl::Entity{{{"origin", "0 0 128"}}});
+    entityRenderer.invalidateEntity(&entityNode1);
+    entityRenderer.validateBounds();
+
+    // the freed block is reused for the new bounds
+    CHECK(wireframeVertices.vertices().size() == 2 * WireframeVertexCount);
+    CHECK(
+      positions(wireframeVertices, 0, WireframeVertexCount)
+      == wireframePositions(entityNode1.logicalBounds()));
+    CHECK(
+      positions(wireframeVertices, WireframeVertexCount, WireframeVertexCount)
+      == wireframePositions(entityNode2.logicalBounds()));
+  }
+
+  SECTION("Removing an entity zeroes its bounds")
+  {
+    entityRenderer.addEntity(&entityNode1);
+    entityRenderer.validateBounds();
+    entityRenderer.addEntity(&entityNode2);
+    entityRenderer.validateBounds();
+
+    entityRenderer.removeEntity(&entityNode1);
+    entityRenderer.validateBounds();
+
+    CHECK(
+      positions(wireframeVertices, 0, WireframeVertexCount)
+      == zeroPositions(WireframeVertexCount));
+    CHECK(
+      positions(solidVertices, 0, SolidVertexCount) == zeroPositions(SolidVertexCount));
+    CHECK(
+      positions(wireframeVertices, WireframeVertexCount, WireframeVertexCount)
+      == wireframePositions(entityNode2.logicalBounds()));
+  }
+
+  SECTION("Blocks are reused after they were freed")
+  {
+    entityRenderer.addEntity(&entityNode1);
+    entityRenderer.validateBounds();
+    entityRenderer.addEntity(&entityNode2);
+    entityRenderer.validateBounds();
+
+    entityRenderer.removeEntity(&entityNode1);
+    entityRenderer.validateBounds();
+
+    entityRenderer.addEntity(&entityNode3);
+    entityRenderer.validateBounds();
+
+    CHECK(wireframeVertices.vertices().size() == 2 * WireframeVertexCount);
+    CHECK(solidVertices.vertices().size() == 2 * SolidVertexCount);
+    CHECK(
+      positions(wireframeVertices, 0, WireframeVertexCount)
+      == wireframePositions(entityNode3.logicalBounds()));
+    CHECK(
+      positions(wireframeVertices, WireframeVertexCount, WireframeVertexCount)
+      == wireframePositions(entityNode2.logicalBounds()));
+  }
+
+  SECTION("Overriding the bounds color rebuilds the bounds of all entities")
+  {
+    entityRenderer.addEntity(&entityNode1);
+    entityRenderer.addEntity(&entityNode2);
+    entityRenderer.validateBounds();
+
+    const auto boundsColor = Color{1.0f, 0.0f, 0.0f, 1.0f};
+    entityRenderer.setBoundsColor(boundsColor);
+    entityRenderer.setOverrideBoundsColor(true);
+    entityRenderer.validateBounds();
+
+    // the vertex arrays were recreated
+    const auto& newSolidVertices = entityRenderer.solidBoundsVertices();
+    REQUIRE(newSolidVertices.vertices().size() == 2 * SolidVertexCount);
+    for (const auto& vertex : newSolidVertices.vertices())
+    {
+      CHECK(getVertexComponent<2>(vertex) == boundsColor);
+    }
+  }
+}
+
+} // namespace tb::render
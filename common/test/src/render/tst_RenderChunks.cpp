@@ -0,0 +1,166 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "render/RenderChunks.h"
+#include "render/ViewFrustum.h"
+
+#include "kdl/vector_utils.h"
+
+#include <map>
+
+#include "Catch2.h"
+
+namespace tb::render
+{
+
+TEST_CASE("RenderChunks")
+{
+  auto bounds = std::map<int, vm::bbox3d>{
+    {1, {{0, 0, 0}, {16, 16, 16}}},
+    {2, {{32, 32, 0}, {64, 64, 16}}},
+    {3, {{2048, 0, 0}, {2064, 16, 16}}},
+    {4, {{16, 16, 0}, {32, 32, 16}}},
+  };
+
+  auto chunks = RenderChunks<int>{[&](const int i) { return bounds.at(i); }};
+
+  SECTION("insert")
+  {
+    CHECK(chunks.empty());
+
+    const auto address1 = chunks.insert(1);
+    const auto address2 = chunks.insert(2);
+    const auto address3 = chunks.insert(3);
+
+    CHECK(address1 == address2);
+    CHECK(address1 != address3);
+    CHECK(chunks.chunkCount() == 2);
+    CHECK(chunks.address(1) == address1);
+    CHECK(chunks.address(4) == std::nullopt);
+
+    CHECK_THAT(
+      chunks.objects(address1), Catch::Matchers::UnorderedEquals(std::vector<int>{1, 2}));
+    CHECK(chunks.objects(address3) == std::vector<int>{3});
+
+    CHECK(chunks.bounds(address1) == vm::bbox3d{{0, 0, 0}, {64, 64, 16}});
+    CHECK(chunks.bounds(address3) == vm::bbox3d{{2048, 0, 0}, {2064, 16, 16}});
+  }
+
+  SECTION("insert again after bounds change")
+  {
+    const auto address1 = chunks.insert(1);
+    chunks.insert(2);
+    const auto address3 = chunks.insert(3);
+
+    SECTION("Object stays in its chunk")
+    {
+      bounds[2] = {{32, 32, 0}, {128, 128, 16}};
+      CHECK(chunks.insert(2) == address1);
+      CHECK(chunks.bounds(address1) == vm::bbox3d{{0, 0, 0}, {128, 128, 16}});
+    }
+
+    SECTION("Object moves to another chunk")
+    {
+      bounds[2] = {{2048, 32, 0}, {2064, 64, 16}};
+      CHECK(chunks.insert(2) == address3);
+      CHECK(chunks.address(2) == address3);
+      CHECK(chunks.objects(address1) == std::vector<int>{1});
+      CHECK(chunks.bounds(address1) == vm::bbox3d{{0, 0, 0}, {16, 16, 16}});
+      CHECK(chunks.bounds(address3) == vm::bbox3d{{2048, 0, 0}, {2064, 64, 16}});
+    }
+  }
+
+  SECTION("remove")
+  {
+    const auto address1 = chunks.insert(1);
+    chunks.insert(2);
+    const auto address3 = chunks.insert(3);
+
+    CHECK(chunks.remove(4) == std::nullopt);
+
+    CHECK(chunks.remove(2) == address1);
+    CHECK(chunks.address(2) == std::nullopt);
+    CHECK(chunks.bounds(address1) == vm::bbox3d{{0, 0, 0}, {16, 16, 16}});
+
+    CHECK(chunks.remove(3) == address3);
+    CHECK_FALSE(chunks.contains(address3));
+    CHECK(chunks.chunkCount() == 1);
+
+    CHECK(chunks.remove(1) == address1);
+    CHECK(chunks.empty());
+  }
+
+  SECTION("remove moves the last object of the chunk")
+  {
+    const auto address1 = chunks.insert(1);
+    chunks.insert(2);
+    chunks.insert(4);
+
+    CHECK(chunks.remove(1) == address1);
+    CHECK_THAT(
+      chunks.objects(address1), Catch::Matchers::UnorderedEquals(std::vector<int>{2, 4}));
+
+    CHECK(chunks.remove(4) == address1);
+    CHECK(chunks.objects(address1) == std::vector<int>{2});
+
+    CHECK(chunks.insert(4) == address1);
+    CHECK(chunks.remove(2) == address1);
+    CHECK(chunks.objects(address1) == std::vector<int>{4});
+    CHECK(chunks.bounds(address1) == vm::bbox3d{{16, 16, 0}, {32, 32, 16}});
+  }
+
+  SECTION("invalidateBounds")
+  {
+    const auto address1 = chunks.insert(1);
+    CHECK(chunks.bounds(address1) == vm::bbox3d{{0, 0, 0}, {16, 16, 16}});
+
+    bounds[1] = {{0, 0, 0}, {32, 32, 32}};
+    chunks.invalidateBounds();
+    CHECK(chunks.bounds(address1) == vm::bbox3d{{0, 0, 0}, {32, 32, 32}});
+  }
+
+  SECTION("visibleChunks")
+  {
+    const auto address1 = chunks.insert(1);
+    chunks.insert(2);
+    const auto address3 = chunks.insert(3);
+
+    // the slab between x = -100 and x = 100
+    const auto frustum = ViewFrustum{{
+      vm::plane3f{vm::vec3f{100, 0, 0}, vm::vec3f{1, 0, 0}},
+      vm::plane3f{vm::vec3f{-100, 0, 0}, vm::vec3f{-1, 0, 0}},
+    }};
+
+    CHECK(chunks.visibleChunks(frustum) == std::vector<RenderChunkAddress>{address1});
+
+    auto visibleObjects = std::vector<int>{};
+    chunks.forEachVisibleObject(
+      frustum, [&](const int i) { visibleObjects.push_back(i); });
+    CHECK_THAT(visibleObjects, Catch::Matchers::UnorderedEquals(std::vector<int>{1, 2}));
+
+    bounds[3] = {{-200, 0, 0}, {4400, 16, 16}};
+    CHECK(chunks.insert(3) == address3);
+    CHECK_THAT(
+      chunks.visibleChunks(frustum),
+      Catch::Matchers::UnorderedEquals(
+        std::vector<RenderChunkAddress>{address1, address3}));
+  }
+}
+
+} // namespace tb::render
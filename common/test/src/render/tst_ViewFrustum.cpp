@@ -0,0 +1,91 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "render/OrthographicCamera.h"
+#include "render/PerspectiveCamera.h"
+#include "render/ViewFrustum.h"
+
+#include "Catch2.h"
+
+namespace tb::render
+{
+
+TEST_CASE("ViewFrustum")
+{
+  SECTION("intersects")
+  {
+    // the box from -1 to 1 in x and y, unbounded in z
+    const auto frustum = ViewFrustum{{
+      vm::plane3f{vm::vec3f{0, 1, 0}, vm::vec3f{0, 1, 0}},
+      vm::plane3f{vm::vec3f{1, 0, 0}, vm::vec3f{1, 0, 0}},
+      vm::plane3f{vm::vec3f{0, -1, 0}, vm::vec3f{0, -1, 0}},
+      vm::plane3f{vm::vec3f{-1, 0, 0}, vm::vec3f{-1, 0, 0}},
+    }};
+
+    CHECK(frustum.intersects(vm::bbox3f{{-0.5f, -0.5f, -0.5f}, {0.5f, 0.5f, 0.5f}}));
+    CHECK(frustum.intersects(vm::bbox3f{{0.5f, 0.5f, 100.0f}, {2.0f, 2.0f, 200.0f}}));
+    CHECK(frustum.intersects(vm::bbox3f{{-2.0f, -2.0f, 0.0f}, {2.0f, 2.0f, 0.0f}}));
+    CHECK(frustum.intersects(vm::bbox3f{{1.0f, 0.0f, 0.0f}, {2.0f, 0.0f, 0.0f}}));
+    CHECK_FALSE(frustum.intersects(vm::bbox3f{{1.5f, 0.0f, 0.0f}, {2.0f, 0.0f, 0.0f}}));
+    CHECK_FALSE(
+      frustum.intersects(vm::bbox3f{{-3.0f, -3.0f, 0.0f}, {-2.0f, 3.0f, 0.0f}}));
+  }
+
+  SECTION("fromCamera")
+  {
+    SECTION("Perspective camera")
+    {
+      const auto camera = PerspectiveCamera{
+        90.0f,
+        1.0f,
+        8192.0f,
+        Camera::Viewport{0, 0, 100, 100},
+        vm::vec3f{0, 0, 0},
+        vm::vec3f{1, 0, 0},
+        vm::vec3f{0, 0, 1}};
+      const auto frustum = ViewFrustum::fromCamera(camera);
+
+      CHECK(frustum.planes().size() == 4u);
+      CHECK(frustum.intersects(vm::bbox3f{{100, -8, -8}, {116, 8, 8}}));
+      CHECK(frustum.intersects(vm::bbox3f{{100, 80, -8}, {116, 96, 8}}));
+      CHECK_FALSE(frustum.intersects(vm::bbox3f{{-116, -8, -8}, {-100, 8, 8}}));
+      CHECK_FALSE(frustum.intersects(vm::bbox3f{{100, 200, -8}, {116, 216, 8}}));
+      CHECK_FALSE(frustum.intersects(vm::bbox3f{{100, -8, 200}, {116, 8, 216}}));
+    }
+
+    SECTION("Orthographic camera")
+    {
+      const auto camera = OrthographicCamera{
+        1.0f,
+        8192.0f,
+        Camera::Viewport{0, 0, 100, 100},
+        vm::vec3f{0, 0, 1000},
+        vm::vec3f{0, 0, -1},
+        vm::vec3f{0, 1, 0}};
+      const auto frustum = ViewFrustum::fromCamera(camera);
+
+      CHECK(frustum.intersects(vm::bbox3f{{-8, -8, -8}, {8, 8, 8}}));
+      CHECK(frustum.intersects(vm::bbox3f{{40, 40, -8}, {60, 60, 8}}));
+      CHECK_FALSE(frustum.intersects(vm::bbox3f{{60, -8, -8}, {80, 8, 8}}));
+      CHECK_FALSE(frustum.intersects(vm::bbox3f{{-8, -80, -8}, {8, -60, 8}}));
+    }
+  }
+}
+
+} // namespace tb::render
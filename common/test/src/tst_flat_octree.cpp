@@ -0,0 +1,353 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "flat_octree.h"
+#include "octree.h"
+
+#include "kdl/vector_utils.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb
+{
+namespace
+{
+
+template <typename Tree>
+std::vector<int> sorted(const Tree& tree, const auto& query)
+{
+  return kdl::vec_sort(tree.find_intersectors(query));
+}
+
+// the behavioral tests run against both implementations to ensure that they can be used
+// interchangeably
+using node_octree = octree<double, int>;
+using array_octree = flat_octree<double, int>;
+
+} // namespace
+
+TEMPLATE_TEST_CASE("flat_octree.insert", "", node_octree, array_octree)
+{
+  auto tree = TestType{32.0};
+  REQUIRE(tree.empty());
+
+  tree.insert(vm::bbox3d{{0, 0, 0}, {2, 1, 1}}, 1);
+  CHECK_FALSE(tree.empty());
+  CHECK(tree.contains(1));
+
+  tree.insert(vm::bbox3d{{-64, -64, -64}, {64, 64, 64}}, 2);
+  tree.insert(vm::bbox3d{{32, 32, 32}, {64, 64, 64}}, 3);
+  tree.insert(vm::bbox3d{{160, 32, 32}, {192, 64, 64}}, 4);
+  tree.insert(vm::bbox3d{{-4096, 32, 32}, {-4000, 64, 64}}, 5);
+
+  CHECK(tree.contains(2));
+  CHECK(tree.contains(3));
+  CHECK(tree.contains(4));
+  CHECK(tree.contains(5));
+
+  CHECK(
+    sorted(tree, vm::bbox3d{{-8192, -8192, -8192}, {8192, 8192, 8192}})
+    == std::vector<int>{1, 2, 3, 4, 5});
+
+  // 2 is stored in the root node, which is always a candidate
+  CHECK(sorted(tree, vm::bbox3d{{170, 40, 40}, {180, 50, 50}}) == std::vector<int>{2, 4});
+}
+
+TEMPLATE_TEST_CASE("flat_octree.insert_duplicate", "", node_octree, array_octree)
+{
+  auto tree = TestType{32.0};
+
+  tree.insert(vm::bbox3d{{0, 0, 0}, {2, 1, 1}}, 1);
+  REQUIRE(tree.contains(1));
+
+  CHECK_THROWS_AS(tree.insert(vm::bbox3d{{0, 0, 0}, {2, 1, 1}}, 1), NodeTreeException);
+
+  CHECK(tree.contains(1));
+  CHECK_FALSE(tree.empty());
+}
+
+TEMPLATE_TEST_CASE("flat_octree.remove", "", node_octree, array_octree)
+{
+  auto tree = TestType{32.0};
+
+  tree.insert(vm::bbox3d{{0, 0, 0}, {16, 16, 16}}, 1);
+  tree.insert(vm::bbox3d{{16, 16, 16}, {24, 24, 24}}, 2);
+  tree.insert(vm::bbox3d{{32, 0, 0}, {48, 16, 16}}, 3);
+  tree.insert(vm::bbox3d{{-16, -16, -16}, {16, 16, 16}}, 4);
+
+  CHECK_FALSE(tree.remove(5));
+
+  CHECK(tree.remove(2));
+  CHECK_FALSE(tree.contains(2));
+  CHECK(sorted(tree, vm::bbox3d{{0, 0, 0}, {64, 64, 64}}) == std::vector<int>{1, 3, 4});
+
+  CHECK(tree.remove(4));
+  CHECK(sorted(tree, vm::bbox3d{{0, 0, 0}, {64, 64, 64}}) == std::vector<int>{1, 3});
+
+  CHECK(tree.remove(1));
+  CHECK(tree.remove(3));
+  CHECK(tree.empty());
+  CHECK(tree.find_intersectors(vm::bbox3d{{0, 0, 0}, {64, 64, 64}}).empty());
+}
+
+TEMPLATE_TEST_CASE("flat_octree.update", "", node_octree, array_octree)
+{
+  auto tree = TestType{32.0};
+
+  tree.insert(vm::bbox3d{{0, 0, 0}, {16, 16, 16}}, 1);
+  CHECK_THROWS_AS(tree.update(vm::bbox3d{{0, 0, 0}, {16, 16, 16}}, 2), NodeTreeException);
+
+  tree.update(vm::bbox3d{{256, 256, 256}, {272, 272, 272}}, 1);
+  CHECK(tree.find_containers({8, 8, 8}).empty());
+  CHECK(tree.find_containers({260, 260, 260}) == std::vector<int>{1});
+}
+
+TEMPLATE_TEST_CASE("flat_octree.find_intersectors-ray", "", node_octree, array_octree)
+{
+  auto tree = TestType{32.0};
+
+  SECTION("empty tree")
+  {
+    CHECK(tree.find_intersectors(vm::ray3d{{0, 0, 0}, {1, 0, 0}}).empty());
+  }
+
+  SECTION("single node")
+  {
+    tree.insert({{32, 32, 32}, {64, 64, 64}}, 1);
+
+    // the node that contains the data does not contain the ray origin
+    CHECK(tree.find_intersectors(vm::ray3d{{48, 48, 0}, {0, 0, -1}}).empty());
+
+    // the node that contains the data contains the ray origin
+    CHECK(
+      tree.find_intersectors(vm::ray3d{{48, 48, 48}, {0, 0, -1}}) == std::vector<int>{1});
+
+    // the node that contains the data is hit by the ray
+    CHECK(
+      tree.find_intersectors(vm::ray3d{{48, 48, 0}, {0, 0, 1}}) == std::vector<int>{1});
+  }
+}
+
+TEMPLATE_TEST_CASE("flat_octree.find_intersectors-bbox", "", node_octree, array_octree)
+{
+  auto tree = TestType{32.0};
+
+  SECTION("empty tree")
+  {
+    CHECK(tree.find_intersectors(vm::bbox3d{{0, 0, 0}, {1, 1, 1}}).empty());
+  }
+
+  SECTION("single node")
+  {
+    tree.insert({{32, 32, 32}, {64, 64, 64}}, 1);
+
+    // not touching
+    CHECK(tree.find_intersectors(vm::bbox3d{{0, 0, 0}, {16, 16, 16}}).empty());
+
+    // share a corner
+    CHECK(
+      tree.find_intersectors(vm::bbox3d{{0, 0, 0}, {32, 32, 32}}) == std::vector<int>{1});
+
+    // fully inside node
+    CHECK(
+      tree.find_intersectors(vm::bbox3d{{40, 40, 40}, {48, 48, 48}})
+      == std::vector<int>{1});
+
+    // fully contains node
+    CHECK(
+      tree.find_intersectors(vm::bbox3d{{0, 0, 0}, {128, 128, 128}})
+      == std::vector<int>{1});
+  }
+}
+
+TEMPLATE_TEST_CASE("flat_octree.find_containers", "", node_octree, array_octree)
+{
+  auto tree = TestType{32.0};
+
+  SECTION("empty tree")
+  {
+    CHECK(tree.find_containers({0, 0, 0}).empty());
+  }
+
+  SECTION("single node")
+  {
+    tree.insert({{32, 32, 32}, {64, 64, 64}}, 1);
+
+    CHECK(tree.find_containers({48, 48, 0}).empty());
+    CHECK(tree.find_containers({48, 48, 48}) == std::vector<int>{1});
+    CHECK(tree.find_containers({32, 32, 32}) == std::vector<int>{1});
+    CHECK(tree.find_containers({64, 64, 64}) == std::vector<int>{1});
+  }
+}
+
+TEMPLATE_TEST_CASE("flat_octree.build", "", node_octree, array_octree)
+{
+  auto tree = TestType{32.0};
+
+  SECTION("empty range")
+  {
+    tree.insert(vm::bbox3d{{0, 0, 0}, {2, 1, 1}}, 1);
+    tree.build(std::vector<std::pair<vm::bbox3d, int>>{});
+    CHECK(tree.empty());
+    CHECK_FALSE(tree.contains(1));
+  }
+
+  SECTION("duplicate data")
+  {
+    CHECK_THROWS_AS(
+      tree.build(std::vector{
+        std::pair{vm::bbox3d{{0, 0, 0}, {2, 1, 1}}, 1},
+        std::pair{vm::bbox3d{{32, 32, 32}, {64, 64, 64}}, 1}}),
+      NodeTreeException);
+  }
+
+  SECTION("nodes")
+  {
+    tree.build(std::vector{
+      std::pair{vm::bbox3d{{-16, -16, -16}, {16, 16, 16}}, 1},
+      std::pair{vm::bbox3d{{32, 32, 32}, {64, 64, 64}}, 2},
+      std::pair{vm::bbox3d{{40, 40, 40}, {48, 48, 48}}, 3},
+      std::pair{vm::bbox3d{{-256, 32, 32}, {-200, 64, 64}}, 4}});
+
+    CHECK(tree.contains(1));
+    CHECK(tree.contains(2));
+    CHECK(tree.contains(3));
+    CHECK(tree.contains(4));
+
+    CHECK(kdl::vec_sort(tree.find_containers({44, 44, 44})) == std::vector<int>{1, 2, 3});
+    CHECK(kdl::vec_sort(tree.find_containers({-220, 44, 44})) == std::vector<int>{1, 4});
+
+    CHECK(tree.remove(2));
+    CHECK(kdl::vec_sort(tree.find_containers({44, 44, 44})) == std::vector<int>{1, 3});
+  }
+}
+
+TEMPLATE_TEST_CASE("flat_octree.find_if", "", node_octree, array_octree)
+{
+  auto tree = TestType{32.0};
+
+  const auto intersects = [](const auto& bbox) {
+    return [=](const vm::bbox3d& bounds) { return bounds.intersects(bbox); };
+  };
+
+  SECTION("empty tree")
+  {
+    CHECK(tree.find_if(intersects(vm::bbox3d{{0, 0, 0}, {1, 1, 1}})).empty());
+  }
+
+  SECTION("nodes")
+  {
+    tree.insert({{32, 32, 32}, {64, 64, 64}}, 1);
+    tree.insert({{-256, 32, 32}, {-200, 64, 64}}, 2);
+
+    CHECK(tree.find_if([](const auto&) { return false; }).empty());
+    CHECK(
+      kdl::vec_sort(tree.find_if([](const auto&) { return true; }))
+      == std::vector<int>{1, 2});
+    CHECK(
+      tree.find_if(intersects(vm::bbox3d{{40, 40, 40}, {48, 48, 48}}))
+      == std::vector<int>{1});
+    CHECK(
+      tree.find_if(intersects(vm::bbox3d{{-240, 40, 40}, {-220, 48, 48}}))
+      == std::vector<int>{2});
+  }
+}
+
+TEST_CASE("flat_octree.matches_octree")
+{
+  auto rng = std::mt19937{1234};
+  auto coord = std::uniform_real_distribution<double>{-4096.0, 4096.0};
+  auto extent = std::uniform_real_distribution<double>{1.0, 512.0};
+
+  const auto make_bounds = [&]() {
+    const auto min = vm::vec3d{coord(rng), coord(rng), coord(rng)};
+    return vm::bbox3d{min, min + vm::vec3d{extent(rng), extent(rng), extent(rng)}};
+  };
+
+  auto expected = octree<double, int>{64.0};
+  auto actual = flat_octree<double, int>{64.0};
+
+  for (int i = 0; i < 2000; ++i)
+  {
+    const auto bounds = make_bounds();
+    expected.insert(bounds, i);
+    actual.insert(bounds, i);
+  }
+
+  for (int i = 0; i < 2000; i += 3)
+  {
+    REQUIRE(expected.remove(i));
+    REQUIRE(actual.remove(i));
+  }
+
+  for (int i = 1; i < 2000; i += 7)
+  {
+    if (expected.contains(i))
+    {
+      const auto bounds = make_bounds();
+      expected.update(bounds, i);
+      actual.update(bounds, i);
+    }
+  }
+
+  const auto check_queries = [&]() {
+    for (int i = 0; i < 100; ++i)
+    {
+      const auto bounds = make_bounds();
+      CHECK(sorted(actual, bounds) == sorted(expected, bounds));
+
+      const auto point = bounds.center();
+      CHECK(
+        kdl::vec_sort(actual.find_containers(point))
+        == kdl::vec_sort(expected.find_containers(point)));
+
+      const auto ray = vm::ray3d{point, vm::normalize(bounds.max - bounds.min)};
+      CHECK(sorted(actual, ray) == sorted(expected, ray));
+
+      const auto intersects = [&](const vm::bbox3d& nodeBounds) {
+        return nodeBounds.intersects(bounds);
+      };
+      CHECK(
+        kdl::vec_sort(actual.find_if(intersects))
+        == kdl::vec_sort(expected.find_if(intersects)));
+    }
+  };
+
+  check_queries();
+
+  actual.compact();
+  check_queries();
+
+  auto items = std::vector<std::pair<vm::bbox3d, int>>{};
+  for (int i = 0; i < 2000; ++i)
+  {
+    items.emplace_back(make_bounds(), i);
+  }
+
+  expected.build(items);
+  actual.build(items);
+  check_queries();
+}
+
+} // namespace tb
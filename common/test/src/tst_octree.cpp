@@ -19,6 +19,12 @@
 
 #include "octree.h"
 
+#include "kdl/vector_utils.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
 #include "Catch2.h"
 
 namespace tb
@@ -224,6 +230,12 @@ TEST_CASE("node_address")
     CHECK(get_container({{-2, 2, 2}, {2, 4, 4}}, 32.0) == node_address{-1, -1, -1, 1});
     CHECK(
       get_container({{-42, -42, -42}, {2, 2, 2}}, 32.0) == node_address{-2, -2, -2, 2});
+
+    // bounds that are degenerate at zero do not cross zero
+    CHECK(get_container({{0, 0, 0}, {0, 0, 0}}, 32.0) == node_address{0, 0, 0, 0});
+    CHECK(get_container({{0, 2, 2}, {0, 6, 6}}, 32.0) == node_address{0, 0, 0, 0});
+    CHECK(
+      get_container({{-4, -4, 0}, {-2, -2, 0}}, 32.0) == node_address{-1, -1, 0, 0});
   }
 }
 } // namespace detail
@@ -675,6 +687,99 @@ TEST_CASE("octree.find_intersectors-bbox")
   }
 }
 
+TEST_CASE("octree.build")
+{
+  auto tree = octree<double, int>{32.0};
+
+  SECTION("empty range")
+  {
+    tree.insert(vm::bbox3d{{0, 0, 0}, {2, 1, 1}}, 1);
+    tree.build(std::vector<std::pair<vm::bbox3d, int>>{});
+    CHECK(tree.empty());
+    CHECK_FALSE(tree.contains(1));
+  }
+
+  SECTION("single node")
+  {
+    tree.build(std::vector{std::pair{vm::bbox3d{{32, 32, 32}, {64, 64, 64}}, 1}});
+    CHECK(
+      tree
+      == octree<double, int>{
+        32.0,
+        inner_node{
+          {-2, -2, -2, 2},
+          {},
+          kdl::vec_from(
+            node{leaf_node{{-2, -2, -2, 1}, {}}},
+            node{leaf_node{{0, -2, -2, 1}, {}}},
+            node{leaf_node{{-2, 0, -2, 1}, {}}},
+            node{leaf_node{{0, 0, -2, 1}, {}}},
+            node{leaf_node{{-2, -2, 0, 1}, {}}},
+            node{leaf_node{{0, -2, 0, 1}, {}}},
+            node{leaf_node{{-2, 0, 0, 1}, {}}},
+            node{leaf_node{{1, 1, 1, 0}, {1}}})}});
+  }
+
+  SECTION("root node")
+  {
+    tree.build(std::vector{
+      std::pair{vm::bbox3d{{-16, -16, -16}, {16, 16, 16}}, 1},
+      std::pair{vm::bbox3d{{-64, -16, -16}, {16, 16, 16}}, 2}});
+    CHECK(tree == octree<double, int>{32.0, leaf_node{{-2, -2, -2, 2}, {1, 2}}});
+  }
+
+  SECTION("duplicate data")
+  {
+    CHECK_THROWS_AS(
+      tree.build(std::vector{
+        std::pair{vm::bbox3d{{0, 0, 0}, {2, 1, 1}}, 1},
+        std::pair{vm::bbox3d{{32, 32, 32}, {64, 64, 64}}, 1}}),
+      NodeTreeException);
+  }
+
+  SECTION("matches incremental insertion")
+  {
+    auto rng = std::mt19937{1234};
+    auto coord = std::uniform_real_distribution<double>{-4096.0, 4096.0};
+    auto extent = std::uniform_real_distribution<double>{1.0, 512.0};
+
+    const auto make_bounds = [&]() {
+      const auto min = vm::vec3d{coord(rng), coord(rng), coord(rng)};
+      return vm::bbox3d{min, min + vm::vec3d{extent(rng), extent(rng), extent(rng)}};
+    };
+
+    auto items = std::vector<std::pair<vm::bbox3d, int>>{};
+    auto expected = octree<double, int>{32.0};
+    for (int i = 0; i < 2000; ++i)
+    {
+      const auto bounds = make_bounds();
+      items.emplace_back(bounds, i);
+      expected.insert(bounds, i);
+    }
+
+    tree.build(items);
+
+    for (int i = 0; i < 100; ++i)
+    {
+      const auto bounds = make_bounds();
+      CHECK(
+        kdl::vec_sort(tree.find_intersectors(bounds))
+        == kdl::vec_sort(expected.find_intersectors(bounds)));
+    }
+
+    // the built tree supports incremental updates
+    for (int i = 0; i < 2000; i += 2)
+    {
+      tree.update(make_bounds(), i);
+    }
+    for (int i = 0; i < 2000; ++i)
+    {
+      CHECK(tree.remove(i));
+    }
+    CHECK(tree.empty());
+  }
+}
+
 TEST_CASE("octree.find_containers")
 {
   auto tree = octree<double, int>{32.0};
@@ -717,4 +822,36 @@ TEST_CASE("octree.find_containers")
     CHECK(tree.find_containers({64, 64, 64}) == std::vector<int>{1});
   }
 }
+
+TEST_CASE("octree.find_if")
+{
+  auto tree = octree<double, int>{32.0};
+
+  SECTION("empty tree")
+  {
+    CHECK(tree.find_if([](const auto&) { return true; }).empty());
+  }
+
+  SECTION("multiple nodes")
+  {
+    tree.insert({{32, 32, 32}, {64, 64, 64}}, 1);
+    tree.insert({{-64, -64, -64}, {-32, -32, -32}}, 2);
+    tree.insert({{0, 0, 0}, {0, 0, 0}}, 3);
+
+    CHECK(tree.find_if([](const auto&) { return false; }).empty());
+
+    CHECK_THAT(
+      tree.find_if([](const auto&) { return true; }),
+      Catch::UnorderedEquals(std::vector<int>{1, 2, 3}));
+
+    // the predicate is applied to the bounds of the nodes, not to the data
+    CHECK_THAT(
+      tree.find_if([](const auto& bounds) { return bounds.max.x() > 0.0; }),
+      Catch::UnorderedEquals(std::vector<int>{1, 3}));
+
+    CHECK(
+      tree.find_if([](const auto& bounds) { return bounds.contains(vm::vec3d{8, 8, 8}); })
+      == std::vector<int>{3});
+  }
+}
 } // namespace tb
@@ -29,8 +29,10 @@
 
 #include <chrono>
 #include <memory>
+#include <string>
 #include <thread>
 #include <variant>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -244,6 +246,30 @@ public:
   }
 };
 
+class SizedCommand : public NullCommand
+{
+private:
+  size_t m_memoryUsage;
+  size_t m_releasableMemory;
+
+public:
+  SizedCommand(
+    std::string name, const size_t memoryUsage, const size_t releasableMemory = 0u)
+    : NullCommand{std::move(name)}
+    , m_memoryUsage{memoryUsage}
+    , m_releasableMemory{releasableMemory}
+  {
+  }
+
+  size_t memoryUsage() const override { return m_memoryUsage; }
+
+  void releaseMemory() override
+  {
+    m_memoryUsage -= m_releasableMemory;
+    m_releasableMemory = 0u;
+  }
+};
+
 } // namespace
 
 TEST_CASE("CommandProcessorTest.doAndUndoSuccessfulCommand")
@@ -845,4 +871,93 @@ TEST_CASE("CommandProcessorTest.collateTransactions")
   commandProcessor.undo();
 }
 
+TEST_CASE("CommandProcessorTest.memoryBudget")
+{
+  auto taskManager = createTestTaskManager();
+  auto facade = MapDocumentCommandFacade{*taskManager};
+  auto commandProcessor = CommandProcessor{facade};
+
+  const auto undoCommandNames = [&]() {
+    auto result = std::vector<std::string>{};
+    while (commandProcessor.canUndo())
+    {
+      result.push_back(commandProcessor.undoCommandName());
+      commandProcessor.undo();
+    }
+    return result;
+  };
+
+  SECTION("Oldest commands are evicted when the budget is exceeded")
+  {
+    commandProcessor.setMemoryBudget(100u);
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 1", 40u));
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 2", 40u));
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 3", 40u));
+
+    CHECK(undoCommandNames() == std::vector<std::string>{"command 3", "command 2"});
+  }
+
+  SECTION("Oldest commands release their memory before they are evicted")
+  {
+    commandProcessor.setMemoryBudget(100u);
+    commandProcessor.executeAndStore(
+      std::make_unique<SizedCommand>("command 1", 80u, 60u));
+    commandProcessor.executeAndStore(
+      std::make_unique<SizedCommand>("command 2", 40u, 20u));
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 3", 40u));
+
+    // command 1 released its memory, command 2 did not need to
+    CHECK(
+      undoCommandNames()
+      == std::vector<std::string>{"command 3", "command 2", "command 1"});
+
+    commandProcessor.redo();
+    commandProcessor.redo();
+    commandProcessor.redo();
+
+    // command 2 releases its memory, but that is not enough, so command 1 is evicted
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 4", 30u));
+    CHECK(
+      undoCommandNames()
+      == std::vector<std::string>{"command 4", "command 3", "command 2"});
+  }
+
+  SECTION("The most recent command is kept even if it exceeds the budget")
+  {
+    commandProcessor.setMemoryBudget(10u);
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 1", 40u));
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 2", 40u));
+
+    CHECK(undoCommandNames() == std::vector<std::string>{"command 2"});
+  }
+
+  SECTION("Transactions are accounted for as a whole")
+  {
+    commandProcessor.setMemoryBudget(100u);
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 1", 40u));
+
+    commandProcessor.startTransaction("transaction", TransactionScope::Oneshot);
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 2", 20u));
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 3", 20u));
+    commandProcessor.commitTransaction();
+
+    CHECK(undoCommandNames() == std::vector<std::string>{"transaction", "command 1"});
+
+    commandProcessor.redo();
+    commandProcessor.redo();
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 4", 30u));
+
+    CHECK(undoCommandNames() == std::vector<std::string>{"command 4", "transaction"});
+  }
+
+  SECTION("Lowering the budget evicts commands immediately")
+  {
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 1", 40u));
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 2", 40u));
+    commandProcessor.setMemoryBudget(50u);
+
+    CHECK(undoCommandNames() == std::vector<std::string>{"command 2"});
+  }
+}
+
 } // namespace tb::ui
@@ -248,6 +248,66 @@ TEST_CASE_METHOD(MapDocumentTest, "CsgTest.csgSubtractMultipleBrushes")
   CHECK(remainderNode2->logicalBounds() == expectedBBox2);
 }
 
+TEST_CASE_METHOD(MapDocumentTest, "CsgTest.csgIntersectMultipleBrushes")
+{
+  const auto builder =
+    mdl::BrushBuilder{document->world()->mapFormat(), document->worldBounds()};
+
+  auto* parentNode = document->parentForNodes();
+
+  auto* brushNode1 = new mdl::BrushNode{
+    builder.createCuboid(
+      vm::bbox3d{vm::vec3d{0, 0, 0}, vm::vec3d{64, 64, 64}}, "material")
+    | kdl::value()};
+  auto* brushNode2 = new mdl::BrushNode{
+    builder.createCuboid(
+      vm::bbox3d{vm::vec3d{16, 0, 0}, vm::vec3d{80, 64, 64}}, "material")
+    | kdl::value()};
+  auto* brushNode3 = new mdl::BrushNode{
+    builder.createCuboid(
+      vm::bbox3d{vm::vec3d{0, 16, 0}, vm::vec3d{64, 80, 64}}, "material")
+    | kdl::value()};
+
+  document->addNodes({{parentNode, {brushNode1, brushNode2, brushNode3}}});
+  CHECK(parentNode->children().size() == 3u);
+
+  SECTION("Intersecting brushes")
+  {
+    auto* brushNode4 = new mdl::BrushNode{
+      builder.createCuboid(
+        vm::bbox3d{vm::vec3d{0, 0, 16}, vm::vec3d{64, 64, 80}}, "material")
+      | kdl::value()};
+    document->addNodes({{parentNode, {brushNode4}}});
+
+    document->selectNodes({brushNode1, brushNode2, brushNode3, brushNode4});
+    CHECK(document->csgIntersect());
+    REQUIRE(parentNode->children().size() == 1u);
+
+    const auto* intersectionNode =
+      dynamic_cast<mdl::BrushNode*>(parentNode->children().front());
+    REQUIRE(intersectionNode != nullptr);
+    CHECK(
+      intersectionNode->logicalBounds()
+      == vm::bbox3d{vm::vec3d{16, 16, 16}, vm::vec3d{64, 64, 64}});
+    CHECK(
+      document->selectedNodes().nodes()
+      == std::vector<mdl::Node*>{parentNode->children().front()});
+  }
+
+  SECTION("Disjoint brushes")
+  {
+    auto* brushNode4 = new mdl::BrushNode{
+      builder.createCuboid(
+        vm::bbox3d{vm::vec3d{128, 128, 128}, vm::vec3d{192, 192, 192}}, "material")
+      | kdl::value()};
+    document->addNodes({{parentNode, {brushNode4}}});
+
+    document->selectNodes({brushNode1, brushNode2, brushNode3, brushNode4});
+    CHECK(document->csgIntersect());
+    CHECK(parentNode->children().empty());
+  }
+}
+
 TEST_CASE_METHOD(MapDocumentTest, "CsgTest.csgSubtractAndUndoRestoresSelection")
 {
   const auto builder =
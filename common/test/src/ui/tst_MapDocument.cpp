@@ -17,9 +17,12 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "Color.h"
 #include "Exceptions.h"
 #include "MapDocumentTest.h"
 #include "TestUtils.h"
+#include "el/Expression.h"
+#include "el/Value.h"
 #include "io/MapHeader.h"
 #include "io/TestEnvironment.h"
 #include "io/WorldReader.h"
@@ -28,12 +31,15 @@
 #include "mdl/Entity.h"
 #include "mdl/EntityDefinition.h"
 #include "mdl/EntityDefinitionManager.h"
+#include "mdl/EntityModel.h"
 #include "mdl/EntityNode.h"
 #include "mdl/Group.h"
 #include "mdl/GroupNode.h"
 #include "mdl/LayerNode.h"
+#include "mdl/ModelDefinition.h"
 #include "mdl/PatchNode.h"
 #include "mdl/PropertyDefinition.h"
+#include "mdl/Resource.h"
 #include "mdl/WorldNode.h"
 
 #include "kdl/map_utils.h"
@@ -697,6 +703,79 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTestFixture")
     }
   }
 
+  SECTION("Entity bounds are updated when their models are loaded")
+  {
+    game->config().materialConfig.palette = "fixture/test/palette.lmp";
+
+    const auto makeModelDefinition = [](const std::string& modelPath) {
+      return mdl::ModelDefinition{
+        el::ExpressionNode{el::LiteralExpression{el::Value{modelPath}}}};
+    };
+
+    document->setEntityDefinitions({
+      mdl::EntityDefinition{
+        "armor",
+        Color{},
+        "",
+        {},
+        mdl::PointEntityDefinition{
+          vm::bbox3d{1.0},
+          makeModelDefinition("fixture/test/io/Mdl/armor.mdl"),
+          {},
+        },
+      },
+      mdl::EntityDefinition{
+        "cube",
+        Color{},
+        "",
+        {},
+        mdl::PointEntityDefinition{
+          vm::bbox3d{1.0},
+          makeModelDefinition("fixture/test/mdl/Game/Quake/id1/cube.bsp"),
+          {},
+        },
+      },
+    });
+
+    const auto processResources = [&]() {
+      document->processResourcesSync(mdl::ProcessContext{false, [](auto, auto) {}});
+    };
+
+    const auto expectedPhysicalBounds = [](const mdl::EntityNode& entityNode) {
+      const auto* modelFrame = entityNode.entity().modelFrame();
+      REQUIRE(modelFrame != nullptr);
+
+      const auto modelBounds = vm::bbox3d{modelFrame->bounds()}.transform(
+        entityNode.entity().modelTransformation(std::nullopt));
+      return vm::merge(entityNode.logicalBounds(), modelBounds);
+    };
+
+    auto* otherEntityNode = new mdl::EntityNode{mdl::Entity{{
+      {"classname", "cube"},
+      {"origin", "64 0 0"},
+    }}};
+    document->addNodes({{document->parentForNodes(), {otherEntityNode}}});
+    processResources();
+
+    const auto otherPhysicalBounds = otherEntityNode->physicalBounds();
+    REQUIRE(otherPhysicalBounds == expectedPhysicalBounds(*otherEntityNode));
+
+    auto* entityNode = new mdl::EntityNode{mdl::Entity{{
+      {"classname", "armor"},
+    }}};
+    document->addNodes({{document->parentForNodes(), {entityNode}}});
+
+    REQUIRE(entityNode->entity().model() != nullptr);
+    REQUIRE(entityNode->entity().modelFrame() == nullptr);
+    REQUIRE(entityNode->physicalBounds() == entityNode->logicalBounds());
+
+    processResources();
+
+    CHECK(entityNode->physicalBounds() == expectedPhysicalBounds(*entityNode));
+    CHECK(entityNode->physicalBounds() != entityNode->logicalBounds());
+    CHECK(otherEntityNode->physicalBounds() == otherPhysicalBounds);
+  }
+
   SECTION("throwExceptionDuringCommand")
   {
     CHECK_THROWS_AS(document->throwExceptionDuringCommand(), CommandProcessorException);
@@ -0,0 +1,226 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PreferenceManager.h"
+#include "Preferences.h"
+#include "mdl/Brush.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushNode.h"
+#include "mdl/MapFormat.h"
+#include "mdl/PickResult.h"
+#include "render/OrthographicCamera.h"
+#include "render/PerspectiveCamera.h"
+#include "ui/VertexHandleManager.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+#include "vm/distance.h"
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <memory>
+#include <ranges>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::ui
+{
+namespace
+{
+
+auto makeCubes()
+{
+  const auto worldBounds = vm::bbox3d{4096.0};
+  const auto builder = mdl::BrushBuilder{mdl::MapFormat::Standard, worldBounds};
+
+  auto result = std::vector<std::unique_ptr<mdl::BrushNode>>{};
+  for (int x = -2; x < 2; ++x)
+  {
+    for (int y = -2; y < 2; ++y)
+    {
+      for (int z = -1; z < 1; ++z)
+      {
+        const auto min = vm::vec3d{double(x), double(y), double(z)} * 32.0;
+        result.push_back(std::make_unique<mdl::BrushNode>(
+          builder.createCuboid(vm::bbox3d{min, min + vm::vec3d{32, 32, 32}}, "material")
+          | kdl::value()));
+      }
+    }
+  }
+  return result;
+}
+
+auto pickAllVertexHandles(
+  const VertexHandleManager& manager,
+  const vm::ray3d& pickRay,
+  const render::Camera& camera)
+{
+  auto pickResult = mdl::PickResult{};
+  for (const auto& position : manager.allHandles())
+  {
+    if (
+      const auto distance = camera.pickPointHandle(
+        pickRay, position, double(pref(Preferences::HandleRadius))))
+    {
+      const auto hitPoint = vm::point_at_distance(pickRay, *distance);
+      const auto error = vm::squared_distance(pickRay, position).distance;
+      pickResult.addHit(mdl::Hit{
+        VertexHandleManager::HandleHitType, *distance, hitPoint, position, error});
+    }
+  }
+  return pickResult;
+}
+
+auto hitPositions(const mdl::PickResult& pickResult)
+{
+  auto result = std::vector<vm::vec3d>{};
+  for (const auto& hit : pickResult.all())
+  {
+    result.push_back(hit.target<vm::vec3d>());
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("VertexHandleManagerTest.addAndRemoveHandles")
+{
+  const auto cubes = makeCubes();
+  auto* cube1 = cubes[0].get();
+  auto* cube2 = cubes[1].get();
+
+  auto manager = VertexHandleManager{};
+  manager.addHandles(cube1);
+  manager.addHandles(cube2);
+
+  // the cubes share one face
+  CHECK(manager.totalHandleCount() == 12);
+
+  const auto sharedVertex = vm::vec3d{-64, -64, 0};
+  const auto otherVertex = vm::vec3d{-64, -64, -32};
+  CHECK(manager.findIncidentBrushes(sharedVertex).size() == 2);
+  CHECK(
+    manager.findIncidentBrushes(otherVertex) == std::vector<mdl::BrushNode*>{cube1});
+  CHECK(
+    manager.findIncidentBrushes(std::vector{sharedVertex, otherVertex}).size() == 2);
+  CHECK(manager.findIncidentBrushes(vm::vec3d{1, 2, 3}).empty());
+
+  manager.select(sharedVertex);
+  CHECK(manager.selectedHandleCount() == 1);
+
+  manager.removeHandles(cube1);
+  CHECK(manager.totalHandleCount() == 8);
+  CHECK(manager.contains(sharedVertex));
+  CHECK_FALSE(manager.contains(otherVertex));
+  CHECK(manager.selected(sharedVertex));
+  CHECK(
+    manager.findIncidentBrushes(sharedVertex) == std::vector<mdl::BrushNode*>{cube2});
+
+  manager.removeHandles(cube2);
+  CHECK(manager.totalHandleCount() == 0);
+  CHECK(manager.selectedHandleCount() == 0);
+  CHECK(manager.findIncidentBrushes(sharedVertex).empty());
+}
+
+TEST_CASE("VertexHandleManagerTest.selectCloseHandles")
+{
+  const auto cubes = makeCubes();
+
+  auto manager = VertexHandleManager{};
+  manager.addHandles(cubes | std::views::transform([](auto& c) { return c.get(); }));
+  REQUIRE(manager.totalHandleCount() == 75);
+
+  // handles on the coordinate planes
+  manager.select(vm::vec3d{0, 0, 0});
+  manager.select(vm::vec3d{32, 0, -32.0000001});
+  CHECK(manager.selectedHandles() == std::vector<vm::vec3d>{{0, 0, 0}, {32, 0, -32}});
+
+  // too far away
+  manager.select(vm::vec3d{32, 0, -31.99});
+  CHECK(manager.selectedHandleCount() == 2);
+
+  manager.toggle(std::vector<vm::vec3d>{{0, 0, 0}, {64, 64, 32}});
+  CHECK(manager.selectedHandles() == std::vector<vm::vec3d>{{32, 0, -32}, {64, 64, 32}});
+
+  manager.deselect(vm::vec3d{31.9999999, 0, -32});
+  CHECK(manager.selectedHandles() == std::vector<vm::vec3d>{{64, 64, 32}});
+}
+
+TEST_CASE("VertexHandleManagerTest.pick")
+{
+  const auto cubes = makeCubes();
+
+  auto manager = VertexHandleManager{};
+  manager.addHandles(cubes | std::views::transform([](auto& c) { return c.get(); }));
+
+  SECTION("perspective camera")
+  {
+    const auto camera = render::PerspectiveCamera{
+      90.0f,
+      1.0f,
+      8000.0f,
+      render::Camera::Viewport{0, 0, 1920, 1080},
+      vm::vec3f{-160, -200, 100},
+      vm::normalize(vm::vec3f{1, 1, -0.5f}),
+      vm::vec3f{0, 0, 1}};
+
+    for (const auto& position : manager.allHandles())
+    {
+      const auto pickRay = vm::ray3d{camera.pickRay(vm::vec3f{position})};
+
+      auto pickResult = mdl::PickResult{};
+      manager.pick(pickRay, camera, pickResult);
+      CHECK_FALSE(pickResult.empty());
+      CHECK(
+        hitPositions(pickResult)
+        == hitPositions(pickAllVertexHandles(manager, pickRay, camera)));
+    }
+
+    // a ray that misses all handles
+    auto pickResult = mdl::PickResult{};
+    manager.pick(vm::ray3d{{-160, -200, 100}, {0, 0, 1}}, camera, pickResult);
+    CHECK(pickResult.empty());
+  }
+
+  SECTION("orthographic camera")
+  {
+    auto camera = render::OrthographicCamera{};
+    camera.moveTo({0, 0, 256});
+    camera.setDirection({0, 0, -1}, {0, 1, 0});
+
+    for (const auto& position : manager.allHandles())
+    {
+      const auto pickRay = vm::ray3d{
+        vm::vec3d{position.x() + 0.5, position.y() - 0.5, 256.0}, {0, 0, -1}};
+
+      auto pickResult = mdl::PickResult{};
+      manager.pick(pickRay, camera, pickResult);
+
+      // all handles along the ray are hit
+      CHECK(pickResult.size() == 3);
+      CHECK(
+        hitPositions(pickResult)
+        == hitPositions(pickAllVertexHandles(manager, pickRay, camera)));
+    }
+  }
+}
+
+} // namespace tb::ui
@@ -0,0 +1,102 @@
+/*
+ Copyright 2024 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kdl/task_manager.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <numeric>
+#include <ranges>
+#include <vector>
+
+#include "catch2.h"
+
+namespace kdl
+{
+namespace
+{
+
+constexpr auto TaskCount = std::size_t(500'000);
+
+// a small amount of work per task, similar to transforming or serializing a brush
+double work(const std::size_t i)
+{
+  auto result = 0.0;
+  for (std::size_t j = 0; j < 64; ++j)
+  {
+    result += std::sqrt(static_cast<double>(i + j));
+  }
+  return result;
+}
+
+template <typename F>
+double time_ms(F&& f)
+{
+  const auto start = std::chrono::high_resolution_clock::now();
+  f();
+  const auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double>(end - start).count() * 1000.0;
+}
+
+} // namespace
+
+TEST_CASE("task_manager scaling")
+{
+  const auto thread_counts = std::vector<std::size_t>{1, 2, 4, 8, 16, 32, 64};
+
+  for (const auto thread_count : thread_counts)
+  {
+    auto tm = task_manager{thread_count};
+
+    auto results = std::vector<double>(TaskCount);
+    const auto parallel_for_ms = time_ms([&] {
+      tm.parallel_for(0, TaskCount, [&](const std::size_t i) { results[i] = work(i); });
+    });
+
+    const auto parallel_transform_ms = time_ms([&] {
+      results = tm.parallel_transform(
+        std::views::iota(std::size_t(0), TaskCount), [](const std::size_t i) {
+          return work(i);
+        });
+    });
+
+    const auto tasks = std::views::iota(std::size_t(0), TaskCount)
+                       | std::views::transform([](const std::size_t i) {
+                           return std::function{[i]() { return work(i); }};
+                         })
+                       | to_vector;
+    const auto run_tasks_and_wait_ms =
+      time_ms([&] { results = tm.run_tasks_and_wait(tasks); });
+
+    std::printf(
+      "%2zu threads: parallel_for %8.2fms, parallel_transform %8.2fms, "
+      "run_tasks_and_wait %8.2fms\n",
+      thread_count,
+      parallel_for_ms,
+      parallel_transform_ms,
+      run_tasks_and_wait_ms);
+
+    CHECK(std::accumulate(results.begin(), results.end(), 0.0) > 0.0);
+  }
+}
+
+} // namespace kdl
@@ -0,0 +1,97 @@
+/*
+ Copyright 2025 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kdl/interned_string.h"
+
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace kdl
+{
+namespace
+{
+
+class symbol_table
+{
+private:
+  std::shared_mutex m_mutex;
+  std::unordered_map<std::string_view, std::unique_ptr<const std::string>> m_strings;
+
+public:
+  const std::string* intern(const std::string_view str)
+  {
+    {
+      const auto lock = std::shared_lock{m_mutex};
+      if (const auto it = m_strings.find(str); it != m_strings.end())
+      {
+        return it->second.get();
+      }
+    }
+
+    const auto lock = std::unique_lock{m_mutex};
+    if (const auto it = m_strings.find(str); it != m_strings.end())
+    {
+      return it->second.get();
+    }
+
+    // the key views the owned string, whose address doesn't change on rehashing
+    auto owned = std::make_unique<const std::string>(str);
+    const auto* result = owned.get();
+    m_strings.emplace(*result, std::move(owned));
+    return result;
+  }
+};
+
+symbol_table& symbols()
+{
+  // Intentionally leaked so that interned strings remain valid during static
+  // destruction.
+  static auto* table = new symbol_table{};
+  return *table;
+}
+
+const std::string* empty_string()
+{
+  // interned once so that default construction doesn't need to lock the table
+  static const auto* str = symbols().intern(std::string_view{});
+  return str;
+}
+
+} // namespace
+
+interned_string::interned_string()
+  : m_str{empty_string()}
+{
+}
+
+interned_string::interned_string(const std::string_view str)
+  : m_str{symbols().intern(str)}
+{
+}
+
+std::ostream& operator<<(std::ostream& lhs, const interned_string& rhs)
+{
+  return lhs << rhs.str();
+}
+
+} // namespace kdl
@@ -0,0 +1,91 @@
+/*
+ Copyright 2025 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+namespace kdl
+{
+
+/**
+ * A handle to an immutable string that is stored in a global symbol table.
+ *
+ * Equal strings are only stored once, so copying an interned string only copies a
+ * pointer, and two interned strings are equal if and only if they refer to the same
+ * table entry. The table entries are never removed.
+ *
+ * Interning a string is thread safe.
+ */
+class interned_string
+{
+private:
+  const std::string* m_str;
+
+public:
+  /**
+   * Creates a handle to the empty string.
+   */
+  interned_string();
+
+  /**
+   * Interns the given string.
+   */
+  explicit interned_string(std::string_view str);
+
+  /**
+   * Returns the interned string.
+   */
+  const std::string& str() const { return *m_str; }
+
+  bool empty() const { return m_str->empty(); }
+
+  friend bool operator==(const interned_string& lhs, const interned_string& rhs)
+  {
+    return lhs.m_str == rhs.m_str;
+  }
+
+  friend std::strong_ordering operator<=>(
+    const interned_string& lhs, const interned_string& rhs)
+  {
+    return lhs.m_str == rhs.m_str ? std::strong_ordering::equal
+                                  : *lhs.m_str <=> *rhs.m_str;
+  }
+
+  friend std::ostream& operator<<(std::ostream& lhs, const interned_string& rhs);
+
+  friend struct std::hash<interned_string>;
+};
+
+} // namespace kdl
+
+template <>
+struct std::hash<kdl::interned_string>
+{
+  std::size_t operator()(const kdl::interned_string& str) const noexcept
+  {
+    return std::hash<const std::string*>{}(str.m_str);
+  }
+};
@@ -0,0 +1,244 @@
+/*
+ Copyright 2025 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace kdl
+{
+
+/**
+ * Provides memory for objects of type T from large slabs instead of allocating every
+ * object individually.
+ *
+ * Every thread carves new blocks from its own slab and keeps a list of the blocks it has
+ * freed, so allocation and deallocation don't need to synchronize in the common case. A
+ * block may be freed on a different thread than it was allocated on. Once a thread holds
+ * more than two slabs worth of freed blocks, it returns a slab worth of them to a free
+ * list that is shared by all threads, and a thread that runs out of blocks refills its
+ * list from the shared list before it allocates a new slab. When a thread exits, its
+ * freed blocks and the rest of its slab are returned to the shared list.
+ *
+ * The slabs are never released, but their blocks are reused. The pool only grows to the
+ * largest number of objects that were alive at the same time plus the blocks held by the
+ * threads, which is at most three slabs per thread.
+ *
+ * The pool is intended to be used by a class-specific operator new and operator delete.
+ *
+ * @tparam T the type of the objects
+ * @tparam BlocksPerSlab the number of blocks in each slab
+ */
+template <typename T, std::size_t BlocksPerSlab = 1024>
+class object_pool
+{
+private:
+  struct free_block
+  {
+    free_block* next;
+  };
+
+  static constexpr auto block_alignment = std::max(alignof(T), alignof(free_block));
+  static constexpr auto block_size =
+    (std::max(sizeof(T), sizeof(free_block)) + block_alignment - 1) / block_alignment
+    * block_alignment;
+
+  static constexpr auto max_cached_blocks = 2 * BlocksPerSlab;
+
+  struct shared_state
+  {
+    std::mutex mutex;
+    free_block* free_list = nullptr;
+    std::vector<std::byte*> slabs;
+  };
+
+  // This must be trivially destructible so that it can still be accessed while the other
+  // thread local objects of the thread are destroyed.
+  struct thread_cache
+  {
+    free_block* free_list = nullptr;
+    std::size_t free_count = 0;
+    std::byte* next_block = nullptr;
+    std::byte* slab_end = nullptr;
+    bool registered = false;
+    bool exited = false;
+  };
+
+  struct thread_exit_handler
+  {
+    ~thread_exit_handler()
+    {
+      auto& c = cache();
+      auto& s = shared();
+
+      const auto lock = std::lock_guard{s.mutex};
+      move_blocks(c.free_list, s.free_list, c.free_count);
+      for (; c.next_block != c.slab_end; c.next_block += block_size)
+      {
+        s.free_list = new (c.next_block) free_block{s.free_list};
+      }
+
+      c.free_count = 0;
+      c.exited = true;
+    }
+  };
+
+  static shared_state& shared()
+  {
+    // The shared state and the slabs are intentionally leaked so that objects which are
+    // destroyed during static destruction can still return their memory.
+    static auto* result = new shared_state{};
+    return *result;
+  }
+
+  static thread_cache& cache()
+  {
+    thread_local auto result = thread_cache{};
+    if (!result.registered)
+    {
+      result.registered = true;
+      thread_local auto exit_handler = thread_exit_handler{};
+    }
+    return result;
+  }
+
+  /**
+   * Moves up to the given number of blocks from the front of one list to the front of
+   * another and returns the number of blocks that were moved.
+   */
+  static std::size_t move_blocks(
+    free_block*& from, free_block*& to, const std::size_t count)
+  {
+    auto moved = std::size_t(0);
+    while (from && moved < count)
+    {
+      auto* block = from;
+      from = block->next;
+      block->next = to;
+      to = block;
+      ++moved;
+    }
+    return moved;
+  }
+
+  // Must be called with the mutex of the shared state held.
+  static std::byte* allocate_slab(shared_state& s)
+  {
+    auto* slab = static_cast<std::byte*>(::operator new(
+      block_size * BlocksPerSlab, std::align_val_t{block_alignment}));
+    s.slabs.push_back(slab);
+    return slab;
+  }
+
+  static void* allocate_shared()
+  {
+    auto& s = shared();
+    const auto lock = std::lock_guard{s.mutex};
+
+    if (!s.free_list)
+    {
+      auto* slab = allocate_slab(s);
+      for (std::size_t i = 0; i < BlocksPerSlab; ++i)
+      {
+        s.free_list = new (slab + i * block_size) free_block{s.free_list};
+      }
+    }
+
+    auto* block = s.free_list;
+    s.free_list = block->next;
+    return block;
+  }
+
+  static void deallocate_shared(void* ptr)
+  {
+    auto& s = shared();
+    const auto lock = std::lock_guard{s.mutex};
+    s.free_list = new (ptr) free_block{s.free_list};
+  }
+
+public:
+  /**
+   * Returns a block of memory that is large enough for an object of type T.
+   */
+  static void* allocate()
+  {
+    auto& c = cache();
+    if (c.exited)
+    {
+      return allocate_shared();
+    }
+
+    if (!c.free_list && c.next_block == c.slab_end)
+    {
+      auto& s = shared();
+      const auto lock = std::lock_guard{s.mutex};
+
+      c.free_count += move_blocks(s.free_list, c.free_list, BlocksPerSlab);
+      if (!c.free_list)
+      {
+        c.next_block = allocate_slab(s);
+        c.slab_end = c.next_block + block_size * BlocksPerSlab;
+      }
+    }
+
+    if (c.free_list)
+    {
+      auto* block = c.free_list;
+      c.free_list = block->next;
+      --c.free_count;
+      return block;
+    }
+
+    auto* block = c.next_block;
+    c.next_block += block_size;
+    return block;
+  }
+
+  /**
+   * Returns the given block to the pool. The block must have been returned by allocate.
+   */
+  static void deallocate(void* ptr) noexcept
+  {
+    if (ptr)
+    {
+      auto& c = cache();
+      if (c.exited)
+      {
+        deallocate_shared(ptr);
+        return;
+      }
+
+      c.free_list = new (ptr) free_block{c.free_list};
+      if (++c.free_count > max_cached_blocks)
+      {
+        auto& s = shared();
+        const auto lock = std::lock_guard{s.mutex};
+        c.free_count -= move_blocks(c.free_list, s.free_list, BlocksPerSlab);
+      }
+    }
+  }
+};
+
+} // namespace kdl
@@ -20,62 +20,205 @@
 
 #include "kdl/task_manager.h"
 
-#include "kdl/range_to_vector.h"
-
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
-#include <functional>
-#include <future>
+#include <exception>
+#include <memory>
 #include <mutex>
-#include <queue>
-#include <ranges>
+#include <optional>
 #include <thread>
 #include <vector>
 
 namespace kdl
 {
+namespace detail
+{
+namespace
+{
+// identifies the task manager and queue of the current worker thread, if any
+thread_local const void* current_task_manager = nullptr;
+thread_local std::size_t current_worker_index = 0;
+} // namespace
 
-std::function<void()> task_manager::make_worker_func()
+parallel_for_state::parallel_for_state(
+  void* func_,
+  invoke_chunk_func invoke_chunk_,
+  const std::size_t first_,
+  const std::size_t last_,
+  const std::size_t chunk_size_)
+  : func{func_}
+  , invoke_chunk{invoke_chunk_}
+  , first{first_}
+  , last{last_}
+  , chunk_size{chunk_size_}
+  , chunk_count{(last_ - first_ + chunk_size_ - 1) / chunk_size_}
 {
-  return [&] {
-    while (true)
+}
+
+void parallel_for_state::run_chunks()
+{
+  while (true)
+  {
+    const auto chunk = next_chunk.fetch_add(1, std::memory_order_relaxed);
+    if (chunk >= chunk_count)
     {
-      auto lock = std::unique_lock{m_pending_tasks_mutex};
-      m_pending_tasks_cv.wait(
-        lock, [&] { return !m_running || !m_pending_tasks.empty(); });
+      break;
+    }
+
+    const auto chunk_first = first + chunk * chunk_size;
+    const auto chunk_last = std::min(chunk_first + chunk_size, last);
 
-      if (!m_running)
+    try
+    {
+      invoke_chunk(func, chunk_first, chunk_last);
+    }
+    catch (...)
+    {
+      auto lock = std::lock_guard{exception_mutex};
+      if (!exception)
       {
-        break;
+        exception = std::current_exception();
       }
+    }
 
-      if (!m_pending_tasks.empty())
-      {
-        auto task = std::move(m_pending_tasks.front());
-        m_pending_tasks.pop();
-        lock.unlock();
+    if (completed_chunks.fetch_add(1, std::memory_order_acq_rel) + 1 == chunk_count)
+    {
+      completed_chunks.notify_all();
+    }
+  }
+}
 
-        task();
-      }
+void parallel_for_state::wait()
+{
+  auto completed = completed_chunks.load(std::memory_order_acquire);
+  while (completed < chunk_count)
+  {
+    completed_chunks.wait(completed, std::memory_order_acquire);
+    completed = completed_chunks.load(std::memory_order_acquire);
+  }
+}
+
+} // namespace detail
+
+void task_manager::run_worker(const std::size_t worker_index)
+{
+  detail::current_task_manager = this;
+  detail::current_worker_index = worker_index;
+
+  while (m_running)
+  {
+    if (auto task = pop_task(worker_index))
+    {
+      (*task)();
+      continue;
+    }
+
+    auto lock = std::unique_lock{m_sleep_mutex};
+    m_sleep_cv.wait(lock, [&] { return !m_running || m_pending_task_count > 0; });
+  }
+}
+
+void task_manager::push_task(detail::task task)
+{
+  // workers push to their own queue, other threads distribute their tasks evenly
+  const auto queue_index =
+    detail::current_task_manager == this
+      ? detail::current_worker_index
+      : m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+
+  // count the task before publishing it so that a worker that pops it right away cannot
+  // decrement the count below zero
+  m_pending_task_count.fetch_add(1);
+
+  {
+    auto& queue = *m_queues[queue_index];
+    auto lock = std::lock_guard{queue.mutex};
+    queue.tasks.push_back(std::move(task));
+  }
+
+  {
+    auto lock = std::lock_guard{m_sleep_mutex};
+  }
+  m_sleep_cv.notify_one();
+}
+
+std::optional<detail::task> task_manager::pop_task(const std::size_t first_queue_index)
+{
+  if (m_pending_task_count.load() == 0)
+  {
+    return std::nullopt;
+  }
+
+  // take the most recently pushed task from our own queue, but steal the oldest task
+  // from other queues
+  {
+    auto& queue = *m_queues[first_queue_index];
+    auto lock = std::lock_guard{queue.mutex};
+    if (!queue.tasks.empty())
+    {
+      auto task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+      m_pending_task_count.fetch_sub(1);
+      return task;
     }
-  };
+  }
+
+  for (std::size_t i = 1; i < m_queues.size(); ++i)
+  {
+    auto& queue = *m_queues[(first_queue_index + i) % m_queues.size()];
+    auto lock = std::lock_guard{queue.mutex};
+    if (!queue.tasks.empty())
+    {
+      auto task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      m_pending_task_count.fetch_sub(1);
+      return task;
+    }
+  }
+
+  return std::nullopt;
+}
+
+void task_manager::run_parallel_for(std::shared_ptr<detail::parallel_for_state> state)
+{
+  // the calling thread processes chunks too, so we need one helper less than chunks
+  const auto helper_count = std::min(m_workers.size(), state->chunk_count - 1);
+  for (std::size_t i = 0; i < helper_count; ++i)
+  {
+    push_task(detail::task{[state]() { state->run_chunks(); }});
+  }
+
+  state->run_chunks();
+  state->wait();
+
+  if (state->exception)
+  {
+    std::rethrow_exception(state->exception);
+  }
 }
 
 task_manager::task_manager(const std::size_t max_concurrent_tasks)
 {
   for (size_t i = 0; i < max_concurrent_tasks; ++i)
   {
-    m_workers.emplace_back(make_worker_func());
+    m_queues.push_back(std::make_unique<worker_queue>());
+  }
+
+  for (size_t i = 0; i < max_concurrent_tasks; ++i)
+  {
+    m_workers.emplace_back([&, i] { run_worker(i); });
   }
 }
 
 task_manager::~task_manager()
 {
   {
-    auto lock = std::lock_guard{m_pending_tasks_mutex};
+    auto lock = std::lock_guard{m_sleep_mutex};
     m_running = false;
   }
 
-  m_pending_tasks_cv.notify_all();
+  m_sleep_cv.notify_all();
   for (auto& worker : m_workers)
   {
     worker.join();
@@ -22,31 +22,217 @@
 
 #include "kdl/range_to_vector.h"
 
+#include <algorithm>
+#include <atomic>
+#include <concepts>
 #include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
 #include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <new>
+#include <optional>
 #include <ranges>
 #include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace kdl
 {
+namespace detail
+{
+
+/**
+ * A move only type erased nullary callable. Callables that fit into the inline buffer
+ * are stored without allocating, which is the case for all tasks created by the task
+ * manager itself.
+ */
+class task
+{
+private:
+  static constexpr std::size_t inline_size = 6 * sizeof(void*);
+
+  struct vtable
+  {
+    void (*invoke)(void*);
+    void (*move)(void* dst, void* src);
+    void (*destroy)(void*);
+  };
+
+  template <typename F>
+  static constexpr bool fits_inline = sizeof(F) <= inline_size
+                                      && alignof(F) <= alignof(std::max_align_t)
+                                      && std::is_nothrow_move_constructible_v<F>;
+
+  template <typename F>
+  static constexpr vtable inline_vtable = {
+    [](void* f) { (*static_cast<F*>(f))(); },
+    [](void* dst, void* src) {
+      new (dst) F{std::move(*static_cast<F*>(src))};
+      static_cast<F*>(src)->~F();
+    },
+    [](void* f) { static_cast<F*>(f)->~F(); },
+  };
+
+  template <typename F>
+  static constexpr vtable heap_vtable = {
+    [](void* f) { (**static_cast<F**>(f))(); },
+    [](void* dst, void* src) { *static_cast<F**>(dst) = *static_cast<F**>(src); },
+    [](void* f) { delete *static_cast<F**>(f); },
+  };
+
+  alignas(std::max_align_t) std::byte m_storage[inline_size];
+  const vtable* m_vtable = nullptr;
+
+public:
+  task() = default;
+
+  template <typename F>
+    requires(!std::same_as<std::remove_cvref_t<F>, task>)
+  explicit task(F&& f)
+  {
+    using func_type = std::remove_cvref_t<F>;
+    if constexpr (fits_inline<func_type>)
+    {
+      new (m_storage) func_type{std::forward<F>(f)};
+      m_vtable = &inline_vtable<func_type>;
+    }
+    else
+    {
+      *reinterpret_cast<func_type**>(m_storage) = new func_type{std::forward<F>(f)};
+      m_vtable = &heap_vtable<func_type>;
+    }
+  }
+
+  task(task&& other) noexcept
+    : m_vtable{std::exchange(other.m_vtable, nullptr)}
+  {
+    if (m_vtable)
+    {
+      m_vtable->move(m_storage, other.m_storage);
+    }
+  }
+
+  task& operator=(task&& other) noexcept
+  {
+    if (this != &other)
+    {
+      reset();
+      m_vtable = std::exchange(other.m_vtable, nullptr);
+      if (m_vtable)
+      {
+        m_vtable->move(m_storage, other.m_storage);
+      }
+    }
+    return *this;
+  }
+
+  task(const task&) = delete;
+  task& operator=(const task&) = delete;
+
+  ~task() { reset(); }
+
+  explicit operator bool() const { return m_vtable != nullptr; }
+
+  void operator()() { m_vtable->invoke(m_storage); }
+
+private:
+  void reset()
+  {
+    if (m_vtable)
+    {
+      m_vtable->destroy(m_storage);
+      m_vtable = nullptr;
+    }
+  }
+};
 
+/**
+ * Shared state of a chunked parallel loop. Every thread that participates in the loop
+ * claims chunks by incrementing next_chunk until all chunks are claimed. The caller of
+ * the loop waits until completed_chunks reaches chunk_count.
+ *
+ * The state is shared with the helper tasks because a helper task may only start
+ * running after the loop has completed, in which case it finds no chunk to claim.
+ */
+struct parallel_for_state
+{
+  using invoke_chunk_func = void (*)(void* func, std::size_t first, std::size_t last);
+
+  void* func;
+  invoke_chunk_func invoke_chunk;
+
+  std::size_t first;
+  std::size_t last;
+  std::size_t chunk_size;
+  std::size_t chunk_count;
+
+  std::atomic<std::size_t> next_chunk = 0;
+  std::atomic<std::size_t> completed_chunks = 0;
+
+  std::mutex exception_mutex;
+  std::exception_ptr exception;
+
+  parallel_for_state(
+    void* func,
+    invoke_chunk_func invoke_chunk,
+    std::size_t first,
+    std::size_t last,
+    std::size_t chunk_size);
+
+  /**
+   * Claims and runs chunks until there are none left. Returns when no more chunks can
+   * be claimed, which does not mean that all chunks have completed.
+   */
+  void run_chunks();
+
+  /**
+   * Blocks until all chunks have completed.
+   */
+  void wait();
+};
+
+} // namespace detail
+
+/**
+ * Runs tasks on a fixed number of worker threads.
+ *
+ * Each worker owns a deque of pending tasks. Workers pop tasks from the back of their
+ * own deque and steal from the front of the other workers' deques when their own deque
+ * is empty, so that there is no single lock that all workers contend for.
+ *
+ * Besides submitting individual tasks with run_task, a range of indices can be
+ * processed with parallel_for and parallel_transform. These split the range into
+ * chunks which are claimed by the workers and by the calling thread itself, so that
+ * submitting a range costs at most one small task per worker regardless of the size of
+ * the range.
+ */
 class task_manager
 {
 private:
-  using pending_task = std::function<void()>;
+  struct worker_queue
+  {
+    std::mutex mutex;
+    std::deque<detail::task> tasks;
+  };
 
+  std::vector<std::unique_ptr<worker_queue>> m_queues;
   std::vector<std::thread> m_workers;
 
-  std::mutex m_pending_tasks_mutex;
-  std::condition_variable m_pending_tasks_cv;
-  std::queue<pending_task> m_pending_tasks;
-  bool m_running = true;
+  std::mutex m_sleep_mutex;
+  std::condition_variable m_sleep_cv;
+  std::atomic<std::size_t> m_pending_task_count = 0;
+  std::atomic<std::size_t> m_next_queue = 0;
+  std::atomic<bool> m_running = true;
 
-  std::function<void()> make_worker_func();
+  void run_worker(std::size_t worker_index);
+  void push_task(detail::task task);
+  std::optional<detail::task> pop_task(std::size_t first_queue_index);
+  void run_parallel_for(std::shared_ptr<detail::parallel_for_state> state);
 
 public:
   explicit task_manager(
@@ -54,26 +240,43 @@ public:
 
   ~task_manager();
 
-  template <typename task_result>
-  auto run_task(std::function<task_result()> task)
+  std::size_t worker_count() const { return m_workers.size(); }
+
+  template <typename F>
+  auto run_task(F task)
   {
+    using task_result = std::invoke_result_t<F&>;
+
     if (m_workers.empty())
     {
       auto promise = std::promise<task_result>{};
-      promise.set_value(task());
+      if constexpr (std::is_void_v<task_result>)
+      {
+        task();
+        promise.set_value();
+      }
+      else
+      {
+        promise.set_value(task());
+      }
       return promise.get_future();
     }
 
-    auto promise = std::make_shared<std::promise<task_result>>();
-    auto future = promise->get_future();
+    auto promise = std::promise<task_result>{};
+    auto future = promise.get_future();
 
-    {
-      auto lock = std::lock_guard{m_pending_tasks_mutex};
-      m_pending_tasks.push([&, task_ = std::move(task), promise_ = std::move(promise)]() {
-        promise_->set_value(task_());
-      });
-    }
-    m_pending_tasks_cv.notify_one();
+    push_task(detail::task{
+      [task_ = std::move(task), promise_ = std::move(promise)]() mutable {
+        if constexpr (std::is_void_v<task_result>)
+        {
+          task_();
+          promise_.set_value();
+        }
+        else
+        {
+          promise_.set_value(task_());
+        }
+      }});
 
     return future;
   }
@@ -87,12 +290,96 @@ public:
            | to_vector;
   }
 
+  /**
+   * Calls f(i) for every i in [first, last) and waits until all calls have returned.
+   *
+   * The range is split into chunks of grain_size indices. If grain_size is 0, a chunk
+   * size is chosen so that every worker gets a few chunks to balance the load. The
+   * calling thread processes chunks, too. If any call to f throws, the first exception
+   * is rethrown after all chunks have completed.
+   */
+  template <typename F>
+  void parallel_for(
+    const std::size_t first, const std::size_t last, F&& f, std::size_t grain_size = 0)
+  {
+    if (first >= last)
+    {
+      return;
+    }
+
+    const auto count = last - first;
+    if (grain_size == 0)
+    {
+      const auto target_chunk_count = std::max(std::size_t(1), m_workers.size() * 4);
+      grain_size = std::max(std::size_t(1), count / target_chunk_count);
+    }
+
+    if (m_workers.empty() || count <= grain_size)
+    {
+      for (auto i = first; i < last; ++i)
+      {
+        f(i);
+      }
+      return;
+    }
+
+    using func_type = std::remove_reference_t<F>;
+    run_parallel_for(std::make_shared<detail::parallel_for_state>(
+      const_cast<void*>(static_cast<const void*>(std::addressof(f))),
+      [](void* func, const std::size_t chunk_first, const std::size_t chunk_last) {
+        auto& f_ = *static_cast<func_type*>(func);
+        for (auto i = chunk_first; i < chunk_last; ++i)
+        {
+          f_(i);
+        }
+      },
+      first,
+      last,
+      grain_size));
+  }
+
+  /**
+   * Applies f to every element of the given random access range in parallel and
+   * returns the results in the order of the range elements.
+   */
+  template <std::ranges::random_access_range range, typename F>
+    requires std::ranges::sized_range<range>
+  auto parallel_transform(range&& r, F&& f, const std::size_t grain_size = 0)
+  {
+    using element_type = std::ranges::range_reference_t<range>;
+    using result_type = std::remove_cvref_t<std::invoke_result_t<F&, element_type>>;
+
+    const auto size = static_cast<std::size_t>(std::ranges::size(r));
+    auto begin = std::ranges::begin(r);
+
+    auto results = std::vector<std::optional<result_type>>(size);
+    parallel_for(
+      0,
+      size,
+      [&](const std::size_t i) {
+        results[i].emplace(
+          f(begin[static_cast<std::ranges::range_difference_t<range>>(i)]));
+      },
+      grain_size);
+
+    return results
+           | std::views::transform([](auto& result) { return std::move(*result); })
+           | to_vector;
+  }
+
   template <std::ranges::range range>
   auto run_tasks_and_wait(range&& tasks)
   {
-    auto futures = run_tasks(std::forward<range>(tasks));
-    return futures | std::views::transform([](auto& future) { return future.get(); })
-           | to_vector;
+    if constexpr (
+      std::ranges::random_access_range<range> && std::ranges::sized_range<range>)
+    {
+      return parallel_transform(
+        std::forward<range>(tasks), [](auto&& task) { return task(); }, 1);
+    }
+    else
+    {
+      return run_tasks_and_wait(std::forward<range>(tasks) | to_vector);
+    }
   }
 };
 
@@ -0,0 +1,103 @@
+/*
+ Copyright 2025 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kdl/interned_string.h"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "catch2.h"
+
+namespace kdl
+{
+
+TEST_CASE("interned_string")
+{
+  SECTION("default constructor")
+  {
+    CHECK(interned_string{}.str() == "");
+    CHECK(interned_string{}.empty());
+    CHECK(interned_string{} == interned_string{""});
+  }
+
+  SECTION("equal strings are interned once")
+  {
+    const auto s1 = interned_string{"some_material"};
+    const auto s2 = interned_string{std::string{"some_"} + "material"};
+    const auto s3 = interned_string{"other_material"};
+
+    CHECK(s1.str() == "some_material");
+    CHECK(&s1.str() == &s2.str());
+    CHECK(s1 == s2);
+    CHECK(s1 != s3);
+    CHECK(std::hash<interned_string>{}(s1) == std::hash<interned_string>{}(s2));
+  }
+
+  SECTION("ordering")
+  {
+    CHECK(interned_string{"a"} < interned_string{"b"});
+    CHECK(interned_string{"b"} > interned_string{"a"});
+    CHECK(interned_string{"a"} <= interned_string{"a"});
+    CHECK_FALSE(interned_string{"a"} < interned_string{"a"});
+  }
+
+  SECTION("operator<<")
+  {
+    auto str = std::stringstream{};
+    str << interned_string{"some_material"};
+    CHECK(str.str() == "some_material");
+  }
+
+  SECTION("strings can be interned concurrently")
+  {
+    auto results = std::vector<std::vector<const std::string*>>(4);
+    auto threads = std::vector<std::thread>{};
+    for (size_t t = 0; t < results.size(); ++t)
+    {
+      threads.emplace_back([&, t]() {
+        for (size_t i = 0; i < 100; ++i)
+        {
+          results[t].push_back(
+            &interned_string{"concurrent_" + std::to_string(i)}.str());
+        }
+      });
+    }
+
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    for (const auto& result : results)
+    {
+      CHECK(result == results.front());
+    }
+    CHECK(
+      std::unordered_set<const std::string*>{
+        results.front().begin(), results.front().end()}
+        .size()
+      == 100u);
+  }
+}
+
+} // namespace kdl
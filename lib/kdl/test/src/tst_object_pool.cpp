@@ -0,0 +1,204 @@
+/*
+ Copyright 2025 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kdl/object_pool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "catch2.h"
+
+namespace kdl
+{
+namespace
+{
+
+struct alignas(32) aligned_type
+{
+  char c;
+};
+
+// every test that depends on the state of the pool uses its own type so that it gets its
+// own pool
+template <int N>
+struct tagged_type
+{
+  std::uint64_t value;
+};
+
+template <typename Pool>
+std::vector<void*> allocate_blocks(const std::size_t count)
+{
+  auto result = std::vector<void*>{};
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    result.push_back(Pool::allocate());
+  }
+  return result;
+}
+
+template <typename Pool>
+void deallocate_blocks(const std::vector<void*>& blocks)
+{
+  for (auto* block : blocks)
+  {
+    Pool::deallocate(block);
+  }
+}
+
+std::unordered_set<void*> to_set(const std::vector<void*>& blocks)
+{
+  return {blocks.begin(), blocks.end()};
+}
+
+} // namespace
+
+TEST_CASE("object_pool")
+{
+  using pool = object_pool<std::uint64_t, 4>;
+
+  SECTION("allocate returns distinct blocks")
+  {
+    auto blocks = std::vector<void*>{};
+    for (size_t i = 0; i < 10; ++i)
+    {
+      blocks.push_back(pool::allocate());
+    }
+
+    CHECK(std::unordered_set<void*>{blocks.begin(), blocks.end()}.size() == 10u);
+
+    for (auto* block : blocks)
+    {
+      pool::deallocate(block);
+    }
+  }
+
+  SECTION("deallocated blocks are reused")
+  {
+    auto* block1 = pool::allocate();
+    auto* block2 = pool::allocate();
+
+    pool::deallocate(block1);
+    pool::deallocate(block2);
+
+    CHECK(pool::allocate() == block2);
+    CHECK(pool::allocate() == block1);
+
+    pool::deallocate(block1);
+    pool::deallocate(block2);
+  }
+
+  SECTION("blocks can be deallocated on another thread")
+  {
+    auto* block = pool::allocate();
+
+    auto* reused = static_cast<void*>(nullptr);
+    auto thread = std::thread{[&]() {
+      pool::deallocate(block);
+      reused = pool::allocate();
+      pool::deallocate(reused);
+    }};
+    thread.join();
+
+    CHECK(reused == block);
+  }
+
+  SECTION("blocks freed on another thread are returned to the shared free list")
+  {
+    using tagged_pool = object_pool<tagged_type<0>, 4>;
+
+    // three full slabs
+    const auto blocks = allocate_blocks<tagged_pool>(12);
+
+    auto freed = std::promise<void>{};
+    auto done = std::promise<void>{};
+    auto thread = std::thread{[&]() {
+      // the thread keeps 8 blocks and returns 4 blocks to the shared free list
+      deallocate_blocks<tagged_pool>(blocks);
+      freed.set_value();
+      done.get_future().wait();
+    }};
+
+    freed.get_future().wait();
+
+    // while the thread is still running, this thread gets the returned blocks instead of
+    // allocating a new slab
+    const auto reused = allocate_blocks<tagged_pool>(4);
+    done.set_value();
+    thread.join();
+
+    for (auto* block : reused)
+    {
+      CHECK(to_set(blocks).contains(block));
+    }
+
+    deallocate_blocks<tagged_pool>(reused);
+  }
+
+  SECTION("blocks held by a thread are returned when the thread exits")
+  {
+    using tagged_pool = object_pool<tagged_type<1>, 4>;
+
+    auto blocks = std::vector<void*>{};
+    auto thread = std::thread{[&]() {
+      // one freed block and three blocks that were never handed out
+      blocks = allocate_blocks<tagged_pool>(1);
+      deallocate_blocks<tagged_pool>(blocks);
+    }};
+    thread.join();
+
+    const auto reused = allocate_blocks<tagged_pool>(4);
+    CHECK(to_set(reused).size() == 4u);
+    CHECK(to_set(reused).contains(blocks.front()));
+
+    // all blocks come from the slab of the other thread
+    const auto [min, max] = std::minmax_element(reused.begin(), reused.end());
+    CHECK(
+      static_cast<std::byte*>(*max) - static_cast<std::byte*>(*min)
+      == 3 * static_cast<std::ptrdiff_t>(sizeof(tagged_type<1>)));
+
+    deallocate_blocks<tagged_pool>(reused);
+  }
+
+  SECTION("blocks are aligned")
+  {
+    using aligned_pool = object_pool<aligned_type, 4>;
+
+    auto blocks = std::vector<void*>{};
+    for (size_t i = 0; i < 10; ++i)
+    {
+      blocks.push_back(aligned_pool::allocate());
+      CHECK(
+        reinterpret_cast<std::uintptr_t>(blocks.back()) % alignof(aligned_type) == 0u);
+    }
+
+    for (auto* block : blocks)
+    {
+      aligned_pool::deallocate(block);
+    }
+  }
+}
+
+} // namespace kdl
@@ -21,8 +21,12 @@
 #include "kdl/range_to_vector.h"
 #include "kdl/task_manager.h"
 
+#include <atomic>
 #include <memory>
+#include <stdexcept>
+#include <string>
 #include <tuple>
+#include <vector>
 
 #include "catch2.h"
 
@@ -123,6 +127,84 @@ TEST_CASE("task_manager")
   }
 }
 
+TEST_CASE("task_manager::parallel_for")
+{
+  const auto max_concurrent_tasks = GENERATE(0u, 1u, 2u, 3u, 4u);
+  CAPTURE(max_concurrent_tasks);
+
+  auto tm = task_manager{max_concurrent_tasks};
+
+  SECTION("empty range")
+  {
+    auto calls = std::atomic<size_t>{0};
+    tm.parallel_for(3, 3, [&](size_t) { ++calls; });
+    tm.parallel_for(3, 2, [&](size_t) { ++calls; });
+    CHECK(calls == 0);
+  }
+
+  SECTION("visits every index exactly once")
+  {
+    const auto grain_size = GENERATE(0u, 1u, 7u, 1000u);
+    CAPTURE(grain_size);
+
+    auto visits = std::vector<std::atomic<int>>(250);
+    tm.parallel_for(
+      10, 250, [&](const size_t i) { ++visits[i]; }, grain_size);
+
+    for (size_t i = 0; i < visits.size(); ++i)
+    {
+      CHECK(visits[i] == (i < 10 ? 0 : 1));
+    }
+  }
+
+  SECTION("nested loops")
+  {
+    auto sum = std::atomic<size_t>{0};
+    tm.parallel_for(
+      0,
+      16,
+      [&](size_t) { tm.parallel_for(0, 16, [&](const size_t j) { sum += j; }, 1); },
+      1);
+    CHECK(sum == 16 * (15 * 16 / 2));
+  }
+
+  SECTION("rethrows exceptions")
+  {
+    CHECK_THROWS_AS(
+      tm.parallel_for(
+        0,
+        100,
+        [&](const size_t i) {
+          if (i == 42)
+          {
+            throw std::runtime_error{"42"};
+          }
+        },
+        1),
+      std::runtime_error);
+  }
+}
+
+TEST_CASE("task_manager::parallel_transform")
+{
+  const auto max_concurrent_tasks = GENERATE(0u, 1u, 4u);
+  CAPTURE(max_concurrent_tasks);
+
+  auto tm = task_manager{max_concurrent_tasks};
+
+  const auto ints = std::views::iota(0, 1000) | to_vector;
+  const auto strings =
+    tm.parallel_transform(ints, [](const int i) { return std::to_string(i * 2); });
+
+  REQUIRE(strings.size() == ints.size());
+  for (size_t i = 0; i < ints.size(); ++i)
+  {
+    CHECK(strings[i] == std::to_string(ints[i] * 2));
+  }
+
+  CHECK(tm.parallel_transform(std::vector<int>{}, [](const int i) { return i; }).empty());
+}
+
 TEST_CASE("task_manager stress test")
 {
   auto tm = task_manager{};